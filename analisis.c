@@ -10,9 +10,14 @@
 #include "db.h"
 #include "utils.h"
 #include "menu.h"
+#include "partido_store.h"
+#include "rachas.h"
+#include "settings.h"
+#include "forma.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 
 
@@ -30,103 +35,75 @@ typedef struct
 } Estadisticas;
 
 /**
- * @brief Calcula estadísticas generales de todos los partidos
- *
- * Establece línea base de rendimiento histórico para comparaciones.
+ * @brief Promedia las métricas de un tramo de partidos consecutivos
  *
+ * @param store Copia en memoria de partido
+ * @param desde Primera posición del tramo
+ * @param hasta Posición siguiente a la última del tramo
  * @param stats Puntero a la estructura donde almacenar las estadísticas
  */
-static void calcular_estadisticas_generales(Estadisticas *stats)
+static void promediar_tramo(const PartidoStore *store, int desde, int hasta, Estadisticas *stats)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT COUNT(*), AVG(goles), AVG(asistencias), AVG(rendimiento_general), AVG(cansancio), AVG(estado_animo) "
-                       "FROM partido",
-                       -1, &stmt, NULL);
+    long long goles = 0, asistencias = 0, rendimiento = 0, cansancio = 0, animo = 0;
 
-    if (sqlite3_step(stmt) == SQLITE_ROW)
+    for (int i = desde; i < hasta; i++)
     {
-        stats->total_partidos = sqlite3_column_int(stmt, 0);
-        stats->avg_goles = sqlite3_column_double(stmt, 1);
-        stats->avg_asistencias = sqlite3_column_double(stmt, 2);
-        stats->avg_rendimiento = sqlite3_column_double(stmt, 3);
-        stats->avg_cansancio = sqlite3_column_double(stmt, 4);
-        stats->avg_animo = sqlite3_column_double(stmt, 5);
+        goles += store->goles[i];
+        asistencias += store->asistencias[i];
+        rendimiento += store->rendimiento[i];
+        cansancio += store->cansancio[i];
+        animo += store->animo[i];
+    }
+
+    stats->total_partidos = hasta - desde;
+    if (stats->total_partidos > 0)
+    {
+        stats->avg_goles = (double)goles / stats->total_partidos;
+        stats->avg_asistencias = (double)asistencias / stats->total_partidos;
+        stats->avg_rendimiento = (double)rendimiento / stats->total_partidos;
+        stats->avg_cansancio = (double)cansancio / stats->total_partidos;
+        stats->avg_animo = (double)animo / stats->total_partidos;
     }
-    sqlite3_finalize(stmt);
 }
 
 /**
- * @brief Calcula estadísticas de los últimos 5 partidos
+ * @brief Calcula estadísticas generales de todos los partidos
+ *
+ * Establece línea base de rendimiento histórico para comparaciones.
  *
+ * @param store Copia en memoria de partido
  * @param stats Puntero a la estructura donde almacenar las estadísticas
  */
-static void calcular_estadisticas_ultimos5(Estadisticas *stats)
+static void calcular_estadisticas_generales(const PartidoStore *store, Estadisticas *stats)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT COUNT(*), AVG(goles), AVG(asistencias), AVG(rendimiento_general), AVG(cansancio), AVG(estado_animo) "
-                       "FROM (SELECT * FROM partido ORDER BY fecha_hora DESC LIMIT 5)",
-                       -1, &stmt, NULL);
+    promediar_tramo(store, 0, store->n, stats);
+}
 
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        stats->total_partidos = sqlite3_column_int(stmt, 0);
-        stats->avg_goles = sqlite3_column_double(stmt, 1);
-        stats->avg_asistencias = sqlite3_column_double(stmt, 2);
-        stats->avg_rendimiento = sqlite3_column_double(stmt, 3);
-        stats->avg_cansancio = sqlite3_column_double(stmt, 4);
-        stats->avg_animo = sqlite3_column_double(stmt, 5);
-    }
-    sqlite3_finalize(stmt);
+/**
+ * @brief Calcula estadísticas de los últimos 5 partidos
+ *
+ * @param store Copia en memoria de partido (en orden cronológico)
+ * @param stats Puntero a la estructura donde almacenar las estadísticas
+ */
+static void calcular_estadisticas_ultimos5(const PartidoStore *store, Estadisticas *stats)
+{
+    promediar_tramo(store, store->n > 5 ? store->n - 5 : 0, store->n, stats);
 }
 
 /**
- * @brief Calcula la racha más larga de victorias y derrotas
+ * @brief Obtiene la racha más larga de victorias y de derrotas
  *
  * @param mejor_racha_victorias Puntero donde almacenar la mejor racha de victorias
  * @param peor_racha_derrotas Puntero donde almacenar la peor racha de derrotas
  */
 static void calcular_rachas(int *mejor_racha_victorias, int *peor_racha_derrotas)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT resultado FROM partido ORDER BY fecha_hora",
-                       -1, &stmt, NULL);
-
-    int racha_actual_v = 0, max_racha_v = 0;
-    int racha_actual_d = 0, max_racha_d = 0;
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        int resultado = sqlite3_column_int(stmt, 0);
-        if (resultado == 1)
-        {
-            // VICTORIA
-            racha_actual_v++;
-            if (racha_actual_v > max_racha_v)
-                max_racha_v = racha_actual_v;
-            racha_actual_d = 0;
-        }
-        else if (resultado == 3)
-        {
-            // DERROTA
-            racha_actual_d++;
-            if (racha_actual_d > max_racha_d)
-                max_racha_d = racha_actual_d;
-            racha_actual_v = 0;
-        }
-        else
-        {
-            // EMPATE
-            racha_actual_v = 0;
-            racha_actual_d = 0;
-        }
-    }
+    Racha racha;
 
-    *mejor_racha_victorias = max_racha_v;
-    *peor_racha_derrotas = max_racha_d;
-    sqlite3_finalize(stmt);
+    rachas_mejor(RACHA_VICTORIAS, RACHAS_TODAS, &racha);
+    *mejor_racha_victorias = racha.largo;
+    rachas_mejor(RACHA_DERROTAS, RACHAS_TODAS, &racha);
+    *peor_racha_derrotas = racha.largo;
 }
 
 /**
@@ -143,7 +120,7 @@ static void mostrar_ultimos5_partidos()
     sqlite3_stmt *stmt;
     sqlite3_prepare_v2(db,
                        "SELECT fecha_hora, goles, asistencias, rendimiento_general, resultado "
-                       "FROM partido ORDER BY fecha_hora DESC LIMIT 5",
+                       "FROM partido ORDER BY fecha_ts DESC, id DESC LIMIT 5",
                        -1, &stmt, NULL);
 
     int count = 0;
@@ -202,6 +179,13 @@ static void mostrar_rachas(int mejor_racha_v, int peor_racha_d)
     printf("----------------------------------------\n");
     printf("Mejor racha de victorias: %d partidos\n", mejor_racha_v);
     printf("Peor racha de derrotas: %d partidos\n", peor_racha_d);
+
+    for (TipoRacha tipo = RACHA_VICTORIAS; tipo <= RACHA_DERROTAS; tipo++)
+    {
+        Racha actual;
+        if (rachas_actual(tipo, RACHAS_TODAS, &actual) && actual.largo > 0)
+            printf("Racha actual: %d partidos (%s)\n", actual.largo, racha_nombre(tipo));
+    }
 }
 
 /**
@@ -240,6 +224,140 @@ static void mensaje_motivacional(const Estadisticas *ultimos, const Estadisticas
     }
 }
 
+/** Puntos de la curva de forma que se muestran en pantalla */
+#define PUNTOS_CURVA_FORMA 30
+
+/**
+ * @brief Da formato de fecha (dd/mm/aaaa) a un fecha_ts de la copia
+ */
+static void formatear_fecha_ts(long long fecha_ts, char *fecha, size_t tam)
+{
+    time_t t = (time_t)fecha_ts;
+    struct tm *tm = fecha_ts != 0 ? gmtime(&t) : NULL;
+
+    if (!tm || strftime(fecha, tam, "%d/%m/%Y", tm) == 0)
+        snprintf(fecha, tam, "sin fecha");
+}
+
+/**
+ * @brief Describe la ventana de forma configurada
+ */
+static void describir_ventana(const ResumenForma *resumen, char *texto, size_t tam)
+{
+    if (resumen->vida_media > 0)
+        snprintf(texto, tam, "ventana de %d partidos, vida media %d", resumen->ventana, resumen->vida_media);
+    else
+        snprintf(texto, tam, "ventana de %d partidos, sin decaimiento", resumen->ventana);
+}
+
+/**
+ * @brief Muestra la forma actual frente a la mejor forma de cada métrica
+ *
+ * El porcentaje indica qué parte de su mejor media móvil conserva la media
+ * actual.
+ *
+ * @param resumen Resultado de forma_calcular()
+ */
+static void mostrar_forma_vs_pico(const ResumenForma *resumen)
+{
+    printf("%-12s %8s %8s %12s %8s\n", "Metrica", "Actual", "Pico", "Fecha pico", "% pico");
+    for (int m = 0; m < NUM_METRICAS_FORMA; m++)
+    {
+        const PuntoForma *pico = &resumen->pico[m];
+        char fecha[32];
+
+        if (pico->indice < 0)
+        {
+            printf("%-12s %8.2f %8s %12s %8s\n", forma_nombre_metrica(m), resumen->actual.media[m], "-", "-", "-");
+            continue;
+        }
+
+        formatear_fecha_ts(pico->fecha_ts, fecha, sizeof(fecha));
+        if (pico->media[m] > 0)
+            printf("%-12s %8.2f %8.2f %12s %7.0f%%\n", forma_nombre_metrica(m), resumen->actual.media[m],
+                   pico->media[m], fecha, 100.0 * resumen->actual.media[m] / pico->media[m]);
+        else
+            printf("%-12s %8.2f %8.2f %12s %8s\n", forma_nombre_metrica(m), resumen->actual.media[m],
+                   pico->media[m], fecha, "-");
+    }
+
+    if (resumen->pico[FORMA_RENDIMIENTO].indice >= 0 && resumen->pico[FORMA_RENDIMIENTO].media[FORMA_RENDIMIENTO] > 0)
+    {
+        double proporcion = resumen->actual.media[FORMA_RENDIMIENTO] /
+                            resumen->pico[FORMA_RENDIMIENTO].media[FORMA_RENDIMIENTO];
+
+        printf("\nEstado de forma: %s\n",
+               proporcion >= 0.9 ? "CERCA DE TU MEJOR NIVEL" :
+               proporcion >= 0.75 ? "BUENA FORMA" :
+               proporcion >= 0.5 ? "FORMA IRREGULAR" : "BAJO NIVEL");
+    }
+}
+
+/**
+ * @brief Muestra la curva de forma de toda la historia
+ *
+ * Recorre todos los partidos en orden cronológico con la ventana y el
+ * decaimiento configurados y muestra PUNTOS_CURVA_FORMA puntos
+ * equiespaciados con la media y la desviación móviles, más una barra del
+ * rendimiento medio, y al final la forma actual frente a la mejor.
+ */
+void mostrar_curva_forma()
+{
+    const AppSettings *config = settings_get();
+    PuntoForma curva[PUNTOS_CURVA_FORMA];
+    ResumenForma resumen;
+    char descripcion[80];
+
+    clear_screen();
+    print_header("CURVA DE FORMA");
+
+    int puntos = forma_calcular(config->ventana_forma, config->vida_media_forma, curva, PUNTOS_CURVA_FORMA, &resumen);
+    if (puntos < 0)
+    {
+        printf("Error al consultar la base de datos.\n");
+        pause_console();
+        return;
+    }
+    if (resumen.partidos == 0)
+    {
+        printf("No hay suficientes datos para mostrar la curva de forma.\n");
+        printf("Registra al menos algunos partidos para ver estadisticas.\n");
+        pause_console();
+        return;
+    }
+
+    describir_ventana(&resumen, descripcion, sizeof(descripcion));
+    printf("%d partidos, %s\n\n", resumen.partidos, descripcion);
+
+    printf("%-8s %-12s %-12s %-12s %-12s\n", "Partido", "Fecha", "Goles", "Asistencias", "Rendimiento");
+    printf("--------------------------------------------------------------------------------\n");
+    for (int i = 0; i < puntos; i++)
+    {
+        char fecha[32];
+        char barra[21];
+        int largo = (int)(curva[i].media[FORMA_RENDIMIENTO] * 2 + 0.5);
+
+        if (largo < 0)
+            largo = 0;
+        if (largo > 20)
+            largo = 20;
+        memset(barra, '#', largo);
+        barra[largo] = '\0';
+
+        formatear_fecha_ts(curva[i].fecha_ts, fecha, sizeof(fecha));
+        printf("%-8d %-12s %5.2f+-%-4.2f %5.2f+-%-4.2f %5.2f+-%-4.2f |%s\n", curva[i].indice + 1, fecha,
+               curva[i].media[FORMA_GOLES], curva[i].desviacion[FORMA_GOLES],
+               curva[i].media[FORMA_ASISTENCIAS], curva[i].desviacion[FORMA_ASISTENCIAS],
+               curva[i].media[FORMA_RENDIMIENTO], curva[i].desviacion[FORMA_RENDIMIENTO], barra);
+    }
+
+    printf("\nFORMA ACTUAL VS MEJOR FORMA:\n");
+    printf("----------------------------------------\n");
+    mostrar_forma_vs_pico(&resumen);
+
+    pause_console();
+}
+
 /**
  * @brief Muestra el análisis completo de rendimiento
  */
@@ -250,11 +368,15 @@ void mostrar_analisis()
 
     Estadisticas generales = {0};
     Estadisticas ultimos5 = {0};
-    int mejor_racha_v, peor_racha_d;
+    int mejor_racha_v = 0, peor_racha_d = 0;
+    const PartidoStore *store = partido_store_obtener();
 
-    calcular_estadisticas_generales(&generales);
-    calcular_estadisticas_ultimos5(&ultimos5);
-    calcular_rachas(&mejor_racha_v, &peor_racha_d);
+    if (store)
+    {
+        calcular_estadisticas_generales(store, &generales);
+        calcular_estadisticas_ultimos5(store, &ultimos5);
+        calcular_rachas(&mejor_racha_v, &peor_racha_d);
+    }
 
     if (generales.total_partidos == 0)
     {
@@ -267,6 +389,18 @@ void mostrar_analisis()
     mostrar_ultimos5_partidos();
     mostrar_comparacion_estadisticas(&ultimos5, &generales);
     mostrar_rachas(mejor_racha_v, peor_racha_d);
+
+    const AppSettings *config = settings_get();
+    ResumenForma forma;
+    char descripcion[80];
+    if (forma_calcular(config->ventana_forma, config->vida_media_forma, NULL, 0, &forma) >= 0)
+    {
+        describir_ventana(&forma, descripcion, sizeof(descripcion));
+        printf("\nFORMA ACTUAL VS MEJOR FORMA (%s):\n", descripcion);
+        printf("----------------------------------------\n");
+        mostrar_forma_vs_pico(&forma);
+    }
+
     mensaje_motivacional(&ultimos5, &generales);
 
     pause_console();
@@ -324,43 +458,94 @@ static const char *mes_to_text(int mes)
     }
 }
 
+/**
+ * @brief Métricas que pueden seguirse mes a mes
+ */
+typedef enum
+{
+    METRICA_GOLES,
+    METRICA_ASISTENCIAS,
+    METRICA_RENDIMIENTO
+} Metrica;
+
+/**
+ * @brief Devuelve la columna de la copia en memoria asociada a una métrica
+ *
+ * @param store Copia en memoria de partido
+ * @param metrica Métrica a consultar
+ * @return Arreglo con un valor por partido
+ */
+static const int *valores_metrica(const PartidoStore *store, Metrica metrica)
+{
+    switch (metrica)
+    {
+    case METRICA_ASISTENCIAS:
+        return store->asistencias;
+    case METRICA_RENDIMIENTO:
+        return store->rendimiento;
+    default:
+        return store->goles;
+    }
+}
+
+/**
+ * @brief Acumula un mes completo a partir de una posición de la copia
+ *
+ * Como la copia está en orden cronológico, los partidos de un mismo mes
+ * son consecutivos y basta con avanzar mientras no cambie el mes.
+ *
+ * @param store Copia en memoria de partido
+ * @param i Posición del partido desde el que se acumula
+ * @param paso 1 para avanzar hacia meses posteriores, -1 hacia anteriores
+ * @param valores Columna a promediar
+ * @param mes Destino del mes acumulado
+ * @return Posición siguiente al mes acumulado en la dirección del paso
+ */
+static int acumular_mes(const PartidoStore *store, int i, int paso, const int *valores, EstadisticasMensuales *mes)
+{
+    long long suma = 0;
+
+    mes->anio = store->anio[i];
+    mes->mes = store->mes[i];
+    mes->total_partidos = 0;
+    while (i >= 0 && i < store->n && store->anio[i] == mes->anio && store->mes[i] == mes->mes)
+    {
+        suma += valores[i];
+        mes->total_partidos++;
+        i += paso;
+    }
+    mes->avg_goles = (double)suma / mes->total_partidos;
+    return i;
+}
+
 /**
  * @brief Calcula estadísticas mensuales para una métrica específica
  *
+ * Los meses se devuelven del más reciente al más antiguo; los partidos
+ * sin fecha válida no pertenecen a ningún mes.
+ *
  * @param stats Array donde almacenar las estadísticas mensuales
  * @param max_stats Tamaño máximo del array
- * @param columna Nombre de la columna a promediar (goles, asistencias, rendimiento_general)
+ * @param metrica Métrica a promediar
  * @return Número de meses con datos
  */
-static int calcular_estadisticas_mensuales(EstadisticasMensuales *stats, int max_stats, const char *columna)
+static int calcular_estadisticas_mensuales(EstadisticasMensuales *stats, int max_stats, Metrica metrica)
 {
-    sqlite3_stmt *stmt;
-    char sql[512];
-
-    sprintf(sql,
-            "SELECT strftime('%%m', fecha_hora) as mes, strftime('%%Y', fecha_hora) as anio, "
-            "AVG(%s), COUNT(*) "
-            "FROM partido "
-            "GROUP BY strftime('%%Y', fecha_hora), strftime('%%m', fecha_hora) "
-            "ORDER BY anio DESC, mes DESC",
-            columna);
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    const PartidoStore *store = partido_store_obtener();
+    if (!store)
     {
         return 0;
     }
 
+    const int *valores = valores_metrica(store, metrica);
     int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW && count < max_stats)
+    int i = store->n - 1;
+    while (i >= 0 && store->mes[i] != 0 && count < max_stats)
     {
-        stats[count].mes = atoi((const char *)sqlite3_column_text(stmt, 0));
-        stats[count].anio = atoi((const char *)sqlite3_column_text(stmt, 1));
-        stats[count].avg_goles = sqlite3_column_double(stmt, 2);
-        stats[count].total_partidos = sqlite3_column_int(stmt, 3);
+        i = acumular_mes(store, i, -1, valores, &stats[count]);
         count++;
     }
 
-    sqlite3_finalize(stmt);
     return count;
 }
 
@@ -368,15 +553,15 @@ static int calcular_estadisticas_mensuales(EstadisticasMensuales *stats, int max
  * @brief Muestra la evolución mensual de una métrica
  *
  * @param titulo Título a mostrar
- * @param columna Nombre de la columna de la base de datos
+ * @param metrica Métrica a promediar
  */
-static void mostrar_evolucion_mensual(const char *titulo, const char *columna)
+static void mostrar_evolucion_mensual(const char *titulo, Metrica metrica)
 {
     clear_screen();
     print_header(titulo);
 
     EstadisticasMensuales stats[120]; // Máximo 10 años de datos
-    int num_meses = calcular_estadisticas_mensuales(stats, 120, columna);
+    int num_meses = calcular_estadisticas_mensuales(stats, 120, metrica);
 
     if (num_meses == 0)
     {
@@ -409,38 +594,39 @@ static void encontrar_mes_historico(int mejor)
     clear_screen();
     print_header(mejor ? "MEJOR MES HISTORICO" : "PEOR MES HISTORICO");
 
-    sqlite3_stmt *stmt;
-    const char *sql = mejor ?
-                      "SELECT strftime('%m', fecha_hora) as mes, strftime('%Y', fecha_hora) as anio, "
-                      "AVG(rendimiento_general), COUNT(*) "
-                      "FROM partido "
-                      "GROUP BY strftime('%Y', fecha_hora), strftime('%m', fecha_hora) "
-                      "ORDER BY AVG(rendimiento_general) DESC LIMIT 1" :
-                      "SELECT strftime('%m', fecha_hora) as mes, strftime('%Y', fecha_hora) as anio, "
-                      "AVG(rendimiento_general), COUNT(*) "
-                      "FROM partido "
-                      "GROUP BY strftime('%Y', fecha_hora), strftime('%m', fecha_hora) "
-                      "ORDER BY AVG(rendimiento_general) ASC LIMIT 1";
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    const PartidoStore *store = partido_store_obtener();
+    if (!store)
     {
         printf("Error al consultar la base de datos.\n");
         pause_console();
         return;
     }
 
-    if (sqlite3_step(stmt) == SQLITE_ROW)
+    EstadisticasMensuales elegido = {0};
+    EstadisticasMensuales actual;
+    int i = 0;
+
+    // Los partidos sin fecha válida quedan al principio de la copia
+    while (i < store->n && store->mes[i] == 0)
+        i++;
+
+    while (i < store->n)
     {
-        int mes = atoi((const char *)sqlite3_column_text(stmt, 0));
-        int anio = atoi((const char *)sqlite3_column_text(stmt, 1));
-        double avg_rendimiento = sqlite3_column_double(stmt, 2);
-        int partidos = sqlite3_column_int(stmt, 3);
+        i = acumular_mes(store, i, 1, store->rendimiento, &actual);
+        if (elegido.total_partidos == 0 ||
+                (mejor ? actual.avg_goles > elegido.avg_goles : actual.avg_goles < elegido.avg_goles))
+        {
+            elegido = actual;
+        }
+    }
 
+    if (elegido.total_partidos > 0)
+    {
         printf("%s MES HISTORICO:\n", mejor ? "MEJOR" : "PEOR");
         printf("----------------------------------------\n");
-        printf("Mes: %s %d\n", mes_to_text(mes), anio);
-        printf("Rendimiento promedio: %.2f\n", avg_rendimiento);
-        printf("Partidos jugados: %d\n", partidos);
+        printf("Mes: %s %d\n", mes_to_text(elegido.mes), elegido.anio);
+        printf("Rendimiento promedio: %.2f\n", elegido.avg_goles);
+        printf("Partidos jugados: %d\n", elegido.total_partidos);
     }
     else
     {
@@ -448,10 +634,42 @@ static void encontrar_mes_historico(int mejor)
                mejor ? "mejor" : "peor");
     }
 
-    sqlite3_finalize(stmt);
     pause_console();
 }
 
+/**
+ * @brief Acumulado de un periodo del año para las comparaciones estacionales
+ */
+typedef struct
+{
+    long long goles;
+    long long asistencias;
+    long long rendimiento;
+    int partidos;
+} AcumuladoPeriodo;
+
+/**
+ * @brief Suma un partido de la copia a un periodo
+ */
+static void acumular_periodo(AcumuladoPeriodo *periodo, const PartidoStore *store, int i)
+{
+    periodo->goles += store->goles[i];
+    periodo->asistencias += store->asistencias[i];
+    periodo->rendimiento += store->rendimiento[i];
+    periodo->partidos++;
+}
+
+/**
+ * @brief Muestra los promedios de un periodo con el formato de las comparaciones
+ */
+static void mostrar_periodo(const AcumuladoPeriodo *periodo)
+{
+    printf("  Goles: %.2f\n", (double)periodo->goles / periodo->partidos);
+    printf("  Asistencias: %.2f\n", (double)periodo->asistencias / periodo->partidos);
+    printf("  Rendimiento: %.2f\n", (double)periodo->rendimiento / periodo->partidos);
+    printf("  Partidos: %d\n\n", periodo->partidos);
+}
+
 /**
  * @brief Compara rendimiento al inicio vs fin de año
  */
@@ -460,47 +678,43 @@ static void comparar_inicio_fin_anio()
     clear_screen();
     print_header("INICIO VS FIN DE ANIO");
 
-    sqlite3_stmt *stmt;
-    const char *sql =
-        "SELECT "
-        "CASE WHEN CAST(strftime('%m', fecha_hora) AS INTEGER) <= 6 THEN 'Inicio' ELSE 'Fin' END as periodo, "
-        "AVG(goles), AVG(asistencias), AVG(rendimiento_general), COUNT(*) "
-        "FROM partido "
-        "GROUP BY CASE WHEN CAST(strftime('%m', fecha_hora) AS INTEGER) <= 6 THEN 'Inicio' ELSE 'Fin' END";
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    const PartidoStore *store = partido_store_obtener();
+    if (!store)
     {
         printf("Error al consultar la base de datos.\n");
         pause_console();
         return;
     }
 
+    // Los partidos sin fecha válida cuentan como fin de año
+    AcumuladoPeriodo inicio = {0}, fin = {0};
+    for (int i = 0; i < store->n; i++)
+    {
+        if (store->mes[i] >= 1 && store->mes[i] <= 6)
+            acumular_periodo(&inicio, store, i);
+        else
+            acumular_periodo(&fin, store, i);
+    }
+
     printf("COMPARACION INICIO VS FIN DE ANIO:\n");
     printf("----------------------------------------\n");
 
-    int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    if (fin.partidos > 0)
     {
-        const char *periodo = (const char *)sqlite3_column_text(stmt, 0);
-        double avg_goles = sqlite3_column_double(stmt, 1);
-        double avg_asistencias = sqlite3_column_double(stmt, 2);
-        double avg_rendimiento = sqlite3_column_double(stmt, 3);
-        int partidos = sqlite3_column_int(stmt, 4);
-
-        printf("%s de año (Ene-Jun):\n", strcmp(periodo, "Inicio") == 0 ? "Inicio" : "Fin");
-        printf("  Goles: %.2f\n", avg_goles);
-        printf("  Asistencias: %.2f\n", avg_asistencias);
-        printf("  Rendimiento: %.2f\n", avg_rendimiento);
-        printf("  Partidos: %d\n\n", partidos);
-        count++;
+        printf("Fin de año (Ene-Jun):\n");
+        mostrar_periodo(&fin);
+    }
+    if (inicio.partidos > 0)
+    {
+        printf("Inicio de año (Ene-Jun):\n");
+        mostrar_periodo(&inicio);
     }
 
-    if (count == 0)
+    if (inicio.partidos == 0 && fin.partidos == 0)
     {
         printf("No hay suficientes datos para comparar inicio vs fin de año.\n");
     }
 
-    sqlite3_finalize(stmt);
     pause_console();
 }
 
@@ -512,63 +726,68 @@ static void comparar_meses_frios_calidos()
     clear_screen();
     print_header("MESES FRIOS VS CALIDOS");
 
-    sqlite3_stmt *stmt;
-    const char *sql =
-        "SELECT "
-        "CASE "
-        "  WHEN CAST(strftime('%m', fecha_hora) AS INTEGER) BETWEEN 6 AND 9 THEN 'Frios' "
-        "  WHEN CAST(strftime('%m', fecha_hora) AS INTEGER) IN (12,1,2,3,4) THEN 'Calidos' "
-        "  ELSE 'Otros' "
-        "END as temporada, "
-        "AVG(goles), AVG(asistencias), AVG(rendimiento_general), COUNT(*) "
-        "FROM partido "
-        "GROUP BY CASE "
-        "  WHEN CAST(strftime('%m', fecha_hora) AS INTEGER) BETWEEN 6 AND 9 THEN 'Frios' "
-        "  WHEN CAST(strftime('%m', fecha_hora) AS INTEGER) IN (12,1,2,3,4) THEN 'Calidos' "
-        "  ELSE 'Otros' "
-        "END";
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    const PartidoStore *store = partido_store_obtener();
+    if (!store)
     {
         printf("Error al consultar la base de datos.\n");
         pause_console();
         return;
     }
 
+    AcumuladoPeriodo frios = {0}, calidos = {0};
+    for (int i = 0; i < store->n; i++)
+    {
+        int mes = store->mes[i];
+        if (mes >= 6 && mes <= 9)
+            acumular_periodo(&frios, store, i);
+        else if (mes == 12 || (mes >= 1 && mes <= 4))
+            acumular_periodo(&calidos, store, i);
+    }
+
     printf("COMPARACION MESES FRIOS VS CALIDOS:\n");
     printf("----------------------------------------\n");
     printf("Meses frios: Junio, Julio, Agosto, Septiembre\n");
     printf("Meses calidos: Diciembre, Enero, Febrero, Marzo, Abril\n\n");
 
-    int count = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    if (calidos.partidos > 0)
     {
-        const char *temporada = (const char *)sqlite3_column_text(stmt, 0);
-        if (strcmp(temporada, "Otros") == 0)
-            continue;
-
-        double avg_goles = sqlite3_column_double(stmt, 1);
-        double avg_asistencias = sqlite3_column_double(stmt, 2);
-        double avg_rendimiento = sqlite3_column_double(stmt, 3);
-        int partidos = sqlite3_column_int(stmt, 4);
-
-        printf("Meses %s:\n", temporada);
-        printf("  Goles: %.2f\n", avg_goles);
-        printf("  Asistencias: %.2f\n", avg_asistencias);
-        printf("  Rendimiento: %.2f\n", avg_rendimiento);
-        printf("  Partidos: %d\n\n", partidos);
-        count++;
+        printf("Meses Calidos:\n");
+        mostrar_periodo(&calidos);
+    }
+    if (frios.partidos > 0)
+    {
+        printf("Meses Frios:\n");
+        mostrar_periodo(&frios);
     }
 
-    if (count == 0)
+    if (frios.partidos == 0 && calidos.partidos == 0)
     {
         printf("No hay suficientes datos en meses frios o calidos para comparar.\n");
     }
 
-    sqlite3_finalize(stmt);
     pause_console();
 }
 
+/**
+ * @brief Obtiene la fecha_hora de un partido por su ID
+ *
+ * @param id ID del partido
+ * @param fecha Buffer destino (queda vacío si no existe)
+ * @param tam Tamaño del buffer
+ */
+static void obtener_fecha_partido(int id, char *fecha, size_t tam)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT fecha_hora FROM partido WHERE id = ?");
+
+    fecha[0] = '\0';
+    if (!stmt)
+        return;
+    sqlite3_bind_int(stmt, 1, id);
+    if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_text(stmt, 0))
+        snprintf(fecha, tam, "%s", (const char *)sqlite3_column_text(stmt, 0));
+    db_release_cached(stmt);
+}
+
 /**
  * @brief Calcula y muestra el progreso total del jugador
  */
@@ -577,75 +796,52 @@ static void calcular_progreso_total()
     clear_screen();
     print_header("PROGRESO TOTAL DEL JUGADOR");
 
-    sqlite3_stmt *stmt;
-    const char *sql =
-        "SELECT "
-        "COUNT(*), "
-        "AVG(goles), AVG(asistencias), AVG(rendimiento_general), "
-        "MIN(fecha_hora), MAX(fecha_hora) "
-        "FROM partido";
-
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    const PartidoStore *store = partido_store_obtener();
+    if (!store)
     {
         printf("Error al consultar la base de datos.\n");
         pause_console();
         return;
     }
 
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        int total_partidos = sqlite3_column_int(stmt, 0);
-        double avg_goles = sqlite3_column_double(stmt, 1);
-        double avg_asistencias = sqlite3_column_double(stmt, 2);
-        double avg_rendimiento = sqlite3_column_double(stmt, 3);
-        const char *fecha_inicio = (const char *)sqlite3_column_text(stmt, 4);
-        const char *fecha_fin = (const char *)sqlite3_column_text(stmt, 5);
+    Estadisticas totales = {0};
+    char fecha_inicio[64] = "";
+    char fecha_fin[64] = "";
 
-        printf("PROGRESO TOTAL DEL JUGADOR:\n");
-        printf("----------------------------------------\n");
-        printf("Periodo: %s - %s\n", fecha_inicio ? fecha_inicio : "N/A", fecha_fin ? fecha_fin : "N/A");
-        printf("Total de partidos: %d\n", total_partidos);
-        printf("Promedio de goles: %.2f\n", avg_goles);
-        printf("Promedio de asistencias: %.2f\n", avg_asistencias);
-        printf("Promedio de rendimiento: %.2f\n", avg_rendimiento);
-
-        // Calcular tendencia (comparar primeros vs últimos partidos)
-        if (total_partidos >= 10)
-        {
-            sqlite3_stmt *tend_stmt;
-            const char *tend_sql =
-                "SELECT AVG(rendimiento_general) FROM "
-                "(SELECT rendimiento_general FROM partido ORDER BY fecha_hora ASC LIMIT 5) "
-                "UNION ALL "
-                "SELECT AVG(rendimiento_general) FROM "
-                "(SELECT rendimiento_general FROM partido ORDER BY fecha_hora DESC LIMIT 5)";
-
-            if (sqlite3_prepare_v2(db, tend_sql, -1, &tend_stmt, NULL) == SQLITE_OK)
-            {
-                double avg_primeros = 0, avg_ultimos = 0;
-                if (sqlite3_step(tend_stmt) == SQLITE_ROW)
-                    avg_primeros = sqlite3_column_double(tend_stmt, 0);
-                if (sqlite3_step(tend_stmt) == SQLITE_ROW)
-                    avg_ultimos = sqlite3_column_double(tend_stmt, 0);
-
-                double tendencia = avg_ultimos - avg_primeros;
-                printf("\nTENDENCIA:\n");
-                printf("Primeros 5 partidos: %.2f\n", avg_primeros);
-                printf("Últimos 5 partidos: %.2f\n", avg_ultimos);
-                printf("Tendencia: %s (%.2f)\n",
-                       tendencia > 0.5 ? "ASCENDENTE" : (tendencia < -0.5 ? "DESCENDENTE" : "ESTABLE"),
-                       tendencia);
-
-                sqlite3_finalize(tend_stmt);
-            }
-        }
+    promediar_tramo(store, 0, store->n, &totales);
+    if (store->n > 0)
+    {
+        obtener_fecha_partido(store->id[0], fecha_inicio, sizeof(fecha_inicio));
+        obtener_fecha_partido(store->id[store->n - 1], fecha_fin, sizeof(fecha_fin));
     }
-    else
+
+    printf("PROGRESO TOTAL DEL JUGADOR:\n");
+    printf("----------------------------------------\n");
+    printf("Periodo: %s - %s\n", fecha_inicio[0] ? fecha_inicio : "N/A", fecha_fin[0] ? fecha_fin : "N/A");
+    printf("Total de partidos: %d\n", totales.total_partidos);
+    printf("Promedio de goles: %.2f\n", totales.avg_goles);
+    printf("Promedio de asistencias: %.2f\n", totales.avg_asistencias);
+    printf("Promedio de rendimiento: %.2f\n", totales.avg_rendimiento);
+
+    // Calcular tendencia (comparar primeros vs últimos partidos, con la ventana de forma)
+    int ventana = settings_get()->ventana_forma;
+    if (!forma_ventana_valida(ventana))
+        ventana = FORMA_VENTANA_DEFECTO;
+    if (totales.total_partidos >= 2 * ventana)
     {
-        printf("No hay datos suficientes para calcular el progreso total.\n");
+        Estadisticas primeros = {0}, ultimos = {0};
+        promediar_tramo(store, 0, ventana, &primeros);
+        promediar_tramo(store, store->n - ventana, store->n, &ultimos);
+
+        double tendencia = ultimos.avg_rendimiento - primeros.avg_rendimiento;
+        printf("\nTENDENCIA:\n");
+        printf("Primeros %d partidos: %.2f\n", ventana, primeros.avg_rendimiento);
+        printf("Últimos %d partidos: %.2f\n", ventana, ultimos.avg_rendimiento);
+        printf("Tendencia: %s (%.2f)\n",
+               tendencia > 0.5 ? "ASCENDENTE" : (tendencia < -0.5 ? "DESCENDENTE" : "ESTABLE"),
+               tendencia);
     }
 
-    sqlite3_finalize(stmt);
     pause_console();
 }
 
@@ -667,10 +863,11 @@ void mostrar_evolucion_temporal()
         {6, "Inicio vs Fin de Anio", inicio_vs_fin_anio},
         {7, "Meses Frios vs Calidos", meses_frios_vs_calidos},
         {8, "Progreso Total del Jugador", progreso_total_jugador},
+        {9, "Curva de Forma", mostrar_curva_forma},
         {0, "Volver", NULL}
     };
 
-    ejecutar_menu("EVOLUCION TEMPORAL", items, 9);
+    ejecutar_menu("EVOLUCION TEMPORAL", items, 10);
 }
 
 /**
@@ -678,7 +875,7 @@ void mostrar_evolucion_temporal()
  */
 void evolucion_mensual_goles()
 {
-    mostrar_evolucion_mensual("EVOLUCION MENSUAL DE GOLES", "goles");
+    mostrar_evolucion_mensual("EVOLUCION MENSUAL DE GOLES", METRICA_GOLES);
 }
 
 /**
@@ -686,7 +883,7 @@ void evolucion_mensual_goles()
  */
 void evolucion_mensual_asistencias()
 {
-    mostrar_evolucion_mensual("EVOLUCION MENSUAL DE ASISTENCIAS", "asistencias");
+    mostrar_evolucion_mensual("EVOLUCION MENSUAL DE ASISTENCIAS", METRICA_ASISTENCIAS);
 }
 
 /**
@@ -694,7 +891,7 @@ void evolucion_mensual_asistencias()
  */
 void evolucion_mensual_rendimiento()
 {
-    mostrar_evolucion_mensual("EVOLUCION MENSUAL DE RENDIMIENTO", "rendimiento_general");
+    mostrar_evolucion_mensual("EVOLUCION MENSUAL DE RENDIMIENTO", METRICA_RENDIMIENTO);
 }
 
 /**
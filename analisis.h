@@ -26,6 +26,15 @@ void mostrar_analisis();
  */
 void mostrar_evolucion_temporal();
 
+/**
+ * @brief Muestra la curva de forma de toda la historia
+ *
+ * Medias y desviaciones móviles de goles, asistencias y rendimiento sobre
+ * la secuencia cronológica de partidos, con la ventana y el decaimiento
+ * configurados en ajustes, y la forma actual frente a la mejor forma.
+ */
+void mostrar_curva_forma();
+
 /**
  * @brief Visualiza evolución mensual de estadística de gol
  *
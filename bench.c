@@ -0,0 +1,408 @@
+/**
+ * @file bench.c
+ * @brief Banco de pruebas de rendimiento de informes, analisis y exportaciones
+ *
+ * Ejecutable independiente (no incluye main.c) que abre una base de datos,
+ * la rellena con datos sinteticos si esta vacia y mide cada funcion publica
+ * de estadisticas, analisis, records, logros y exportacion varias veces con
+ * stdout redirigido al dispositivo nulo. Los resultados (mediana y p95 por
+ * funcion) se escriben en un archivo JSON para comparar entre versiones.
+ *
+ * Uso: MiFutbolC_bench [--db ruta] [--generar partidos] [--semilla n]
+ *                      [--iteraciones n] [--filtro texto] [--salida archivo]
+ *                      [--memoria]
+ */
+
+#include "db.h"
+#include "utils.h"
+#include "settings.h"
+#include "migraciones.h"
+#include "generador.h"
+#include "partido_store.h"
+#include "cJSON.h"
+#include "analisis.h"
+#include "logros.h"
+#include "estadisticas_generales.h"
+#include "estadisticas_anio.h"
+#include "estadisticas_mes.h"
+#include "estadisticas_meta.h"
+#include "records_rankings.h"
+#include "export.h"
+#include "export_camisetas.h"
+#include "export_camisetas_mejorado.h"
+#include "export_partidos.h"
+#include "export_lesiones.h"
+#include "export_lesiones_mejorado.h"
+#include "export_estadisticas.h"
+#include "export_estadisticas_generales.h"
+#include "export_correlaciones.h"
+#include "export_records_rankings.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define DISPOSITIVO_NULO "NUL"
+#else
+#define DISPOSITIVO_NULO "/dev/null"
+#endif
+
+/**
+ * @brief Funcion medida por el banco de pruebas
+ */
+typedef struct
+{
+    const char *grupo;
+    const char *nombre;
+    void (*funcion)();
+} CasoBench;
+
+/** Camiseta usada por los casos de logros (la generada con ID 1) */
+#define CAMISETA_BENCH 1
+
+/** Recarga completa de la copia en memoria de partido (el resto de casos la usan ya cargada) */
+static void store_carga()
+{
+    partido_store_invalidar();
+    partido_store_obtener();
+}
+
+/** Modificacion de un partido y revalidacion de la copia a partir del registro de cambios */
+static void store_incremental()
+{
+    sqlite3_exec(db, "UPDATE partido SET goles = goles WHERE id = 1", 0, 0, 0);
+    partido_store_obtener();
+}
+
+static void logros_todos()
+{
+    mostrar_logros_de_camiseta(CAMISETA_BENCH, 0);
+}
+
+static void logros_completados()
+{
+    mostrar_logros_de_camiseta(CAMISETA_BENCH, 1);
+}
+
+static void logros_en_progreso()
+{
+    mostrar_logros_de_camiseta(CAMISETA_BENCH, 2);
+}
+
+/**
+ * @brief Casos medidos
+ *
+ * Las exportaciones agregadas (*_todo_mejorado) no se incluyen porque solo
+ * encadenan exportaciones que ya se miden por separado.
+ */
+static const CasoBench CASOS[] =
+{
+    {"store", "partido_store_carga", store_carga},
+    {"store", "partido_store_incremental", store_incremental},
+    {"estadisticas", "mostrar_estadisticas_generales", mostrar_estadisticas_generales},
+    {"estadisticas", "mostrar_estadisticas_por_anio", mostrar_estadisticas_por_anio},
+    {"estadisticas", "mostrar_estadisticas_por_mes", mostrar_estadisticas_por_mes},
+    {"estadisticas", "mostrar_rendimiento_promedio_por_clima", mostrar_rendimiento_promedio_por_clima},
+    {"estadisticas", "mostrar_mejor_dia_semana", mostrar_mejor_dia_semana},
+    {"meta", "mostrar_consistencia_rendimiento", mostrar_consistencia_rendimiento},
+    {"meta", "mostrar_partidos_outliers", mostrar_partidos_outliers},
+    {"meta", "mostrar_matriz_correlaciones", mostrar_matriz_correlaciones},
+    {"meta", "mostrar_dependencia_contexto", mostrar_dependencia_contexto},
+    {"meta", "mostrar_impacto_real_cansancio", mostrar_impacto_real_cansancio},
+    {"meta", "mostrar_impacto_real_estado_animo", mostrar_impacto_real_estado_animo},
+    {"meta", "mostrar_eficiencia_goles_vs_rendimiento", mostrar_eficiencia_goles_vs_rendimiento},
+    {"meta", "mostrar_eficiencia_asistencias_vs_cansancio", mostrar_eficiencia_asistencias_vs_cansancio},
+    {"meta", "mostrar_rendimiento_por_esfuerzo", mostrar_rendimiento_por_esfuerzo},
+    {"meta", "mostrar_partidos_exigentes_bien_rendidos", mostrar_partidos_exigentes_bien_rendidos},
+    {"meta", "mostrar_partidos_faciles_mal_rendidos", mostrar_partidos_faciles_mal_rendidos},
+    {"analisis", "mostrar_analisis", mostrar_analisis},
+    {"analisis", "mostrar_curva_forma", mostrar_curva_forma},
+    {"records", "mostrar_record_goles_partido", mostrar_record_goles_partido},
+    {"records", "mostrar_record_asistencias_partido", mostrar_record_asistencias_partido},
+    {"records", "mostrar_mejor_combinacion_cancha_camiseta", mostrar_mejor_combinacion_cancha_camiseta},
+    {"records", "mostrar_peor_combinacion_cancha_camiseta", mostrar_peor_combinacion_cancha_camiseta},
+    {"records", "mostrar_mejor_temporada", mostrar_mejor_temporada},
+    {"records", "mostrar_peor_temporada", mostrar_peor_temporada},
+    {"records", "mostrar_partido_mejor_rendimiento_general", mostrar_partido_mejor_rendimiento_general},
+    {"records", "mostrar_partido_peor_rendimiento_general", mostrar_partido_peor_rendimiento_general},
+    {"records", "mostrar_partido_mejor_combinacion_goles_asistencias", mostrar_partido_mejor_combinacion_goles_asistencias},
+    {"records", "mostrar_partidos_sin_goles", mostrar_partidos_sin_goles},
+    {"records", "mostrar_partidos_sin_asistencias", mostrar_partidos_sin_asistencias},
+    {"records", "mostrar_mejor_racha_goleadora", mostrar_mejor_racha_goleadora},
+    {"records", "mostrar_peor_racha", mostrar_peor_racha},
+    {"records", "mostrar_partidos_consecutivos_anotando", mostrar_partidos_consecutivos_anotando},
+    {"records", "mostrar_rachas_por_camiseta", mostrar_rachas_por_camiseta},
+    {"export", "exportar_camisetas_csv", exportar_camisetas_csv},
+    {"export", "exportar_camisetas_txt", exportar_camisetas_txt},
+    {"export", "exportar_camisetas_json", exportar_camisetas_json},
+    {"export", "exportar_camisetas_html", exportar_camisetas_html},
+    {"export", "exportar_camisetas_csv_mejorado", exportar_camisetas_csv_mejorado},
+    {"export", "exportar_camisetas_txt_mejorado", exportar_camisetas_txt_mejorado},
+    {"export", "exportar_camisetas_json_mejorado", exportar_camisetas_json_mejorado},
+    {"export", "exportar_camisetas_html_mejorado", exportar_camisetas_html_mejorado},
+    {"export", "exportar_partidos_csv", exportar_partidos_csv},
+    {"export", "exportar_partidos_txt", exportar_partidos_txt},
+    {"export", "exportar_partidos_json", exportar_partidos_json},
+    {"export", "exportar_partidos_html", exportar_partidos_html},
+    {"export", "exportar_partido_mas_goles_csv", exportar_partido_mas_goles_csv},
+    {"export", "exportar_partido_mas_goles_txt", exportar_partido_mas_goles_txt},
+    {"export", "exportar_partido_mas_goles_json", exportar_partido_mas_goles_json},
+    {"export", "exportar_partido_mas_goles_html", exportar_partido_mas_goles_html},
+    {"export", "exportar_partido_mas_asistencias_csv", exportar_partido_mas_asistencias_csv},
+    {"export", "exportar_partido_mas_asistencias_txt", exportar_partido_mas_asistencias_txt},
+    {"export", "exportar_partido_mas_asistencias_json", exportar_partido_mas_asistencias_json},
+    {"export", "exportar_partido_mas_asistencias_html", exportar_partido_mas_asistencias_html},
+    {"export", "exportar_partido_menos_goles_reciente_csv", exportar_partido_menos_goles_reciente_csv},
+    {"export", "exportar_partido_menos_goles_reciente_txt", exportar_partido_menos_goles_reciente_txt},
+    {"export", "exportar_partido_menos_goles_reciente_json", exportar_partido_menos_goles_reciente_json},
+    {"export", "exportar_partido_menos_goles_reciente_html", exportar_partido_menos_goles_reciente_html},
+    {"export", "exportar_partido_menos_asistencias_reciente_csv", exportar_partido_menos_asistencias_reciente_csv},
+    {"export", "exportar_partido_menos_asistencias_reciente_txt", exportar_partido_menos_asistencias_reciente_txt},
+    {"export", "exportar_partido_menos_asistencias_reciente_json", exportar_partido_menos_asistencias_reciente_json},
+    {"export", "exportar_partido_menos_asistencias_reciente_html", exportar_partido_menos_asistencias_reciente_html},
+    {"export", "exportar_lesiones_csv", exportar_lesiones_csv},
+    {"export", "exportar_lesiones_txt", exportar_lesiones_txt},
+    {"export", "exportar_lesiones_json", exportar_lesiones_json},
+    {"export", "exportar_lesiones_html", exportar_lesiones_html},
+    {"export", "exportar_lesiones_csv_mejorado", exportar_lesiones_csv_mejorado},
+    {"export", "exportar_lesiones_txt_mejorado", exportar_lesiones_txt_mejorado},
+    {"export", "exportar_lesiones_json_mejorado", exportar_lesiones_json_mejorado},
+    {"export", "exportar_lesiones_html_mejorado", exportar_lesiones_html_mejorado},
+    {"export", "exportar_estadisticas_csv", exportar_estadisticas_csv},
+    {"export", "exportar_estadisticas_txt", exportar_estadisticas_txt},
+    {"export", "exportar_estadisticas_json", exportar_estadisticas_json},
+    {"export", "exportar_estadisticas_html", exportar_estadisticas_html},
+    {"export", "exportar_estadisticas_generales_csv", exportar_estadisticas_generales_csv},
+    {"export", "exportar_estadisticas_generales_txt", exportar_estadisticas_generales_txt},
+    {"export", "exportar_estadisticas_generales_json", exportar_estadisticas_generales_json},
+    {"export", "exportar_estadisticas_generales_html", exportar_estadisticas_generales_html},
+    {"export", "exportar_correlaciones_csv", exportar_correlaciones_csv},
+    {"export", "exportar_correlaciones_txt", exportar_correlaciones_txt},
+    {"export", "exportar_correlaciones_json", exportar_correlaciones_json},
+    {"export", "exportar_correlaciones_html", exportar_correlaciones_html},
+    {"export", "exportar_estadisticas_por_mes_csv", exportar_estadisticas_por_mes_csv},
+    {"export", "exportar_estadisticas_por_mes_txt", exportar_estadisticas_por_mes_txt},
+    {"export", "exportar_estadisticas_por_mes_json", exportar_estadisticas_por_mes_json},
+    {"export", "exportar_estadisticas_por_mes_html", exportar_estadisticas_por_mes_html},
+    {"export", "exportar_estadisticas_por_anio_csv", exportar_estadisticas_por_anio_csv},
+    {"export", "exportar_estadisticas_por_anio_txt", exportar_estadisticas_por_anio_txt},
+    {"export", "exportar_estadisticas_por_anio_json", exportar_estadisticas_por_anio_json},
+    {"export", "exportar_estadisticas_por_anio_html", exportar_estadisticas_por_anio_html},
+    {"export", "exportar_record_goles_partido_csv", exportar_record_goles_partido_csv},
+    {"export", "exportar_record_asistencias_partido_csv", exportar_record_asistencias_partido_csv},
+    {"export", "exportar_mejor_combinacion_cancha_camiseta_csv", exportar_mejor_combinacion_cancha_camiseta_csv},
+    {"export", "exportar_peor_combinacion_cancha_camiseta_csv", exportar_peor_combinacion_cancha_camiseta_csv},
+    {"export", "exportar_mejor_temporada_csv", exportar_mejor_temporada_csv},
+    {"export", "exportar_peor_temporada_csv", exportar_peor_temporada_csv},
+    {"export", "exportar_records_rankings_txt", exportar_records_rankings_txt},
+    {"export", "exportar_records_rankings_json", exportar_records_rankings_json},
+    {"export", "exportar_records_rankings_html", exportar_records_rankings_html},
+    {"export", "exportar_analisis_csv", exportar_analisis_csv},
+    {"export", "exportar_analisis_txt", exportar_analisis_txt},
+    {"export", "exportar_analisis_json", exportar_analisis_json},
+    {"export", "exportar_analisis_html", exportar_analisis_html},
+
+    {"logros", "logros_todos", logros_todos},
+    {"logros", "logros_completados", logros_completados},
+    {"logros", "logros_en_progreso", logros_en_progreso}
+};
+
+#define NUM_CASOS ((int)(sizeof(CASOS) / sizeof(CASOS[0])))
+
+/**
+ * @brief Orden ascendente de doubles para qsort
+ */
+static int comparar_double(const void *a, const void *b)
+{
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Percentil por rango mas cercano sobre un arreglo ordenado
+ */
+static double percentil(const double *ordenados, int n, double p)
+{
+    int rango = (int)(p * n + 0.999999);
+    if (rango < 1)
+        rango = 1;
+    if (rango > n)
+        rango = n;
+    return ordenados[rango - 1];
+}
+
+/**
+ * @brief Cuenta los partidos de la base abierta
+ */
+static int contar_partidos()
+{
+    sqlite3_stmt *stmt;
+    int total = 0;
+    if (sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM partido", -1, &stmt, NULL) == SQLITE_OK)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            total = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+    }
+    return total;
+}
+
+/**
+ * @brief Mide un caso y agrega su resultado al arreglo JSON
+ *
+ * @return Mediana en milisegundos
+ */
+static double medir_caso(const CasoBench *caso, int iteraciones, double *muestras, cJSON *resultados)
+{
+    double suma = 0.0;
+
+    // Una ejecucion de calentamiento para que la cache de paginas y de sentencias este caliente
+    caso->funcion();
+    fflush(stdout);
+
+    for (int i = 0; i < iteraciones; i++)
+    {
+        double inicio = get_time_ms();
+        caso->funcion();
+        fflush(stdout);
+        muestras[i] = get_time_ms() - inicio;
+        suma += muestras[i];
+    }
+    qsort(muestras, iteraciones, sizeof(double), comparar_double);
+
+    double mediana = percentil(muestras, iteraciones, 0.5);
+    cJSON *r = cJSON_CreateObject();
+    cJSON_AddStringToObject(r, "grupo", caso->grupo);
+    cJSON_AddStringToObject(r, "nombre", caso->nombre);
+    cJSON_AddNumberToObject(r, "mediana_ms", mediana);
+    cJSON_AddNumberToObject(r, "p95_ms", percentil(muestras, iteraciones, 0.95));
+    cJSON_AddNumberToObject(r, "min_ms", muestras[0]);
+    cJSON_AddNumberToObject(r, "max_ms", muestras[iteraciones - 1]);
+    cJSON_AddNumberToObject(r, "media_ms", suma / iteraciones);
+    cJSON_AddItemToArray(resultados, r);
+    return mediana;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *ruta_db = "bench.db";
+    const char *salida = "bench_resultados.json";
+    const char *filtro = NULL;
+    int iteraciones = 15;
+    int partidos_generar = 20000;
+    unsigned long long semilla = 42;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *valor = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(argv[i], "--memoria") == 0)
+        {
+            db_set_modo_memoria(1);
+            continue;
+        }
+        if (!valor)
+        {
+            fprintf(stderr, "Falta el valor de %s\n", argv[i]);
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--db") == 0)
+            ruta_db = valor;
+        else if (strcmp(argv[i], "--salida") == 0)
+            salida = valor;
+        else if (strcmp(argv[i], "--filtro") == 0)
+            filtro = valor;
+        else if (strcmp(argv[i], "--iteraciones") == 0)
+            iteraciones = atoi(valor);
+        else if (strcmp(argv[i], "--generar") == 0)
+            partidos_generar = atoi(valor);
+        else if (strcmp(argv[i], "--semilla") == 0)
+            semilla = strtoull(valor, NULL, 10);
+        else
+        {
+            fprintf(stderr, "Opcion desconocida: %s\n", argv[i]);
+            return 1;
+        }
+        i++;
+    }
+    if (iteraciones < 1)
+        iteraciones = 1;
+
+    db_set_ruta(ruta_db);
+    if (!db_init())
+        return 1;
+    settings_init();
+    set_modo_batch(1);
+
+    int partidos = contar_partidos();
+    if (partidos == 0)
+    {
+        GeneradorConfig cfg;
+        fprintf(stderr, "Base vacia: generando %d partidos (semilla %llu)...\n", partidos_generar, semilla);
+        generador_config_defecto(&cfg, partidos_generar, semilla);
+        if (!generador_ejecutar(&cfg))
+        {
+            db_close();
+            return 1;
+        }
+        partidos = contar_partidos();
+    }
+
+    double *muestras = malloc(sizeof(double) * iteraciones);
+    cJSON *raiz = cJSON_CreateObject();
+    cJSON *resultados = cJSON_CreateArray();
+    char fecha[32];
+
+    get_datetime(fecha, sizeof(fecha));
+    cJSON_AddStringToObject(raiz, "fecha", fecha);
+    cJSON_AddStringToObject(raiz, "db", ruta_db);
+    cJSON_AddNumberToObject(raiz, "version_esquema", migraciones_version_actual());
+    cJSON_AddNumberToObject(raiz, "partidos", partidos);
+    cJSON_AddNumberToObject(raiz, "iteraciones", iteraciones);
+    cJSON_AddBoolToObject(raiz, "memoria", db_en_memoria());
+    cJSON_AddItemToObject(raiz, "resultados", resultados);
+
+    // Todo lo que imprimen los informes va al dispositivo nulo; el progreso sale por stderr
+    fflush(stdout);
+    if (!freopen(DISPOSITIVO_NULO, "w", stdout))
+    {
+        fprintf(stderr, "No se pudo redirigir stdout\n");
+        free(muestras);
+        cJSON_Delete(raiz);
+        db_close();
+        return 1;
+    }
+
+    double inicio_total = get_time_ms();
+    for (int c = 0; c < NUM_CASOS; c++)
+    {
+        if (filtro && !strstr(CASOS[c].nombre, filtro) && strcmp(CASOS[c].grupo, filtro) != 0)
+            continue;
+        double mediana = medir_caso(&CASOS[c], iteraciones, muestras, resultados);
+        fprintf(stderr, "%-14s %-52s %10.3f ms\n", CASOS[c].grupo, CASOS[c].nombre, mediana);
+    }
+    cJSON_AddNumberToObject(raiz, "duracion_total_ms", get_time_ms() - inicio_total);
+
+    int ok = 0;
+    char *json = cJSON_Print(raiz);
+    FILE *f = fopen(salida, "w");
+    if (f && json)
+    {
+        fprintf(f, "%s\n", json);
+        ok = 1;
+    }
+    if (f)
+        fclose(f);
+    if (ok)
+        fprintf(stderr, "Resultados guardados en %s\n", salida);
+    else
+        fprintf(stderr, "Error escribiendo %s\n", salida);
+
+    cJSON_free(json);
+    cJSON_Delete(raiz);
+    free(muestras);
+    db_close();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# Compile the benchmark executable (all modules except main.c, plus bench.c)
+gcc -Wall -O2 -DSQLITE_ENABLE_FTS5 analisis.c cJSON.c cJSON_Utils.c camiseta.c cancha.c db.c estadisticas.c estadisticas_meta.c estadisticas_anio.c estadisticas_generales.c estadisticas_lesiones.c estadisticas_mes.c export.c export_all.c export_all_mejorado.c export_camisetas.c export_camisetas_mejorado.c export_estadisticas.c export_estadisticas_generales.c export_lesiones.c export_lesiones_mejorado.c export_partidos.c export_records_rankings.c import.c lesion.c logros.c menu.c partido.c records_rankings.c sqlite3.c utils.c equipo.c torneo.c api.c financiamiento.c migraciones.c perfil_sql.c cli.c generador.c respaldo.c partido_store.c cambios.c resumenes.c cuantiles.c correlaciones.c export_correlaciones.c forma.c rachas.c bench.c -lcurl -o MiFutbolC_bench
+
+# Check if compilation was successful
+if [ $? -eq 0 ]; then
+    echo "Compilation successful. Running the benchmark..."
+    ./MiFutbolC_bench "$@"
+else
+    echo "Compilation failed."
+fi
@@ -0,0 +1,205 @@
+/**
+ * @file cambios.c
+ * @brief Registro de cambios para procesamiento incremental
+ *
+ * Ver cambios.h. Las tablas cambio y cambio_consumidor y los triggers se
+ * crean en la migracion 10; aqui se lee y se purga el registro y se
+ * guardan las marcas de los consumidores.
+ */
+
+#include "cambios.h"
+#include "db.h"
+#include <stdio.h>
+
+/**
+ * @brief Devuelve la ultima secuencia asignada en el registro
+ *
+ * MAX(seq) se resuelve con el extremo de la clave primaria y es fiable
+ * porque cambios_purgar() nunca borra la ultima entrada.
+ */
+long long cambios_secuencia_actual()
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT COALESCE(MAX(seq), 0) FROM cambio");
+    long long secuencia = -1;
+
+    if (!stmt)
+        return -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        secuencia = sqlite3_column_int64(stmt, 0);
+    db_release_cached(stmt);
+    return secuencia;
+}
+
+/**
+ * @brief Devuelve la secuencia mas antigua que conserva el registro
+ *
+ * @param actual Ultima secuencia asignada
+ * @return Secuencia mas antigua (actual + 1 si el registro esta vacio), -1 si error
+ */
+static long long secuencia_minima(long long actual)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT MIN(seq) FROM cambio");
+    long long minima = -1;
+
+    if (!stmt)
+        return -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        if (sqlite3_column_type(stmt, 0) == SQLITE_NULL)
+            minima = actual + 1;
+        else
+            minima = sqlite3_column_int64(stmt, 0);
+    }
+    db_release_cached(stmt);
+    return minima;
+}
+
+/**
+ * @brief Recorre en orden los cambios posteriores a una marca
+ *
+ * La secuencia no tiene huecos salvo por la purga, que borra siempre un
+ * prefijo: si la entrada desde + 1 ya no esta, el consumidor se perdio
+ * cambios y debe recalcular.
+ */
+int cambios_consumir(long long desde, const char *tabla, CambioVisitor visitor, void *contexto, long long *hasta)
+{
+    sqlite3_stmt *stmt;
+    long long actual = cambios_secuencia_actual();
+    long long minima;
+    int entregados = 0;
+    int rc;
+    Cambio c;
+
+    if (hasta)
+        *hasta = desde;
+    if (actual < 0)
+        return -1;
+    if (desde > actual)
+        return CAMBIOS_DESBORDE;
+    if (desde == actual)
+        return 0;
+
+    minima = secuencia_minima(actual);
+    if (minima < 0)
+        return -1;
+    if (desde + 1 < minima)
+        return CAMBIOS_DESBORDE;
+
+    stmt = db_prepare_cached("SELECT seq, tabla, fila, op FROM cambio "
+                             "WHERE seq > ? AND (?2 IS NULL OR tabla = ?2) ORDER BY seq");
+    if (!stmt)
+        return -1;
+    sqlite3_bind_int64(stmt, 1, desde);
+    if (tabla)
+        sqlite3_bind_text(stmt, 2, tabla, -1, SQLITE_STATIC);
+
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        const char *op = (const char *)sqlite3_column_text(stmt, 3);
+
+        c.secuencia = sqlite3_column_int64(stmt, 0);
+        c.tabla = (const char *)sqlite3_column_text(stmt, 1);
+        c.fila = sqlite3_column_int64(stmt, 2);
+        c.operacion = op ? op[0] : 'U';
+        entregados++;
+        if (hasta)
+            *hasta = c.secuencia;
+        if (!visitor(&c, contexto))
+            break;
+    }
+    db_release_cached(stmt);
+
+    if (rc != SQLITE_ROW && rc != SQLITE_DONE)
+    {
+        printf("Error leyendo el registro de cambios: %s\n", sqlite3_errmsg(db));
+        return -1;
+    }
+    // Recorrido completo: la marca llega al final aunque el filtro de tabla no dejara pasar nada
+    if (hasta && rc == SQLITE_DONE && actual > *hasta)
+        *hasta = actual;
+    return entregados;
+}
+
+/**
+ * @brief Lee la marca persistida de un consumidor
+ */
+long long cambios_leer_marca(const char *consumidor)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT seq FROM cambio_consumidor WHERE nombre = ?");
+    long long marca = 0;
+    int rc;
+
+    if (!stmt)
+        return -1;
+    sqlite3_bind_text(stmt, 1, consumidor, -1, SQLITE_STATIC);
+    rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW)
+        marca = sqlite3_column_int64(stmt, 0);
+    else if (rc != SQLITE_DONE)
+        marca = -1;
+    db_release_cached(stmt);
+    return marca;
+}
+
+/**
+ * @brief Guarda la marca de un consumidor, registrandolo si no existia
+ */
+int cambios_guardar_marca(const char *consumidor, long long secuencia)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("INSERT OR REPLACE INTO cambio_consumidor(nombre, seq) VALUES(?, ?)");
+    int ok;
+
+    if (!stmt)
+        return 0;
+    sqlite3_bind_text(stmt, 1, consumidor, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 2, secuencia);
+    ok = sqlite3_step(stmt) == SQLITE_DONE;
+    if (!ok)
+        printf("Error guardando la marca de %s: %s\n", consumidor, sqlite3_errmsg(db));
+    db_release_cached(stmt);
+    return ok;
+}
+
+/**
+ * @brief Borra las entradas que ya no necesita ningun consumidor
+ *
+ * El limite parte de la ventana minima, baja hasta la menor marca
+ * registrada y nunca deja mas de CAMBIOS_RETENCION_MAXIMA entradas. Como
+ * la ventana minima no es vacia, la ultima entrada se conserva siempre:
+ * es la que fija la secuencia actual.
+ */
+int cambios_purgar()
+{
+    sqlite3_stmt *stmt;
+    long long actual = cambios_secuencia_actual();
+    long long limite;
+    int borradas = -1;
+
+    if (actual < 0)
+        return -1;
+    limite = actual - CAMBIOS_RETENCION_MINIMA;
+
+    stmt = db_prepare_cached("SELECT MIN(seq) FROM cambio_consumidor");
+    if (!stmt)
+        return -1;
+    if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_type(stmt, 0) != SQLITE_NULL &&
+            sqlite3_column_int64(stmt, 0) < limite)
+        limite = sqlite3_column_int64(stmt, 0);
+    db_release_cached(stmt);
+
+    if (limite < actual - CAMBIOS_RETENCION_MAXIMA)
+        limite = actual - CAMBIOS_RETENCION_MAXIMA;
+    if (limite <= 0)
+        return 0;
+
+    stmt = db_prepare_cached("DELETE FROM cambio WHERE seq <= ?");
+    if (!stmt)
+        return -1;
+    sqlite3_bind_int64(stmt, 1, limite);
+    if (sqlite3_step(stmt) == SQLITE_DONE)
+        borradas = sqlite3_changes(db);
+    else
+        printf("Error purgando el registro de cambios: %s\n", sqlite3_errmsg(db));
+    db_release_cached(stmt);
+    return borradas;
+}
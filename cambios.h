@@ -0,0 +1,108 @@
+/**
+ * @file cambios.h
+ * @brief Registro de cambios para procesamiento incremental
+ *
+ * Triggers AFTER INSERT/UPDATE/DELETE sobre partido, lesion, partido_torneo,
+ * jugador_estadisticas y financiamiento anotan cada fila modificada en la
+ * tabla cambio con un numero de secuencia creciente. Un consumidor recuerda
+ * la ultima secuencia procesada y en la siguiente pasada solo lee lo
+ * posterior: la copia en memoria de partido guarda su marca en memoria y
+ * los consumidores que corren en procesos distintos (por ejemplo
+ * --cambios desde una tarea programada) la persisten con
+ * cambios_guardar_marca().
+ *
+ * La purga conserva siempre las ultimas CAMBIOS_RETENCION_MINIMA entradas,
+ * para las copias en memoria de otras sesiones abiertas, y lo que algun
+ * consumidor registrado aun no leyo, con un tope de
+ * CAMBIOS_RETENCION_MAXIMA entradas. Un consumidor que se queda atras
+ * recibe CAMBIOS_DESBORDE y debe recalcular desde las tablas.
+ */
+
+#ifndef CAMBIOS_H
+#define CAMBIOS_H
+
+/** Entradas mas recientes que la purga conserva siempre */
+#define CAMBIOS_RETENCION_MINIMA 10000
+
+/** Entradas del registro que se conservan como maximo al purgar */
+#define CAMBIOS_RETENCION_MAXIMA 100000
+
+/** Resultado de cambios_consumir() cuando faltan cambios posteriores a la marca */
+#define CAMBIOS_DESBORDE -2
+
+/**
+ * @brief Cambio registrado sobre una fila
+ */
+typedef struct
+{
+    long long secuencia;    /**< Posicion en el registro (creciente, sin reutilizar) */
+    const char *tabla;      /**< Tabla modificada */
+    long long fila;         /**< rowid de la fila (ID de la entidad) */
+    char operacion;         /**< 'I' alta, 'U' modificacion, 'D' baja */
+} Cambio;
+
+/**
+ * @brief Funcion que recibe cada cambio leido
+ *
+ * @param cambio Cambio leido; tabla solo es valida durante la llamada
+ * @param contexto Puntero pasado a cambios_consumir()
+ * @return 1 para seguir leyendo, 0 para detenerse
+ */
+typedef int (*CambioVisitor)(const Cambio *cambio, void *contexto);
+
+/**
+ * @brief Devuelve la ultima secuencia asignada en el registro
+ *
+ * Un consumidor que recalcula desde las tablas guarda este valor como marca
+ * antes de empezar, de modo que no pierde los cambios hechos mientras tanto.
+ *
+ * @return Ultima secuencia (0 si nunca hubo cambios), -1 en caso de error
+ */
+long long cambios_secuencia_actual();
+
+/**
+ * @brief Recorre en orden los cambios posteriores a una marca
+ *
+ * @param desde Ultima secuencia ya procesada por el consumidor
+ * @param tabla Tabla cuyos cambios interesan, o NULL para todas
+ * @param visitor Funcion llamada con cada cambio
+ * @param contexto Puntero que se pasa a visitor
+ * @param hasta Si no es NULL, recibe la secuencia del ultimo cambio entregado
+ *              (desde si no hubo ninguno); es la nueva marca del consumidor
+ * @return Cambios entregados, CAMBIOS_DESBORDE si los posteriores a desde ya
+ *         se purgaron o desde es mayor que la secuencia actual, -1 si error
+ */
+int cambios_consumir(long long desde, const char *tabla, CambioVisitor visitor, void *contexto, long long *hasta);
+
+/**
+ * @brief Lee la marca persistida de un consumidor
+ *
+ * @param consumidor Nombre del consumidor
+ * @return Marca guardada, 0 si el consumidor no esta registrado, -1 si error
+ */
+long long cambios_leer_marca(const char *consumidor);
+
+/**
+ * @brief Guarda la marca de un consumidor, registrandolo si no existia
+ *
+ * Los consumidores registrados retienen en el registro los cambios que aun
+ * no procesaron (hasta CAMBIOS_RETENCION_MAXIMA entradas).
+ *
+ * @param consumidor Nombre del consumidor
+ * @param secuencia Ultima secuencia procesada
+ * @return 1 si exito, 0 en caso de error
+ */
+int cambios_guardar_marca(const char *consumidor, long long secuencia);
+
+/**
+ * @brief Borra las entradas que ya no necesita ningun consumidor
+ *
+ * Conserva las ultimas CAMBIOS_RETENCION_MINIMA entradas y las posteriores
+ * a la menor marca registrada, sin pasar de CAMBIOS_RETENCION_MAXIMA. Se
+ * invoca desde db_close().
+ *
+ * @return Entradas borradas, -1 en caso de error
+ */
+int cambios_purgar();
+
+#endif
@@ -13,30 +13,6 @@
 #include <stdlib.h>
 #include <time.h>
 
-/**
- * @brief Obtiene el siguiente ID disponible para una nueva camiseta
- *
- * Mantiene IDs secuenciales reutilizando espacios de eliminaciones para
- * evitar IDs excesivamente altos y facilitar la navegación del usuario.
- *
- * @return El ID disponible más pequeño (comenzando desde 1 si la tabla está vacía)
- */
-static int obtener_siguiente_id_camiseta()
-{
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "WITH RECURSIVE seq(id) AS (VALUES(1) UNION ALL SELECT id+1 FROM seq WHERE id < (SELECT COALESCE(MAX(id),0)+1 FROM camiseta)) SELECT MIN(id) FROM seq WHERE id NOT IN (SELECT id FROM camiseta)",
-                       -1, &stmt, NULL);
-
-    int id = 1; // Default si la tabla está vacía
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        id = sqlite3_column_int(stmt, 0);
-    }
-    sqlite3_finalize(stmt);
-    return id;
-}
-
 /**
  * @brief Verifica si hay camisetas registradas en la base de datos
  *
@@ -72,7 +48,7 @@ void crear_camiseta()
     char nombre[50];
     input_string("Nombre y Numero: ", nombre, 50);
 
-    int id = obtener_siguiente_id_camiseta();
+    int id = db_siguiente_id("camiseta");
 
     sqlite3_stmt *stmt;
     sqlite3_prepare_v2(db,
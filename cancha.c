@@ -4,30 +4,6 @@
 #include "utils.h"
 #include <stdio.h>
 
-/**
- * @brief Obtiene el siguiente ID disponible para una nueva cancha
- *
- * Mantiene IDs secuenciales reutilizando espacios de eliminaciones para
- * evitar IDs excesivamente altos y facilitar la navegación del usuario.
- *
- * @return El ID disponible más pequeño (comenzando desde 1 si la tabla está vacía)
- */
-static int obtener_siguiente_id_cancha()
-{
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "WITH RECURSIVE seq(id) AS (VALUES(1) UNION ALL SELECT id+1 FROM seq WHERE id < (SELECT COALESCE(MAX(id),0)+1 FROM cancha)) SELECT MIN(id) FROM seq WHERE id NOT IN (SELECT id FROM cancha)",
-                       -1, &stmt, NULL);
-
-    int id = 1; // Default si la tabla está vacía
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        id = sqlite3_column_int(stmt, 0);
-    }
-    sqlite3_finalize(stmt);
-    return id;
-}
-
 /**
  * @brief Verifica si hay canchas registradas en la base de datos
  *
@@ -61,7 +37,7 @@ void crear_cancha()
     char nombre[100];
     input_string("Nombre de la cancha: ", nombre, 100);
 
-    int id = obtener_siguiente_id_cancha();
+    int id = db_siguiente_id("cancha");
 
     sqlite3_stmt *stmt;
     sqlite3_prepare_v2(db,
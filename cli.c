@@ -0,0 +1,372 @@
+/**
+ * @file cli.c
+ * @brief Modo no interactivo de linea de comandos
+ *
+ * Cada subcomando llama directamente a las funciones que usan los menus.
+ * Las opciones de arranque (--profile, --verificar-indices, --memoria) las
+ * gestiona main.c y aqui se ignoran.
+ */
+
+#include "cli.h"
+#include "utils.h"
+#include "export_all.h"
+#include "import.h"
+#include "logros.h"
+#include "analisis.h"
+#include "estadisticas_generales.h"
+#include "estadisticas_mes.h"
+#include "estadisticas_anio.h"
+#include "estadisticas_lesiones.h"
+#include "estadisticas_meta.h"
+#include "records_rankings.h"
+#include "generador.h"
+#include "respaldo.h"
+#include "resumenes.h"
+#include "cambios.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Informes de pantalla disponibles con --report <nombre>
+ */
+typedef struct
+{
+    const char *nombre;
+    void (*accion)();
+} InformeNombrado;
+
+/**
+ * @brief Muestra todos los records y rankings seguidos
+ */
+static void informe_records_rankings()
+{
+    mostrar_record_goles_partido();
+    mostrar_record_asistencias_partido();
+    mostrar_mejor_combinacion_cancha_camiseta();
+    mostrar_peor_combinacion_cancha_camiseta();
+    mostrar_mejor_temporada();
+    mostrar_peor_temporada();
+    mostrar_partido_mejor_rendimiento_general();
+    mostrar_partido_peor_rendimiento_general();
+    mostrar_partido_mejor_combinacion_goles_asistencias();
+    mostrar_partidos_sin_goles();
+    mostrar_partidos_sin_asistencias();
+    mostrar_mejor_racha_goleadora();
+    mostrar_peor_racha();
+    mostrar_partidos_consecutivos_anotando();
+    mostrar_rachas_por_camiseta();
+}
+
+/**
+ * @brief Muestra todos los informes de evolucion temporal seguidos
+ */
+static void informe_evolucion()
+{
+    evolucion_mensual_goles();
+    evolucion_mensual_asistencias();
+    evolucion_mensual_rendimiento();
+    mejor_mes_historico();
+    peor_mes_historico();
+    inicio_vs_fin_anio();
+    meses_frios_vs_calidos();
+    progreso_total_jugador();
+}
+
+static const InformeNombrado INFORMES[] =
+{
+    {"estadisticas-generales", mostrar_estadisticas_generales},
+    {"estadisticas-mes", mostrar_estadisticas_por_mes},
+    {"estadisticas-anio", mostrar_estadisticas_por_anio},
+    {"estadisticas-lesiones", mostrar_estadisticas_lesiones},
+    {"analisis", mostrar_analisis},
+    {"forma", mostrar_curva_forma},
+    {"evolucion", informe_evolucion},
+    {"records-rankings", informe_records_rankings},
+    {"correlaciones", mostrar_matriz_correlaciones}
+};
+
+#define NUM_INFORMES (sizeof(INFORMES) / sizeof(INFORMES[0]))
+
+/**
+ * @brief Ejecuta un informe por nombre
+ *
+ * @return 1 si el nombre es valido, 0 en caso contrario
+ */
+static int ejecutar_informe(const char *nombre)
+{
+    for (size_t i = 0; i < NUM_INFORMES; i++)
+    {
+        if (strcmp(INFORMES[i].nombre, nombre) == 0)
+        {
+            INFORMES[i].accion();
+            printf("\n");
+            return 1;
+        }
+    }
+
+    printf("Informe desconocido: %s\nDisponibles:", nombre);
+    for (size_t i = 0; i < NUM_INFORMES; i++)
+        printf(" %s", INFORMES[i].nombre);
+    printf("\n");
+    return 0;
+}
+
+/**
+ * @brief Muestra los logros de una camiseta indicada por su ID
+ *
+ * @return 1 si el ID es valido y la camiseta existe, 0 en caso contrario
+ */
+static int ejecutar_logros(const char *arg)
+{
+    char *fin;
+    long id = strtol(arg, &fin, 10);
+
+    if (*arg == '\0' || *fin != '\0' || id <= 0)
+    {
+        printf("ID de camiseta invalido: %s\n", arg);
+        return 0;
+    }
+    return mostrar_logros_de_camiseta((int)id, 0);
+}
+
+/**
+ * @brief Genera datos sinteticos con el numero de partidos indicado
+ *
+ * @param arg Numero de partidos
+ * @param semilla Semilla del generador
+ * @return 1 si exito, 0 en caso de error
+ */
+static int ejecutar_generador(const char *arg, unsigned long long semilla)
+{
+    GeneradorConfig cfg;
+    char *fin;
+    long partidos = strtol(arg, &fin, 10);
+
+    if (*arg == '\0' || *fin != '\0' || partidos < 0 || partidos > 100000000L)
+    {
+        printf("Numero de partidos invalido: %s\n", arg);
+        return 0;
+    }
+    generador_config_defecto(&cfg, (int)partidos, semilla);
+    return generador_ejecutar(&cfg);
+}
+
+/**
+ * @brief Ejecuta una accion sobre los respaldos
+ *
+ * @param accion crear, listar o rotar
+ * @return 1 si exito, 0 en caso de error
+ */
+static int ejecutar_respaldo(const char *accion)
+{
+    if (strcmp(accion, "crear") == 0)
+        return respaldo_crear(NULL, 0);
+    if (strcmp(accion, "listar") == 0)
+    {
+        respaldo_listar();
+        return 1;
+    }
+    if (strcmp(accion, "rotar") == 0)
+    {
+        int borrados = respaldo_rotar(RESPALDO_DIARIOS, RESPALDO_SEMANALES);
+        if (borrados < 0)
+            return 0;
+        printf("Respaldos borrados: %d\n", borrados);
+        return 1;
+    }
+
+    printf("Accion de respaldo desconocida: %s\nDisponibles: crear listar rotar\n", accion);
+    return 0;
+}
+
+/**
+ * @brief Verifica o reconstruye los resumenes de partido
+ *
+ * @param accion verificar o reconstruir
+ * @return 1 si exito (verificar exige que no haya diferencias), 0 en otro caso
+ */
+static int ejecutar_resumenes(const char *accion)
+{
+    if (strcmp(accion, "verificar") == 0)
+        return resumenes_verificar(1) == 0;
+    if (strcmp(accion, "reconstruir") == 0)
+        return resumenes_reconstruir();
+
+    printf("Accion de resumenes desconocida: %s\nDisponibles: verificar reconstruir\n", accion);
+    return 0;
+}
+
+/**
+ * @brief Escribe un cambio como linea "secuencia tabla fila operacion"
+ */
+static int imprimir_cambio(const Cambio *cambio, void *contexto)
+{
+    (void)contexto;
+    printf("%lld %s %lld %c\n", cambio->secuencia, cambio->tabla, cambio->fila, cambio->operacion);
+    return 1;
+}
+
+/**
+ * @brief Muestra los cambios pendientes de un consumidor y avanza su marca
+ *
+ * Pensado para tareas programadas que procesan solo lo que cambio desde
+ * su ultima ejecucion. Si el consumidor perdio cambios (o es su primera
+ * ejecucion sobre un registro ya purgado) su marca pasa a la secuencia
+ * actual y se informa que debe recalcular desde las tablas.
+ *
+ * @param consumidor Nombre del consumidor
+ * @return 1 si se entregaron los cambios pendientes, 0 si hay que recalcular o hubo error
+ */
+static int ejecutar_cambios(const char *consumidor)
+{
+    long long marca = cambios_leer_marca(consumidor);
+    long long hasta;
+    int entregados;
+
+    if (marca < 0)
+        return 0;
+
+    entregados = cambios_consumir(marca, NULL, imprimir_cambio, NULL, &hasta);
+    if (entregados == CAMBIOS_DESBORDE)
+    {
+        long long actual = cambios_secuencia_actual();
+        if (actual < 0 || !cambios_guardar_marca(consumidor, actual))
+            return 0;
+        printf("El consumidor %s perdio cambios: debe recalcular desde las tablas.\n", consumidor);
+        return 0;
+    }
+    if (entregados < 0 || !cambios_guardar_marca(consumidor, hasta))
+        return 0;
+    return 1;
+}
+
+/**
+ * @brief Muestra la ayuda del modo de linea de comandos
+ */
+static void mostrar_ayuda()
+{
+    printf("Uso: MiFutbolC [opciones] [subcomandos]\n\n");
+    printf("Opciones:\n");
+    printf("  --profile                Perfila las sentencias SQL y guarda un informe al salir\n");
+    printf("  --verificar-indices      Comprueba los planes de consulta y termina\n");
+    printf("  --db <ruta>              Usa otro archivo de base de datos\n");
+    printf("  --memoria                Trabaja sobre una copia en memoria y la guarda al salir\n");
+    printf("  --semilla <n>            Semilla de --generar (por defecto 42)\n\n");
+    printf("Subcomandos (se ejecutan en orden y el programa termina):\n");
+    printf("  --export <nombre>        Exporta en todos los formatos (all, camisetas, partidos...)\n");
+    printf("  --import <archivo>       Importa un archivo del directorio de importacion\n");
+    printf("                           (partidos.json, lesiones.csv, todo.txt...)\n");
+    printf("  --report <nombre>        Muestra un informe:");
+    for (size_t i = 0; i < NUM_INFORMES; i++)
+        printf(" %s", INFORMES[i].nombre);
+    printf("\n");
+    printf("  --logros <camiseta>      Muestra los logros de una camiseta\n");
+    printf("  --generar <partidos>     Llena una base vacia con datos sinteticos\n");
+    printf("  --respaldo <accion>      Gestiona los respaldos: crear, listar, rotar\n");
+    printf("  --restaurar <archivo>    Restaura un respaldo (<base>_AAAAMMDD_HHMMSS.db)\n");
+    printf("  --resumenes <accion>     Resumenes estadisticos: verificar, reconstruir\n");
+    printf("  --cambios <consumidor>   Cambios desde la ultima ejecucion del consumidor\n");
+    printf("  --help                   Muestra esta ayuda\n");
+}
+
+/**
+ * @brief Indica si un argumento es un subcomando que requiere valor
+ */
+static int requiere_valor(const char *arg)
+{
+    return strcmp(arg, "--export") == 0 || strcmp(arg, "--import") == 0 ||
+           strcmp(arg, "--report") == 0 || strcmp(arg, "--logros") == 0 ||
+           strcmp(arg, "--generar") == 0 || strcmp(arg, "--respaldo") == 0 ||
+           strcmp(arg, "--restaurar") == 0 || strcmp(arg, "--resumenes") == 0 ||
+           strcmp(arg, "--cambios") == 0;
+}
+
+/**
+ * @brief Indica si un argumento es una opcion con valor que no es subcomando
+ */
+static int es_opcion_con_valor(const char *arg)
+{
+    return strcmp(arg, "--db") == 0 || strcmp(arg, "--semilla") == 0;
+}
+
+int cli_hay_comandos(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (requiere_valor(argv[i]) || strcmp(argv[i], "--help") == 0)
+            return 1;
+    }
+    return 0;
+}
+
+int cli_ejecutar(int argc, char *argv[])
+{
+    int codigo = 0;
+    unsigned long long semilla = 42;
+
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--semilla") == 0)
+            semilla = strtoull(argv[i + 1], NULL, 10);
+    }
+
+    set_modo_batch(1);
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *cmd = argv[i];
+
+        if (strcmp(cmd, "--help") == 0)
+        {
+            mostrar_ayuda();
+            continue;
+        }
+        if (es_opcion_con_valor(cmd))
+        {
+            i++;
+            continue;
+        }
+        if (!requiere_valor(cmd))
+            continue;
+
+        if (i + 1 >= argc)
+        {
+            printf("Falta el valor de %s\n", cmd);
+            codigo = 1;
+            break;
+        }
+
+        const char *valor = argv[++i];
+        double inicio = get_time_ms();
+        int ok;
+
+        if (strcmp(cmd, "--export") == 0)
+            ok = exportar_por_nombre(valor);
+        else if (strcmp(cmd, "--import") == 0)
+            ok = importar_por_nombre(valor);
+        else if (strcmp(cmd, "--report") == 0)
+            ok = ejecutar_informe(valor);
+        else if (strcmp(cmd, "--generar") == 0)
+            ok = ejecutar_generador(valor, semilla);
+        else if (strcmp(cmd, "--respaldo") == 0)
+            ok = ejecutar_respaldo(valor);
+        else if (strcmp(cmd, "--restaurar") == 0)
+            ok = respaldo_restaurar(valor);
+        else if (strcmp(cmd, "--resumenes") == 0)
+            ok = ejecutar_resumenes(valor);
+        else if (strcmp(cmd, "--cambios") == 0)
+            ok = ejecutar_cambios(valor);
+        else
+            ok = ejecutar_logros(valor);
+
+        fflush(stdout);
+        fprintf(stderr, "%s %s: %s en %.1f ms\n", cmd, valor,
+                ok ? "ok" : "error", get_time_ms() - inicio);
+        if (!ok)
+            codigo = 1;
+    }
+
+    set_modo_batch(0);
+    return codigo;
+}
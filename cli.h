@@ -0,0 +1,36 @@
+/**
+ * @file cli.h
+ * @brief Modo no interactivo de linea de comandos
+ *
+ * Permite ejecutar exportaciones, importaciones, informes y consultas de
+ * logros directamente desde argumentos del programa, sin pasar por los
+ * menus, para poder lanzarlos desde tareas programadas y medir su tiempo.
+ */
+
+#ifndef CLI_H
+#define CLI_H
+
+/**
+ * @brief Indica si los argumentos contienen algun subcomando no interactivo
+ *
+ * @param argc Numero de argumentos
+ * @param argv Argumentos del programa
+ * @return 1 si hay al menos un subcomando, 0 en caso contrario
+ */
+int cli_hay_comandos(int argc, char *argv[]);
+
+/**
+ * @brief Ejecuta en orden los subcomandos recibidos
+ *
+ * Subcomandos: --export <nombre>, --import <archivo>, --report <nombre>,
+ * --logros <camiseta>, --generar <partidos> y --help. Activa el modo no
+ * interactivo, de forma que las pausas y la limpieza de pantalla no hacen
+ * nada. El tiempo de cada subcomando se escribe en stderr.
+ *
+ * @param argc Numero de argumentos
+ * @param argv Argumentos del programa
+ * @return Codigo de salida: 0 si todos los subcomandos tuvieron exito, 1 si alguno fallo
+ */
+int cli_ejecutar(int argc, char *argv[]);
+
+#endif
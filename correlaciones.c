@@ -0,0 +1,425 @@
+/**
+ * @file correlaciones.c
+ * @brief Matriz de correlaciones entre los atributos numericos de partido
+ *
+ * Ver correlaciones.h.
+ */
+
+#include "correlaciones.h"
+#include "partido_store.h"
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Filas por bloque: la copia de las siete columnas (56 KB) queda en la cache L2 */
+#define CORRELACION_BLOQUE 4096
+
+/** Mayor valor absoluto con el que la suma de un bloque de productos cabe en un int */
+#define CORRELACION_MAX_CORTO 724
+
+/** Iteraciones maximas de la fraccion continua de la beta incompleta */
+#define BETA_ITERACIONES 10000
+
+static const char *NOMBRES[NUM_VARIABLES_CORRELACION] =
+{
+    "Goles", "Asistencias", "Rendimiento", "Cansancio", "Animo", "Clima", "Dia"
+};
+
+/**
+ * @brief Nombre de una variable para mostrar
+ */
+const char *correlacion_nombre(VariableCorrelacion variable)
+{
+    if (variable < 0 || variable >= NUM_VARIABLES_CORRELACION)
+        return "";
+    return NOMBRES[variable];
+}
+
+/**
+ * @brief Sumas de una pasada: por variable y por par de variables
+ *
+ * Solo se rellena el triangulo superior de producto (a <= b).
+ */
+typedef struct
+{
+    long long suma[NUM_VARIABLES_CORRELACION];
+    long long producto[NUM_VARIABLES_CORRELACION][NUM_VARIABLES_CORRELACION];
+} SumasCruzadas;
+
+/*
+ * Los nucleos recorren columnas contiguas sin saltos ni dependencias entre
+ * filas, de modo que el compilador los vectoriza. Con las columnas del
+ * bloque copiadas a short, el producto de 16 bits con suma en 32 bits es
+ * exactamente el patron de pmaddwd (SSE2): ocho productos por instruccion.
+ * El largo fijo del bloque permite vectorizar tambien con -O2 (el modelo
+ * de costo de -O2 descarta los bucles de largo desconocido); el ultimo
+ * bloque se completa con ceros, que no suman nada.
+ */
+
+static int suma_bloque(const short *restrict x)
+{
+    int s = 0;
+
+    for (int i = 0; i < CORRELACION_BLOQUE; i++)
+        s += x[i];
+    return s;
+}
+
+static int producto_bloque(const short *restrict x, const short *restrict y)
+{
+    int s = 0;
+
+    for (int i = 0; i < CORRELACION_BLOQUE; i++)
+        s += x[i] * y[i];
+    return s;
+}
+
+static long long suma_bloque_largo(const int *restrict x, int n)
+{
+    long long s = 0;
+
+    for (int i = 0; i < n; i++)
+        s += x[i];
+    return s;
+}
+
+static long long producto_bloque_largo(const int *restrict x, const int *restrict y, int n)
+{
+    long long s = 0;
+
+    for (int i = 0; i < n; i++)
+        s += (long long)x[i] * y[i];
+    return s;
+}
+
+/**
+ * @brief Mayor valor absoluto de una columna
+ */
+static long long maximo_absoluto(const int *x, int n)
+{
+    int minimo = 0, maximo = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        minimo = x[i] < minimo ? x[i] : minimo;
+        maximo = x[i] > maximo ? x[i] : maximo;
+    }
+    return -(long long)minimo > maximo ? -(long long)minimo : maximo;
+}
+
+/**
+ * @brief Acumula sumas y productos cruzados de las columnas por bloques
+ *
+ * Cada bloque de filas se lee una vez de memoria y se reutiliza desde la
+ * cache para los 28 pares. Si ningun valor supera CORRELACION_MAX_CORTO
+ * (el caso normal: notas de 1 a 10) el bloque se copia a short y las sumas
+ * del bloque se hacen en int; si no, se acumula directamente en long long.
+ */
+static void acumular(const int *const columnas[], int n, SumasCruzadas *sumas)
+{
+    static short copia[NUM_VARIABLES_CORRELACION][CORRELACION_BLOQUE];
+    int corto = 1;
+
+    memset(sumas, 0, sizeof(*sumas));
+
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION && corto; a++)
+        corto = maximo_absoluto(columnas[a], n) <= CORRELACION_MAX_CORTO;
+
+    for (int inicio = 0; inicio < n; inicio += CORRELACION_BLOQUE)
+    {
+        int largo = n - inicio < CORRELACION_BLOQUE ? n - inicio : CORRELACION_BLOQUE;
+
+        if (!corto)
+        {
+            for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+            {
+                sumas->suma[a] += suma_bloque_largo(columnas[a] + inicio, largo);
+                for (int b = a; b < NUM_VARIABLES_CORRELACION; b++)
+                    sumas->producto[a][b] += producto_bloque_largo(columnas[a] + inicio, columnas[b] + inicio, largo);
+            }
+            continue;
+        }
+
+        for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+        {
+            for (int i = 0; i < largo; i++)
+                copia[a][i] = (short)columnas[a][inicio + i];
+            for (int i = largo; i < CORRELACION_BLOQUE; i++)
+                copia[a][i] = 0;
+        }
+        for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+        {
+            sumas->suma[a] += suma_bloque(copia[a]);
+            for (int b = a; b < NUM_VARIABLES_CORRELACION; b++)
+                sumas->producto[a][b] += producto_bloque(copia[a], copia[b]);
+        }
+    }
+}
+
+/**
+ * @brief Fraccion continua de la beta incompleta (metodo de Lentz)
+ */
+static double fraccion_beta(double a, double b, double x)
+{
+    const double minimo = 1e-300;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    double h;
+
+    if (fabs(d) < minimo)
+        d = minimo;
+    d = 1.0 / d;
+    h = d;
+
+    for (int m = 1; m <= BETA_ITERACIONES; m++)
+    {
+        int m2 = 2 * m;
+        double aa = m * (b - m) * x / ((a - 1.0 + m2) * (a + m2));
+        double delta;
+
+        d = 1.0 + aa * d;
+        if (fabs(d) < minimo)
+            d = minimo;
+        c = 1.0 + aa / c;
+        if (fabs(c) < minimo)
+            c = minimo;
+        d = 1.0 / d;
+        h *= d * c;
+
+        aa = -(a + m) * (a + b + m) * x / ((a + m2) * (a + 1.0 + m2));
+        d = 1.0 + aa * d;
+        if (fabs(d) < minimo)
+            d = minimo;
+        c = 1.0 + aa / c;
+        if (fabs(c) < minimo)
+            c = minimo;
+        d = 1.0 / d;
+        delta = d * c;
+        h *= delta;
+        if (fabs(delta - 1.0) < 1e-15)
+            break;
+    }
+    return h;
+}
+
+/**
+ * @brief Beta incompleta regularizada I_x(a, b)
+ *
+ * Recibe x y 1 - x por separado para no perder precision cuando x esta
+ * muy cerca de 1 (correlaciones casi nulas).
+ */
+static double beta_incompleta(double a, double b, double x, double complemento)
+{
+    double factor;
+
+    if (x <= 0.0)
+        return 0.0;
+    if (complemento <= 0.0)
+        return 1.0;
+
+    factor = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(complemento));
+    if (x < (a + 1.0) / (a + b + 2.0))
+        return factor * fraccion_beta(a, b, x) / a;
+    return 1.0 - factor * fraccion_beta(b, a, complemento) / b;
+}
+
+/**
+ * @brief p-valor bilateral de un coeficiente de Pearson
+ *
+ * Con gl = n - 2, la cola bilateral de t es I_{gl / (gl + t^2)}(gl / 2, 1 / 2),
+ * y gl / (gl + t^2) = 1 - r^2.
+ */
+double correlacion_p_valor(double r, int n)
+{
+    double r2;
+
+    if (n < 3 || isnan(r))
+        return NAN;
+
+    r2 = r * r;
+    if (r2 >= 1.0)
+        return 0.0;
+    return beta_incompleta((n - 2) / 2.0, 0.5, 1.0 - r2, r2);
+}
+
+/**
+ * @brief Da formato a un p-valor para pantallas y exportaciones
+ */
+void correlacion_formatear_p(double p, char *texto, size_t tam)
+{
+    if (isnan(p))
+        snprintf(texto, tam, "-");
+    else if (p < 0.0001)
+        snprintf(texto, tam, "<0.0001");
+    else
+        snprintf(texto, tam, "%.4f", p);
+}
+
+/**
+ * @brief Simbolo de intensidad de una correlacion para el mapa de calor en texto
+ */
+static char simbolo_intensidad(double r)
+{
+    double a = fabs(r);
+
+    if (a >= 0.7)
+        return '#';
+    if (a >= 0.5)
+        return 'O';
+    if (a >= 0.3)
+        return 'o';
+    if (a >= 0.1)
+        return '.';
+    return ' ';
+}
+
+/**
+ * @brief Escribe la matriz como mapa de calor en texto
+ */
+void correlaciones_escribir_mapa(FILE *salida, const MatrizCorrelacion *matriz)
+{
+    static const char *abreviaturas[NUM_VARIABLES_CORRELACION] =
+    {
+        "Gol", "Asi", "Ren", "Can", "Ani", "Cli", "Dia"
+    };
+
+    fprintf(salida, "%-12s", "");
+    for (int b = 0; b < NUM_VARIABLES_CORRELACION; b++)
+        fprintf(salida, "   %-6s", abreviaturas[b]);
+    fprintf(salida, "\n");
+
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+    {
+        fprintf(salida, "%-12s", NOMBRES[a]);
+        for (int b = 0; b < NUM_VARIABLES_CORRELACION; b++)
+        {
+            double r = matriz->r[a][b];
+            char simbolo;
+
+            if (isnan(r))
+            {
+                fprintf(salida, "    --   ");
+                continue;
+            }
+            simbolo = simbolo_intensidad(r);
+            fprintf(salida, " %c%c%+.2f%c", simbolo, simbolo, r,
+                    a != b && matriz->p[a][b] < CORRELACION_ALFA ? '*' : ' ');
+        }
+        fprintf(salida, "\n");
+    }
+
+    fprintf(salida, "\nIntensidad |r|: ' ' < 0.1  '.' 0.1-0.3  'o' 0.3-0.5  'O' 0.5-0.7  '#' >= 0.7\n");
+    fprintf(salida, "* p-valor < %.2f (prueba t con n - 2 grados de libertad)\n", CORRELACION_ALFA);
+}
+
+/**
+ * @brief |r| para ordenar pares; los no definidos van al final
+ */
+static double clave_orden(double r)
+{
+    return isnan(r) ? -1.0 : fabs(r);
+}
+
+/**
+ * @brief Escribe todos los pares de variables de mayor a menor |r|
+ */
+void correlaciones_escribir_pares(FILE *salida, const MatrizCorrelacion *matriz)
+{
+    int pares[NUM_VARIABLES_CORRELACION * (NUM_VARIABLES_CORRELACION - 1) / 2][2];
+    int num_pares = 0;
+
+    // Insercion ordenada; ante empates queda el orden de la matriz
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+    {
+        for (int b = a + 1; b < NUM_VARIABLES_CORRELACION; b++)
+        {
+            double clave = clave_orden(matriz->r[a][b]);
+            int i = num_pares++;
+
+            for (; i > 0 && clave_orden(matriz->r[pares[i - 1][0]][pares[i - 1][1]]) < clave; i--)
+            {
+                pares[i][0] = pares[i - 1][0];
+                pares[i][1] = pares[i - 1][1];
+            }
+            pares[i][0] = a;
+            pares[i][1] = b;
+        }
+    }
+
+    for (int i = 0; i < num_pares; i++)
+    {
+        int a = pares[i][0];
+        int b = pares[i][1];
+        char nombre[40];
+        char p_valor[16];
+
+        snprintf(nombre, sizeof(nombre), "%s-%s", NOMBRES[a], NOMBRES[b]);
+        if (isnan(matriz->r[a][b]))
+        {
+            fprintf(salida, "%-30s : %s\n", nombre, "sin datos suficientes");
+            continue;
+        }
+        correlacion_formatear_p(matriz->p[a][b], p_valor, sizeof(p_valor));
+        fprintf(salida, "%-30s : %+.4f  p = %s%s\n", nombre, matriz->r[a][b], p_valor,
+                matriz->p[a][b] < CORRELACION_ALFA ? " *" : "");
+    }
+}
+
+/**
+ * @brief Calcula la matriz de correlaciones de todos los partidos
+ */
+int correlaciones_calcular(MatrizCorrelacion *matriz)
+{
+    const PartidoStore *s = partido_store_obtener();
+    const int *columnas[NUM_VARIABLES_CORRELACION];
+    SumasCruzadas sumas;
+    double n;
+
+    memset(matriz, 0, sizeof(*matriz));
+    if (!s)
+        return 0;
+
+    columnas[CORR_GOLES] = s->goles;
+    columnas[CORR_ASISTENCIAS] = s->asistencias;
+    columnas[CORR_RENDIMIENTO] = s->rendimiento;
+    columnas[CORR_CANSANCIO] = s->cansancio;
+    columnas[CORR_ANIMO] = s->animo;
+    columnas[CORR_CLIMA] = s->clima;
+    columnas[CORR_DIA] = s->dia;
+
+    acumular(columnas, s->n, &sumas);
+
+    matriz->n = s->n;
+    n = s->n;
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+        matriz->media[a] = s->n > 0 ? sumas.suma[a] / n : 0.0;
+
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+    {
+        for (int b = a; b < NUM_VARIABLES_CORRELACION; b++)
+        {
+            // Misma formula que la version SQL: n*Sxy - Sx*Sy sobre la raiz
+            // del producto de las varianzas sin normalizar
+            double sa = (double)sumas.suma[a];
+            double sb = (double)sumas.suma[b];
+            double covarianza = n * (double)sumas.producto[a][b] - sa * sb;
+            double varianza_a = n * (double)sumas.producto[a][a] - sa * sa;
+            double varianza_b = n * (double)sumas.producto[b][b] - sb * sb;
+            double r = NAN;
+
+            if (s->n >= 3 && varianza_a > 0 && varianza_b > 0)
+            {
+                r = covarianza / sqrt(varianza_a * varianza_b);
+                if (r > 1.0)
+                    r = 1.0;
+                else if (r < -1.0)
+                    r = -1.0;
+            }
+
+            matriz->r[a][b] = matriz->r[b][a] = r;
+            matriz->p[a][b] = matriz->p[b][a] = correlacion_p_valor(r, s->n);
+        }
+    }
+    return 1;
+}
@@ -0,0 +1,107 @@
+/**
+ * @file correlaciones.h
+ * @brief Matriz de correlaciones entre los atributos numericos de partido
+ *
+ * Una sola pasada sobre la copia en memoria de partido acumula, para las
+ * siete variables (goles, asistencias, rendimiento, cansancio, animo, clima
+ * y dia), las sumas, las sumas de cuadrados y todos los productos cruzados.
+ * De ahi sale el coeficiente de Pearson de cada par y su p-valor bilateral
+ * con la prueba t de Student (n - 2 grados de libertad). Los valores NULL
+ * cuentan como 0, igual que en el resto de pantallas que leen la copia.
+ */
+
+#ifndef CORRELACIONES_H
+#define CORRELACIONES_H
+
+#include <stdio.h>
+
+/**
+ * @brief Variables de la matriz, en el orden de filas y columnas
+ */
+typedef enum
+{
+    CORR_GOLES,
+    CORR_ASISTENCIAS,
+    CORR_RENDIMIENTO,
+    CORR_CANSANCIO,
+    CORR_ANIMO,
+    CORR_CLIMA,
+    CORR_DIA,
+    NUM_VARIABLES_CORRELACION
+} VariableCorrelacion;
+
+/** Nivel de significacion con el que se marca una correlacion */
+#define CORRELACION_ALFA 0.05
+
+/**
+ * @brief Matriz de correlaciones de Pearson con sus p-valores
+ *
+ * r y p son simetricas. Si una de las dos variables no varia (o hay menos
+ * de tres partidos) el coeficiente no esta definido: r y p valen NAN.
+ */
+typedef struct
+{
+    int n;                                                          /**< Partidos considerados */
+    double media[NUM_VARIABLES_CORRELACION];                        /**< Media de cada variable */
+    double r[NUM_VARIABLES_CORRELACION][NUM_VARIABLES_CORRELACION]; /**< Coeficiente de Pearson */
+    double p[NUM_VARIABLES_CORRELACION][NUM_VARIABLES_CORRELACION]; /**< p-valor bilateral */
+} MatrizCorrelacion;
+
+/**
+ * @brief Nombre de una variable para mostrar
+ */
+const char *correlacion_nombre(VariableCorrelacion variable);
+
+/**
+ * @brief Calcula la matriz de correlaciones de todos los partidos
+ *
+ * @param matriz Resultado
+ * @return 1 si exito, 0 si no se pudo cargar la copia en memoria
+ */
+int correlaciones_calcular(MatrizCorrelacion *matriz);
+
+/**
+ * @brief p-valor bilateral de un coeficiente de Pearson
+ *
+ * t = r * sqrt((n - 2) / (1 - r^2)) con n - 2 grados de libertad; la cola
+ * de la t de Student sale de la funcion beta incompleta regularizada.
+ *
+ * @param r Coeficiente de Pearson
+ * @param n Tamano de la muestra
+ * @return p-valor (0-1), NAN si n < 3 o r es NAN
+ */
+double correlacion_p_valor(double r, int n);
+
+/**
+ * @brief Da formato a un p-valor para pantallas y exportaciones
+ *
+ * Cuatro decimales; por debajo de 0.0001 se escribe "<0.0001" y si no
+ * esta definido, "-".
+ *
+ * @param p p-valor
+ * @param texto Buffer de salida
+ * @param tam Tamano del buffer
+ */
+void correlacion_formatear_p(double p, char *texto, size_t tam);
+
+/**
+ * @brief Escribe la matriz como mapa de calor en texto
+ *
+ * Cada celda lleva el coeficiente de Pearson, un simbolo que crece con |r|
+ * (' ', '.', 'o', 'O', '#') y un asterisco si el p-valor queda por debajo
+ * de CORRELACION_ALFA; al pie va la leyenda.
+ *
+ * @param salida Destino (stdout o un archivo de exportacion)
+ * @param matriz Matriz calculada
+ */
+void correlaciones_escribir_mapa(FILE *salida, const MatrizCorrelacion *matriz);
+
+/**
+ * @brief Escribe todos los pares de variables de mayor a menor |r|
+ *
+ * @param salida Destino (stdout o un archivo de exportacion)
+ * @param matriz Matriz calculada
+ */
+void correlaciones_escribir_pares(FILE *salida, const MatrizCorrelacion *matriz);
+
+#endif
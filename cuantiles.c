@@ -0,0 +1,331 @@
+/**
+ * @file cuantiles.c
+ * @brief Cuantiles, IQR y MAD para detectar partidos atipicos
+ *
+ * Ver cuantiles.h.
+ */
+
+#include "cuantiles.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief Intercambia dos posiciones de un arreglo
+ */
+static void intercambiar(double *valores, int a, int b)
+{
+    double t = valores[a];
+    valores[a] = valores[b];
+    valores[b] = t;
+}
+
+/**
+ * @brief Lleva el k-esimo menor valor a la posicion k
+ *
+ * Quickselect con pivote mediana de tres y particion de Hoare; la
+ * particion se detiene en los valores iguales al pivote, de modo que las
+ * muestras con muchos repetidos (notas de 1 a 10) se parten a la mitad en
+ * lugar de degenerar. Al terminar, todo lo que queda a la derecha de k es
+ * mayor o igual que valores[k].
+ *
+ * @param valores Muestra (se reordena)
+ * @param n Tamano de la muestra
+ * @param k Posicion buscada (0 a n - 1)
+ * @return valores[k]
+ */
+static double seleccionar(double *valores, int n, int k)
+{
+    int lo = 0, hi = n - 1;
+
+    while (hi > lo)
+    {
+        int medio = lo + (hi - lo) / 2;
+        int i = lo, j = hi;
+        double pivote;
+
+        if (valores[medio] < valores[lo])
+            intercambiar(valores, lo, medio);
+        if (valores[hi] < valores[lo])
+            intercambiar(valores, lo, hi);
+        if (valores[hi] < valores[medio])
+            intercambiar(valores, medio, hi);
+        pivote = valores[medio];
+
+        while (i <= j)
+        {
+            while (valores[i] < pivote)
+                i++;
+            while (valores[j] > pivote)
+                j--;
+            if (i <= j)
+            {
+                intercambiar(valores, i, j);
+                i++;
+                j--;
+            }
+        }
+
+        // [lo, j] <= pivote, (j, i) == pivote, [i, hi] >= pivote
+        if (k <= j)
+            hi = j;
+        else if (k >= i)
+            lo = i;
+        else
+            break;
+    }
+    return valores[k];
+}
+
+/**
+ * @brief Cuantil de una muestra por seleccion en tiempo lineal
+ *
+ * Tras seleccionar la posicion k = floor(p * (n - 1)), el siguiente valor
+ * de la muestra ordenada es el minimo de lo que quedo a su derecha.
+ */
+double cuantil_seleccion(double *valores, int n, double p)
+{
+    double h = p * (n - 1);
+    int k = (int)floor(h);
+    double fraccion = h - k;
+    double x = seleccionar(valores, n, k);
+    double siguiente;
+
+    if (fraccion <= 0 || k + 1 >= n)
+        return x;
+
+    siguiente = valores[k + 1];
+    for (int i = k + 2; i < n; i++)
+    {
+        if (valores[i] < siguiente)
+            siguiente = valores[i];
+    }
+    return x + fraccion * (siguiente - x);
+}
+
+/**
+ * @brief Cuartiles, IQR, mediana y MAD de una muestra en memoria
+ */
+int resumen_robusto(double *valores, int n, ResumenRobusto *resumen)
+{
+    memset(resumen, 0, sizeof(*resumen));
+    if (n <= 0)
+        return 0;
+
+    resumen->n = n;
+    resumen->exacto = 1;
+    resumen->mediana = cuantil_seleccion(valores, n, 0.5);
+    resumen->q1 = cuantil_seleccion(valores, n, 0.25);
+    resumen->q3 = cuantil_seleccion(valores, n, 0.75);
+    resumen->iqr = resumen->q3 - resumen->q1;
+
+    for (int i = 0; i < n; i++)
+        valores[i] = fabs(valores[i] - resumen->mediana);
+    resumen->mad = cuantil_seleccion(valores, n, 0.5);
+    return 1;
+}
+
+/**
+ * @brief Inicia un estimador P-cuadrado para el cuantil p
+ */
+void sketch_iniciar(SketchCuantil *sketch, double p)
+{
+    memset(sketch, 0, sizeof(*sketch));
+    sketch->p = p;
+}
+
+/**
+ * @brief Prediccion parabolica de la altura del marcador i movido d posiciones
+ */
+static double parabolica(const SketchCuantil *s, int i, double d)
+{
+    const double *q = s->altura;
+    const double *n = s->posicion;
+
+    return q[i] + d / (n[i + 1] - n[i - 1]) *
+           ((n[i] - n[i - 1] + d) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+            (n[i + 1] - n[i] - d) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+}
+
+/**
+ * @brief Agrega un valor al estimador
+ *
+ * Los cinco primeros valores se guardan tal cual; a partir de ahi se
+ * ajustan los marcadores segun el algoritmo P-cuadrado.
+ */
+void sketch_agregar(SketchCuantil *sketch, double valor)
+{
+    double *q = sketch->altura;
+    double *n = sketch->posicion;
+    int k;
+
+    if (sketch->cuenta < 5)
+    {
+        int i = sketch->cuenta++;
+
+        // Insercion ordenada de las cinco primeras observaciones
+        for (; i > 0 && q[i - 1] > valor; i--)
+            q[i] = q[i - 1];
+        q[i] = valor;
+
+        if (sketch->cuenta == 5)
+        {
+            double p = sketch->p;
+            double deseadas[5] = {1, 1 + 2 * p, 1 + 4 * p, 3 + 2 * p, 5};
+            double incrementos[5] = {0, p / 2, p, (1 + p) / 2, 1};
+
+            for (i = 0; i < 5; i++)
+                n[i] = i + 1;
+            memcpy(sketch->deseada, deseadas, sizeof(deseadas));
+            memcpy(sketch->incremento, incrementos, sizeof(incrementos));
+        }
+        return;
+    }
+
+    sketch->cuenta++;
+    if (valor < q[0])
+    {
+        q[0] = valor;
+        k = 0;
+    }
+    else if (valor >= q[4])
+    {
+        q[4] = valor;
+        k = 3;
+    }
+    else
+    {
+        for (k = 0; k < 3 && valor >= q[k + 1]; k++)
+            ;
+    }
+
+    for (int i = k + 1; i < 5; i++)
+        n[i]++;
+    for (int i = 0; i < 5; i++)
+        sketch->deseada[i] += sketch->incremento[i];
+
+    for (int i = 1; i <= 3; i++)
+    {
+        double d = sketch->deseada[i] - n[i];
+
+        if ((d >= 1 && n[i + 1] - n[i] > 1) || (d <= -1 && n[i - 1] - n[i] < -1))
+        {
+            double signo = d > 0 ? 1 : -1;
+            double prediccion = parabolica(sketch, i, signo);
+
+            if (q[i - 1] < prediccion && prediccion < q[i + 1])
+                q[i] = prediccion;
+            else
+                q[i] += signo * (q[i + (int)signo] - q[i]) / (n[i + (int)signo] - n[i]);
+            n[i] += signo;
+        }
+    }
+}
+
+/**
+ * @brief Estimacion actual del cuantil
+ *
+ * Con menos de cinco valores se interpola entre los guardados, igual que
+ * cuantil_seleccion().
+ */
+double sketch_estimar(const SketchCuantil *sketch)
+{
+    double copia[5];
+
+    if (sketch->cuenta == 0)
+        return 0.0;
+    if (sketch->cuenta >= 5)
+        return sketch->altura[2];
+
+    memcpy(copia, sketch->altura, sizeof(copia));
+    return cuantil_seleccion(copia, sketch->cuenta, sketch->p);
+}
+
+/**
+ * @brief Estimadores de la primera pasada: cuartiles y mediana
+ */
+typedef struct
+{
+    SketchCuantil q1;
+    SketchCuantil mediana;
+    SketchCuantil q3;
+    int n;
+} PasadaCuartiles;
+
+/**
+ * @brief Estimador de la segunda pasada: mediana de las desviaciones
+ */
+typedef struct
+{
+    SketchCuantil desviacion;
+    double mediana;
+} PasadaDesviaciones;
+
+static void agregar_cuartiles(void *destino, double valor)
+{
+    PasadaCuartiles *p = destino;
+
+    sketch_agregar(&p->q1, valor);
+    sketch_agregar(&p->mediana, valor);
+    sketch_agregar(&p->q3, valor);
+    p->n++;
+}
+
+static void agregar_desviacion(void *destino, double valor)
+{
+    PasadaDesviaciones *p = destino;
+
+    sketch_agregar(&p->desviacion, fabs(valor - p->mediana));
+}
+
+/**
+ * @brief Cuartiles, IQR, mediana y MAD estimados en streaming
+ */
+int resumen_robusto_streaming(FuenteValores fuente, void *contexto, ResumenRobusto *resumen)
+{
+    PasadaCuartiles cuartiles;
+    PasadaDesviaciones desviaciones;
+
+    memset(resumen, 0, sizeof(*resumen));
+
+    sketch_iniciar(&cuartiles.q1, 0.25);
+    sketch_iniciar(&cuartiles.mediana, 0.5);
+    sketch_iniciar(&cuartiles.q3, 0.75);
+    cuartiles.n = 0;
+    if (!fuente(contexto, agregar_cuartiles, &cuartiles) || cuartiles.n == 0)
+        return 0;
+
+    resumen->n = cuartiles.n;
+    resumen->mediana = sketch_estimar(&cuartiles.mediana);
+    resumen->q1 = sketch_estimar(&cuartiles.q1);
+    resumen->q3 = sketch_estimar(&cuartiles.q3);
+    resumen->iqr = resumen->q3 - resumen->q1;
+
+    sketch_iniciar(&desviaciones.desviacion, 0.5);
+    desviaciones.mediana = resumen->mediana;
+    if (!fuente(contexto, agregar_desviacion, &desviaciones))
+        return 0;
+    resumen->mad = sketch_estimar(&desviaciones.desviacion);
+    return 1;
+}
+
+/**
+ * @brief Puntuacion z robusta de un valor
+ */
+double z_robusta(const ResumenRobusto *resumen, double valor)
+{
+    if (resumen->mad <= 0)
+        return 0.0;
+    return 0.6745 * (valor - resumen->mediana) / resumen->mad;
+}
+
+/**
+ * @brief Indica si un valor queda fuera de las vallas de Tukey
+ */
+int fuera_de_vallas(const ResumenRobusto *resumen, double valor)
+{
+    if (valor > resumen->q3 + TUKEY_FACTOR * resumen->iqr)
+        return 1;
+    if (valor < resumen->q1 - TUKEY_FACTOR * resumen->iqr)
+        return -1;
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file cuantiles.h
+ * @brief Cuantiles, IQR y MAD para detectar partidos atipicos
+ *
+ * SQLite no tiene PERCENTILE_CONT, asi que los cuantiles se calculan en C.
+ * Con los valores en memoria se usa seleccion en tiempo lineal (quickselect)
+ * con la misma interpolacion que PERCENTILE_CONT: el cuantil p cae en la
+ * posicion p * (n - 1) de la muestra ordenada. Cuando la muestra no cabe en
+ * memoria se recorre en streaming con el estimador P-cuadrado de Jain y
+ * Chlamtac, que guarda cinco marcadores por cuantil.
+ *
+ * Un valor es atipico por las vallas de Tukey si queda a mas de
+ * TUKEY_FACTOR * IQR fuera de los cuartiles, y por la puntuacion z robusta
+ * (Iglewicz y Hoaglin) si 0.6745 * |x - mediana| / MAD supera Z_ROBUSTA_LIMITE.
+ */
+
+#ifndef CUANTILES_H
+#define CUANTILES_H
+
+/** Multiplo del IQR que separa las vallas de Tukey de los cuartiles */
+#define TUKEY_FACTOR 1.5
+
+/** Puntuacion z robusta a partir de la cual un valor es atipico */
+#define Z_ROBUSTA_LIMITE 3.5
+
+/** Valores a partir de los cuales resumen_robusto_streaming() reemplaza a la seleccion en memoria */
+#define CUANTILES_MAX_SELECCION 8000000
+
+/**
+ * @brief Resumen robusto de una muestra
+ */
+typedef struct
+{
+    int n;              /**< Tamano de la muestra */
+    double q1;          /**< Primer cuartil */
+    double mediana;     /**< Mediana */
+    double q3;          /**< Tercer cuartil */
+    double iqr;         /**< Rango intercuartil (q3 - q1) */
+    double mad;         /**< Mediana de las desviaciones absolutas respecto de la mediana */
+    int exacto;         /**< 1 si se calculo por seleccion, 0 si es una estimacion en streaming */
+} ResumenRobusto;
+
+/**
+ * @brief Estimador P-cuadrado de un cuantil en streaming
+ *
+ * Memoria constante: cinco marcadores cuyas alturas se ajustan con una
+ * interpolacion parabolica a medida que llegan los valores. Con menos de
+ * cinco valores el resultado es exacto.
+ */
+typedef struct
+{
+    double p;               /**< Cuantil buscado (0-1) */
+    int cuenta;             /**< Valores agregados */
+    double altura[5];       /**< Alturas de los marcadores */
+    double posicion[5];     /**< Posiciones reales de los marcadores */
+    double deseada[5];      /**< Posiciones deseadas de los marcadores */
+    double incremento[5];   /**< Avance de las posiciones deseadas por valor */
+} SketchCuantil;
+
+/**
+ * @brief Cuantil de una muestra por seleccion en tiempo lineal
+ *
+ * Reordena valores parcialmente.
+ *
+ * @param valores Muestra (se reordena)
+ * @param n Tamano de la muestra, mayor que 0
+ * @param p Cuantil buscado (0-1)
+ * @return Cuantil con interpolacion lineal, como PERCENTILE_CONT
+ */
+double cuantil_seleccion(double *valores, int n, double p);
+
+/**
+ * @brief Cuartiles, IQR, mediana y MAD de una muestra en memoria
+ *
+ * Cuatro selecciones lineales; la ultima, sobre las desviaciones absolutas,
+ * sobrescribe valores.
+ *
+ * @param valores Muestra (se reordena y se sobrescribe)
+ * @param n Tamano de la muestra
+ * @param resumen Resultado
+ * @return 1 si exito, 0 si la muestra esta vacia
+ */
+int resumen_robusto(double *valores, int n, ResumenRobusto *resumen);
+
+/**
+ * @brief Funcion que entrega los valores de una muestra en streaming
+ *
+ * Se la llama una vez por pasada; debe llamar a agregar con cada valor.
+ *
+ * @param contexto Puntero pasado a resumen_robusto_streaming()
+ * @param agregar Funcion que recibe cada valor
+ * @param destino Primer argumento para agregar
+ * @return 1 si exito, 0 en caso de error
+ */
+typedef int (*FuenteValores)(void *contexto, void (*agregar)(void *destino, double valor), void *destino);
+
+/**
+ * @brief Cuartiles, IQR, mediana y MAD estimados en streaming
+ *
+ * Dos pasadas sobre la fuente: la primera estima los cuartiles y la
+ * mediana, la segunda la mediana de las desviaciones respecto de esa
+ * mediana. Memoria constante.
+ *
+ * @param fuente Funcion que recorre la muestra
+ * @param contexto Puntero para fuente
+ * @param resumen Resultado (exacto = 0)
+ * @return 1 si exito, 0 si la fuente fallo o la muestra esta vacia
+ */
+int resumen_robusto_streaming(FuenteValores fuente, void *contexto, ResumenRobusto *resumen);
+
+/**
+ * @brief Inicia un estimador P-cuadrado para el cuantil p
+ */
+void sketch_iniciar(SketchCuantil *sketch, double p);
+
+/**
+ * @brief Agrega un valor al estimador
+ */
+void sketch_agregar(SketchCuantil *sketch, double valor);
+
+/**
+ * @brief Estimacion actual del cuantil (0 si no se agrego ningun valor)
+ */
+double sketch_estimar(const SketchCuantil *sketch);
+
+/**
+ * @brief Puntuacion z robusta de un valor
+ *
+ * @return 0.6745 * (valor - mediana) / MAD, o 0 si MAD es 0
+ */
+double z_robusta(const ResumenRobusto *resumen, double valor);
+
+/**
+ * @brief Indica si un valor queda fuera de las vallas de Tukey
+ *
+ * @return 1 por encima de la valla superior, -1 por debajo de la inferior, 0 dentro
+ */
+int fuera_de_vallas(const ResumenRobusto *resumen, double valor);
+
+#endif
@@ -7,6 +7,11 @@
  */
 
 #include "db.h"
+#include "utils.h"
+#include "migraciones.h"
+#include "perfil_sql.h"
+#include "partido_store.h"
+#include "cambios.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -33,12 +38,90 @@ static char DB_DIR[1024];
 /** Ruta completa al archivo de la base de datos */
 static char DB_PATH[1024];
 
+/** Ruta indicada con db_set_ruta(); vacia para usar la ruta por defecto */
+static char DB_PATH_FORZADA[1024];
+
 /** Directorio de exportaciones */
 static char EXPORT_DIR[1024];
 
 /** Directorio de importaciones */
 static char IMPORT_DIR[1024];
 
+/**
+ * @brief Entrada de la cache de sentencias preparadas
+ */
+typedef struct
+{
+    char *sql;                 /**< Copia del texto SQL usado como clave */
+    unsigned long hash;        /**< Hash FNV-1a del texto SQL */
+    sqlite3_stmt *stmt;        /**< Sentencia compilada */
+    unsigned long ultimo_uso;  /**< Marca de reloj logico para LRU */
+    int en_uso;                /**< 1 mientras el llamador no la haya liberado */
+} EntradaCacheStmt;
+
+/** Cache de sentencias preparadas indexada por texto SQL */
+static EntradaCacheStmt stmt_cache[DB_STMT_CACHE_CAPACIDAD];
+
+/** Reloj logico que ordena los accesos a la cache */
+static unsigned long stmt_cache_reloj = 0;
+
+/**
+ * @brief Valores de pragmas que definen un perfil de ajuste
+ */
+typedef struct
+{
+    const char *nombre;
+    const char *journal_mode;
+    const char *synchronous;
+    int cache_size;            /**< Negativo: KiB, como en PRAGMA cache_size */
+    long long mmap_size;       /**< Bytes mapeados en memoria */
+    const char *temp_store;
+    int busy_timeout;          /**< Milisegundos de espera ante bloqueos */
+} PerfilConexion;
+
+/**
+ * @brief Presets de ajuste indexados por DbPerfil
+ *
+ * Ambos usan WAL para que las lecturas no bloqueen escrituras. El perfil
+ * durable sincroniza cada commit; el de maximo rendimiento deja el fsync
+ * al sistema operativo y solo debe usarse durante cargas masivas.
+ */
+static const PerfilConexion PERFILES[] =
+{
+    {"Durable", "WAL", "FULL", -16000, 64LL * 1024 * 1024, "MEMORY", 5000},
+    {"Maximo rendimiento", "WAL", "OFF", -65536, 256LL * 1024 * 1024, "MEMORY", 5000},
+};
+
+/** Tablas de entidad cuyos IDs asigna db_siguiente_id() */
+static const char *TABLAS_ID_GESTIONADO[] =
+{
+    "camiseta", "cancha", "partido", "lesion", "financiamiento", NULL
+};
+
+/** 1 si db_siguiente_id() reutiliza IDs liberados */
+static int reutilizar_ids = 1;
+
+/** Perfil aplicado actualmente a la conexion */
+static DbPerfil perfil_activo = DB_PERFIL_DURABLE;
+
+/** 1 si la conexion de trabajo es una copia en memoria del archivo */
+static int modo_memoria = 0;
+
+/** 1 si db_set_modo_memoria() pidio el modo memoria para esta sesion */
+static int modo_memoria_forzado = 0;
+
+/** sqlite3_total_changes64() en el ultimo volcado a disco */
+static sqlite3_int64 cambios_guardados = 0;
+
+/** Instante (get_time_ms) del ultimo volcado a disco */
+static double ultimo_guardado_ms = 0.0;
+
+/** Niveles de transaccion abiertos con db_begin() */
+static int transaccion_nivel = 0;
+
+/** Contadores acumulados de la cache */
+static DbCacheStats stmt_cache_stats = {0, 0, 0, 0, 0, DB_STMT_CACHE_CAPACIDAD, 0.0};
+
 /**
  * @brief Configura rutas y directorios para almacenamiento de datos
  *
@@ -99,6 +182,62 @@ static int setup_database_paths()
     return 1;
 }
 
+/**
+ * @brief Implementacion SQL de fecha_epoch(texto)
+ *
+ * Devuelve los segundos desde 1970 de una fecha "dd/mm/yyyy hh:mm",
+ * o NULL si el texto no es una fecha valida.
+ */
+static void sql_fecha_epoch(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+    long long epoch;
+    (void)argc;
+
+    if (fecha_a_epoch((const char*)sqlite3_value_text(argv[0]), &epoch))
+        sqlite3_result_int64(ctx, epoch);
+    else
+        sqlite3_result_null(ctx);
+}
+
+/**
+ * @brief Implementacion SQL de fecha_normalizada(texto)
+ *
+ * Devuelve la fecha en el formato de almacenamiento, como
+ * normalizar_fecha(), o NULL si el texto no es una fecha valida.
+ */
+static void sql_fecha_normalizada(sqlite3_context *ctx, int argc, sqlite3_value **argv)
+{
+    char fecha[20];
+    (void)argc;
+
+    if (normalizar_fecha((const char*)sqlite3_value_text(argv[0]), fecha, sizeof(fecha)))
+        sqlite3_result_text(ctx, fecha, -1, SQLITE_TRANSIENT);
+    else
+        sqlite3_result_null(ctx);
+}
+
+/**
+ * @brief Registra las funciones SQL propias de la aplicacion
+ *
+ * La migracion 4 normaliza fecha_hora con fecha_normalizada() y rellena
+ * fecha_ts con fecha_epoch(), por lo que deben existir antes de ejecutarla. Los triggers no las llaman: otros clientes
+ * de SQLite (la consola sqlite3, navegadores de bases) no las tienen.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int registrar_funciones_sql()
+{
+    if (sqlite3_create_function(db, "fecha_epoch", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+                                NULL, sql_fecha_epoch, NULL, NULL) != SQLITE_OK ||
+            sqlite3_create_function(db, "fecha_normalizada", 1, SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+                                    NULL, sql_fecha_normalizada, NULL, NULL) != SQLITE_OK)
+    {
+        printf("Error registrando funciones SQL: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    return 1;
+}
+
 /**
  * @brief Establece conexión activa con base de datos SQLite
  *
@@ -114,232 +253,320 @@ static int create_database_connection()
         printf("Error abriendo DB: %s\n", sqlite3_errmsg(db));
         return 0;
     }
+    return registrar_funciones_sql();
+}
+
+/**
+ * @brief Copia una base de datos completa con la API de backup
+ *
+ * La copia avanza en tramos de DB_PAGINAS_POR_PASO paginas para no
+ * retener el bloqueo del origen durante toda la operacion.
+ *
+ * @param destino Conexion destino (se sobrescribe su base "main")
+ * @param origen Conexion origen
+ * @return 1 si la copia termino, 0 en caso de error
+ */
+static int copiar_base(sqlite3 *destino, sqlite3 *origen)
+{
+    sqlite3_backup *backup = sqlite3_backup_init(destino, "main", origen, "main");
+    int rc;
+
+    if (!backup)
+    {
+        printf("Error iniciando copia de la base de datos: %s\n", sqlite3_errmsg(destino));
+        return 0;
+    }
+
+    do
+    {
+        rc = sqlite3_backup_step(backup, DB_PAGINAS_POR_PASO);
+        if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED)
+            sqlite3_sleep(10);
+    }
+    while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+
+    if (sqlite3_backup_finish(backup) != SQLITE_OK || rc != SQLITE_DONE)
+    {
+        printf("Error copiando la base de datos: %s\n", sqlite3_errmsg(destino));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Sustituye de forma atomica un archivo por otro
+ *
+ * @param origen Archivo nuevo (deja de existir si la operacion tiene exito)
+ * @param destino Archivo a reemplazar
+ * @return 1 si exito, 0 en caso de error
+ */
+static int reemplazar_archivo(const char *origen, const char *destino)
+{
+#ifdef _WIN32
+    if (!MoveFileExA(origen, destino, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+    {
+        printf("Error reemplazando %s (codigo %lu)\n", destino, (unsigned long)GetLastError());
+        return 0;
+    }
+#else
+    if (rename(origen, destino) != 0)
+    {
+        printf("Error reemplazando %s: %s\n", destino, strerror(errno));
+        return 0;
+    }
+#endif
     return 1;
 }
 
 /**
- * @brief Crea esquema completo de tablas si no existen
- *
- * Define estructura relacional completa incluyendo todas las entidades,
- * restricciones de integridad referencial y valores por defecto.
- *
- * @return 1 si creación exitosa, 0 en caso de error
- */
-static int create_database_schema()
-{
-    const char *sql_create =
-        "CREATE TABLE IF NOT EXISTS camiseta ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " nombre TEXT NOT NULL,"
-        " sorteada INTEGER DEFAULT 0);"
-
-        "CREATE TABLE IF NOT EXISTS cancha ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " nombre TEXT NOT NULL);"
-
-        "CREATE TABLE IF NOT EXISTS partido ("
-        " id INTEGER PRIMARY KEY,"
-        " cancha_id INTEGER NOT NULL,"
-        " fecha_hora TEXT NOT NULL,"
-        " goles INTEGER NOT NULL,"
-        " asistencias INTEGER NOT NULL,"
-        " camiseta_id INTEGER NOT NULL,"
-        " FOREIGN KEY(cancha_id) REFERENCES cancha(id),"
-        " FOREIGN KEY(camiseta_id) REFERENCES camiseta(id));"
-
-        "CREATE TABLE IF NOT EXISTS lesion ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " jugador TEXT NOT NULL,"
-        " tipo TEXT NOT NULL,"
-        " descripcion TEXT NOT NULL,"
-        " fecha TEXT NOT NULL,"
-        " camiseta_id INTEGER NOT NULL,"
-        " FOREIGN KEY(camiseta_id) REFERENCES camiseta(id));"
-
-        "CREATE TABLE IF NOT EXISTS usuario ("
-        " id INTEGER PRIMARY KEY,"
-        " nombre TEXT NOT NULL);"
-
-        "CREATE TABLE IF NOT EXISTS equipo ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " nombre TEXT NOT NULL,"
-        " tipo INTEGER NOT NULL,"
-        " tipo_futbol INTEGER NOT NULL,"
-        " num_jugadores INTEGER NOT NULL,"
-        " partido_id INTEGER DEFAULT -1);"
-
-        "CREATE TABLE IF NOT EXISTS jugador ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " equipo_id INTEGER NOT NULL,"
-        " nombre TEXT NOT NULL,"
-        " numero INTEGER NOT NULL,"
-        " posicion INTEGER NOT NULL,"
-        " es_capitan INTEGER NOT NULL,"
-        " FOREIGN KEY(equipo_id) REFERENCES equipo(id));"
-
-        "CREATE TABLE IF NOT EXISTS torneo ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " nombre TEXT NOT NULL,"
-        " tiene_equipo_fijo INTEGER NOT NULL,"
-        " equipo_fijo_id INTEGER DEFAULT -1,"
-        " cantidad_equipos INTEGER NOT NULL,"
-        " tipo_torneo INTEGER NOT NULL,"
-        " formato_torneo INTEGER NOT NULL,"
-        " fase_actual TEXT DEFAULT 'Fase de Grupos');"
-
-        "CREATE TABLE IF NOT EXISTS equipo_torneo ("
-        " torneo_id INTEGER NOT NULL,"
-        " equipo_id INTEGER NOT NULL,"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
-        " FOREIGN KEY(equipo_id) REFERENCES equipo(id),"
-        " PRIMARY KEY(torneo_id, equipo_id));"
-
-        "CREATE TABLE IF NOT EXISTS partido_torneo ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " torneo_id INTEGER NOT NULL,"
-        " equipo1_id INTEGER NOT NULL,"
-        " equipo2_id INTEGER NOT NULL,"
-        " fecha TEXT,"
-        " goles_equipo1 INTEGER DEFAULT 0,"
-        " goles_equipo2 INTEGER DEFAULT 0,"
-        " estado TEXT,"
-        " fase TEXT DEFAULT 'Fase de Grupos',"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
-        " FOREIGN KEY(equipo1_id) REFERENCES equipo(id),"
-        " FOREIGN KEY(equipo2_id) REFERENCES equipo(id));"
-
-        "CREATE TABLE IF NOT EXISTS equipo_torneo_estadisticas ("
-        " torneo_id INTEGER NOT NULL,"
-        " equipo_id INTEGER NOT NULL,"
-        " partidos_jugados INTEGER DEFAULT 0,"
-        " partidos_ganados INTEGER DEFAULT 0,"
-        " partidos_empatados INTEGER DEFAULT 0,"
-        " partidos_perdidos INTEGER DEFAULT 0,"
-        " goles_favor INTEGER DEFAULT 0,"
-        " goles_contra INTEGER DEFAULT 0,"
-        " puntos INTEGER DEFAULT 0,"
-        " estado TEXT DEFAULT 'Activo',"
-        " PRIMARY KEY(torneo_id, equipo_id),"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
-        " FOREIGN KEY(equipo_id) REFERENCES equipo(id));"
-
-        "CREATE TABLE IF NOT EXISTS jugador_estadisticas ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " jugador_id INTEGER NOT NULL,"
-        " torneo_id INTEGER NOT NULL,"
-        " equipo_id INTEGER NOT NULL,"
-        " goles INTEGER DEFAULT 0,"
-        " asistencias INTEGER DEFAULT 0,"
-        " tarjetas_amarillas INTEGER DEFAULT 0,"
-        " tarjetas_rojas INTEGER DEFAULT 0,"
-        " minutos_jugados INTEGER DEFAULT 0,"
-        " FOREIGN KEY(jugador_id) REFERENCES jugador(id),"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
-        " FOREIGN KEY(equipo_id) REFERENCES equipo(id));"
-
-        "CREATE TABLE IF NOT EXISTS equipo_historial ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " equipo_id INTEGER NOT NULL,"
-        " torneo_id INTEGER NOT NULL,"
-        " posicion_final INTEGER,"
-        " partidos_jugados INTEGER DEFAULT 0,"
-        " partidos_ganados INTEGER DEFAULT 0,"
-        " partidos_empatados INTEGER DEFAULT 0,"
-        " partidos_perdidos INTEGER DEFAULT 0,"
-        " goles_favor INTEGER DEFAULT 0,"
-        " goles_contra INTEGER DEFAULT 0,"
-        " mejor_goleador TEXT,"
-        " goles_mejor_goleador INTEGER DEFAULT 0,"
-        " fecha_inicio TEXT,"
-        " fecha_fin TEXT,"
-        " FOREIGN KEY(equipo_id) REFERENCES equipo(id),"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id));"
-
-        "CREATE TABLE IF NOT EXISTS torneo_fases ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " torneo_id INTEGER NOT NULL,"
-        " nombre_fase TEXT NOT NULL,"
-        " descripcion TEXT,"
-        " orden INTEGER NOT NULL,"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id));"
-
-        "CREATE TABLE IF NOT EXISTS equipo_fase ("
-        " torneo_id INTEGER NOT NULL,"
-        " equipo_id INTEGER NOT NULL,"
-        " fase_id INTEGER NOT NULL,"
-        " grupo TEXT,"
-        " posicion_en_grupo INTEGER DEFAULT 0,"
-        " clasificado INTEGER DEFAULT 0,"
-        " eliminado INTEGER DEFAULT 0,"
-        " PRIMARY KEY(torneo_id, equipo_id, fase_id),"
-        " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
-        " FOREIGN KEY(equipo_id) REFERENCES equipo(id),"
-        " FOREIGN KEY(fase_id) REFERENCES torneo_fases(id));"
-
-        "CREATE TABLE IF NOT EXISTS settings ("
-        " id INTEGER PRIMARY KEY,"
-        " theme INTEGER DEFAULT 0,"
-        " language INTEGER DEFAULT 0);"
-
-        "CREATE TABLE IF NOT EXISTS financiamiento ("
-        " id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        " fecha TEXT NOT NULL,"
-        " tipo INTEGER NOT NULL,"
-        " categoria INTEGER NOT NULL,"
-        " descripcion TEXT NOT NULL,"
-        " monto REAL NOT NULL,"
-        " item_especifico TEXT);";
-
-    if (sqlite3_exec(db, sql_create, 0, 0, 0) != SQLITE_OK)
-    {
-        printf("Error creando tablas\n");
+ * @brief Sustituye la conexion al archivo por una copia en memoria
+ *
+ * La conexion al archivo se cierra despues de copiar, lo que vacia su WAL;
+ * a partir de aqui el archivo solo se modifica al volcar con db_guardar().
+ *
+ * @return 1 si exito, 0 si se sigue trabajando sobre el archivo
+ */
+static int cargar_en_memoria()
+{
+    sqlite3 *memoria;
+    double inicio = get_time_ms();
+
+    if (sqlite3_open(":memory:", &memoria) != SQLITE_OK)
+    {
+        printf("Error abriendo base de datos en memoria: %s\n", sqlite3_errmsg(memoria));
+        sqlite3_close(memoria);
+        return 0;
+    }
+    if (!copiar_base(memoria, db))
+    {
+        sqlite3_close(memoria);
         return 0;
     }
+
+    db_cache_clear();
+    sqlite3_close(db);
+    db = memoria;
+    if (!registrar_funciones_sql())
+        return 0;
+
+    modo_memoria = 1;
+    cambios_guardados = sqlite3_total_changes64(db);
+    ultimo_guardado_ms = get_time_ms();
+    printf("Base de datos cargada en memoria en %.1f ms\n", ultimo_guardado_ms - inicio);
     return 1;
 }
 
 /**
- * @brief Agrega columnas faltantes por evolución del esquema
+ * @brief Carga las preferencias que afectan a la capa de datos
  *
- * Ejecuta sentencias ALTER TABLE para añadir campos nuevos sin
- * afectar datos existentes, ignorando errores de columnas duplicadas.
+ * Lee de la configuracion el perfil de ajuste de la conexion, la politica
+ * de reutilizacion de IDs y el modo memoria. Si corresponde pasa a
+ * trabajar en memoria y despues aplica el perfil a la conexion resultante.
  */
-static void add_missing_columns()
+static void cargar_preferencias_db()
 {
-    const char *alter_statements[] =
+    sqlite3_stmt *stmt;
+    DbPerfil perfil = DB_PERFIL_DURABLE;
+    int memoria = modo_memoria_forzado;
+
+    if (sqlite3_prepare_v2(db, "SELECT perfil_db, reutilizar_ids, modo_memoria FROM settings WHERE id = 1;", -1, &stmt, NULL) == SQLITE_OK)
     {
-        "ALTER TABLE camiseta ADD COLUMN sorteada INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN resultado INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN clima INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN dia INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN rendimiento_general INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN cansancio INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN estado_animo INTEGER DEFAULT 0;",
-        "ALTER TABLE partido ADD COLUMN comentario_personal TEXT DEFAULT '';",
-        "ALTER TABLE lesion ADD COLUMN partido_id INTEGER DEFAULT NULL;",
-        NULL
-    };
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            if (sqlite3_column_int(stmt, 0) == DB_PERFIL_MAX_RENDIMIENTO)
+                perfil = DB_PERFIL_MAX_RENDIMIENTO;
+            reutilizar_ids = sqlite3_column_int(stmt, 1) != 0;
+            memoria = memoria || sqlite3_column_int(stmt, 2) != 0;
+        }
+        sqlite3_finalize(stmt);
+    }
+
+    if (memoria)
+        cargar_en_memoria();
+    db_aplicar_perfil(perfil);
+}
+
+/**
+ * @brief Sustituye la ruta del archivo de base de datos
+ *
+ * Debe llamarse antes de db_init(). Los directorios de importacion y
+ * exportacion no cambian.
+ *
+ * @param ruta Ruta del archivo; NULL o cadena vacia restaura la ruta por defecto
+ */
+void db_set_ruta(const char *ruta)
+{
+    DB_PATH_FORZADA[0] = '\0';
+    if (ruta)
+        snprintf(DB_PATH_FORZADA, sizeof(DB_PATH_FORZADA), "%s", ruta);
+}
 
-    for (int i = 0; alter_statements[i] != NULL; i++)
+/**
+ * @brief Devuelve la ruta del archivo de la base de trabajo
+ *
+ * En modo memoria es el archivo al que se vuelcan los cambios.
+ */
+const char* db_get_ruta()
+{
+    return DB_PATH;
+}
+
+/**
+ * @brief Pide trabajar sobre una copia en memoria durante esta sesion
+ *
+ * Debe llamarse antes de db_init(). Es independiente de la preferencia
+ * guardada en settings: basta con que una de las dos lo active.
+ *
+ * @param activo 1 para activar
+ */
+void db_set_modo_memoria(int activo)
+{
+    modo_memoria_forzado = activo ? 1 : 0;
+}
+
+/**
+ * @brief Indica si la conexion de trabajo esta en memoria
+ *
+ * @return 1 si la sesion trabaja en memoria, 0 en caso contrario
+ */
+int db_en_memoria()
+{
+    return modo_memoria;
+}
+
+/**
+ * @brief Indica si hay cambios en memoria que aun no se volcaron a disco
+ *
+ * @return 1 si hay cambios pendientes, 0 en caso contrario
+ */
+int db_cambios_pendientes()
+{
+    return modo_memoria && sqlite3_total_changes64(db) != cambios_guardados;
+}
+
+/**
+ * @brief Vuelca la base en memoria al archivo de forma segura ante fallos
+ *
+ * La copia se escribe en un archivo temporal junto al original, con
+ * synchronous=FULL, y solo cuando esta completa se renombra sobre el
+ * archivo de la base. Si el proceso se interrumpe a mitad, el archivo
+ * original queda intacto.
+ *
+ * @return 1 si exito o si no hay nada que guardar, 0 en caso de error
+ */
+int db_guardar()
+{
+    char temporal[sizeof(DB_PATH) + 8];
+    sqlite3 *archivo;
+    int ok;
+
+    if (!modo_memoria || !db_cambios_pendientes())
+        return 1;
+
+    snprintf(temporal, sizeof(temporal), "%s.tmp", DB_PATH);
+    remove(temporal);
+
+    if (sqlite3_open(temporal, &archivo) != SQLITE_OK)
+    {
+        printf("Error creando %s: %s\n", temporal, sqlite3_errmsg(archivo));
+        sqlite3_close(archivo);
+        return 0;
+    }
+    sqlite3_exec(archivo, "PRAGMA synchronous=FULL;", NULL, NULL, NULL);
+
+    ok = copiar_base(archivo, db);
+    if (sqlite3_close(archivo) != SQLITE_OK)
+        ok = 0;
+
+    if (ok)
+        ok = reemplazar_archivo(temporal, DB_PATH);
+    if (!ok)
+    {
+        remove(temporal);
+        return 0;
+    }
+
+    cambios_guardados = sqlite3_total_changes64(db);
+    ultimo_guardado_ms = get_time_ms();
+    return 1;
+}
+
+/**
+ * @brief Vuelca a disco si hay cambios y vencio el intervalo de guardado
+ *
+ * Se invoca en cada vuelta de los menus; en modo archivo no hace nada.
+ */
+void db_guardado_periodico()
+{
+    if (transaccion_nivel > 0 || !db_cambios_pendientes())
+        return;
+    if (get_time_ms() - ultimo_guardado_ms < DB_INTERVALO_GUARDADO_MS)
+        return;
+    if (!db_guardar())
+        printf("No se pudo guardar la base de datos en disco; se reintentara.\n");
+}
+
+/**
+ * @brief Reemplaza el contenido de la base de trabajo por el de otro archivo
+ *
+ * Copia el archivo sobre la conexion abierta con la API de backup, de modo
+ * que el resto de la aplicacion sigue usando el mismo puntero db. Despues
+ * aplica las migraciones pendientes por si el archivo tiene un esquema
+ * anterior. En modo memoria el resultado queda pendiente de volcado.
+ *
+ * @param ruta Archivo SQLite de origen
+ * @return 1 si exito, 0 en caso de error
+ */
+int db_restaurar_desde(const char *ruta)
+{
+    sqlite3 *origen;
+    int ok;
+
+    if (transaccion_nivel > 0)
+    {
+        printf("No se puede restaurar con una transaccion en curso.\n");
+        return 0;
+    }
+    if (sqlite3_open_v2(ruta, &origen, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
     {
-        sqlite3_exec(db, alter_statements[i], 0, 0, 0); // Ignore errors if column already exists
+        printf("Error abriendo %s: %s\n", ruta, sqlite3_errmsg(origen));
+        sqlite3_close(origen);
+        return 0;
     }
+
+    db_cache_clear();
+    ok = copiar_base(db, origen);
+    sqlite3_close(origen);
+    // La API de backup no pasa por el update hook
+    partido_store_invalidar();
+    if (!ok)
+        return 0;
+
+    if (!migraciones_aplicar())
+        return 0;
+
+    // La copia no cuenta como cambios: forzar el siguiente volcado
+    if (modo_memoria)
+        cambios_guardados = -1;
+    return 1;
 }
 
 /**
  * @brief Inicializa el entorno completo de persistencia de datos
  *
  * Orquesta configuración de rutas, conexión a base de datos,
- * creación de esquema y preparación de directorios auxiliares.
+ * migraciones de esquema pendientes y preparación de directorios auxiliares.
  *
  * @return 1 si inicialización completa exitosa, 0 en caso de error
  */
 int db_init()
 {
     if (!setup_database_paths()) return 0;
+    if (DB_PATH_FORZADA[0])
+        strcpy(DB_PATH, DB_PATH_FORZADA);
     if (!create_database_connection()) return 0;
-    if (!create_database_schema()) return 0;
-    add_missing_columns();
+    if (!migraciones_aplicar()) return 0;
+    cargar_preferencias_db();
 
     // Crear directorios de importación y exportación al iniciar
     get_import_dir();
@@ -356,8 +583,441 @@ int db_init()
  */
 void db_close()
 {
+    while (transaccion_nivel > 0)
+        db_rollback();
+
+    // Antes del volcado, para que el modo memoria no guarde lo ya procesado
+    if (db)
+        cambios_purgar();
+
+    if (modo_memoria && !db_guardar())
+        printf("Error guardando la base de datos en disco; los ultimos cambios se perdieron.\n");
+    modo_memoria = 0;
+
+    db_cache_clear();
+    partido_store_liberar();
     if (db)
         sqlite3_close(db);
+    db = NULL;
+    perfil_sql_finalizar();
+}
+
+/**
+ * @brief Ejecuta una orden de savepoint sobre el nivel indicado
+ *
+ * @param orden Texto SQL con un %d para el numero de nivel
+ * @param nivel Nivel de anidamiento (desde 1)
+ * @return 1 si exito, 0 en caso de error
+ */
+static int ejecutar_savepoint(const char *orden, int nivel)
+{
+    char sql[96];
+    char *err = NULL;
+
+    snprintf(sql, sizeof(sql), orden, nivel, nivel);
+    if (sqlite3_exec(db, sql, 0, 0, &err) != SQLITE_OK)
+    {
+        printf("Error en transaccion (%s): %s\n", sql, err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Abre un nivel de transaccion
+ *
+ * Cada llamada crea un SAVEPOINT propio. El mas externo inicia la
+ * transaccion real y los internos pueden deshacerse por separado, asi
+ * una funcion transaccional puede llamar a otra sin coordinarse con ella.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+int db_begin()
+{
+    if (!ejecutar_savepoint("SAVEPOINT nivel_%d;", transaccion_nivel + 1))
+        return 0;
+    transaccion_nivel++;
+    return 1;
+}
+
+/**
+ * @brief Confirma el nivel de transaccion mas interno
+ *
+ * Liberar el nivel mas externo escribe la transaccion en disco con una
+ * sola sincronizacion. Si falla, el nivel sigue abierto y el llamador
+ * debe deshacerlo con db_rollback().
+ *
+ * @return 1 si exito, 0 en caso de error o si no habia transaccion
+ */
+int db_commit()
+{
+    if (transaccion_nivel == 0)
+        return 0;
+    if (!ejecutar_savepoint("RELEASE nivel_%d;", transaccion_nivel))
+        return 0;
+    transaccion_nivel--;
+    return 1;
+}
+
+/**
+ * @brief Deshace y cierra el nivel de transaccion mas interno
+ *
+ * Los cambios de los niveles exteriores se conservan. Si SQLite ya
+ * revirtio la transaccion completa por un error grave, solo se
+ * reinicia el contador de niveles.
+ *
+ * @return 1 si exito, 0 en caso de error o si no habia transaccion
+ */
+int db_rollback()
+{
+    int ok;
+
+    if (transaccion_nivel == 0)
+        return 0;
+    if (sqlite3_get_autocommit(db))
+    {
+        transaccion_nivel = 0;
+        return 1;
+    }
+    ok = ejecutar_savepoint("ROLLBACK TO nivel_%d; RELEASE nivel_%d;", transaccion_nivel);
+    transaccion_nivel--;
+    return ok;
+}
+
+int db_transaccion_nivel()
+{
+    return transaccion_nivel;
+}
+
+/**
+ * @brief Calcula el hash FNV-1a de un texto SQL
+ *
+ * @param sql Texto SQL
+ * @return Hash de 32 bits del texto
+ */
+static unsigned long hash_sql(const char *sql)
+{
+    unsigned long h = 2166136261UL;
+    while (*sql)
+    {
+        h ^= (unsigned char)*sql++;
+        h = (h * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return h;
+}
+
+/**
+ * @brief Libera una entrada de la cache finalizando su sentencia
+ *
+ * @param e Entrada a vaciar
+ */
+static void vaciar_entrada_cache(EntradaCacheStmt *e)
+{
+    if (e->stmt)
+    {
+        sqlite3_finalize(e->stmt);
+        stmt_cache_stats.entradas--;
+    }
+    free(e->sql);
+    memset(e, 0, sizeof(*e));
+}
+
+/**
+ * @brief Entrega una sentencia preparada reutilizada o recien compilada
+ *
+ * Las consultas que se ejecutan repetidamente (bucles de importacion,
+ * calculo de logros, cabeceras de pantalla) dejan de pagar la compilacion
+ * SQL en cada llamada.
+ *
+ * @param sql Texto SQL de la sentencia
+ * @return Sentencia lista para usar, NULL si hubo error de compilacion
+ */
+sqlite3_stmt* db_prepare_cached(const char *sql)
+{
+    unsigned long h;
+    int libre = -1;
+    int victima = -1;
+    int ocupada = 0;
+    sqlite3_stmt *stmt = NULL;
+    double inicio;
+
+    if (!db || !sql)
+        return NULL;
+
+    h = hash_sql(sql);
+    for (int i = 0; i < DB_STMT_CACHE_CAPACIDAD; i++)
+    {
+        EntradaCacheStmt *e = &stmt_cache[i];
+        if (!e->stmt)
+        {
+            if (libre < 0)
+                libre = i;
+            continue;
+        }
+        if (e->hash == h && strcmp(e->sql, sql) == 0)
+        {
+            if (!e->en_uso)
+            {
+                e->en_uso = 1;
+                e->ultimo_uso = ++stmt_cache_reloj;
+                stmt_cache_stats.aciertos++;
+                sqlite3_reset(e->stmt);
+                sqlite3_clear_bindings(e->stmt);
+                return e->stmt;
+            }
+            ocupada = 1;
+        }
+        else if (!e->en_uso && (victima < 0 || e->ultimo_uso < stmt_cache[victima].ultimo_uso))
+        {
+            victima = i;
+        }
+    }
+
+    inicio = get_time_ms();
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    {
+        sqlite3_finalize(stmt);
+        return NULL;
+    }
+    stmt_cache_stats.ms_compilacion += get_time_ms() - inicio;
+    stmt_cache_stats.fallos++;
+
+    // Una misma consulta anidada consigo misma no puede compartir la entrada
+    if (ocupada || (libre < 0 && victima < 0))
+    {
+        stmt_cache_stats.sin_cache++;
+        return stmt;
+    }
+
+    if (libre < 0)
+    {
+        vaciar_entrada_cache(&stmt_cache[victima]);
+        stmt_cache_stats.desalojos++;
+        libre = victima;
+    }
+
+    EntradaCacheStmt *nueva = &stmt_cache[libre];
+    nueva->sql = STRDUP(sql);
+    if (!nueva->sql)
+    {
+        stmt_cache_stats.sin_cache++;
+        return stmt;
+    }
+    nueva->hash = h;
+    nueva->stmt = stmt;
+    nueva->en_uso = 1;
+    nueva->ultimo_uso = ++stmt_cache_reloj;
+    stmt_cache_stats.entradas++;
+    return stmt;
+}
+
+/**
+ * @brief Devuelve una sentencia a la cache para su reutilizacion
+ *
+ * Reiniciar al liberar evita que una sentencia de lectura mantenga
+ * abierta una transaccion implicita mientras espera en la cache.
+ *
+ * @param stmt Sentencia obtenida con db_prepare_cached()
+ */
+void db_release_cached(sqlite3_stmt *stmt)
+{
+    if (!stmt)
+        return;
+
+    for (int i = 0; i < DB_STMT_CACHE_CAPACIDAD; i++)
+    {
+        if (stmt_cache[i].stmt == stmt)
+        {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+            stmt_cache[i].en_uso = 0;
+            return;
+        }
+    }
+    sqlite3_finalize(stmt);
+}
+
+/**
+ * @brief Vacia la cache finalizando todas las sentencias retenidas
+ *
+ * sqlite3_close() falla con SQLITE_BUSY si quedan sentencias sin finalizar,
+ * por eso se invoca antes de cerrar la conexion.
+ */
+void db_cache_clear()
+{
+    for (int i = 0; i < DB_STMT_CACHE_CAPACIDAD; i++)
+    {
+        if (stmt_cache[i].stmt || stmt_cache[i].sql)
+            vaciar_entrada_cache(&stmt_cache[i]);
+    }
+}
+
+/**
+ * @brief Expone los contadores de la cache para diagnostico
+ *
+ * @param stats Estructura destino
+ */
+void db_cache_stats(DbCacheStats *stats)
+{
+    if (stats)
+        *stats = stmt_cache_stats;
+}
+
+/**
+ * @brief Ajusta la conexion con los pragmas del perfil indicado
+ *
+ * journal_mode no puede cambiarse dentro de una transaccion, por lo que
+ * esta funcion debe llamarse fuera de ellas.
+ *
+ * @param perfil Perfil a aplicar
+ * @return 1 si exito, 0 si algun pragma fallo
+ */
+int db_aplicar_perfil(DbPerfil perfil)
+{
+    const PerfilConexion *p;
+    char sql[512];
+    char *err = NULL;
+
+    if (perfil != DB_PERFIL_DURABLE && perfil != DB_PERFIL_MAX_RENDIMIENTO)
+        perfil = DB_PERFIL_DURABLE;
+    p = &PERFILES[perfil];
+
+    snprintf(sql, sizeof(sql),
+             "PRAGMA journal_mode = %s;"
+             "PRAGMA synchronous = %s;"
+             "PRAGMA cache_size = %d;"
+             "PRAGMA mmap_size = %lld;"
+             "PRAGMA temp_store = %s;"
+             "PRAGMA busy_timeout = %d;",
+             p->journal_mode, p->synchronous, p->cache_size,
+             p->mmap_size, p->temp_store, p->busy_timeout);
+
+    if (sqlite3_exec(db, sql, 0, 0, &err) != SQLITE_OK)
+    {
+        printf("Error aplicando perfil %s: %s\n", p->nombre, err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return 0;
+    }
+
+    perfil_activo = perfil;
+    return 1;
+}
+
+DbPerfil db_perfil_actual()
+{
+    return perfil_activo;
+}
+
+const char* db_perfil_nombre(DbPerfil perfil)
+{
+    if (perfil != DB_PERFIL_DURABLE && perfil != DB_PERFIL_MAX_RENDIMIENTO)
+        return "Desconocido";
+    return PERFILES[perfil].nombre;
+}
+
+const char* db_tabla_id_gestionado(int indice)
+{
+    if (indice < 0 || indice >= (int)(sizeof(TABLAS_ID_GESTIONADO) / sizeof(TABLAS_ID_GESTIONADO[0])))
+        return NULL;
+    return TABLAS_ID_GESTIONADO[indice];
+}
+
+void db_set_reutilizar_ids(int activar)
+{
+    reutilizar_ids = activar ? 1 : 0;
+}
+
+/**
+ * @brief Servicio unico de asignacion de IDs para tablas de entidad
+ *
+ * Sustituye las busquedas de huecos por CTE recursivos o auto-uniones,
+ * cuyo coste crecia con el tamano de la tabla. Los triggers de la tabla
+ * id_libre anotan los IDs borrados y retiran los reutilizados.
+ *
+ * @param tabla Tabla de entidad
+ * @return ID a usar, 0 en caso de error
+ */
+int db_siguiente_id(const char *tabla)
+{
+    sqlite3_stmt *stmt;
+    char sql[128];
+    int id = 0;
+    int gestionada = 0;
+
+    for (int i = 0; TABLAS_ID_GESTIONADO[i] != NULL; i++)
+    {
+        if (tabla && strcmp(tabla, TABLAS_ID_GESTIONADO[i]) == 0)
+        {
+            gestionada = 1;
+            break;
+        }
+    }
+    if (!gestionada)
+    {
+        printf("Tabla sin asignacion de IDs gestionada: %s\n", tabla ? tabla : "(null)");
+        return 0;
+    }
+
+    if (reutilizar_ids)
+    {
+        stmt = db_prepare_cached("SELECT id FROM id_libre WHERE tabla = ? ORDER BY id LIMIT 1;");
+        if (stmt)
+        {
+            sqlite3_bind_text(stmt, 1, tabla, -1, SQLITE_STATIC);
+            if (sqlite3_step(stmt) == SQLITE_ROW)
+                id = sqlite3_column_int(stmt, 0);
+            db_release_cached(stmt);
+        }
+        if (id > 0)
+            return id;
+    }
+
+    snprintf(sql, sizeof(sql), "SELECT COALESCE(MAX(id), 0) + 1 FROM %s;", tabla);
+    stmt = db_prepare_cached(sql);
+    if (stmt)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            id = sqlite3_column_int(stmt, 0);
+        db_release_cached(stmt);
+    }
+    return id;
+}
+
+/**
+ * @brief Imprime el valor efectivo de un pragma
+ *
+ * @param pragma Nombre del pragma
+ */
+static void mostrar_pragma(const char *pragma)
+{
+    sqlite3_stmt *stmt;
+    char sql[64];
+
+    snprintf(sql, sizeof(sql), "PRAGMA %s;", pragma);
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            printf("%-14s: %s\n", pragma, (const char*)sqlite3_column_text(stmt, 0));
+        sqlite3_finalize(stmt);
+    }
+}
+
+void db_mostrar_pragmas()
+{
+    printf("Perfil activo : %s\n", db_perfil_nombre(perfil_activo));
+    if (modo_memoria)
+        printf("Modo memoria  : activo (%s, ultimo guardado hace %.0f s)\n",
+               db_cambios_pendientes() ? "cambios pendientes" : "sin cambios pendientes",
+               (get_time_ms() - ultimo_guardado_ms) / 1000.0);
+    else
+        printf("Modo memoria  : inactivo\n");
+    mostrar_pragma("journal_mode");
+    mostrar_pragma("synchronous");
+    mostrar_pragma("cache_size");
+    mostrar_pragma("mmap_size");
+    mostrar_pragma("temp_store");
+    mostrar_pragma("busy_timeout");
 }
 
 /**
@@ -370,11 +1030,10 @@ void db_close()
  */
 char* get_user_name()
 {
-    sqlite3_stmt *stmt;
-    const char *sql = "SELECT nombre FROM usuario LIMIT 1;";
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT nombre FROM usuario LIMIT 1;");
     char *nombre = NULL;
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK)
+    if (stmt)
     {
         if (sqlite3_step(stmt) == SQLITE_ROW)
         {
@@ -384,7 +1043,7 @@ char* get_user_name()
                 nombre = STRDUP(temp);
             }
         }
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
     }
 
     return nombre;
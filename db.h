@@ -5,11 +5,49 @@
  * Define interfaz para operaciones de base de datos utilizando motor SQLite3,
  * implementando patrón Singleton para conexión global, configuración automática
  * de esquema relacional y gestión de directorios específicos del sistema operativo.
- * Soporta evolución de esquema mediante ALTER TABLE dinámicos.
+ * Soporta evolución de esquema mediante migraciones versionadas (PRAGMA user_version).
  */
 
+#ifndef DB_H
+#define DB_H
+
 #include "sqlite3.h"
 
+/**
+ * @brief Perfiles de ajuste de la conexion SQLite
+ */
+typedef enum
+{
+    DB_PERFIL_DURABLE = 0,          /**< Uso normal: WAL con sincronizacion completa */
+    DB_PERFIL_MAX_RENDIMIENTO = 1   /**< Cargas masivas: sin fsync y caches grandes */
+} DbPerfil;
+
+/** Numero maximo de sentencias preparadas retenidas en la cache */
+#define DB_STMT_CACHE_CAPACIDAD 128
+
+/** Paginas copiadas por cada paso de sqlite3_backup_step() */
+#define DB_PAGINAS_POR_PASO 1024
+
+/** Intervalo minimo entre volcados automaticos a disco en modo memoria */
+#define DB_INTERVALO_GUARDADO_MS 60000.0
+
+/**
+ * @brief Contadores de uso de la cache de sentencias preparadas
+ *
+ * Permite cuantificar cuanto tiempo de compilacion SQL se ahorra
+ * reutilizando sentencias en lugar de prepararlas en cada llamada.
+ */
+typedef struct
+{
+    unsigned long aciertos;      /**< Sentencias servidas desde la cache */
+    unsigned long fallos;        /**< Sentencias que hubo que compilar */
+    unsigned long desalojos;     /**< Entradas expulsadas por politica LRU */
+    unsigned long sin_cache;     /**< Sentencias entregadas fuera de la cache (todas ocupadas) */
+    int entradas;                /**< Entradas actualmente ocupadas */
+    int capacidad;               /**< Tamano maximo de la cache */
+    double ms_compilacion;       /**< Tiempo total invertido compilando en los fallos */
+} DbCacheStats;
+
 /**
  * @brief Instancia global de conexión SQLite3
  *
@@ -23,18 +61,80 @@ extern sqlite3 *db;
  * @brief Inicializa infraestructura completa de persistencia
  *
  * Ejecuta secuencia de configuración: rutas del SO, conexión SQLite,
- * creación de esquema relacional completo, adición de columnas faltantes
+ * migraciones de esquema pendientes segun PRAGMA user_version
  * y preparación de directorios auxiliares para import/export.
  *
  * @return 1 si configuración completa exitosa, 0 en caso de error crítico
  */
 int db_init();
 
+/**
+ * @brief Usa otro archivo de base de datos en lugar del predeterminado
+ *
+ * Debe llamarse antes de db_init(). Permite, por ejemplo, generar datos
+ * sinteticos en una base aparte sin tocar la del usuario.
+ *
+ * @param ruta Ruta del archivo; NULL o cadena vacia restaura la ruta por defecto
+ */
+void db_set_ruta(const char *ruta);
+
+/**
+ * @brief Devuelve la ruta del archivo de la base de trabajo
+ *
+ * Solo es valida despues de db_init().
+ *
+ * @return Ruta del archivo (en modo memoria, el destino de los volcados)
+ */
+const char* db_get_ruta();
+
+/**
+ * @brief Trabaja sobre una copia en memoria de la base durante esta sesion
+ *
+ * Debe llamarse antes de db_init(). La preferencia modo_memoria de
+ * settings tambien lo activa. Los cambios se vuelcan al archivo con
+ * db_guardar(), periodicamente desde los menus y al cerrar.
+ *
+ * @param activo 1 para activar
+ */
+void db_set_modo_memoria(int activo);
+
+/**
+ * @brief Indica si la sesion trabaja sobre una copia en memoria
+ *
+ * @return 1 si esta en memoria, 0 si trabaja sobre el archivo
+ */
+int db_en_memoria();
+
+/**
+ * @brief Indica si hay cambios en memoria sin volcar al archivo
+ *
+ * @return 1 si hay cambios pendientes, 0 en caso contrario
+ */
+int db_cambios_pendientes();
+
+/**
+ * @brief Vuelca la copia en memoria al archivo
+ *
+ * Escribe un archivo temporal completo y lo renombra de forma atomica
+ * sobre el archivo de la base, de modo que una interrupcion nunca deja
+ * el archivo a medio escribir. No hace nada fuera del modo memoria o si
+ * no hay cambios.
+ *
+ * @return 1 si exito o sin cambios, 0 en caso de error
+ */
+int db_guardar();
+
+/**
+ * @brief Vuelca a disco si vencio DB_INTERVALO_GUARDADO_MS y hay cambios
+ */
+void db_guardado_periodico();
+
 /**
  * @brief Finaliza conexión y libera recursos del motor SQLite
  *
  * Cierra handle de base de datos de manera ordenada, asegurando
  * commit de transacciones pendientes y liberación de memoria.
+ * En modo memoria vuelca antes los cambios al archivo.
  */
 void db_close();
 
@@ -90,3 +190,152 @@ const char* get_export_dir();
  * @return Puntero constante a string con path del directorio de importaciones
  */
 const char* get_import_dir();
+
+/**
+ * @brief Reemplaza el contenido de la base de trabajo por el de otro archivo
+ *
+ * Pensado para restaurar respaldos: la conexion global se conserva, se
+ * aplican las migraciones pendientes y en modo memoria el resultado queda
+ * marcado para el siguiente volcado.
+ *
+ * @param ruta Archivo SQLite de origen
+ * @return 1 si exito, 0 en caso de error
+ */
+int db_restaurar_desde(const char *ruta);
+
+/**
+ * @brief Abre un nivel de transaccion anidable (SAVEPOINT)
+ *
+ * Las operaciones que modifican varias filas o tablas se agrupan entre
+ * db_begin() y db_commit() para aplicarse de forma atomica y con una sola
+ * escritura a disco. Las llamadas pueden anidarse.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+int db_begin();
+
+/**
+ * @brief Confirma el nivel abierto por el ultimo db_begin()
+ *
+ * @return 1 si exito, 0 en caso de error (el nivel queda abierto)
+ */
+int db_commit();
+
+/**
+ * @brief Deshace los cambios del nivel abierto por el ultimo db_begin()
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+int db_rollback();
+
+/**
+ * @brief Numero de niveles de transaccion abiertos
+ *
+ * @return 0 si no hay transaccion en curso
+ */
+int db_transaccion_nivel();
+
+/**
+ * @brief Obtiene una sentencia preparada reutilizable para el SQL dado
+ *
+ * Busca el texto SQL en la cache de sentencias; si existe se entrega
+ * reiniciada y sin parametros vinculados, si no se compila y se guarda,
+ * desalojando la entrada menos usada recientemente cuando la cache esta llena.
+ * La sentencia debe devolverse con db_release_cached() y nunca finalizarse
+ * directamente.
+ *
+ * @param sql Texto SQL constante que identifica la sentencia
+ * @return Sentencia lista para vincular y ejecutar, NULL si el SQL no compila
+ */
+sqlite3_stmt* db_prepare_cached(const char *sql);
+
+/**
+ * @brief Devuelve a la cache una sentencia obtenida con db_prepare_cached()
+ *
+ * Reinicia la sentencia y limpia sus parametros para el siguiente uso.
+ * Si la sentencia no pertenece a la cache se finaliza.
+ *
+ * @param stmt Sentencia a liberar (se admite NULL)
+ */
+void db_release_cached(sqlite3_stmt *stmt);
+
+/**
+ * @brief Finaliza todas las sentencias retenidas en la cache
+ *
+ * Necesario antes de cerrar la conexion o de operaciones que requieren
+ * que no haya sentencias pendientes sobre la base de datos.
+ */
+void db_cache_clear();
+
+/**
+ * @brief Copia los contadores actuales de la cache de sentencias
+ *
+ * @param stats Estructura destino de los contadores
+ */
+void db_cache_stats(DbCacheStats *stats);
+
+/**
+ * @brief Aplica un perfil de ajuste a la conexion abierta
+ *
+ * Configura journal_mode, synchronous, cache_size, mmap_size, temp_store
+ * y busy_timeout segun el perfil. No guarda la preferencia; para eso se
+ * usa la configuracion de la aplicacion.
+ *
+ * @param perfil Perfil a aplicar
+ * @return 1 si todos los pragmas se aplicaron, 0 en caso de error
+ */
+int db_aplicar_perfil(DbPerfil perfil);
+
+/**
+ * @brief Devuelve el perfil de ajuste aplicado actualmente
+ *
+ * @return Perfil activo en la conexion
+ */
+DbPerfil db_perfil_actual();
+
+/**
+ * @brief Nombre legible de un perfil de ajuste
+ *
+ * @param perfil Perfil consultado
+ * @return Texto constante con el nombre del perfil
+ */
+const char* db_perfil_nombre(DbPerfil perfil);
+
+/**
+ * @brief Asigna el siguiente ID para una nueva fila de una tabla de entidad
+ *
+ * Con la reutilizacion activada devuelve el menor ID liberado por borrados
+ * (lista persistida en la tabla id_libre); si no hay huecos, o con la
+ * reutilizacion desactivada, devuelve MAX(id)+1. Ambas consultas son
+ * busquedas en B-tree, independientes del numero de filas recorridas.
+ *
+ * @param tabla Tabla de entidad gestionada (ver db_tabla_id_gestionado)
+ * @return ID a usar, 0 si la tabla no esta gestionada o hubo error
+ */
+int db_siguiente_id(const char *tabla);
+
+/**
+ * @brief Enumera las tablas cuyos IDs asigna db_siguiente_id()
+ *
+ * @param indice Posicion en la lista (desde 0)
+ * @return Nombre de la tabla, NULL al superar el final de la lista
+ */
+const char* db_tabla_id_gestionado(int indice);
+
+/**
+ * @brief Activa o desactiva la reutilizacion de IDs liberados
+ *
+ * @param activar 1 para rellenar huecos, 0 para asignar siempre MAX(id)+1
+ */
+void db_set_reutilizar_ids(int activar);
+
+/**
+ * @brief Muestra los valores efectivos de los pragmas de ajuste
+ *
+ * Consulta la conexion en lugar de confiar en el perfil configurado,
+ * ya que algunos pragmas (journal_mode en bases de solo lectura o en
+ * memoria) pueden no aceptar el valor solicitado.
+ */
+void db_mostrar_pragmas();
+
+#endif
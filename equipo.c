@@ -2037,31 +2037,50 @@ void eliminar_equipo()
 
     if (confirmar("Esta seguro que desea eliminar este equipo? Esta accion no se puede deshacer."))
     {
+        if (!db_begin())
+        {
+            pause_console();
+            return;
+        }
+        int ok = 1;
+
         // Eliminar jugadores primero
         const char *sql_delete_jugadores = "DELETE FROM jugador WHERE equipo_id = ?;";
-        if (sqlite3_prepare_v2(db, sql_delete_jugadores, -1, &stmt, 0) == SQLITE_OK)
+        if (ok && sqlite3_prepare_v2(db, sql_delete_jugadores, -1, &stmt, 0) == SQLITE_OK)
         {
             sqlite3_bind_int(stmt, 1, equipo_id);
-            sqlite3_step(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
             sqlite3_finalize(stmt);
         }
+        else
+        {
+            ok = 0;
+        }
 
         // Eliminar equipo
         const char *sql_delete_equipo = "DELETE FROM equipo WHERE id = ?;";
-        if (sqlite3_prepare_v2(db, sql_delete_equipo, -1, &stmt, 0) == SQLITE_OK)
+        if (ok && sqlite3_prepare_v2(db, sql_delete_equipo, -1, &stmt, 0) == SQLITE_OK)
         {
             sqlite3_bind_int(stmt, 1, equipo_id);
-
-            if (sqlite3_step(stmt) == SQLITE_DONE)
-            {
-                printf("Equipo eliminado exitosamente.\n");
-            }
-            else
-            {
-                printf("Error al eliminar el equipo: %s\n", sqlite3_errmsg(db));
-            }
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
             sqlite3_finalize(stmt);
         }
+        else
+        {
+            ok = 0;
+        }
+
+        if (ok && db_commit())
+        {
+            printf("Equipo eliminado exitosamente.\n");
+        }
+        else
+        {
+            printf("Error al eliminar el equipo: %s\n", sqlite3_errmsg(db));
+            db_rollback();
+        }
     }
     else
     {
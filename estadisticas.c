@@ -159,8 +159,9 @@ void menu_estadisticas_rendimiento()
         {14, "Impacto Real del Cansancio", mostrar_impacto_real_cansancio},
         {15, "Impacto Real del Estado de Animo", mostrar_impacto_real_estado_animo},
         {16, "Rendimiento por Esfuerzo", mostrar_rendimiento_por_esfuerzo},
+        {17, "Matriz de Correlaciones", mostrar_matriz_correlaciones},
         {0, "Volver", NULL}
     };
 
-    ejecutar_menu("ESTADISTICAS DE RENDIMIENTO", items, 17);
+    ejecutar_menu("ESTADISTICAS DE RENDIMIENTO", items, 18);
 }
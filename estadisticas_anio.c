@@ -4,6 +4,7 @@
  *
  * Implementa consultas SQL para agregación de métricas deportivas por año,
  * permitiendo evaluación de rendimiento longitudinal y tendencias históricas.
+ * Los totales salen de los resúmenes mensuales (resumenes.h), no de partido.
  */
 
 #include "estadisticas_anio.h"
@@ -17,6 +18,8 @@
  *
  * Agrega métricas por año para identificar patrones estacionales,
  * comparar rendimiento interanual y evaluar progreso a largo plazo.
+ * Suma las filas mensuales de cada camiseta; los partidos sin fecha
+ * válida no pertenecen a ningún año.
  */
 void mostrar_estadisticas_por_anio()
 {
@@ -24,9 +27,11 @@ void mostrar_estadisticas_por_anio()
     print_header("ESTADISTICAS POR ANIO");
     sqlite3_stmt *stmt;
     sqlite3_prepare_v2(db,
-                       "SELECT substr(fecha_hora, 7, 4) AS anio, c.nombre, COUNT(*) AS partidos, SUM(goles) AS total_goles, SUM(asistencias) AS total_asistencias, ROUND(AVG(goles), 2) AS avg_goles, ROUND(AVG(asistencias), 2) AS avg_asistencias "
-                       "FROM partido p "
-                       "JOIN camiseta c ON p.camiseta_id = c.id "
+                       "SELECT r.clave / 100 AS anio, c.nombre, SUM(r.partidos) AS partidos, SUM(r.goles) AS total_goles, SUM(r.asistencias) AS total_asistencias, "
+                       "ROUND(CAST(SUM(r.goles) AS REAL) / SUM(r.partidos), 2) AS avg_goles, ROUND(CAST(SUM(r.asistencias) AS REAL) / SUM(r.partidos), 2) AS avg_asistencias "
+                       "FROM resumen_partido r "
+                       "JOIN camiseta c ON r.camiseta_id = c.id "
+                       "WHERE r.dimension = 'mes' AND r.clave > 0 "
                        "GROUP BY anio, c.id "
                        "ORDER BY anio DESC, total_goles DESC",
                        -1, &stmt, NULL);
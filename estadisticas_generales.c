@@ -2,178 +2,368 @@
  * @file estadisticas_generales.c
  * @brief Módulo de análisis estadístico global de rendimiento deportivo
  *
- * Implementa consultas SQL para métricas agregadas de partidos,
- * incluyendo análisis por clima, día de semana, cansancio y estado anímico,
- * utilizando funciones de agrupamiento y JOINs para insights comprehensivos.
+ * Implementa métricas agregadas de partidos, incluyendo análisis por clima,
+ * día de semana, cansancio y estado anímico. Todas salen de una pasada sobre
+ * la copia en memoria de partido (estadisticas_generales_calcular); cada
+ * pantalla solo da formato a la parte que le corresponde.
  */
 
 #include "estadisticas_generales.h"
 #include "db.h"
 #include "utils.h"
+#include "partido_store.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
 // Array de días de la semana en español
 const char* dias[] = {"Domingo", "Lunes", "Martes", "Miercoles", "Jueves", "Viernes", "Sabado"};
 
+/** Nombres de los códigos de clima; el 0 agrupa los partidos sin clima válido */
+static const char *CLIMAS[7] = {"Desconocido", "Despejado", "Nublado", "Lluvia", "Ventoso", "Mucho Calor", "Mucho Frio"};
+
+/** Etiquetas de las bandas de cansancio y de estado de ánimo */
+static const char *BANDAS[NUM_BANDAS] = {"Bajo (1-3)", "Medio (4-7)", "Alto (8-10)"};
+
+/** Columnas que las pantallas promedian por grupo */
+typedef enum
+{
+    METRICA_GOLES,
+    METRICA_ASISTENCIAS,
+    METRICA_RENDIMIENTO
+} Metrica;
+
 /**
- * @brief Función auxiliar para ejecutar consultas SQL y mostrar resultados.
- *
- * Esta función ejecuta una consulta SQL preparada y muestra los resultados
- * en formato de tabla con el título proporcionado.
+ * @brief Banda de un valor de cansancio o de estado de ánimo
+ */
+static int banda(int valor)
+{
+    if (valor <= 3)
+        return BANDA_BAJA;
+    if (valor <= 7)
+        return BANDA_MEDIA;
+    return BANDA_ALTA;
+}
+
+/**
+ * @brief Suma un partido de la copia en memoria a un grupo
+ */
+static void sumar_partido(SumasPartidos *s, const PartidoStore *store, int i)
+{
+    s->partidos++;
+    s->goles += store->goles[i];
+    s->asistencias += store->asistencias[i];
+    s->rendimiento += store->rendimiento[i];
+    s->cansancio += store->cansancio[i];
+    s->animo += store->animo[i];
+    if (store->resultado[i] == 1)
+        s->victorias++;
+    else if (store->resultado[i] == 2)
+        s->empates++;
+    else if (store->resultado[i] == 3)
+        s->derrotas++;
+}
+
+/**
+ * @brief Suma de una métrica en un grupo
+ */
+static long long suma_metrica(const SumasPartidos *s, Metrica metrica)
+{
+    switch (metrica)
+    {
+    case METRICA_GOLES:
+        return s->goles;
+    case METRICA_ASISTENCIAS:
+        return s->asistencias;
+    default:
+        return s->rendimiento;
+    }
+}
+
+/**
+ * @brief Promedio por partido de una métrica en un grupo (0 si no hay partidos)
+ */
+static double promedio_metrica(const SumasPartidos *s, Metrica metrica)
+{
+    return s->partidos ? (double)suma_metrica(s, metrica) / s->partidos : 0.0;
+}
+
+/**
+ * @brief Valor de una camiseta en una categoría de destacadas
  *
- * @param titulo El título a mostrar antes de los resultados.
- * @param sql La consulta SQL a ejecutar.
+ * El cansancio se niega para que en todas las categorías gane el mayor.
  */
-static void query(const char *titulo, const char *sql)
+static double valor_categoria(const SumasPartidos *s, int categoria)
 {
-    sqlite3_stmt *stmt;
-    char nombre[200];
-    int num_cols;
+    switch (categoria)
+    {
+    case DESTACADA_GOLES:
+        return (double)s->goles;
+    case DESTACADA_ASISTENCIAS:
+        return (double)s->asistencias;
+    case DESTACADA_PARTIDOS:
+        return s->partidos;
+    case DESTACADA_GOLES_ASISTENCIAS:
+        return (double)(s->goles + s->asistencias);
+    case DESTACADA_RENDIMIENTO:
+        return (double)s->rendimiento / s->partidos;
+    case DESTACADA_ANIMO:
+        return (double)s->animo / s->partidos;
+    case DESTACADA_CANSANCIO:
+        return -(double)s->cansancio / s->partidos;
+    case DESTACADA_VICTORIAS:
+        return s->victorias;
+    case DESTACADA_EMPATES:
+        return s->empates;
+    default:
+        return s->derrotas;
+    }
+}
 
-    printf("\n%s\n", titulo);
-    printf("----------------------------------------\n");
+/**
+ * @brief Elige las camisetas destacadas a partir de las sumas por camiseta
+ *
+ * Recorre la tabla camiseta en orden de ID, de modo que ante empates queda
+ * la primera.
+ *
+ * @param r Resultado cuyas destacadas se rellenan
+ * @param por_camiseta Sumas indexadas por ID de camiseta
+ * @param max_camiseta Mayor ID presente en por_camiseta
+ * @return 1 si exito, 0 en caso de error
+ */
+static int elegir_destacadas(EstadisticasGenerales *r, const SumasPartidos *por_camiseta, int max_camiseta)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT id, nombre, sorteada FROM camiseta ORDER BY id");
+    int rc;
 
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-    num_cols = sqlite3_column_count(stmt);
+    if (!stmt)
+        return 0;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
     {
-        if (num_cols == 1)
+        int id = sqlite3_column_int(stmt, 0);
+        const char *nombre = (const char *)sqlite3_column_text(stmt, 1);
+        const SumasPartidos *s = id >= 0 && id <= max_camiseta ? &por_camiseta[id] : NULL;
+        CamisetaDestacada *d;
+
+        for (int c = 0; c < NUM_DESTACADAS; c++)
         {
-            if (sqlite3_column_type(stmt, 0) == SQLITE_INTEGER)
-            {
-                printf("%d\n", sqlite3_column_int(stmt, 0));
-            }
-            else if (sqlite3_column_type(stmt, 0) == SQLITE_FLOAT)
-            {
-                printf("%.2f\n", sqlite3_column_double(stmt, 0));
-            }
+            double valor;
+
+            if (c == DESTACADA_SORTEADA)
+                valor = sqlite3_column_int(stmt, 2);
+            else if (s && s->partidos > 0)
+                valor = valor_categoria(s, c);
             else
-            {
-                snprintf(nombre, sizeof(nombre), "%s", sqlite3_column_text(stmt, 0));
-                printf("%s\n", nombre);
-            }
+                continue;
+
+            d = &r->destacada[c];
+            if (d->id != 0 && valor <= (c == DESTACADA_CANSANCIO ? -d->valor : d->valor))
+                continue;
+            d->id = id;
+            d->valor = c == DESTACADA_CANSANCIO ? -valor : valor;
+            snprintf(d->nombre, sizeof(d->nombre), "%s", nombre ? nombre : "");
         }
-        else
-        {
-            snprintf(nombre, sizeof(nombre), "%s", sqlite3_column_text(stmt, 0));
+    }
+    db_release_cached(stmt);
 
-            // Check if the second column is integer or real
-            if (sqlite3_column_type(stmt, 1) == SQLITE_INTEGER)
-            {
-                printf("%-30s : %d\n",
-                       nombre,
-                       sqlite3_column_int(stmt, 1));
-            }
-            else if (sqlite3_column_type(stmt, 1) == SQLITE_FLOAT)
-            {
-                printf("%-30s : %.2f\n",
-                       nombre,
-                       sqlite3_column_double(stmt, 1));
-            }
-            else
+    if (rc != SQLITE_DONE)
+    {
+        printf("Error leyendo camisetas: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    return 1;
+}
+
+/** Resultado de la última pasada, sin destacadas */
+static EstadisticasGenerales pasada;
+
+/** Sumas por ID de camiseta de la última pasada */
+static SumasPartidos *pasada_camisetas = NULL;
+
+/** Mayor ID de camiseta de la última pasada */
+static int pasada_max_camiseta = 0;
+
+/** Generación de partido_store sobre la que se hizo la pasada; 0 si ninguna */
+static unsigned long long pasada_generacion = 0;
+
+/**
+ * @brief Recorre una vez la copia en memoria acumulando todos los grupos
+ *
+ * Los últimos partidos con cansancio alto se guardan en un buffer circular
+ * durante la pasada; la copia en memoria ya está en orden cronológico.
+ *
+ * @param store Copia en memoria de partido
+ * @return 1 si exito, 0 si no hubo memoria
+ */
+static int recorrer_partidos(const PartidoStore *store)
+{
+    int ultimos[PARTIDOS_CAIDA_CANSANCIO];
+    int vistos_alto = 0;
+    int max_camiseta = 0;
+    SumasPartidos *por_camiseta;
+
+    pasada_generacion = 0;
+    memset(&pasada, 0, sizeof(pasada));
+
+    for (int i = 0; i < store->n; i++)
+    {
+        if (store->camiseta_id[i] > max_camiseta)
+            max_camiseta = store->camiseta_id[i];
+    }
+    por_camiseta = realloc(pasada_camisetas, ((size_t)max_camiseta + 1) * sizeof(SumasPartidos));
+    if (!por_camiseta)
+    {
+        printf("Memoria insuficiente.\n");
+        return 0;
+    }
+    memset(por_camiseta, 0, ((size_t)max_camiseta + 1) * sizeof(SumasPartidos));
+    pasada_camisetas = por_camiseta;
+    pasada_max_camiseta = max_camiseta;
+
+    for (int i = 0; i < store->n; i++)
+    {
+        int clima = store->clima[i] >= 1 && store->clima[i] <= 6 ? store->clima[i] : 0;
+        int banda_cansancio = banda(store->cansancio[i]);
+
+        sumar_partido(&pasada.total, store, i);
+        sumar_partido(&pasada.clima[clima], store, i);
+        if (store->dia_semana[i] >= 0)
+            sumar_partido(&pasada.dia[store->dia_semana[i]], store, i);
+        sumar_partido(&pasada.cansancio[banda_cansancio], store, i);
+        sumar_partido(&pasada.animo[banda(store->animo[i])], store, i);
+        if (store->camiseta_id[i] >= 0)
+            sumar_partido(&por_camiseta[store->camiseta_id[i]], store, i);
+
+        if (banda_cansancio == BANDA_ALTA)
+        {
+            if (pasada.caida_antiguos < PARTIDOS_CAIDA_CANSANCIO)
             {
-                // Fallback to int
-                printf("%-30s : %d\n",
-                       nombre,
-                       sqlite3_column_int(stmt, 1));
+                pasada.caida_antiguos++;
+                pasada.caida_rendimiento_antiguos += store->rendimiento[i];
             }
+            ultimos[vistos_alto % PARTIDOS_CAIDA_CANSANCIO] = store->rendimiento[i];
+            vistos_alto++;
         }
     }
 
-    sqlite3_finalize(stmt);
+    pasada.caida_recientes = vistos_alto < PARTIDOS_CAIDA_CANSANCIO ? vistos_alto : PARTIDOS_CAIDA_CANSANCIO;
+    for (int i = 0; i < pasada.caida_recientes; i++)
+        pasada.caida_rendimiento_recientes += ultimos[i];
+
+    pasada_generacion = store->generacion;
+    return 1;
+}
+
+/**
+ * @brief Calcula todas las métricas de estadísticas generales
+ *
+ * La pasada sobre partido se reutiliza mientras la copia en memoria no
+ * cambie de generación; las destacadas se eligen siempre de nuevo porque
+ * dependen también de la tabla camiseta.
+ */
+int estadisticas_generales_calcular(EstadisticasGenerales *resultado)
+{
+    const PartidoStore *store = partido_store_obtener();
+
+    memset(resultado, 0, sizeof(*resultado));
+    if (!store)
+        return 0;
+    if (store->generacion != pasada_generacion && !recorrer_partidos(store))
+        return 0;
+
+    *resultado = pasada;
+    resultado->destacada[DESTACADA_RENDIMIENTO].es_promedio = 1;
+    resultado->destacada[DESTACADA_ANIMO].es_promedio = 1;
+    resultado->destacada[DESTACADA_CANSANCIO].es_promedio = 1;
+    return elegir_destacadas(resultado, pasada_camisetas, pasada_max_camiseta);
+}
+
+/**
+ * @brief Imprime el título de una sección de resultados
+ */
+static void titulo_seccion(const char *titulo)
+{
+    printf("\n%s\n", remover_tildes(titulo));
+    printf("----------------------------------------\n");
+}
+
+/**
+ * @brief Ordena índices de grupos por promedio descendente de una métrica
+ *
+ * Compara los promedios redondeados a dos decimales, como se muestran;
+ * ante empates conserva el orden de los índices. Omite los grupos vacíos.
+ *
+ * @param grupos Grupos a ordenar
+ * @param n Número de grupos
+ * @param metrica Métrica promediada
+ * @param orden Destino de los índices ordenados
+ * @return Número de índices escritos
+ */
+static int ordenar_por_promedio(const SumasPartidos *grupos, int n, Metrica metrica, int *orden)
+{
+    int escritos = 0;
+
+    for (int g = 0; g < n; g++)
+    {
+        int j;
+
+        if (grupos[g].partidos == 0)
+            continue;
+        for (j = escritos; j > 0 &&
+                redondear(promedio_metrica(&grupos[orden[j - 1]], metrica), 2) <
+                redondear(promedio_metrica(&grupos[g], metrica), 2); j--)
+            orden[j] = orden[j - 1];
+        orden[j] = g;
+        escritos++;
+    }
+    return escritos;
 }
 
 /**
  * @brief Muestra las estadísticas principales de las camisetas.
  *
- * Esta función imprime un encabezado y ejecuta varias consultas para mostrar
- * estadísticas como la camiseta con más goles, asistencias, partidos jugados
- * y la suma de goles más asistencias. Al final, pausa la consola.
+ * Esta función imprime un encabezado y muestra, a partir de
+ * estadisticas_generales_calcular(), estadísticas como la camiseta con más
+ * goles, asistencias, partidos jugados y la suma de goles más asistencias.
+ * Al final, pausa la consola.
  */
 void mostrar_estadisticas_generales()
 {
+    static const char *TITULOS[NUM_DESTACADAS] =
+    {
+        "Camiseta con mas Goles",
+        "Camiseta con mas Asistencias",
+        "Camiseta con mas Partidos",
+        "Camiseta con mas Goles + Asistencias",
+        "Camiseta con mejor Rendimiento General promedio",
+        "Camiseta con mejor Estado de Animo promedio",
+        "Camiseta con menos Cansancio promedio",
+        "Camiseta con mas Victorias",
+        "Camiseta con mas Empates",
+        "Camiseta con mas Derrotas",
+        "Camiseta mas Sorteada"
+    };
+    EstadisticasGenerales e;
+
     clear_screen();
     print_header("ESTADISTICAS");
-    query("Camiseta con mas Goles",
-          "SELECT c.nombre, IFNULL(SUM(p.goles),0) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mas Asistencias",
-          "SELECT c.nombre, IFNULL(SUM(p.asistencias),0) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mas Partidos",
-          "SELECT c.nombre, COUNT(*) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mas Goles + Asistencias",
-          "SELECT c.nombre, IFNULL(SUM(p.goles+p.asistencias),0) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mejor Rendimiento General promedio",
-          "SELECT c.nombre, IFNULL(ROUND(AVG(p.rendimiento_general), 2), 0.00) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mejor Estado de Animo promedio",
-          "SELECT c.nombre, IFNULL(ROUND(AVG(p.estado_animo), 2), 0.00) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con menos Cansancio promedio",
-          "SELECT c.nombre, IFNULL(ROUND(AVG(p.cansancio), 2), 0.00) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "GROUP BY c.id "
-          "ORDER BY 2 ASC LIMIT 1");
-
-    query("Camiseta con mas Victorias",
-          "SELECT c.nombre, COUNT(*) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "WHERE p.resultado = 1 "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mas Empates",
-          "SELECT c.nombre, COUNT(*) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "WHERE p.resultado = 2 "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta con mas Derrotas",
-          "SELECT c.nombre, COUNT(*) "
-          "FROM partido p "
-          "JOIN camiseta c ON p.camiseta_id=c.id "
-          "WHERE p.resultado = 3 "
-          "GROUP BY c.id "
-          "ORDER BY 2 DESC LIMIT 1");
-
-    query("Camiseta mas Sorteada",
-          "SELECT c.nombre, c.sorteada "
-          "FROM camiseta c "
-          "ORDER BY c.sorteada DESC LIMIT 1");
+    estadisticas_generales_calcular(&e);
+
+    for (int c = 0; c < NUM_DESTACADAS; c++)
+    {
+        const CamisetaDestacada *d = &e.destacada[c];
+
+        titulo_seccion(TITULOS[c]);
+        // Victorias, empates y derrotas solo cuentan camisetas con al menos uno
+        if (d->id == 0 || (c >= DESTACADA_VICTORIAS && c <= DESTACADA_DERROTAS && d->valor == 0))
+            continue;
+        if (d->es_promedio)
+            printf("%-30s : %.2f\n", d->nombre, redondear(d->valor, 2));
+        else
+            printf("%-30s : %d\n", d->nombre, (int)d->valor);
+    }
 
     pause_console();
 }
@@ -183,41 +373,49 @@ void mostrar_estadisticas_generales()
  */
 void mostrar_total_partidos_jugados()
 {
+    EstadisticasGenerales e;
+
     clear_screen();
     print_header("TOTAL DE PARTIDOS JUGADOS");
+    estadisticas_generales_calcular(&e);
 
-    query("Total de Partidos Jugados",
-          "SELECT COUNT(*) FROM partido");
+    titulo_seccion("Total de Partidos Jugados");
+    printf("%d\n", e.total.partidos);
 
     pause_console();
 }
 
 /**
- * @brief Muestra el promedio de goles por partido
+ * @brief Muestra el promedio general de una métrica
  */
-void mostrar_promedio_goles_por_partido()
+static void mostrar_promedio_general(const char *encabezado, const char *titulo, Metrica metrica)
 {
+    EstadisticasGenerales e;
+
     clear_screen();
-    print_header("PROMEDIO DE GOLES POR PARTIDO");
+    print_header(encabezado);
+    estadisticas_generales_calcular(&e);
 
-    query("Promedio de Goles por Partido",
-          "SELECT ROUND(AVG(goles), 2) FROM partido");
+    titulo_seccion(titulo);
+    printf("%.2f\n", redondear(promedio_metrica(&e.total, metrica), 2));
 
     pause_console();
 }
 
+/**
+ * @brief Muestra el promedio de goles por partido
+ */
+void mostrar_promedio_goles_por_partido()
+{
+    mostrar_promedio_general("PROMEDIO DE GOLES POR PARTIDO", "Promedio de Goles por Partido", METRICA_GOLES);
+}
+
 /**
  * @brief Muestra el promedio de asistencias por partido
  */
 void mostrar_promedio_asistencias_por_partido()
 {
-    clear_screen();
-    print_header("PROMEDIO DE ASISTENCIAS POR PARTIDO");
-
-    query("Promedio de Asistencias por Partido",
-          "SELECT ROUND(AVG(asistencias), 2) FROM partido");
-
-    pause_console();
+    mostrar_promedio_general("PROMEDIO DE ASISTENCIAS POR PARTIDO", "Promedio de Asistencias por Partido", METRICA_ASISTENCIAS);
 }
 
 /**
@@ -225,11 +423,51 @@ void mostrar_promedio_asistencias_por_partido()
  */
 void mostrar_promedio_rendimiento_general()
 {
+    mostrar_promedio_general("PROMEDIO DE RENDIMIENTO_GENERAL", "Promedio de Rendimiento General", METRICA_RENDIMIENTO);
+}
+
+/**
+ * @brief Muestra una métrica por clima
+ *
+ * @param encabezado Encabezado de la pantalla
+ * @param titulo Título de la sección
+ * @param metrica Métrica a mostrar
+ * @param promedio 1 para el promedio por partido, 0 para el total
+ * @param seleccion 0 para listar todos los climas, 1 solo el mejor, -1 solo el peor
+ */
+static void mostrar_por_clima(const char *encabezado, const char *titulo, Metrica metrica, int promedio, int seleccion)
+{
+    EstadisticasGenerales e;
+    int orden[7];
+    int n;
+
     clear_screen();
-    print_header("PROMEDIO DE RENDIMIENTO_GENERAL");
+    print_header(encabezado);
+    estadisticas_generales_calcular(&e);
 
-    query("Promedio de Rendimiento General",
-          "SELECT ROUND(AVG(rendimiento_general), 2) FROM partido");
+    titulo_seccion(titulo);
+    if (seleccion == 0)
+    {
+        for (int c = 1; c <= 7; c++)
+        {
+            int clima = c % 7; // Los partidos sin clima válido van al final
+            if (e.clima[clima].partidos == 0)
+                continue;
+            if (promedio)
+                printf("%-30s : %.2f\n", CLIMAS[clima], redondear(promedio_metrica(&e.clima[clima], metrica), 2));
+            else
+                printf("%-30s : %lld\n", CLIMAS[clima], suma_metrica(&e.clima[clima], metrica));
+        }
+    }
+    else
+    {
+        n = ordenar_por_promedio(e.clima, 7, metrica, orden);
+        if (n > 0)
+        {
+            int clima = orden[seleccion > 0 ? 0 : n - 1];
+            printf("%-30s : %.2f\n", CLIMAS[clima], redondear(promedio_metrica(&e.clima[clima], metrica), 2));
+        }
+    }
 
     pause_console();
 }
@@ -239,13 +477,7 @@ void mostrar_promedio_rendimiento_general()
  */
 void mostrar_rendimiento_promedio_por_clima()
 {
-    clear_screen();
-    print_header("RENDIMIENTO PROMEDIO POR CLIMA");
-
-    query("Rendimiento Promedio por Clima",
-          "SELECT CASE WHEN clima = 1 THEN 'Despejado' WHEN clima = 2 THEN 'Nublado' WHEN clima = 3 THEN 'Lluvia' WHEN clima = 4 THEN 'Ventoso' WHEN clima = 5 THEN 'Mucho Calor' WHEN clima = 6 THEN 'Mucho Frio' END AS clima_texto, ROUND(AVG(rendimiento_general), 2) FROM partido GROUP BY clima ORDER BY clima");
-
-    pause_console();
+    mostrar_por_clima("RENDIMIENTO PROMEDIO POR CLIMA", "Rendimiento Promedio por Clima", METRICA_RENDIMIENTO, 1, 0);
 }
 
 /**
@@ -253,13 +485,7 @@ void mostrar_rendimiento_promedio_por_clima()
  */
 void mostrar_goles_por_clima()
 {
-    clear_screen();
-    print_header("GOLES POR CLIMA");
-
-    query("Goles por Clima",
-          "SELECT CASE clima WHEN 1 THEN 'Despejado' WHEN 2 THEN 'Nublado' WHEN 3 THEN 'Lluvia' WHEN 4 THEN 'Ventoso' WHEN 5 THEN 'Mucho Calor' WHEN 6 THEN 'Mucho Frio' END AS clima_texto, SUM(goles) FROM partido GROUP BY clima ORDER BY clima");
-
-    pause_console();
+    mostrar_por_clima("GOLES POR CLIMA", "Goles por Clima", METRICA_GOLES, 0, 0);
 }
 
 /**
@@ -267,13 +493,7 @@ void mostrar_goles_por_clima()
  */
 void mostrar_asistencias_por_clima()
 {
-    clear_screen();
-    print_header("ASISTENCIAS POR CLIMA");
-
-    query("Asistencias por Clima",
-          "SELECT CASE clima WHEN 1 THEN 'Despejado' WHEN 2 THEN 'Nublado' WHEN 3 THEN 'Lluvia' WHEN 4 THEN 'Ventoso' WHEN 5 THEN 'Mucho Calor' WHEN 6 THEN 'Mucho Frio' END AS clima_texto, SUM(asistencias) FROM partido GROUP BY clima ORDER BY clima");
-
-    pause_console();
+    mostrar_por_clima("ASISTENCIAS POR CLIMA", "Asistencias por Clima", METRICA_ASISTENCIAS, 0, 0);
 }
 
 /**
@@ -281,13 +501,7 @@ void mostrar_asistencias_por_clima()
  */
 void mostrar_clima_mejor_rendimiento()
 {
-    clear_screen();
-    print_header("CLIMA DONDE SE RINDE MEJOR");
-
-    query("Clima con Mejor Rendimiento Promedio",
-          "SELECT CASE clima WHEN 1 THEN 'Despejado' WHEN 2 THEN 'Nublado' WHEN 3 THEN 'Lluvia' WHEN 4 THEN 'Ventoso' WHEN 5 THEN 'Mucho Calor' WHEN 6 THEN 'Mucho Frio' END AS clima_texto, ROUND(AVG(rendimiento_general), 2) FROM partido GROUP BY clima ORDER BY AVG(rendimiento_general) DESC LIMIT 1");
-
-    pause_console();
+    mostrar_por_clima("CLIMA DONDE SE RINDE MEJOR", "Clima con Mejor Rendimiento Promedio", METRICA_RENDIMIENTO, 1, 1);
 }
 
 /**
@@ -295,105 +509,64 @@ void mostrar_clima_mejor_rendimiento()
  */
 void mostrar_clima_peor_rendimiento()
 {
-    clear_screen();
-    print_header("CLIMA DONDE SE RINDE PEOR");
-
-    query("Clima con Peor Rendimiento Promedio",
-          "SELECT CASE clima WHEN 1 THEN 'Despejado' WHEN 2 THEN 'Nublado' WHEN 3 THEN 'Lluvia' WHEN 4 THEN 'Ventoso' WHEN 5 THEN 'Mucho Calor' WHEN 6 THEN 'Mucho Frio' END AS clima_texto, ROUND(AVG(rendimiento_general), 2) FROM partido GROUP BY clima ORDER BY AVG(rendimiento_general) ASC LIMIT 1");
-
-    pause_console();
+    mostrar_por_clima("CLIMA DONDE SE RINDE PEOR", "Clima con Peor Rendimiento Promedio", METRICA_RENDIMIENTO, 1, -1);
 }
 
 /**
- * @brief Muestra el mejor día de la semana
+ * @brief Muestra el promedio de una métrica por día de la semana
+ *
+ * Los partidos sin fecha válida no cuentan. Los días sin partidos tienen
+ * promedio 0.
+ *
+ * @param encabezado Encabezado de la pantalla
+ * @param titulo Título de la sección
+ * @param metrica Métrica a promediar
+ * @param seleccion 0 para listar todos los días, 1 solo el mejor, -1 solo el peor
  */
-void mostrar_mejor_dia_semana()
+static void mostrar_promedio_por_dia(const char *encabezado, const char *titulo, Metrica metrica, int seleccion)
 {
+    EstadisticasGenerales e;
+    double promedios[7];
+    int elegido = 0;
+
     clear_screen();
-    print_header("MEJOR DIA DE LA SEMANA");
+    print_header(encabezado);
+    estadisticas_generales_calcular(&e);
 
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Mejor Dia de la Semana"));
-    printf("----------------------------------------\n");
+    titulo_seccion(titulo);
 
-    // Crear una consulta que garantice que todos los días de la semana aparezcan
-    sqlite3_stmt *stmt;
-    const char *sql = "WITH dias_semana AS ("
-                      "SELECT 0 AS dia_num, 'Domingo' AS dia_nombre UNION ALL "
-                      "SELECT 1, 'Lunes' UNION ALL "
-                      "SELECT 2, 'Martes' UNION ALL "
-                      "SELECT 3, 'Miercoles' UNION ALL "
-                      "SELECT 4, 'Jueves' UNION ALL "
-                      "SELECT 5, 'Viernes' UNION ALL "
-                      "SELECT 6, 'Sabado'"
-                      ") "
-                      "SELECT ds.dia_nombre, "
-                      "ROUND(COALESCE(AVG(p.rendimiento_general), 0), 2) AS promedio_rendimiento "
-                      "FROM dias_semana ds "
-                      "LEFT JOIN partido p ON CAST(strftime('%w', substr(p.fecha_hora, 7, 4) || '-' || substr(p.fecha_hora, 4, 2) || '-' || substr(p.fecha_hora, 1, 2)) AS INTEGER) = ds.dia_num "
-                      "AND p.fecha_hora IS NOT NULL AND p.fecha_hora != '' "
-                      "GROUP BY ds.dia_num, ds.dia_nombre "
-                      "ORDER BY promedio_rendimiento DESC LIMIT 1";
-
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    for (int d = 0; d < 7; d++)
     {
-        const char *dia = (const char *)sqlite3_column_text(stmt, 0);
-        double promedio = sqlite3_column_double(stmt, 1);
-
-        printf("%-30s : %.2f\n", remover_tildes(dia), promedio);
+        promedios[d] = redondear(promedio_metrica(&e.dia[d], metrica), 2);
+        if ((seleccion > 0 && promedios[d] > promedios[elegido]) ||
+                (seleccion < 0 && promedios[d] < promedios[elegido]))
+            elegido = d;
     }
 
-    sqlite3_finalize(stmt);
+    for (int d = 0; d < 7; d++)
+    {
+        if (seleccion != 0 && d != elegido)
+            continue;
+        printf("%-30s : %.2f\n", remover_tildes(dias[d]), promedios[d]);
+    }
 
     pause_console();
 }
 
+/**
+ * @brief Muestra el mejor día de la semana
+ */
+void mostrar_mejor_dia_semana()
+{
+    mostrar_promedio_por_dia("MEJOR DIA DE LA SEMANA", "Mejor Dia de la Semana", METRICA_RENDIMIENTO, 1);
+}
+
 /**
  * @brief Muestra el peor día de la semana
  */
 void mostrar_peor_dia_semana()
 {
-    clear_screen();
-    print_header("PEOR DIA DE LA SEMANA");
-
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Peor Dia de la Semana"));
-    printf("----------------------------------------\n");
-
-    // Crear una consulta que garantice que todos los días de la semana aparezcan
-    sqlite3_stmt *stmt;
-    const char *sql = "WITH dias_semana AS ("
-                      "SELECT 0 AS dia_num, 'Domingo' AS dia_nombre UNION ALL "
-                      "SELECT 1, 'Lunes' UNION ALL "
-                      "SELECT 2, 'Martes' UNION ALL "
-                      "SELECT 3, 'Miercoles' UNION ALL "
-                      "SELECT 4, 'Jueves' UNION ALL "
-                      "SELECT 5, 'Viernes' UNION ALL "
-                      "SELECT 6, 'Sabado'"
-                      ") "
-                      "SELECT ds.dia_nombre, "
-                      "ROUND(COALESCE(AVG(p.rendimiento_general), 0), 2) AS promedio_rendimiento "
-                      "FROM dias_semana ds "
-                      "LEFT JOIN partido p ON CAST(strftime('%w', substr(p.fecha_hora, 7, 4) || '-' || substr(p.fecha_hora, 4, 2) || '-' || substr(p.fecha_hora, 1, 2)) AS INTEGER) = ds.dia_num "
-                      "AND p.fecha_hora IS NOT NULL AND p.fecha_hora != '' "
-                      "GROUP BY ds.dia_num, ds.dia_nombre "
-                      "ORDER BY promedio_rendimiento ASC LIMIT 1";
-
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        const char *dia = (const char *)sqlite3_column_text(stmt, 0);
-        double promedio = sqlite3_column_double(stmt, 1);
-
-        printf("%-30s : %.2f\n", remover_tildes(dia), promedio);
-    }
-
-    sqlite3_finalize(stmt);
-
-    pause_console();
+    mostrar_promedio_por_dia("PEOR DIA DE LA SEMANA", "Peor Dia de la Semana", METRICA_RENDIMIENTO, -1);
 }
 
 /**
@@ -401,45 +574,7 @@ void mostrar_peor_dia_semana()
  */
 void mostrar_goles_promedio_por_dia()
 {
-    clear_screen();
-    print_header("GOLES PROMEDIO POR DIA");
-
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Goles Promedio por Dia"));
-    printf("----------------------------------------\n");
-
-    // Crear una consulta que garantice que todos los días de la semana aparezcan
-    sqlite3_stmt *stmt;
-    const char *sql = "WITH dias_semana AS ("
-                      "SELECT 0 AS dia_num, 'Domingo' AS dia_nombre UNION ALL "
-                      "SELECT 1, 'Lunes' UNION ALL "
-                      "SELECT 2, 'Martes' UNION ALL "
-                      "SELECT 3, 'Miercoles' UNION ALL "
-                      "SELECT 4, 'Jueves' UNION ALL "
-                      "SELECT 5, 'Viernes' UNION ALL "
-                      "SELECT 6, 'Sabado'"
-                      ") "
-                      "SELECT ds.dia_nombre, "
-                      "ROUND(COALESCE(AVG(p.goles), 0), 2) AS promedio_goles "
-                      "FROM dias_semana ds "
-                      "LEFT JOIN partido p ON CAST(strftime('%w', substr(p.fecha_hora, 7, 4) || '-' || substr(p.fecha_hora, 4, 2) || '-' || substr(p.fecha_hora, 1, 2)) AS INTEGER) = ds.dia_num "
-                      "AND p.fecha_hora IS NOT NULL AND p.fecha_hora != '' "
-                      "GROUP BY ds.dia_num, ds.dia_nombre "
-                      "ORDER BY ds.dia_num";
-
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        const char *dia = (const char *)sqlite3_column_text(stmt, 0);
-        double promedio = sqlite3_column_double(stmt, 1);
-
-        printf("%-30s : %.2f\n", remover_tildes(dia), promedio);
-    }
-
-    sqlite3_finalize(stmt);
-
-    pause_console();
+    mostrar_promedio_por_dia("GOLES PROMEDIO POR DIA", "Goles Promedio por Dia", METRICA_GOLES, 0);
 }
 
 /**
@@ -447,45 +582,7 @@ void mostrar_goles_promedio_por_dia()
  */
 void mostrar_asistencias_promedio_por_dia()
 {
-    clear_screen();
-    print_header("ASISTENCIAS PROMEDIO POR DIA");
-
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Asistencias Promedio por Dia"));
-    printf("----------------------------------------\n");
-
-    // Crear una consulta que garantice que todos los días de la semana aparezcan
-    sqlite3_stmt *stmt;
-    const char *sql = "WITH dias_semana AS ("
-                      "SELECT 0 AS dia_num, 'Domingo' AS dia_nombre UNION ALL "
-                      "SELECT 1, 'Lunes' UNION ALL "
-                      "SELECT 2, 'Martes' UNION ALL "
-                      "SELECT 3, 'Miercoles' UNION ALL "
-                      "SELECT 4, 'Jueves' UNION ALL "
-                      "SELECT 5, 'Viernes' UNION ALL "
-                      "SELECT 6, 'Sabado'"
-                      ") "
-                      "SELECT ds.dia_nombre, "
-                      "ROUND(COALESCE(AVG(p.asistencias), 0), 2) AS promedio_asistencias "
-                      "FROM dias_semana ds "
-                      "LEFT JOIN partido p ON CAST(strftime('%w', substr(p.fecha_hora, 7, 4) || '-' || substr(p.fecha_hora, 4, 2) || '-' || substr(p.fecha_hora, 1, 2)) AS INTEGER) = ds.dia_num "
-                      "AND p.fecha_hora IS NOT NULL AND p.fecha_hora != '' "
-                      "GROUP BY ds.dia_num, ds.dia_nombre "
-                      "ORDER BY ds.dia_num";
-
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        const char *dia = (const char *)sqlite3_column_text(stmt, 0);
-        double promedio = sqlite3_column_double(stmt, 1);
-
-        printf("%-30s : %.2f\n", remover_tildes(dia), promedio);
-    }
-
-    sqlite3_finalize(stmt);
-
-    pause_console();
+    mostrar_promedio_por_dia("ASISTENCIAS PROMEDIO POR DIA", "Asistencias Promedio por Dia", METRICA_ASISTENCIAS, 0);
 }
 
 /**
@@ -493,45 +590,30 @@ void mostrar_asistencias_promedio_por_dia()
  */
 void mostrar_rendimiento_promedio_por_dia()
 {
-    clear_screen();
-    print_header("RENDIMIENTO PROMEDIO POR DIA");
+    mostrar_promedio_por_dia("RENDIMIENTO PROMEDIO POR DIA", "Rendimiento Promedio por Dia", METRICA_RENDIMIENTO, 0);
+}
 
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Rendimiento Promedio por Dia"));
-    printf("----------------------------------------\n");
+/**
+ * @brief Muestra una métrica por banda, ordenada por su promedio descendente
+ *
+ * @param bandas Sumas por banda (de cansancio o de estado de ánimo)
+ * @param metrica Métrica por la que se ordena
+ * @param total 1 para mostrar la suma de la métrica, 0 para su promedio
+ * @param limite Máximo de bandas a mostrar
+ */
+static void mostrar_por_banda(const SumasPartidos *bandas, Metrica metrica, int total, int limite)
+{
+    int orden[NUM_BANDAS];
+    int n = ordenar_por_promedio(bandas, NUM_BANDAS, metrica, orden);
 
-    // Crear una consulta que garantice que todos los días de la semana aparezcan
-    sqlite3_stmt *stmt;
-    const char *sql = "WITH dias_semana AS ("
-                      "SELECT 0 AS dia_num, 'Domingo' AS dia_nombre UNION ALL "
-                      "SELECT 1, 'Lunes' UNION ALL "
-                      "SELECT 2, 'Martes' UNION ALL "
-                      "SELECT 3, 'Miercoles' UNION ALL "
-                      "SELECT 4, 'Jueves' UNION ALL "
-                      "SELECT 5, 'Viernes' UNION ALL "
-                      "SELECT 6, 'Sabado'"
-                      ") "
-                      "SELECT ds.dia_nombre, "
-                      "ROUND(COALESCE(AVG(p.rendimiento_general), 0), 2) AS promedio_rendimiento "
-                      "FROM dias_semana ds "
-                      "LEFT JOIN partido p ON CAST(strftime('%w', substr(p.fecha_hora, 7, 4) || '-' || substr(p.fecha_hora, 4, 2) || '-' || substr(p.fecha_hora, 1, 2)) AS INTEGER) = ds.dia_num "
-                      "AND p.fecha_hora IS NOT NULL AND p.fecha_hora != '' "
-                      "GROUP BY ds.dia_num, ds.dia_nombre "
-                      "ORDER BY ds.dia_num";
-
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    for (int i = 0; i < n && i < limite; i++)
     {
-        const char *dia = (const char *)sqlite3_column_text(stmt, 0);
-        double promedio = sqlite3_column_double(stmt, 1);
-
-        printf("%-30s : %.2f\n", remover_tildes(dia), promedio);
+        const SumasPartidos *s = &bandas[orden[i]];
+        if (total)
+            printf("%-30s : %lld\n", BANDAS[orden[i]], suma_metrica(s, metrica));
+        else
+            printf("%-30s : %.2f\n", BANDAS[orden[i]], redondear(promedio_metrica(s, metrica), 2));
     }
-
-    sqlite3_finalize(stmt);
-
-    pause_console();
 }
 
 /**
@@ -539,11 +621,14 @@ void mostrar_rendimiento_promedio_por_dia()
  */
 void mostrar_rendimiento_por_nivel_cansancio()
 {
+    EstadisticasGenerales e;
+
     clear_screen();
     print_header("RENDIMIENTO POR NIVEL DE CANSANCIO");
+    estadisticas_generales_calcular(&e);
 
-    query("Rendimiento por Nivel de Cansancio",
-          "SELECT CASE WHEN cansancio <= 3 THEN 'Bajo (1-3)' WHEN cansancio <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END AS nivel_cansancio, ROUND(AVG(rendimiento_general), 2) AS rendimiento_promedio, COUNT(*) AS partidos FROM partido GROUP BY CASE WHEN cansancio <= 3 THEN 'Bajo (1-3)' WHEN cansancio <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END ORDER BY rendimiento_promedio DESC");
+    titulo_seccion("Rendimiento por Nivel de Cansancio");
+    mostrar_por_banda(e.cansancio, METRICA_RENDIMIENTO, 0, NUM_BANDAS);
 
     pause_console();
 }
@@ -553,47 +638,33 @@ void mostrar_rendimiento_por_nivel_cansancio()
  */
 void mostrar_goles_cansancio_alto_vs_bajo()
 {
+    EstadisticasGenerales e;
+    SumasPartidos bajo = {0};
+
     clear_screen();
     print_header("GOLES CON CANSANCIO ALTO VS BAJO");
+    estadisticas_generales_calcular(&e);
 
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Goles con Cansancio Alto vs Bajo"));
-    printf("----------------------------------------\n");
-
-    // Query modificada para mostrar el formato esperado: Alto: 1, Bajo: 0
-    sqlite3_stmt *stmt;
-    int num_cols;
-
-    // Consulta para cansancio alto (>7) vs bajo (<=7)
-    const char *sql = "SELECT CASE WHEN cansancio > 7 THEN 'Alto' ELSE 'Bajo' END AS nivel_cansancio, "
-                      "SUM(goles) AS total_goles, ROUND(AVG(goles), 2) AS promedio_goles, COUNT(*) AS partidos "
-                      "FROM partido GROUP BY CASE WHEN cansancio > 7 THEN 'Alto' ELSE 'Bajo' END";
+    titulo_seccion("Goles con Cansancio Alto vs Bajo");
 
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
-    num_cols = sqlite3_column_count(stmt);
+    // Alto es cansancio > 7; bajo, todo lo demás
+    bajo.partidos = e.cansancio[BANDA_BAJA].partidos + e.cansancio[BANDA_MEDIA].partidos;
+    bajo.goles = e.cansancio[BANDA_BAJA].goles + e.cansancio[BANDA_MEDIA].goles;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    if (e.cansancio[BANDA_ALTA].partidos > 0)
+        printf("%-30s : %d\n", "Alto", (int)e.cansancio[BANDA_ALTA].goles);
+    if (bajo.partidos > 0)
     {
-        if (num_cols >= 2)
-        {
-            const char *nivel = (const char *)sqlite3_column_text(stmt, 0);
-            int total_goles = sqlite3_column_int(stmt, 1);
-            double promedio_goles = sqlite3_column_double(stmt, 2);
-
-            // Mostrar en el formato especificado en la tarea
-            printf("%-30s : %d", remover_tildes(nivel), total_goles);
+        printf("%-30s : %d", "Bajo", (int)bajo.goles);
 
-            // Agregar nota para cansancio bajo si hay caida de rendimiento
-            if (strcmp(nivel, "Bajo") == 0 && promedio_goles < 1.0)
-            {
-                printf(", Caida de Rendimiento por Cansancio Acumulado");
-            }
-            printf("\n");
+        // Agregar nota para cansancio bajo si hay caida de rendimiento
+        if (redondear(promedio_metrica(&bajo, METRICA_GOLES), 2) < 1.0)
+        {
+            printf(", Caida de Rendimiento por Cansancio Acumulado");
         }
+        printf("\n");
     }
 
-    sqlite3_finalize(stmt);
-
     pause_console();
 }
 
@@ -602,43 +673,54 @@ void mostrar_goles_cansancio_alto_vs_bajo()
  */
 void mostrar_partidos_cansancio_alto()
 {
+    EstadisticasGenerales e;
+
     clear_screen();
     print_header("PARTIDOS JUGADOS CON CANSANCIO ALTO");
+    estadisticas_generales_calcular(&e);
 
-    query("Partidos con Cansancio Alto (>7)",
-          "SELECT COUNT(*) AS partidos_cansancio_alto FROM partido WHERE cansancio > 7");
+    titulo_seccion("Partidos con Cansancio Alto (>7)");
+    printf("%d\n", e.cansancio[BANDA_ALTA].partidos);
 
     pause_console();
 }
 
 /**
  * @brief Muestra la caída de rendimiento por cansancio acumulado
+ *
+ * Compara el rendimiento de los últimos y los primeros partidos con
+ * cansancio alto.
  */
 void mostrar_caida_rendimiento_cansancio_acumulado()
 {
+    EstadisticasGenerales e;
+
     clear_screen();
     print_header("CAIDA DE RENDIMIENTO POR CANSANCIO ACUMULADO");
+    estadisticas_generales_calcular(&e);
 
-    // Usar la funcion para remover tildes de los textos
-    printf("\n%s\n", remover_tildes("Caida de Rendimiento por Cansancio Acumulado"));
-    printf("----------------------------------------\n");
-
-    // Comparar rendimiento en partidos recientes vs antiguos con alto cansancio
-    sqlite3_stmt *stmt;
-    const char *sql = "SELECT 'Recientes (ultimos 5)' AS periodo, ROUND(AVG(rendimiento_general), 2) AS rendimiento_promedio FROM (SELECT rendimiento_general FROM partido WHERE cansancio > 7 ORDER BY fecha_hora DESC LIMIT 5) UNION ALL SELECT 'Antiguos (primeros 5)' AS periodo, ROUND(AVG(rendimiento_general), 2) AS rendimiento_promedio FROM (SELECT rendimiento_general FROM partido WHERE cansancio > 7 ORDER BY fecha_hora ASC LIMIT 5)";
+    titulo_seccion("Caida de Rendimiento por Cansancio Acumulado");
+    printf("%-30s : %.2f\n", "Recientes (ultimos 5)",
+           e.caida_recientes ? redondear((double)e.caida_rendimiento_recientes / e.caida_recientes, 2) : 0.0);
+    printf("%-30s : %.2f\n", "Antiguos (primeros 5)",
+           e.caida_antiguos ? redondear((double)e.caida_rendimiento_antiguos / e.caida_antiguos, 2) : 0.0);
 
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+    pause_console();
+}
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        const char *periodo = (const char *)sqlite3_column_text(stmt, 0);
-        double rendimiento = sqlite3_column_double(stmt, 1);
+/**
+ * @brief Muestra una métrica por banda de estado de ánimo
+ */
+static void mostrar_por_estado_animo(const char *encabezado, const char *titulo, Metrica metrica, int total, int limite)
+{
+    EstadisticasGenerales e;
 
-        printf("%-30s : %.2f", remover_tildes(periodo), rendimiento);
-        printf("\n");
-    }
+    clear_screen();
+    print_header(encabezado);
+    estadisticas_generales_calcular(&e);
 
-    sqlite3_finalize(stmt);
+    titulo_seccion(titulo);
+    mostrar_por_banda(e.animo, metrica, total, limite);
 
     pause_console();
 }
@@ -648,13 +730,7 @@ void mostrar_caida_rendimiento_cansancio_acumulado()
  */
 void mostrar_rendimiento_por_estado_animo()
 {
-    clear_screen();
-    print_header("RENDIMIENTO POR ESTADO DE ANIMO");
-
-    query("Rendimiento por Estado de Animo",
-          "SELECT CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END AS nivel_animo, ROUND(AVG(rendimiento_general), 2) AS rendimiento_promedio, COUNT(*) AS partidos FROM partido GROUP BY CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END ORDER BY rendimiento_promedio DESC");
-
-    pause_console();
+    mostrar_por_estado_animo("RENDIMIENTO POR ESTADO DE ANIMO", "Rendimiento por Estado de Animo", METRICA_RENDIMIENTO, 0, NUM_BANDAS);
 }
 
 /**
@@ -662,13 +738,7 @@ void mostrar_rendimiento_por_estado_animo()
  */
 void mostrar_goles_por_estado_animo()
 {
-    clear_screen();
-    print_header("GOLES POR ESTADO DE ANIMO");
-
-    query("Goles por Estado de Animo",
-          "SELECT CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END AS nivel_animo, SUM(goles) AS total_goles, ROUND(AVG(goles), 2) AS promedio_goles, COUNT(*) AS partidos FROM partido GROUP BY CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END ORDER BY promedio_goles DESC");
-
-    pause_console();
+    mostrar_por_estado_animo("GOLES POR ESTADO DE ANIMO", "Goles por Estado de Animo", METRICA_GOLES, 1, NUM_BANDAS);
 }
 
 /**
@@ -676,13 +746,7 @@ void mostrar_goles_por_estado_animo()
  */
 void mostrar_asistencias_por_estado_animo()
 {
-    clear_screen();
-    print_header("ASISTENCIAS POR ESTADO DE ANIMO");
-
-    query("Asistencias por Estado de Animo",
-          "SELECT CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END AS nivel_animo, SUM(asistencias) AS total_asistencias, ROUND(AVG(asistencias), 2) AS promedio_asistencias, COUNT(*) AS partidos FROM partido GROUP BY CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END ORDER BY promedio_asistencias DESC");
-
-    pause_console();
+    mostrar_por_estado_animo("ASISTENCIAS POR ESTADO DE ANIMO", "Asistencias por Estado de Animo", METRICA_ASISTENCIAS, 1, NUM_BANDAS);
 }
 
 /**
@@ -690,13 +754,7 @@ void mostrar_asistencias_por_estado_animo()
  */
 void mostrar_estado_animo_ideal()
 {
-    clear_screen();
-    print_header("ESTADO DE ANIMO IDEAL PARA JUGAR");
-
-    query("Estado de Animo Ideal",
-          "SELECT CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END AS nivel_animo, ROUND(AVG(rendimiento_general), 2) AS rendimiento_promedio FROM partido GROUP BY CASE WHEN estado_animo <= 3 THEN 'Bajo (1-3)' WHEN estado_animo <= 7 THEN 'Medio (4-7)' ELSE 'Alto (8-10)' END ORDER BY rendimiento_promedio DESC LIMIT 1");
-
-    pause_console();
+    mostrar_por_estado_animo("ESTADO DE ANIMO IDEAL PARA JUGAR", "Estado de Animo Ideal", METRICA_RENDIMIENTO, 0, 1);
 }
 /**
  * @brief Obtiene el día de la semana para una fecha dada
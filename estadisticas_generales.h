@@ -3,19 +3,110 @@
  * @brief API de consultas estadísticas globales de rendimiento deportivo
  *
  * Define interfaz para análisis cuantitativo de métricas agregadas por partidos,
- * incluyendo segmentación por clima, día semanal, cansancio y estado anímico,
- * utilizando consultas SQL preparadas con funciones de agrupamiento y JOINs.
+ * incluyendo segmentación por clima, día semanal, cansancio y estado anímico.
+ * Todas las métricas salen de una única pasada (EstadisticasGenerales).
  */
 
 #ifndef ESTADISTICAS_GENERALES_H
 #define ESTADISTICAS_GENERALES_H
 
+/** Bandas de cansancio y de estado de ánimo: bajo (1-3), medio (4-7), alto (8-10) */
+#define BANDA_BAJA 0
+#define BANDA_MEDIA 1
+#define BANDA_ALTA 2
+#define NUM_BANDAS 3
+
+/** Partidos con cansancio alto que compara la caída de rendimiento */
+#define PARTIDOS_CAIDA_CANSANCIO 5
+
+/**
+ * @brief Sumas de un grupo de partidos
+ */
+typedef struct
+{
+    int partidos;           /**< Numero de partidos del grupo */
+    long long goles;        /**< Suma de goles */
+    long long asistencias;  /**< Suma de asistencias */
+    long long rendimiento;  /**< Suma de rendimiento_general */
+    long long cansancio;    /**< Suma de cansancio */
+    long long animo;        /**< Suma de estado_animo */
+    int victorias;          /**< Partidos con resultado 1 */
+    int empates;            /**< Partidos con resultado 2 */
+    int derrotas;           /**< Partidos con resultado 3 */
+} SumasPartidos;
+
+/**
+ * @brief Categorías de camiseta destacada de la pantalla general
+ */
+typedef enum
+{
+    DESTACADA_GOLES,
+    DESTACADA_ASISTENCIAS,
+    DESTACADA_PARTIDOS,
+    DESTACADA_GOLES_ASISTENCIAS,
+    DESTACADA_RENDIMIENTO,
+    DESTACADA_ANIMO,
+    DESTACADA_CANSANCIO,
+    DESTACADA_VICTORIAS,
+    DESTACADA_EMPATES,
+    DESTACADA_DERROTAS,
+    DESTACADA_SORTEADA,
+    NUM_DESTACADAS
+} CategoriaDestacada;
+
+/**
+ * @brief Camiseta destacada en una categoría
+ */
+typedef struct
+{
+    int id;                 /**< ID de la camiseta, 0 si ninguna califica */
+    char nombre[256];       /**< Nombre de la camiseta */
+    double valor;           /**< Total o promedio (sin redondear) de la categoría */
+    int es_promedio;        /**< 1 si valor es un promedio por partido */
+} CamisetaDestacada;
+
+/**
+ * @brief Todas las métricas de las pantallas de estadísticas generales
+ *
+ * Se calcula con una sola pasada sobre la copia en memoria de partido;
+ * la pantalla y las exportaciones de estadísticas generales solo dan
+ * formato a este resultado. Los valores NULL cuentan como 0.
+ */
+typedef struct
+{
+    SumasPartidos total;                    /**< Todos los partidos */
+    SumasPartidos clima[7];                 /**< Por código de clima (1-6); el 0 agrupa los que no tienen */
+    SumasPartidos dia[7];                   /**< Por día de la semana (0 domingo), solo partidos con fecha válida */
+    SumasPartidos cansancio[NUM_BANDAS];    /**< Por banda de cansancio */
+    SumasPartidos animo[NUM_BANDAS];        /**< Por banda de estado de ánimo */
+    int caida_antiguos;                     /**< Partidos con cansancio alto entre los primeros cronológicos */
+    long long caida_rendimiento_antiguos;   /**< Suma de rendimiento de esos partidos */
+    int caida_recientes;                    /**< Partidos con cansancio alto entre los últimos cronológicos */
+    long long caida_rendimiento_recientes;  /**< Suma de rendimiento de esos partidos */
+    CamisetaDestacada destacada[NUM_DESTACADAS]; /**< Camiseta destacada por categoría */
+} EstadisticasGenerales;
+
+/**
+ * @brief Calcula todas las métricas de estadísticas generales
+ *
+ * Recorre una vez la copia en memoria de partido acumulando totales,
+ * sumas por clima, día, banda de cansancio y banda de ánimo y sumas por
+ * camiseta; luego lee la tabla camiseta una vez para elegir las
+ * destacadas. Ante empates gana la camiseta de menor ID. Solo cuentan
+ * las camisetas que existen y tienen partidos (salvo la más sorteada).
+ *
+ * @param resultado Estructura a rellenar
+ * @return 1 si exito, 0 en caso de error
+ */
+int estadisticas_generales_calcular(EstadisticasGenerales *resultado);
+
 /**
  * @brief Muestra las estadísticas principales de las camisetas.
  *
- * Esta función imprime un encabezado y ejecuta varias consultas para mostrar
- * estadísticas como la camiseta con más goles, asistencias, partidos jugados
- * y la suma de goles más asistencias. Al final, pausa la consola.
+ * Esta función imprime un encabezado y muestra, a partir de
+ * estadisticas_generales_calcular(), estadísticas como la camiseta con más
+ * goles, asistencias, partidos jugados y la suma de goles más asistencias.
+ * Al final, pausa la consola.
  */
 void mostrar_estadisticas_generales();
 
@@ -3,7 +3,8 @@
  * @brief Módulo para mostrar estadísticas históricas agrupadas por mes.
  *
  * Este archivo contiene funciones para consultar y mostrar estadísticas
- * individuales por camiseta agrupadas por mes.
+ * individuales por camiseta agrupadas por mes. Cada fila mostrada es una
+ * fila de los resúmenes mensuales (resumenes.h).
  */
 
 #include "estadisticas_mes.h"
@@ -19,11 +20,12 @@
 static void preparar_consulta(sqlite3_stmt **stmt)
 {
     sqlite3_prepare_v2(db,
-                       "SELECT substr(fecha_hora, 4, 7) AS mes_anio, c.nombre, COUNT(*) AS partidos, SUM(goles) AS total_goles, SUM(asistencias) AS total_asistencias, ROUND(AVG(goles), 2) AS avg_goles, ROUND(AVG(asistencias), 2) AS avg_asistencias "
-                       "FROM partido p "
-                       "JOIN camiseta c ON p.camiseta_id = c.id "
-                       "GROUP BY mes_anio, c.id "
-                       "ORDER BY mes_anio DESC, total_goles DESC",
+                       "SELECT printf('%02d/%04d', r.clave % 100, r.clave / 100) AS mes_anio, c.nombre, r.partidos, r.goles, r.asistencias, "
+                       "ROUND(CAST(r.goles AS REAL) / r.partidos, 2), ROUND(CAST(r.asistencias AS REAL) / r.partidos, 2) "
+                       "FROM resumen_partido r "
+                       "JOIN camiseta c ON r.camiseta_id = c.id "
+                       "WHERE r.dimension = 'mes' AND r.clave > 0 "
+                       "ORDER BY r.clave DESC, r.goles DESC",
                        -1, stmt, NULL);
 }
 
@@ -9,7 +9,11 @@
 #include "estadisticas_meta.h"
 #include "db.h"
 #include "utils.h"
+#include "partido_store.h"
+#include "cuantiles.h"
+#include "correlaciones.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <time.h>
@@ -63,6 +67,38 @@ static void query(const char *titulo, const char *sql)
     sqlite3_finalize(stmt);
 }
 
+/**
+ * @brief Muestra el coeficiente de Pearson de un par de variables y su p-valor
+ *
+ * Sale de la matriz de correlaciones, que acumula todos los pares en una
+ * sola pasada sobre la copia en memoria de partido.
+ */
+static void mostrar_correlacion(const char *titulo, VariableCorrelacion a, VariableCorrelacion b)
+{
+    MatrizCorrelacion matriz;
+    char p_valor[16];
+
+    printf("\n%s\n", titulo);
+    printf("----------------------------------------\n");
+
+    if (!correlaciones_calcular(&matriz))
+    {
+        printf("Error al calcular las correlaciones.\n");
+        return;
+    }
+    if (isnan(matriz.r[a][b]))
+    {
+        printf("%-30s : %s\n", "Coeficiente de Pearson", "sin datos suficientes");
+        return;
+    }
+
+    correlacion_formatear_p(matriz.p[a][b], p_valor, sizeof(p_valor));
+    printf("%-30s : %.4f\n", "Coeficiente de Pearson", matriz.r[a][b]);
+    printf("%-30s : %s%s\n", "p-valor", p_valor,
+           matriz.p[a][b] < CORRELACION_ALFA ? " (significativa)" : "");
+    printf("%-30s : %d\n", "Partidos", matriz.n);
+}
+
 /**
  * @brief Muestra la consistencia del rendimiento (variabilidad)
  *
@@ -74,82 +110,250 @@ void mostrar_consistencia_rendimiento()
     clear_screen();
     print_header("CONSISTENCIA DEL RENDIMIENTO");
 
-    // Calcular estadísticas básicas
-    query("Promedio de Rendimiento General",
-          "SELECT ROUND(AVG(rendimiento_general), 2) FROM partido");
+    // Una sola pasada: suma, suma de cuadrados, mínimo y máximo
+    const PartidoStore *store = partido_store_obtener();
+    if (!store || store->n == 0)
+    {
+        printf("\nNo hay partidos registrados.\n");
+        pause_console();
+        return;
+    }
+
+    long long suma = 0, suma_cuadrados = 0;
+    int minimo = store->rendimiento[0], maximo = store->rendimiento[0];
+    for (int i = 0; i < store->n; i++)
+    {
+        int r = store->rendimiento[i];
+        suma += r;
+        suma_cuadrados += (long long)r * r;
+        if (r < minimo)
+            minimo = r;
+        if (r > maximo)
+            maximo = r;
+    }
+
+    double promedio = (double)suma / store->n;
+    double varianza = (double)suma_cuadrados / store->n - promedio * promedio;
+    double desviacion = sqrt(varianza > 0 ? varianza : 0);
 
-    // Calcular desviación estándar
-    query("Desviacion Estandar del Rendimiento",
-          "SELECT ROUND(SQRT(AVG(rendimiento_general * rendimiento_general) - AVG(rendimiento_general) * AVG(rendimiento_general)), 2) FROM partido");
+    printf("\nPromedio de Rendimiento General\n");
+    printf("----------------------------------------\n");
+    printf("%.2f\n", redondear(promedio, 2));
 
-    // Calcular coeficiente de variación
-    query("Coeficiente de Variacion (%)",
-          "SELECT ROUND((SQRT(AVG(rendimiento_general * rendimiento_general) - AVG(rendimiento_general) * AVG(rendimiento_general)) / AVG(rendimiento_general) * 100), 2) FROM partido");
+    printf("\nDesviacion Estandar del Rendimiento\n");
+    printf("----------------------------------------\n");
+    printf("%.2f\n", redondear(desviacion, 2));
 
-    // Mostrar rango de rendimiento
-    query("Rango de Rendimiento (Minimo)",
-          "SELECT MIN(rendimiento_general) FROM partido");
-    query("Rango de Rendimiento (Maximo)",
-          "SELECT MAX(rendimiento_general) FROM partido");
+    printf("\nCoeficiente de Variacion (%%)\n");
+    printf("----------------------------------------\n");
+    if (promedio != 0)
+        printf("%.2f\n", redondear(desviacion / promedio * 100, 2));
+    else
+        printf("N/A\n");
+
+    printf("\nRango de Rendimiento (Minimo)\n");
+    printf("----------------------------------------\n");
+    printf("%d\n", minimo);
+
+    printf("\nRango de Rendimiento (Maximo)\n");
+    printf("----------------------------------------\n");
+    printf("%d\n", maximo);
 
     pause_console();
 }
 
 /**
- * @brief Muestra los partidos atípicos (muy buenos/muy malos)
+ * @brief Entrega el rendimiento_general de todos los partidos leyendo de SQLite
  *
- * Identifica partidos con rendimiento significativamente diferente al promedio.
+ * Fuente de resumen_robusto_streaming() cuando la muestra no cabe en memoria.
+ * Los NULL cuentan como 0, igual que en la copia en memoria.
  */
-void mostrar_partidos_outliers()
+static int fuente_rendimiento(void *contexto, void (*agregar)(void *destino, double valor), void *destino)
 {
-    clear_screen();
-    print_header("PARTIDOS ATIPICOS");
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT rendimiento_general FROM partido");
+    int rc;
+
+    (void)contexto;
+    if (!stmt)
+        return 0;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        agregar(destino, sqlite3_column_double(stmt, 0));
+    db_release_cached(stmt);
+    return rc == SQLITE_DONE;
+}
 
-    // Calcular límites para outliers (1.5 * IQR)
-    printf("\nPartidos con rendimiento excepcionalmente alto:\n");
-    printf("----------------------------------------\n");
+/**
+ * @brief Calcula cuartiles, IQR, mediana y MAD del rendimiento general
+ *
+ * Usa seleccion lineal sobre una copia de la columna en memoria; si la
+ * copia en memoria no esta disponible, la muestra supera
+ * CUANTILES_MAX_SELECCION o no hay memoria para copiarla, estima en
+ * streaming desde SQLite.
+ *
+ * @param resumen Resultado
+ * @return 1 si exito, 0 si no hay partidos o hubo un error
+ */
+static int resumen_rendimiento(ResumenRobusto *resumen)
+{
+    const PartidoStore *store = partido_store_obtener();
+    double *valores = NULL;
+    int ok;
 
+    if (store && store->n == 0)
+    {
+        memset(resumen, 0, sizeof(*resumen));
+        return 0;
+    }
+    if (store && store->n <= CUANTILES_MAX_SELECCION)
+        valores = malloc(sizeof(double) * store->n);
+    if (!valores)
+        return resumen_robusto_streaming(fuente_rendimiento, NULL, resumen);
+
+    for (int i = 0; i < store->n; i++)
+        valores[i] = store->rendimiento[i];
+    ok = resumen_robusto(valores, store->n, resumen);
+    free(valores);
+    return ok;
+}
+
+/**
+ * @brief Lista los partidos atipicos por encima o por debajo de la mediana
+ *
+ * La consulta trae los partidos mas alla del mas cercano de los dos
+ * limites (valla de Tukey o z robusta); cada fila se vuelve a comprobar
+ * con ambos criterios para indicar cual la marca.
+ *
+ * @param resumen Resumen robusto del rendimiento
+ * @param altos 1 para los excepcionalmente altos, 0 para los bajos
+ */
+static void listar_atipicos(const ResumenRobusto *resumen, int altos)
+{
+    double valla = altos ? resumen->q3 + TUKEY_FACTOR * resumen->iqr : resumen->q1 - TUKEY_FACTOR * resumen->iqr;
+    double limite = valla;
     sqlite3_stmt *stmt;
-    const char *sql = "SELECT id, fecha_hora, rendimiento_general, goles, asistencias "
-                      "FROM partido "
-                      "WHERE rendimiento_general > (SELECT AVG(rendimiento_general) + 1.5 * (SELECT (PERCENTILE_CONT(0.75) WITHIN GROUP (ORDER BY rendimiento_general) - PERCENTILE_CONT(0.25) WITHIN GROUP (ORDER BY rendimiento_general)) FROM partido) FROM partido) "
-                      "ORDER BY rendimiento_general DESC";
+    int listados = 0;
 
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+    if (resumen->mad > 0)
+    {
+        double limite_z = resumen->mediana + (altos ? 1 : -1) * Z_ROBUSTA_LIMITE * resumen->mad / 0.6745;
+        if (altos ? limite_z < limite : limite_z > limite)
+            limite = limite_z;
+    }
+
+    stmt = db_prepare_cached(altos
+                             ? "SELECT id, fecha_hora, rendimiento_general, goles, asistencias FROM partido "
+                             "WHERE rendimiento_general > ? ORDER BY rendimiento_general DESC, id"
+                             : "SELECT id, fecha_hora, rendimiento_general, goles, asistencias FROM partido "
+                             "WHERE rendimiento_general < ? ORDER BY rendimiento_general ASC, id");
+    if (!stmt)
+        return;
+    sqlite3_bind_double(stmt, 1, limite);
 
     while (sqlite3_step(stmt) == SQLITE_ROW)
     {
-        printf("Partido ID: %d, Fecha: %s, Rendimiento: %d, Goles: %d, Asistencias: %d\n",
+        int rendimiento = sqlite3_column_int(stmt, 2);
+        double z = z_robusta(resumen, rendimiento);
+        int tukey = fuera_de_vallas(resumen, rendimiento) != 0;
+        int robusta = fabs(z) > Z_ROBUSTA_LIMITE;
+
+        if (!tukey && !robusta)
+            continue;
+        printf("Partido ID: %d, Fecha: %s, Rendimiento: %d, Goles: %d, Asistencias: %d, z robusta: %.2f, Criterio: %s\n",
                sqlite3_column_int(stmt, 0),
                sqlite3_column_text(stmt, 1),
-               sqlite3_column_int(stmt, 2),
+               rendimiento,
                sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4));
+               sqlite3_column_int(stmt, 4),
+               z,
+               tukey && robusta ? "Tukey y z robusta" : (tukey ? "Tukey" : "z robusta"));
+        listados++;
     }
+    db_release_cached(stmt);
 
-    sqlite3_finalize(stmt);
+    if (listados == 0)
+        printf("Ninguno.\n");
+}
+
+/**
+ * @brief Muestra los partidos atípicos (muy buenos/muy malos)
+ *
+ * Identifica partidos con rendimiento significativamente diferente al
+ * habitual: fuera de las vallas de Tukey (1.5 * IQR) o con puntuación z
+ * robusta (basada en la mediana y la MAD) mayor que 3.5 en valor absoluto.
+ */
+void mostrar_partidos_outliers()
+{
+    ResumenRobusto resumen;
+
+    clear_screen();
+    print_header("PARTIDOS ATIPICOS");
+
+    if (!resumen_rendimiento(&resumen))
+    {
+        printf("\nNo hay partidos registrados.\n");
+        pause_console();
+        return;
+    }
+
+    printf("\nDistribucion del Rendimiento General (%d partidos, %s)\n",
+           resumen.n, resumen.exacto ? "exacta" : "estimada en streaming");
+    printf("----------------------------------------\n");
+    printf("%-30s : %.2f\n", "Primer cuartil (Q1)", resumen.q1);
+    printf("%-30s : %.2f\n", "Mediana", resumen.mediana);
+    printf("%-30s : %.2f\n", "Tercer cuartil (Q3)", resumen.q3);
+    printf("%-30s : %.2f\n", "Rango intercuartil (IQR)", resumen.iqr);
+    printf("%-30s : %.2f\n", "MAD", resumen.mad);
+    printf("%-30s : %.2f a %.2f\n", "Vallas de Tukey",
+           resumen.q1 - TUKEY_FACTOR * resumen.iqr, resumen.q3 + TUKEY_FACTOR * resumen.iqr);
+    if (resumen.mad > 0)
+        printf("%-30s : |z| > %.1f\n", "Z robusta", Z_ROBUSTA_LIMITE);
+    else
+        printf("%-30s : no aplica (MAD = 0)\n", "Z robusta");
+
+    printf("\nPartidos con rendimiento excepcionalmente alto:\n");
+    printf("----------------------------------------\n");
+    listar_atipicos(&resumen, 1);
 
     printf("\nPartidos con rendimiento excepcionalmente bajo:\n");
     printf("----------------------------------------\n");
+    listar_atipicos(&resumen, 0);
 
-    const char *sql2 = "SELECT id, fecha_hora, rendimiento_general, goles, asistencias "
-                       "FROM partido "
-                       "WHERE rendimiento_general < (SELECT AVG(rendimiento_general) - 1.5 * (SELECT (PERCENTILE_CONT(0.75) WITHIN GROUP (ORDER BY rendimiento_general) - PERCENTILE_CONT(0.25) WITHIN GROUP (ORDER BY rendimiento_general)) FROM partido) FROM partido) "
-                       "ORDER BY rendimiento_general ASC";
+    pause_console();
+}
 
-    sqlite3_prepare_v2(db, sql2, -1, &stmt, NULL);
+/**
+ * @brief Muestra la matriz de correlaciones como mapa de calor
+ *
+ * Cada celda lleva el coeficiente de Pearson, un simbolo que crece con |r|
+ * y un asterisco si el p-valor queda por debajo de CORRELACION_ALFA. Debajo
+ * se listan todos los pares de mayor a menor |r| con su p-valor.
+ */
+void mostrar_matriz_correlaciones()
+{
+    MatrizCorrelacion matriz;
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    clear_screen();
+    print_header("MATRIZ DE CORRELACIONES");
+
+    if (!correlaciones_calcular(&matriz))
     {
-        printf("Partido ID: %d, Fecha: %s, Rendimiento: %d, Goles: %d, Asistencias: %d\n",
-               sqlite3_column_int(stmt, 0),
-               sqlite3_column_text(stmt, 1),
-               sqlite3_column_int(stmt, 2),
-               sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4));
+        printf("Error al calcular las correlaciones.\n");
+        pause_console();
+        return;
+    }
+    if (matriz.n == 0)
+    {
+        printf("No hay partidos registrados.\n");
+        pause_console();
+        return;
     }
 
-    sqlite3_finalize(stmt);
+    printf("Partidos analizados: %d\n\n", matriz.n);
+    correlaciones_escribir_mapa(stdout, &matriz);
+
+    printf("\nPares de mayor a menor |r|\n");
+    printf("----------------------------------------\n");
+    correlaciones_escribir_pares(stdout, &matriz);
 
     pause_console();
 }
@@ -169,11 +373,14 @@ void mostrar_dependencia_contexto()
 
     // Rendimiento por clima
     query("Rendimiento por Clima",
-          "SELECT clima, ROUND(AVG(rendimiento_general), 2), COUNT(*) FROM partido GROUP BY clima ORDER BY AVG(rendimiento_general) DESC");
+          "SELECT clave, ROUND(CAST(SUM(rendimiento) AS REAL) / SUM(partidos), 2), SUM(partidos) FROM resumen_partido "
+          "WHERE dimension = 'clima' GROUP BY clave ORDER BY CAST(SUM(rendimiento) AS REAL) / SUM(partidos) DESC");
 
     // Rendimiento por día de semana
     query("Rendimiento por Dia de Semana",
-          "SELECT CASE strftime('%w', fecha_hora) WHEN '0' THEN 'Domingo' WHEN '1' THEN 'Lunes' WHEN '2' THEN 'Martes' WHEN '3' THEN 'Miércoles' WHEN '4' THEN 'Jueves' WHEN '5' THEN 'Viernes' WHEN '6' THEN 'Sábado' ELSE 'Desconocido' END AS dia, ROUND(AVG(rendimiento_general), 2), COUNT(*) FROM partido GROUP BY dia ORDER BY AVG(rendimiento_general) DESC");
+          "SELECT CASE clave WHEN 0 THEN 'Domingo' WHEN 1 THEN 'Lunes' WHEN 2 THEN 'Martes' WHEN 3 THEN 'Miércoles' WHEN 4 THEN 'Jueves' WHEN 5 THEN 'Viernes' WHEN 6 THEN 'Sábado' ELSE 'Desconocido' END AS dia, "
+          "ROUND(CAST(SUM(rendimiento) AS REAL) / SUM(partidos), 2), SUM(partidos) FROM resumen_partido "
+          "WHERE dimension = 'dia' GROUP BY clave ORDER BY CAST(SUM(rendimiento) AS REAL) / SUM(partidos) DESC");
 
     // Rendimiento por resultado
     query("Rendimiento por Resultado",
@@ -193,11 +400,7 @@ void mostrar_impacto_real_cansancio()
     print_header("IMPACTO REAL DEL CANSANCIO");
 
     // Correlacion entre cansancio y rendimiento
-    query("Correlacion Cansancio-Rendimiento",
-          "SELECT ROUND((COUNT(*) * SUM(cansancio * rendimiento_general) - SUM(cansancio) * SUM(rendimiento_general)) / "
-          "(SQRT((COUNT(*) * SUM(cansancio * cansancio) - SUM(cansancio) * SUM(cansancio)) * "
-          "(COUNT(*) * SUM(rendimiento_general * rendimiento_general) - SUM(rendimiento_general) * SUM(rendimiento_general)))), 4) "
-          "FROM partido");
+    mostrar_correlacion("Correlacion Cansancio-Rendimiento", CORR_CANSANCIO, CORR_RENDIMIENTO);
 
     // Rendimiento por nivel de cansancio
     query("Rendimiento por Nivel de Cansancio",
@@ -232,11 +435,7 @@ void mostrar_impacto_real_estado_animo()
     print_header("IMPACTO REAL DEL ESTADO DE ÁNIMO");
 
     // Correlacion entre estado de ánimo y rendimiento
-    query("Correlacion Estado de Animo-Rendimiento",
-          "SELECT ROUND((COUNT(*) * SUM(estado_animo * rendimiento_general) - SUM(estado_animo) * SUM(rendimiento_general)) / "
-          "(SQRT((COUNT(*) * SUM(estado_animo * estado_animo) - SUM(estado_animo) * SUM(estado_animo)) * "
-          "(COUNT(*) * SUM(rendimiento_general * rendimiento_general) - SUM(rendimiento_general) * SUM(rendimiento_general)))), 4) "
-          "FROM partido");
+    mostrar_correlacion("Correlacion Estado de Animo-Rendimiento", CORR_ANIMO, CORR_RENDIMIENTO);
 
     // Rendimiento por nivel de estado de ánimo
     query("Rendimiento por Nivel de Estado de Animo",
@@ -271,11 +470,7 @@ void mostrar_eficiencia_goles_vs_rendimiento()
     print_header("EFICIENCIA: GOLES POR PARTIDO VS RENDIMIENTO");
 
     // Correlacion entre goles y rendimiento
-    query("Correlacion Goles-Rendimiento",
-          "SELECT ROUND((COUNT(*) * SUM(goles * rendimiento_general) - SUM(goles) * SUM(rendimiento_general)) / "
-          "(SQRT((COUNT(*) * SUM(goles * goles) - SUM(goles) * SUM(goles)) * "
-          "(COUNT(*) * SUM(rendimiento_general * rendimiento_general) - SUM(rendimiento_general) * SUM(rendimiento_general)))), 4) "
-          "FROM partido");
+    mostrar_correlacion("Correlacion Goles-Rendimiento", CORR_GOLES, CORR_RENDIMIENTO);
 
     // Eficiencia por rango de goles
     query("Eficiencia por Rango de Goles",
@@ -304,11 +499,7 @@ void mostrar_eficiencia_asistencias_vs_cansancio()
     print_header("EFICIENCIA: ASISTENCIAS VS CANSANCIO");
 
     // Correlacion entre asistencias y cansancio
-    query("Correlacion Asistencias-Cansancio",
-          "SELECT ROUND((COUNT(*) * SUM(asistencias * cansancio) - SUM(asistencias) * SUM(cansancio)) / "
-          "(SQRT((COUNT(*) * SUM(asistencias * asistencias) - SUM(asistencias) * SUM(asistencias)) * "
-          "(COUNT(*) * SUM(cansancio * cansancio) - SUM(cansancio) * SUM(cansancio)))), 4) "
-          "FROM partido");
+    mostrar_correlacion("Correlacion Asistencias-Cansancio", CORR_ASISTENCIAS, CORR_CANSANCIO);
 
     // Asistencias por nivel de cansancio
     query("Asistencias por Nivel de Cansancio",
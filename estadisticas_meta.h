@@ -16,6 +16,11 @@ void mostrar_consistencia_rendimiento();
  */
 void mostrar_partidos_outliers();
 
+/**
+ * @brief Muestra la matriz de correlaciones de los atributos de partido como mapa de calor
+ */
+void mostrar_matriz_correlaciones();
+
 /**
  * @brief Muestra la dependencia del contexto
  */
@@ -10,6 +10,8 @@
 #include "db.h"
 #include "utils.h"
 #include "cJSON.h"
+#include "partido_store.h"
+#include "rachas.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <direct.h>
@@ -73,8 +75,8 @@ char *get_export_path(const char *filename)
 /* ===================== HELPER FUNCTIONS (STATIC) ===================== */
 
 /* Forward declarations of static functions */
-static void calcular_estadisticas_generales(Estadisticas *stats);
-static void calcular_estadisticas_ultimos5(Estadisticas *stats);
+static void calcular_estadisticas_generales(const PartidoStore *store, Estadisticas *stats);
+static void calcular_estadisticas_ultimos5(const PartidoStore *store, Estadisticas *stats);
 static void calcular_rachas(int *mejor_racha_victorias, int *peor_racha_derrotas);
 static int has_partido_records();
 
@@ -85,15 +87,8 @@ static int has_partido_records();
  */
 static int has_partido_records()
 {
-    sqlite3_stmt *check_stmt;
-    int count = 0;
-    sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM partido", -1, &check_stmt, NULL);
-    if (sqlite3_step(check_stmt) == SQLITE_ROW)
-    {
-        count = sqlite3_column_int(check_stmt, 0);
-    }
-    sqlite3_finalize(check_stmt);
-    return count > 0;
+    const PartidoStore *store = partido_store_obtener();
+    return store && store->n > 0;
 }
 
 /**
@@ -102,108 +97,81 @@ static int has_partido_records()
  */
 static void calcular_todas_estadisticas(Estadisticas *generales, Estadisticas *ultimos5, int *mejor_racha_v, int *peor_racha_d)
 {
-    calcular_estadisticas_generales(generales);
-    calcular_estadisticas_ultimos5(ultimos5);
+    const PartidoStore *store = partido_store_obtener();
+
+    *mejor_racha_v = 0;
+    *peor_racha_d = 0;
+    if (!store)
+        return;
+
+    calcular_estadisticas_generales(store, generales);
+    calcular_estadisticas_ultimos5(store, ultimos5);
     calcular_rachas(mejor_racha_v, peor_racha_d);
 }
 
 /* ===================== ANALISIS ===================== */
 
 /**
- * Calcula estadísticas generales de todos los partidos.
- * Esta función es utilizada por el análisis de rendimiento para obtener métricas globales.
+ * Promedia las métricas de los partidos en las posiciones [desde, hasta) de la copia en memoria.
  */
-static void calcular_estadisticas_generales(Estadisticas *stats)
+static void promediar_tramo(const PartidoStore *store, int desde, int hasta, Estadisticas *stats)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT COUNT(*), AVG(goles), AVG(asistencias), AVG(rendimiento_general), AVG(cansancio), AVG(estado_animo) "
-                       "FROM partido",
-                       -1, &stmt, NULL);
+    long long goles = 0, asistencias = 0, rendimiento = 0, cansancio = 0, animo = 0;
+
+    for (int i = desde; i < hasta; i++)
+    {
+        goles += store->goles[i];
+        asistencias += store->asistencias[i];
+        rendimiento += store->rendimiento[i];
+        cansancio += store->cansancio[i];
+        animo += store->animo[i];
+    }
 
-    if (sqlite3_step(stmt) == SQLITE_ROW)
+    stats->total_partidos = hasta - desde;
+    if (stats->total_partidos > 0)
     {
-        stats->total_partidos = sqlite3_column_int(stmt, 0);
-        stats->avg_goles = sqlite3_column_double(stmt, 1);
-        stats->avg_asistencias = sqlite3_column_double(stmt, 2);
-        stats->avg_rendimiento = sqlite3_column_double(stmt, 3);
-        stats->avg_cansancio = sqlite3_column_double(stmt, 4);
-        stats->avg_animo = sqlite3_column_double(stmt, 5);
+        stats->avg_goles = (double)goles / stats->total_partidos;
+        stats->avg_asistencias = (double)asistencias / stats->total_partidos;
+        stats->avg_rendimiento = (double)rendimiento / stats->total_partidos;
+        stats->avg_cansancio = (double)cansancio / stats->total_partidos;
+        stats->avg_animo = (double)animo / stats->total_partidos;
     }
-    sqlite3_finalize(stmt);
+}
+
+/**
+ * Calcula estadísticas generales de todos los partidos.
+ * Esta función es utilizada por el análisis de rendimiento para obtener métricas globales.
+ */
+static void calcular_estadisticas_generales(const PartidoStore *store, Estadisticas *stats)
+{
+    promediar_tramo(store, 0, store->n, stats);
 }
 
 /**
  * @brief Calcula estadísticas de los últimos 5 partidos
  *
+ * @param store Copia en memoria de partido (en orden cronológico)
  * @param stats Puntero a la estructura donde almacenar las estadísticas
  */
-static void calcular_estadisticas_ultimos5(Estadisticas *stats)
+static void calcular_estadisticas_ultimos5(const PartidoStore *store, Estadisticas *stats)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT COUNT(*), AVG(goles), AVG(asistencias), AVG(rendimiento_general), AVG(cansancio), AVG(estado_animo) "
-                       "FROM (SELECT * FROM partido ORDER BY fecha_hora DESC LIMIT 5)",
-                       -1, &stmt, NULL);
-
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        stats->total_partidos = sqlite3_column_int(stmt, 0);
-        stats->avg_goles = sqlite3_column_double(stmt, 1);
-        stats->avg_asistencias = sqlite3_column_double(stmt, 2);
-        stats->avg_rendimiento = sqlite3_column_double(stmt, 3);
-        stats->avg_cansancio = sqlite3_column_double(stmt, 4);
-        stats->avg_animo = sqlite3_column_double(stmt, 5);
-    }
-    sqlite3_finalize(stmt);
+    promediar_tramo(store, store->n > 5 ? store->n - 5 : 0, store->n, stats);
 }
 
 /**
- * @brief Calcula la racha más larga de victorias y derrotas
+ * @brief Obtiene la racha más larga de victorias y de derrotas
  *
  * @param mejor_racha_victorias Puntero donde almacenar la mejor racha de victorias
  * @param peor_racha_derrotas Puntero donde almacenar la peor racha de derrotas
  */
 static void calcular_rachas(int *mejor_racha_victorias, int *peor_racha_derrotas)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT resultado FROM partido ORDER BY fecha_hora",
-                       -1, &stmt, NULL);
-
-    int racha_actual_v = 0, max_racha_v = 0;
-    int racha_actual_d = 0, max_racha_d = 0;
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        int resultado = sqlite3_column_int(stmt, 0);
-        if (resultado == 1)
-        {
-            // VICTORIA
-            racha_actual_v++;
-            if (racha_actual_v > max_racha_v)
-                max_racha_v = racha_actual_v;
-            racha_actual_d = 0;
-        }
-        else if (resultado == 3)
-        {
-            // DERROTA
-            racha_actual_d++;
-            if (racha_actual_d > max_racha_d)
-                max_racha_d = racha_actual_d;
-            racha_actual_v = 0;
-        }
-        else
-        {
-            // EMPATE
-            racha_actual_v = 0;
-            racha_actual_d = 0;
-        }
-    }
+    Racha racha;
 
-    *mejor_racha_victorias = max_racha_v;
-    *peor_racha_derrotas = max_racha_d;
-    sqlite3_finalize(stmt);
+    rachas_mejor(RACHA_VICTORIAS, RACHAS_TODAS, &racha);
+    *mejor_racha_victorias = racha.largo;
+    rachas_mejor(RACHA_DERROTAS, RACHAS_TODAS, &racha);
+    *peor_racha_derrotas = racha.largo;
 }
 
 /**
@@ -14,11 +14,13 @@
 #include "export_lesiones.h"
 #include "export_estadisticas.h"
 #include "export_estadisticas_generales.h"
+#include "export_correlaciones.h"
 #include "export_records_rankings.h"
 #include "utils.h"
 #include "menu.h"
 #include "ascii_art.h"
 #include <stdio.h>
+#include <string.h>
 
 /**
  * @brief Exportación integral de datos de camisetas
@@ -135,6 +137,24 @@ static void exportar_estadisticas_generales_todo()
     pause_console();
 }
 
+/**
+ * @brief Exportación integral de la matriz de correlaciones
+ *
+ * Exporta en todos los formatos la matriz de correlaciones entre los atributos
+ * de los partidos, con sus p-valores, para revisar qué factores se mueven juntos.
+ */
+static void exportar_correlaciones_todo()
+{
+    printf("Exportando correlaciones...\n");
+    exportar_correlaciones_csv();
+    exportar_correlaciones_txt();
+    exportar_correlaciones_json();
+    exportar_correlaciones_html();
+    printf("Exportacion de correlaciones completada.\n");
+    printf("%s\n", ASCII_EXPORT_EXITOSO);
+    pause_console();
+}
+
 /**
  * @brief Exportación integral de estadísticas mensuales
  *
@@ -368,6 +388,12 @@ static void exportar_todo()
     exportar_records_rankings_json();
     exportar_records_rankings_html();
 
+    // Exportar matriz de correlaciones
+    exportar_correlaciones_csv();
+    exportar_correlaciones_txt();
+    exportar_correlaciones_json();
+    exportar_correlaciones_html();
+
     printf("Exportacion de todo completada.\n");
     printf("%s\n", ASCII_EXPORT_EXITOSO);
     pause_console();
@@ -401,9 +427,60 @@ static void menu_exportar_estadisticas_generales()
         {2, "Estadisticas Por Mes", exportar_estadisticas_por_mes_todo},
         {3, "Estadisticas Por Anio", exportar_estadisticas_por_anio_todo},
         {4, "Records & Rankings", exportar_records_rankings_todo},
+        {5, "Correlaciones", exportar_correlaciones_todo},
         {0, "Volver", NULL}
     };
-    ejecutar_menu("EXPORTAR ESTADISTICAS GENERALES", items, 5);
+    ejecutar_menu("EXPORTAR ESTADISTICAS GENERALES", items, 6);
+}
+
+/**
+ * @brief Asociacion entre un nombre de linea de comandos y una exportacion
+ */
+typedef struct
+{
+    const char *nombre;
+    void (*accion)();
+} ExportacionNombrada;
+
+/**
+ * @brief Exportaciones disponibles desde la linea de comandos (--export <nombre>)
+ */
+static const ExportacionNombrada EXPORTACIONES[] =
+{
+    {"all", exportar_todo},
+    {"camisetas", exportar_camisetas_todo},
+    {"partidos", exportar_partidos_todo},
+    {"partido-mas-goles", exportar_partido_mas_goles_todo},
+    {"partido-mas-asistencias", exportar_partido_mas_asistencias_todo},
+    {"partido-menos-goles", exportar_partido_menos_goles_reciente_todo},
+    {"partido-menos-asistencias", exportar_partido_menos_asistencias_reciente_todo},
+    {"lesiones", exportar_lesiones_todo},
+    {"estadisticas", exportar_estadisticas_todo},
+    {"analisis", exportar_analisis_todo},
+    {"analisis-avanzado", exportar_todo_mejorado},
+    {"estadisticas-generales", exportar_estadisticas_generales_todo},
+    {"estadisticas-mes", exportar_estadisticas_por_mes_todo},
+    {"estadisticas-anio", exportar_estadisticas_por_anio_todo},
+    {"records-rankings", exportar_records_rankings_todo},
+    {"correlaciones", exportar_correlaciones_todo}
+};
+
+int exportar_por_nombre(const char *nombre)
+{
+    for (size_t i = 0; i < sizeof(EXPORTACIONES) / sizeof(EXPORTACIONES[0]); i++)
+    {
+        if (strcmp(EXPORTACIONES[i].nombre, nombre) == 0)
+        {
+            EXPORTACIONES[i].accion();
+            return 1;
+        }
+    }
+
+    printf("Exportacion desconocida: %s\nDisponibles:", nombre);
+    for (size_t i = 0; i < sizeof(EXPORTACIONES) / sizeof(EXPORTACIONES[0]); i++)
+        printf(" %s", EXPORTACIONES[i].nombre);
+    printf("\n");
+    return 0;
 }
 
 /**
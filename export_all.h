@@ -37,3 +37,17 @@
  * @see exportar_todo()
  */
 void menu_exportar();
+
+/**
+ * @brief Ejecuta una exportacion identificada por nombre, sin menu
+ *
+ * Punto de entrada del modo de linea de comandos (--export <nombre>). Los
+ * nombres validos son "all", "camisetas", "partidos", "lesiones",
+ * "estadisticas", "analisis", "analisis-avanzado", "estadisticas-generales",
+ * "estadisticas-mes", "estadisticas-anio", "records-rankings" y los partidos
+ * destacados ("partido-mas-goles", etc.).
+ *
+ * @param nombre Nombre de la exportacion
+ * @return 1 si el nombre es valido y se ejecuto, 0 en caso contrario
+ */
+int exportar_por_nombre(const char *nombre);
@@ -0,0 +1,227 @@
+/**
+ * @file export_correlaciones.c
+ * @brief Funciones de exportación de la matriz de correlaciones
+ *
+ * Todas las exportaciones dan formato al resultado de
+ * correlaciones_calcular(), el mismo que muestra la pantalla de
+ * meta-análisis.
+ */
+
+#include "export_correlaciones.h"
+#include "correlaciones.h"
+#include "export.h"
+#include "cJSON.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ============================================================================
+ * HELPER ESTÁTICOS
+ * ============================================================================ */
+
+/**
+ * @brief Calcula la matriz y verifica que haya partidos para exportar
+ *
+ * @return 1 si hay datos, 0 si no (ya avisado por consola)
+ */
+static int preparar_matriz(MatrizCorrelacion *matriz)
+{
+    if (!correlaciones_calcular(matriz) || matriz->n == 0)
+    {
+        printf("No hay registros.\n");
+        return 0;
+    }
+    return 1;
+}
+
+/** @brief Número JSON, o null si no está definido */
+static cJSON *json_numero(double valor)
+{
+    return isnan(valor) ? cJSON_CreateNull() : cJSON_CreateNumber(valor);
+}
+
+/**
+ * @brief Color de fondo de una celda del mapa de calor
+ *
+ * Interpola desde blanco hacia azul (r > 0) o rojo (r < 0) según |r|.
+ */
+static void color_celda(double r, char *color, size_t tam)
+{
+    double t = isnan(r) ? 0.0 : fabs(r);
+    int rojo = r < 0 ? 214 : 33;
+    int verde = r < 0 ? 39 : 102;
+    int azul = r < 0 ? 40 : 172;
+
+    snprintf(color, tam, "#%02x%02x%02x",
+             (int)(255 + (rojo - 255) * t),
+             (int)(255 + (verde - 255) * t),
+             (int)(255 + (azul - 255) * t));
+}
+
+/* ============================================================================
+ * EXPORTACIÓN
+ * ============================================================================ */
+
+void exportar_correlaciones_csv(void)
+{
+    MatrizCorrelacion m;
+
+    if (!preparar_matriz(&m))
+        return;
+
+    const char *path = get_export_path("correlaciones.csv");
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("Error CSV\n");
+        return;
+    }
+
+    fprintf(file, "variable_a,variable_b,r,p_valor,significativa,partidos\n");
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+    {
+        for (int b = a + 1; b < NUM_VARIABLES_CORRELACION; b++)
+        {
+            fprintf(file, "%s,%s,", correlacion_nombre(a), correlacion_nombre(b));
+            if (isnan(m.r[a][b]))
+                fprintf(file, ",,,%d\n", m.n);
+            else
+                fprintf(file, "%.4f,%.6g,%d,%d\n", m.r[a][b], m.p[a][b],
+                        m.p[a][b] < CORRELACION_ALFA, m.n);
+        }
+    }
+
+    fclose(file);
+    printf("Exportado: %s\n", path);
+}
+
+void exportar_correlaciones_txt(void)
+{
+    MatrizCorrelacion m;
+
+    if (!preparar_matriz(&m))
+        return;
+
+    const char *path = get_export_path("correlaciones.txt");
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("Error TXT\n");
+        return;
+    }
+
+    fprintf(file, "MATRIZ DE CORRELACIONES\n");
+    fprintf(file, "=======================\n\n");
+    fprintf(file, "Partidos analizados: %d\n\n", m.n);
+    correlaciones_escribir_mapa(file, &m);
+    fprintf(file, "\nPares de mayor a menor |r|\n");
+    fprintf(file, "----------------------------------------\n");
+    correlaciones_escribir_pares(file, &m);
+
+    fclose(file);
+    printf("Exportado: %s\n", path);
+}
+
+void exportar_correlaciones_json(void)
+{
+    MatrizCorrelacion m;
+
+    if (!preparar_matriz(&m))
+        return;
+
+    const char *path = get_export_path("correlaciones.json");
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("Error JSON\n");
+        return;
+    }
+
+    cJSON *root = cJSON_CreateObject();
+    cJSON *corr = cJSON_CreateObject();
+    cJSON *variables = cJSON_CreateArray();
+    cJSON *r = cJSON_CreateArray();
+    cJSON *p = cJSON_CreateArray();
+
+    cJSON_AddNumberToObject(corr, "partidos", m.n);
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+    {
+        cJSON *fila_r = cJSON_CreateArray();
+        cJSON *fila_p = cJSON_CreateArray();
+
+        cJSON_AddItemToArray(variables, cJSON_CreateString(correlacion_nombre(a)));
+        for (int b = 0; b < NUM_VARIABLES_CORRELACION; b++)
+        {
+            cJSON_AddItemToArray(fila_r, json_numero(m.r[a][b]));
+            cJSON_AddItemToArray(fila_p, json_numero(m.p[a][b]));
+        }
+        cJSON_AddItemToArray(r, fila_r);
+        cJSON_AddItemToArray(p, fila_p);
+    }
+    cJSON_AddItemToObject(corr, "variables", variables);
+    cJSON_AddItemToObject(corr, "r", r);
+    cJSON_AddItemToObject(corr, "p_valor", p);
+    cJSON_AddItemToObject(root, "correlaciones", corr);
+
+    char *json_str = cJSON_Print(root);
+    fprintf(file, "%s", json_str);
+
+    free(json_str);
+    cJSON_Delete(root);
+    fclose(file);
+    printf("Exportado: %s\n", path);
+}
+
+void exportar_correlaciones_html(void)
+{
+    MatrizCorrelacion m;
+
+    if (!preparar_matriz(&m))
+        return;
+
+    const char *path = get_export_path("correlaciones.html");
+    FILE *file = fopen(path, "w");
+    if (!file)
+    {
+        printf("Error HTML\n");
+        return;
+    }
+
+    fprintf(file, "<!DOCTYPE html>\n<html>\n<head><title>Correlaciones</title>\n");
+    fprintf(file, "<style>td{text-align:center;width:90px;padding:6px}</style>\n</head>\n");
+    fprintf(file, "<body>\n<h1>Matriz de Correlaciones</h1>\n");
+    fprintf(file, "<p>Partidos analizados: %d</p>\n<table border='1'>\n<tr><th></th>", m.n);
+    for (int b = 0; b < NUM_VARIABLES_CORRELACION; b++)
+        fprintf(file, "<th>%s</th>", correlacion_nombre(b));
+    fprintf(file, "</tr>\n");
+
+    for (int a = 0; a < NUM_VARIABLES_CORRELACION; a++)
+    {
+        fprintf(file, "<tr><th>%s</th>", correlacion_nombre(a));
+        for (int b = 0; b < NUM_VARIABLES_CORRELACION; b++)
+        {
+            double r = m.r[a][b];
+            char color[8];
+            char p_valor[16];
+
+            if (isnan(r))
+            {
+                fprintf(file, "<td>-</td>");
+                continue;
+            }
+            color_celda(r, color, sizeof(color));
+            correlacion_formatear_p(m.p[a][b], p_valor, sizeof(p_valor));
+            fprintf(file, "<td style='background:%s;color:%s' title='p = %s'>%+.2f%s</td>",
+                    color, fabs(r) >= 0.5 ? "#fff" : "#000", p_valor, r,
+                    a != b && m.p[a][b] < CORRELACION_ALFA ? "*" : "");
+        }
+        fprintf(file, "</tr>\n");
+    }
+
+    fprintf(file, "</table>\n");
+    fprintf(file, "<p>Azul: correlaci&oacute;n positiva. Rojo: negativa. "
+            "* p-valor &lt; %.2f (prueba t con n - 2 grados de libertad).</p>\n", CORRELACION_ALFA);
+    fprintf(file, "</body>\n</html>\n");
+    fclose(file);
+    printf("Exportado: %s\n", path);
+}
@@ -0,0 +1,71 @@
+/**
+ * @file export_correlaciones.h
+ * @brief Funciones para exportar la matriz de correlaciones de los partidos
+ *
+ * Exporta en CSV, TXT, JSON y HTML la misma matriz que muestra la pantalla
+ * de meta-análisis (correlaciones_calcular): coeficiente de Pearson y
+ * p-valor para cada par de goles, asistencias, rendimiento, cansancio,
+ * ánimo, clima y día.
+ *
+ * @note Requiere que la base de datos esté inicializada (variable global 'db')
+ */
+
+#ifndef EXPORT_CORRELACIONES_H
+#define EXPORT_CORRELACIONES_H
+
+/**
+ * @brief Exporta la matriz de correlaciones a formato CSV
+ *
+ * Una fila por par de variables distintas: variable_a, variable_b, r,
+ * p_valor, significativa (1 si p < 0.05) y partidos. Los coeficientes no
+ * definidos (variable constante) quedan vacíos.
+ *
+ * @pre La base de datos debe contener registros en la tabla 'partido'
+ * @post Crea el archivo 'correlaciones.csv' en el directorio de exportación
+ */
+void exportar_correlaciones_csv();
+
+/**
+ * @brief Exporta la matriz de correlaciones a formato TXT
+ *
+ * Mapa de calor en texto, igual que la pantalla, seguido de los pares
+ * ordenados por |r|.
+ *
+ * @pre La base de datos debe contener registros en la tabla 'partido'
+ * @post Crea el archivo 'correlaciones.txt' en el directorio de exportación
+ */
+void exportar_correlaciones_txt();
+
+/**
+ * @brief Exporta la matriz de correlaciones a formato JSON
+ *
+ * Estructura del JSON (null donde el coeficiente no está definido):
+ * @code
+ * {
+ *   "correlaciones": {
+ *     "partidos": N,
+ *     "variables": ["Goles", "Asistencias", ...],
+ *     "r": [[1, 0.12, ...], ...],
+ *     "p_valor": [[0, 0.003, ...], ...]
+ *   }
+ * }
+ * @endcode
+ *
+ * @pre La base de datos debe contener registros en la tabla 'partido'
+ * @post Crea el archivo 'correlaciones.json' en el directorio de exportación
+ */
+void exportar_correlaciones_json();
+
+/**
+ * @brief Exporta la matriz de correlaciones a formato HTML
+ *
+ * Tabla con forma de mapa de calor: azul para correlaciones positivas y
+ * rojo para negativas, con una intensidad proporcional a |r|. Las celdas
+ * significativas llevan un asterisco y el p-valor va en el título de la celda.
+ *
+ * @pre La base de datos debe contener registros en la tabla 'partido'
+ * @post Crea el archivo 'correlaciones.html' en el directorio de exportación
+ */
+void exportar_correlaciones_html();
+
+#endif /* EXPORT_CORRELACIONES_H */
@@ -22,9 +22,11 @@ static const char *SQL_STATS_BY_CAMISETA =
     "GROUP BY c.id";
 
 static const char *SQL_STATS_BY_ANIO =
-    "SELECT substr(fecha_hora, 7, 4) AS anio, c.nombre, COUNT(*) AS partidos, SUM(goles) AS total_goles, SUM(asistencias) AS total_asistencias, ROUND(AVG(goles), 2) AS avg_goles, ROUND(AVG(asistencias), 2) AS avg_asistencias "
-    "FROM partido p "
-    "JOIN camiseta c ON p.camiseta_id = c.id "
+    "SELECT CAST(r.clave / 100 AS TEXT) AS anio, c.nombre, SUM(r.partidos) AS partidos, SUM(r.goles) AS total_goles, SUM(r.asistencias) AS total_asistencias, "
+    "ROUND(CAST(SUM(r.goles) AS REAL) / SUM(r.partidos), 2) AS avg_goles, ROUND(CAST(SUM(r.asistencias) AS REAL) / SUM(r.partidos), 2) AS avg_asistencias "
+    "FROM resumen_partido r "
+    "JOIN camiseta c ON r.camiseta_id = c.id "
+    "WHERE r.dimension = 'mes' AND r.clave > 0 "
     "GROUP BY anio, c.id "
     "ORDER BY anio DESC, total_goles DESC";
 
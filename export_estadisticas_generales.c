@@ -1,9 +1,13 @@
 /**
  * @file export_estadisticas_generales.c
  * @brief Funciones de exportación de estadísticas
+ *
+ * Las estadísticas generales se exportan desde el mismo resultado que
+ * muestra la pantalla (estadisticas_generales_calcular).
  */
 
 #include "export.h"
+#include "estadisticas_generales.h"
 #include "db.h"
 #include "utils.h"
 #include "cJSON.h"
@@ -17,17 +21,12 @@
 
 static const char *SQL_COUNT_PARTIDOS = "SELECT COUNT(*) FROM partido";
 
-static const char *SQL_BEST_BY_METRIC =
-    "SELECT c.nombre, %s FROM partido p "
-    "JOIN camiseta c ON p.camiseta_id = c.id "
-    "GROUP BY c.id ORDER BY 2 %s LIMIT 1";
-
 static const char *SQL_STATS_MONTH =
-    "SELECT substr(fecha_hora, 4, 7), c.nombre, COUNT(*), SUM(goles), SUM(asistencias), "
-    "ROUND(AVG(goles), 2), ROUND(AVG(asistencias), 2) "
-    "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id "
-    "GROUP BY substr(fecha_hora, 4, 7), c.id "
-    "ORDER BY substr(fecha_hora, 4, 7) DESC, SUM(goles) DESC";
+    "SELECT printf('%02d/%04d', r.clave % 100, r.clave / 100), c.nombre, r.partidos, r.goles, r.asistencias, "
+    "ROUND(CAST(r.goles AS REAL) / r.partidos, 2), ROUND(CAST(r.asistencias AS REAL) / r.partidos, 2) "
+    "FROM resumen_partido r JOIN camiseta c ON r.camiseta_id = c.id "
+    "WHERE r.dimension = 'mes' AND r.clave > 0 "
+    "ORDER BY r.clave DESC, r.goles DESC";
 
 /* ============================================================================
  * HELPER ESTÁTICOS
@@ -53,108 +52,91 @@ static int has_partidos(void)
     return result;
 }
 
-/** @brief Obtiene top 1 por métrica (reutilizable) */
-static int get_top_camiseta(const char *metric, const char *orderDir,
-                            char *nombre, int *valor)
+/** @brief Categorías exportadas: clave JSON y etiqueta de CSV, TXT y HTML */
+static const struct
 {
-    sqlite3_stmt *stmt = NULL;
-    char query[512];
-    int result = 0;
-
-    snprintf(query, sizeof(query), SQL_BEST_BY_METRIC, metric, orderDir);
-
-    if (sqlite3_prepare_v2(db, query, -1, &stmt, NULL) == SQLITE_OK)
-    {
-        if (sqlite3_step(stmt) == SQLITE_ROW)
-        {
-            strcpy(nombre, (const char *)sqlite3_column_text(stmt, 0));
-            *valor = sqlite3_column_int(stmt, 1);
-            result = 1;
-        }
-        sqlite3_finalize(stmt);
-    }
+    CategoriaDestacada categoria;
+    const char *clave;
+    const char *etiqueta;
+} CATEGORIAS[] =
+{
+    {DESTACADA_GOLES, "mas_goles", "Mas Goles"},
+    {DESTACADA_ASISTENCIAS, "mas_asistencias", "Mas Asistencias"},
+    {DESTACADA_PARTIDOS, "mas_partidos", "Mas Partidos"},
+    {DESTACADA_GOLES_ASISTENCIAS, "mas_goles_asistencias", "Mas Goles+Asistencias"},
+    {DESTACADA_RENDIMIENTO, "mejor_rendimiento", "Mejor Rendimiento"},
+    {DESTACADA_ANIMO, "mejor_estado_animo", "Mejor Estado Animo"},
+    {DESTACADA_CANSANCIO, "menos_cansancio", "Menos Cansancio"},
+    {DESTACADA_VICTORIAS, "mas_victorias", "Mas Victorias"},
+    {DESTACADA_EMPATES, "mas_empates", "Mas Empates"},
+    {DESTACADA_DERROTAS, "mas_derrotas", "Mas Derrotas"}
+};
+
+#define NUM_CATEGORIAS ((int)(sizeof(CATEGORIAS) / sizeof(CATEGORIAS[0])))
 
-    return result;
+/**
+ * @brief Valor exportado de una camiseta destacada
+ *
+ * Los promedios se truncan a entero, como hacía la lectura con
+ * sqlite3_column_int del AVG.
+ */
+static int valor_exportado(const CamisetaDestacada *d)
+{
+    return (int)d->valor;
 }
 
 /** @brief Escribe estadística en JSON */
 static void json_write_stat(cJSON *json, const char *cat,
-                            const char *nombre, int valor)
+                            const CamisetaDestacada *d)
 {
     cJSON *stat = cJSON_CreateObject();
-    cJSON_AddStringToObject(stat, "camiseta", nombre);
-    cJSON_AddNumberToObject(stat, "valor", valor);
+    cJSON_AddStringToObject(stat, "camiseta", d->nombre);
+    cJSON_AddNumberToObject(stat, "valor", valor_exportado(d));
     cJSON_AddItemToObject(json, cat, stat);
 }
 
 /** @brief Escribe estadísticas en formato CSV */
-static void write_stats_csv(FILE *file, const char *category,
-                            const char *metric, const char *order,
+static void write_stats_csv(FILE *file, const CamisetaDestacada *d,
                             const char *label)
 {
-    char nombre[256];
-    int valor;
-    if (get_top_camiseta(metric, order, nombre, &valor))
+    if (d->id != 0)
     {
-        fprintf(file, "%s,%s,%d\n", label, nombre, valor);
+        fprintf(file, "%s,%s,%d\n", label, d->nombre, valor_exportado(d));
     }
 }
 
 /** @brief Escribe estadísticas en formato TXT */
-static void write_stats_txt(FILE *file, const char *category,
-                            const char *metric, const char *order,
+static void write_stats_txt(FILE *file, const CamisetaDestacada *d,
                             const char *label)
 {
-    char nombre[256];
-    int valor;
-    if (get_top_camiseta(metric, order, nombre, &valor))
+    if (d->id != 0)
     {
-        fprintf(file, "%s: %s (%d)\n", label, nombre, valor);
+        fprintf(file, "%s: %s (%d)\n", label, d->nombre, valor_exportado(d));
     }
 }
 
 /** @brief Escribe estadísticas en formato HTML */
-static void write_stats_html(FILE *file, const char *category,
-                             const char *metric, const char *order,
+static void write_stats_html(FILE *file, const CamisetaDestacada *d,
                              const char *label)
 {
-    char nombre[256];
-    int valor;
-    if (get_top_camiseta(metric, order, nombre, &valor))
+    if (d->id != 0)
     {
-        fprintf(file, "<tr><td>%s</td><td>%s</td><td>%d</td></tr>\n", label, nombre, valor);
+        fprintf(file, "<tr><td>%s</td><td>%s</td><td>%d</td></tr>\n", label, d->nombre, valor_exportado(d));
     }
 }
 
 /** @brief Construye objeto JSON con estadísticas generales */
-static cJSON *json_build_estadisticas(void)
+static cJSON *json_build_estadisticas(const EstadisticasGenerales *e)
 {
     cJSON *root = cJSON_CreateObject();
     if (!root) return NULL;
 
-    char nombre[256];
-    int valor;
-
-    if (get_top_camiseta("SUM(goles)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_goles", nombre, valor);
-    if (get_top_camiseta("SUM(asistencias)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_asistencias", nombre, valor);
-    if (get_top_camiseta("COUNT(*)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_partidos", nombre, valor);
-    if (get_top_camiseta("SUM(goles+asistencias)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_goles_asistencias", nombre, valor);
-    if (get_top_camiseta("AVG(rendimiento_general)", "DESC", nombre, &valor))
-        json_write_stat(root, "mejor_rendimiento", nombre, valor);
-    if (get_top_camiseta("AVG(estado_animo)", "DESC", nombre, &valor))
-        json_write_stat(root, "mejor_estado_animo", nombre, valor);
-    if (get_top_camiseta("AVG(cansancio)", "ASC", nombre, &valor))
-        json_write_stat(root, "menos_cansancio", nombre, valor);
-    if (get_top_camiseta("SUM(CASE WHEN resultado=1 THEN 1 ELSE 0 END)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_victorias", nombre, valor);
-    if (get_top_camiseta("SUM(CASE WHEN resultado=2 THEN 1 ELSE 0 END)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_empates", nombre, valor);
-    if (get_top_camiseta("SUM(CASE WHEN resultado=3 THEN 1 ELSE 0 END)", "DESC", nombre, &valor))
-        json_write_stat(root, "mas_derrotas", nombre, valor);
+    for (int i = 0; i < NUM_CATEGORIAS; i++)
+    {
+        const CamisetaDestacada *d = &e->destacada[CATEGORIAS[i].categoria];
+        if (d->id != 0)
+            json_write_stat(root, CATEGORIAS[i].clave, d);
+    }
 
     return root;
 }
@@ -165,6 +147,8 @@ static cJSON *json_build_estadisticas(void)
 
 void exportar_estadisticas_generales_csv(void)
 {
+    EstadisticasGenerales e;
+
     if (!has_partidos())
     {
         printf("No hay registros.\n");
@@ -181,16 +165,9 @@ void exportar_estadisticas_generales_csv(void)
 
     fprintf(file, "Categoria,Camiseta,Valor\n");
 
-    write_stats_csv(file, "goles", "SUM(goles)", "DESC", "Mas Goles");
-    write_stats_csv(file, "asistencias", "SUM(asistencias)", "DESC", "Mas Asistencias");
-    write_stats_csv(file, "partidos", "COUNT(*)", "DESC", "Mas Partidos");
-    write_stats_csv(file, "goles_asistencias", "SUM(goles+asistencias)", "DESC", "Mas Goles+Asistencias");
-    write_stats_csv(file, "rendimiento", "AVG(rendimiento_general)", "DESC", "Mejor Rendimiento");
-    write_stats_csv(file, "estado_animo", "AVG(estado_animo)", "DESC", "Mejor Estado Animo");
-    write_stats_csv(file, "cansancio", "AVG(cansancio)", "ASC", "Menos Cansancio");
-    write_stats_csv(file, "victorias", "SUM(CASE WHEN resultado=1 THEN 1 ELSE 0 END)", "DESC", "Mas Victorias");
-    write_stats_csv(file, "empates", "SUM(CASE WHEN resultado=2 THEN 1 ELSE 0 END)", "DESC", "Mas Empates");
-    write_stats_csv(file, "derrotas", "SUM(CASE WHEN resultado=3 THEN 1 ELSE 0 END)", "DESC", "Mas Derrotas");
+    estadisticas_generales_calcular(&e);
+    for (int i = 0; i < NUM_CATEGORIAS; i++)
+        write_stats_csv(file, &e.destacada[CATEGORIAS[i].categoria], CATEGORIAS[i].etiqueta);
 
     fclose(file);
     printf("Exportado: %s\n", path);
@@ -198,6 +175,8 @@ void exportar_estadisticas_generales_csv(void)
 
 void exportar_estadisticas_generales_txt(void)
 {
+    EstadisticasGenerales e;
+
     if (!has_partidos())
     {
         printf("No hay registros.\n");
@@ -214,16 +193,9 @@ void exportar_estadisticas_generales_txt(void)
 
     fprintf(file, "ESTADISTICAS GENERALES\n======================\n\n");
 
-    write_stats_txt(file, "goles", "SUM(goles)", "DESC", "Mas Goles");
-    write_stats_txt(file, "asistencias", "SUM(asistencias)", "DESC", "Mas Asistencias");
-    write_stats_txt(file, "partidos", "COUNT(*)", "DESC", "Mas Partidos");
-    write_stats_txt(file, "goles_asistencias", "SUM(goles+asistencias)", "DESC", "Mas Goles+Asistencias");
-    write_stats_txt(file, "rendimiento", "AVG(rendimiento_general)", "DESC", "Mejor Rendimiento");
-    write_stats_txt(file, "estado_animo", "AVG(estado_animo)", "DESC", "Mejor Estado Animo");
-    write_stats_txt(file, "cansancio", "AVG(cansancio)", "ASC", "Menos Cansancio");
-    write_stats_txt(file, "victorias", "SUM(CASE WHEN resultado=1 THEN 1 ELSE 0 END)", "DESC", "Mas Victorias");
-    write_stats_txt(file, "empates", "SUM(CASE WHEN resultado=2 THEN 1 ELSE 0 END)", "DESC", "Mas Empates");
-    write_stats_txt(file, "derrotas", "SUM(CASE WHEN resultado=3 THEN 1 ELSE 0 END)", "DESC", "Mas Derrotas");
+    estadisticas_generales_calcular(&e);
+    for (int i = 0; i < NUM_CATEGORIAS; i++)
+        write_stats_txt(file, &e.destacada[CATEGORIAS[i].categoria], CATEGORIAS[i].etiqueta);
 
     fclose(file);
     printf("Exportado: %s\n", path);
@@ -231,6 +203,8 @@ void exportar_estadisticas_generales_txt(void)
 
 void exportar_estadisticas_generales_json(void)
 {
+    EstadisticasGenerales e;
+
     if (!has_partidos())
     {
         printf("No hay registros.\n");
@@ -245,8 +219,9 @@ void exportar_estadisticas_generales_json(void)
         return;
     }
 
+    estadisticas_generales_calcular(&e);
     cJSON *root = cJSON_CreateObject();
-    cJSON *stats = json_build_estadisticas();
+    cJSON *stats = json_build_estadisticas(&e);
     if (stats) cJSON_AddItemToObject(root, "estadisticas_generales", stats);
 
     char *json_str = cJSON_Print(root);
@@ -260,6 +235,8 @@ void exportar_estadisticas_generales_json(void)
 
 void exportar_estadisticas_generales_html(void)
 {
+    EstadisticasGenerales e;
+
     if (!has_partidos())
     {
         printf("No hay registros.\n");
@@ -278,16 +255,9 @@ void exportar_estadisticas_generales_html(void)
     fprintf(file, "<body>\n<h1>Estadisticas Generales</h1>\n<table border='1'>\n");
     fprintf(file, "<tr><th>Categoria</th><th>Camiseta</th><th>Valor</th></tr>\n");
 
-    write_stats_html(file, "goles", "SUM(goles)", "DESC", "Mas Goles");
-    write_stats_html(file, "asistencias", "SUM(asistencias)", "DESC", "Mas Asistencias");
-    write_stats_html(file, "partidos", "COUNT(*)", "DESC", "Mas Partidos");
-    write_stats_html(file, "goles_asistencias", "SUM(goles+asistencias)", "DESC", "Mas Goles+Asistencias");
-    write_stats_html(file, "rendimiento", "AVG(rendimiento_general)", "DESC", "Mejor Rendimiento");
-    write_stats_html(file, "estado_animo", "AVG(estado_animo)", "DESC", "Mejor Estado Animo");
-    write_stats_html(file, "cansancio", "AVG(cansancio)", "ASC", "Menos Cansancio");
-    write_stats_html(file, "victorias", "SUM(CASE WHEN resultado=1 THEN 1 ELSE 0 END)", "DESC", "Mas Victorias");
-    write_stats_html(file, "empates", "SUM(CASE WHEN resultado=2 THEN 1 ELSE 0 END)", "DESC", "Mas Empates");
-    write_stats_html(file, "derrotas", "SUM(CASE WHEN resultado=3 THEN 1 ELSE 0 END)", "DESC", "Mas Derrotas");
+    estadisticas_generales_calcular(&e);
+    for (int i = 0; i < NUM_CATEGORIAS; i++)
+        write_stats_html(file, &e.destacada[CATEGORIAS[i].categoria], CATEGORIAS[i].etiqueta);
 
     fprintf(file, "</table>\n</body>\n</html>\n");
     fclose(file);
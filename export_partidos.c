@@ -324,7 +324,7 @@ void exportar_partido_mas_goles_csv()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -382,7 +382,7 @@ void exportar_partido_mas_goles_txt()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -440,7 +440,7 @@ void exportar_partido_mas_goles_json()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -504,7 +504,7 @@ void exportar_partido_mas_goles_html()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -564,7 +564,7 @@ void exportar_partido_mas_asistencias_csv()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -622,7 +622,7 @@ void exportar_partido_mas_asistencias_txt()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -680,7 +680,7 @@ void exportar_partido_mas_asistencias_json()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -744,7 +744,7 @@ void exportar_partido_mas_asistencias_html()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias DESC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias DESC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -804,7 +804,7 @@ void exportar_partido_menos_goles_reciente_csv()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -862,7 +862,7 @@ void exportar_partido_menos_goles_reciente_txt()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -920,7 +920,7 @@ void exportar_partido_menos_goles_reciente_json()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -984,7 +984,7 @@ void exportar_partido_menos_goles_reciente_html()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.goles ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.goles ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -1044,7 +1044,7 @@ void exportar_partido_menos_asistencias_reciente_csv()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -1102,7 +1102,7 @@ void exportar_partido_menos_asistencias_reciente_txt()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -1160,7 +1160,7 @@ void exportar_partido_menos_asistencias_reciente_json()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -1224,7 +1224,7 @@ void exportar_partido_menos_asistencias_reciente_html()
                        "SELECT can.nombre,p.fecha_hora,p.goles,p.asistencias,c.nombre,p.resultado,p.clima,p.dia,p.rendimiento_general,p.cansancio,p.estado_animo,p.comentario_personal "
                        "FROM partido p JOIN camiseta c ON p.camiseta_id=c.id "
                        "JOIN cancha can ON p.cancha_id = can.id "
-                       "ORDER BY p.asistencias ASC, p.fecha_hora DESC LIMIT 1",
+                       "ORDER BY p.asistencias ASC, p.fecha_ts DESC, p.id DESC LIMIT 1",
                        -1, &stmt, NULL);
 
     if (sqlite3_step(stmt) == SQLITE_ROW)
@@ -11,6 +11,40 @@
 #include <string.h>
 #include <stdlib.h>
 
+/* ============================================================================
+ * CONSULTAS SQL ESTÁTICAS - Leen los resúmenes de resumenes.h
+ * ============================================================================ */
+
+static const char *SQL_MEJOR_COMBINACION =
+    "SELECT ca.nombre, c.nombre, ROUND(CAST(r.rendimiento AS REAL) / r.partidos, 2), r.partidos "
+    "FROM resumen_partido r "
+    "JOIN cancha ca ON r.clave = ca.id "
+    "JOIN camiseta c ON r.camiseta_id = c.id "
+    "WHERE r.dimension = 'cancha' "
+    "ORDER BY CAST(r.rendimiento AS REAL) / r.partidos DESC LIMIT 1";
+
+static const char *SQL_PEOR_COMBINACION =
+    "SELECT ca.nombre, c.nombre, ROUND(CAST(r.rendimiento AS REAL) / r.partidos, 2), r.partidos "
+    "FROM resumen_partido r "
+    "JOIN cancha ca ON r.clave = ca.id "
+    "JOIN camiseta c ON r.camiseta_id = c.id "
+    "WHERE r.dimension = 'cancha' "
+    "ORDER BY CAST(r.rendimiento AS REAL) / r.partidos ASC LIMIT 1";
+
+static const char *SQL_MEJOR_TEMPORADA =
+    "SELECT CAST(clave / 100 AS TEXT), ROUND(CAST(SUM(rendimiento) AS REAL) / SUM(partidos), 2), SUM(partidos) "
+    "FROM resumen_partido "
+    "WHERE dimension = 'mes' AND clave > 0 "
+    "GROUP BY clave / 100 "
+    "ORDER BY CAST(SUM(rendimiento) AS REAL) / SUM(partidos) DESC LIMIT 1";
+
+static const char *SQL_PEOR_TEMPORADA =
+    "SELECT CAST(clave / 100 AS TEXT), ROUND(CAST(SUM(rendimiento) AS REAL) / SUM(partidos), 2), SUM(partidos) "
+    "FROM resumen_partido "
+    "WHERE dimension = 'mes' AND clave > 0 "
+    "GROUP BY clave / 100 "
+    "ORDER BY CAST(SUM(rendimiento) AS REAL) / SUM(partidos) ASC LIMIT 1";
+
 /**
  * Ejecuta una consulta SQL y devuelve el statement.
  * Centraliza la ejecución de consultas para evitar duplicación de código.
@@ -206,12 +240,7 @@ void exportar_record_asistencias_partido_csv()
 void exportar_mejor_combinacion_cancha_camiseta_csv()
 {
     exportar_combinacion_csv("Mejor Combinacion Cancha + Camiseta",
-                             "SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) "
-                             "FROM partido p "
-                             "JOIN cancha ca ON p.cancha_id = ca.id "
-                             "JOIN camiseta c ON p.camiseta_id = c.id "
-                             "GROUP BY p.cancha_id, p.camiseta_id "
-                             "ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1",
+                             SQL_MEJOR_COMBINACION,
                              get_export_path("mejor_combinacion_cancha_camiseta.csv"));
 }
 
@@ -221,12 +250,7 @@ void exportar_mejor_combinacion_cancha_camiseta_csv()
 void exportar_peor_combinacion_cancha_camiseta_csv()
 {
     exportar_combinacion_csv("Peor Combinacion Cancha + Camiseta",
-                             "SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) "
-                             "FROM partido p "
-                             "JOIN cancha ca ON p.cancha_id = ca.id "
-                             "JOIN camiseta c ON p.camiseta_id = c.id "
-                             "GROUP BY p.cancha_id, p.camiseta_id "
-                             "ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1",
+                             SQL_PEOR_COMBINACION,
                              get_export_path("peor_combinacion_cancha_camiseta.csv"));
 }
 
@@ -236,10 +260,7 @@ void exportar_peor_combinacion_cancha_camiseta_csv()
 void exportar_mejor_temporada_csv()
 {
     exportar_temporada_csv("Mejor Temporada",
-                           "SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) "
-                           "FROM partido p "
-                           "GROUP BY strftime('%Y', p.fecha_hora) "
-                           "ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1",
+                           SQL_MEJOR_TEMPORADA,
                            get_export_path("mejor_temporada.csv"));
 }
 
@@ -249,10 +270,7 @@ void exportar_mejor_temporada_csv()
 void exportar_peor_temporada_csv()
 {
     exportar_temporada_csv("Peor Temporada",
-                           "SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) "
-                           "FROM partido p "
-                           "GROUP BY strftime('%Y', p.fecha_hora) "
-                           "ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1",
+                           SQL_PEOR_TEMPORADA,
                            get_export_path("peor_temporada.csv"));
 }
 
@@ -298,7 +316,7 @@ void exportar_records_rankings_txt()
     if (stmt) sqlite3_finalize(stmt);
 
     // Mejor combinación cancha + camiseta
-    stmt = execute_records_query("SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p JOIN cancha ca ON p.cancha_id = ca.id JOIN camiseta c ON p.camiseta_id = c.id GROUP BY p.cancha_id, p.camiseta_id ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    stmt = execute_records_query(SQL_MEJOR_COMBINACION);
     if (stmt && get_combinacion_data(stmt, &cancha, &camiseta, &rendimiento, &partidos))
     {
         fprintf(file, "Mejor Combinacion Cancha + Camiseta: Cancha: %s, Camiseta: %s, Rendimiento Promedio: %.2f, Partidos: %d\n", cancha, camiseta, rendimiento, partidos);
@@ -306,7 +324,7 @@ void exportar_records_rankings_txt()
     if (stmt) sqlite3_finalize(stmt);
 
     // Peor combinación cancha + camiseta
-    stmt = execute_records_query("SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p JOIN cancha ca ON p.cancha_id = ca.id JOIN camiseta c ON p.camiseta_id = c.id GROUP BY p.cancha_id, p.camiseta_id ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    stmt = execute_records_query(SQL_PEOR_COMBINACION);
     if (stmt && get_combinacion_data(stmt, &cancha, &camiseta, &rendimiento, &partidos))
     {
         fprintf(file, "Peor Combinacion Cancha + Camiseta: Cancha: %s, Camiseta: %s, Rendimiento Promedio: %.2f, Partidos: %d\n", cancha, camiseta, rendimiento, partidos);
@@ -314,7 +332,7 @@ void exportar_records_rankings_txt()
     if (stmt) sqlite3_finalize(stmt);
 
     // Mejor temporada
-    stmt = execute_records_query("SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p GROUP BY strftime('%Y', p.fecha_hora) ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    stmt = execute_records_query(SQL_MEJOR_TEMPORADA);
     if (stmt && get_temporada_data(stmt, &anio, &rendimiento, &partidos))
     {
         fprintf(file, "Mejor Temporada: Anio: %s, Rendimiento Promedio: %.2f, Partidos: %d\n", anio, rendimiento, partidos);
@@ -322,7 +340,7 @@ void exportar_records_rankings_txt()
     if (stmt) sqlite3_finalize(stmt);
 
     // Peor temporada
-    stmt = execute_records_query("SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p GROUP BY strftime('%Y', p.fecha_hora) ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    stmt = execute_records_query(SQL_PEOR_TEMPORADA);
     if (stmt && get_temporada_data(stmt, &anio, &rendimiento, &partidos))
     {
         fprintf(file, "Peor Temporada: Anio: %s, Rendimiento Promedio: %.2f, Partidos: %d\n", anio, rendimiento, partidos);
@@ -386,7 +404,7 @@ void exportar_records_rankings_json()
 
     // Mejor combinación cancha + camiseta
     fprintf(file, ",\n    \"mejor_combinacion\": ");
-    stmt = execute_records_query("SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p JOIN cancha ca ON p.cancha_id = ca.id JOIN camiseta c ON p.camiseta_id = c.id GROUP BY p.cancha_id, p.camiseta_id ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    stmt = execute_records_query(SQL_MEJOR_COMBINACION);
     if (stmt && get_combinacion_data(stmt, &cancha, &camiseta, &rendimiento, &partidos))
     {
         fprintf(file, "{\"cancha\": \"%s\", \"camiseta\": \"%s\", \"rendimiento_promedio\": %.2f, \"partidos\": %d}", cancha, camiseta, rendimiento, partidos);
@@ -399,7 +417,7 @@ void exportar_records_rankings_json()
 
     // Peor combinación cancha + camiseta
     fprintf(file, ",\n    \"peor_combinacion\": ");
-    stmt = execute_records_query("SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p JOIN cancha ca ON p.cancha_id = ca.id JOIN camiseta c ON p.camiseta_id = c.id GROUP BY p.cancha_id, p.camiseta_id ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    stmt = execute_records_query(SQL_PEOR_COMBINACION);
     if (stmt && get_combinacion_data(stmt, &cancha, &camiseta, &rendimiento, &partidos))
     {
         fprintf(file, "{\"cancha\": \"%s\", \"camiseta\": \"%s\", \"rendimiento_promedio\": %.2f, \"partidos\": %d}", cancha, camiseta, rendimiento, partidos);
@@ -412,7 +430,7 @@ void exportar_records_rankings_json()
 
     // Mejor temporada
     fprintf(file, ",\n    \"mejor_temporada\": ");
-    stmt = execute_records_query("SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p GROUP BY strftime('%Y', p.fecha_hora) ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    stmt = execute_records_query(SQL_MEJOR_TEMPORADA);
     if (stmt && get_temporada_data(stmt, &anio, &rendimiento, &partidos))
     {
         fprintf(file, "{\"anio\": \"%s\", \"rendimiento_promedio\": %.2f, \"partidos\": %d}", anio, rendimiento, partidos);
@@ -425,7 +443,7 @@ void exportar_records_rankings_json()
 
     // Peor temporada
     fprintf(file, ",\n    \"peor_temporada\": ");
-    stmt = execute_records_query("SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p GROUP BY strftime('%Y', p.fecha_hora) ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    stmt = execute_records_query(SQL_PEOR_TEMPORADA);
     if (stmt && get_temporada_data(stmt, &anio, &rendimiento, &partidos))
     {
         fprintf(file, "{\"anio\": \"%s\", \"rendimiento_promedio\": %.2f, \"partidos\": %d}", anio, rendimiento, partidos);
@@ -499,7 +517,7 @@ void exportar_records_rankings_html()
 
     // Mejor combinación cancha + camiseta
     fprintf(file, "<h2>Mejor Combinacion Cancha + Camiseta</h2>\n");
-    stmt = execute_records_query("SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p JOIN cancha ca ON p.cancha_id = ca.id JOIN camiseta c ON p.camiseta_id = c.id GROUP BY p.cancha_id, p.camiseta_id ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    stmt = execute_records_query(SQL_MEJOR_COMBINACION);
     if (stmt && get_combinacion_data(stmt, &cancha, &camiseta, &rendimiento, &partidos))
     {
         fprintf(file, "<p>Cancha: <strong>%s</strong>, Camiseta: <strong>%s</strong>, Rendimiento Promedio: <strong>%.2f</strong>, Partidos: <strong>%d</strong></p>\n", cancha, camiseta, rendimiento, partidos);
@@ -512,7 +530,7 @@ void exportar_records_rankings_html()
 
     // Peor combinación cancha + camiseta
     fprintf(file, "<h2>Peor Combinacion Cancha + Camiseta</h2>\n");
-    stmt = execute_records_query("SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p JOIN cancha ca ON p.cancha_id = ca.id JOIN camiseta c ON p.camiseta_id = c.id GROUP BY p.cancha_id, p.camiseta_id ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    stmt = execute_records_query(SQL_PEOR_COMBINACION);
     if (stmt && get_combinacion_data(stmt, &cancha, &camiseta, &rendimiento, &partidos))
     {
         fprintf(file, "<p>Cancha: <strong>%s</strong>, Camiseta: <strong>%s</strong>, Rendimiento Promedio: <strong>%.2f</strong>, Partidos: <strong>%d</strong></p>\n", cancha, camiseta, rendimiento, partidos);
@@ -525,7 +543,7 @@ void exportar_records_rankings_html()
 
     // Mejor temporada
     fprintf(file, "<h2>Mejor Temporada</h2>\n");
-    stmt = execute_records_query("SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p GROUP BY strftime('%Y', p.fecha_hora) ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    stmt = execute_records_query(SQL_MEJOR_TEMPORADA);
     if (stmt && get_temporada_data(stmt, &anio, &rendimiento, &partidos))
     {
         fprintf(file, "<p>Anio: <strong>%s</strong>, Rendimiento Promedio: <strong>%.2f</strong>, Partidos: <strong>%d</strong></p>\n", anio, rendimiento, partidos);
@@ -538,7 +556,7 @@ void exportar_records_rankings_html()
 
     // Peor temporada
     fprintf(file, "<h2>Peor Temporada</h2>\n");
-    stmt = execute_records_query("SELECT strftime('%Y', p.fecha_hora), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p GROUP BY strftime('%Y', p.fecha_hora) ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    stmt = execute_records_query(SQL_PEOR_TEMPORADA);
     if (stmt && get_temporada_data(stmt, &anio, &rendimiento, &partidos))
     {
         fprintf(file, "<p>Anio: <strong>%s</strong>, Rendimiento Promedio: <strong>%.2f</strong>, Partidos: <strong>%d</strong></p>\n", anio, rendimiento, partidos);
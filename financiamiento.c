@@ -173,30 +173,6 @@ int convertir_fecha_ddmmyyyy_a_yyyymmdd(const char *fecha_ddmmyyyy, char *fecha_
     return 1; // Éxito
 }
 
-/**
- * @brief Obtiene el siguiente ID disponible para una nueva transacción financiera
- *
- * Busca el ID más pequeño disponible reutilizando espacios de IDs eliminados.
- * Utiliza una consulta SQL que encuentra el primer hueco en la secuencia de IDs.
- *
- * @return El ID disponible más pequeño (comenzando desde 1 si la tabla está vacía)
- */
-static int obtener_siguiente_id_financiamiento()
-{
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "WITH RECURSIVE seq(id) AS (VALUES(1) UNION ALL SELECT id+1 FROM seq WHERE id < (SELECT COALESCE(MAX(id),0)+1 FROM financiamiento)) SELECT MIN(id) FROM seq WHERE id NOT IN (SELECT id FROM financiamiento)",
-                       -1, &stmt, NULL);
-
-    int id = 1; // Default si la tabla está vacía
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        id = sqlite3_column_int(stmt, 0);
-    }
-    sqlite3_finalize(stmt);
-    return id;
-}
-
 /**
  * @brief Agregar una nueva transacción financiera
  */
@@ -342,7 +318,7 @@ void agregar_transaccion()
     }
 
     // Obtener el ID y asignarlo a la transacción
-    transaccion.id = obtener_siguiente_id_financiamiento();
+    transaccion.id = db_siguiente_id("financiamiento");
 
     // Mostrar resumen y confirmar
     clear_screen();
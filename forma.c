@@ -0,0 +1,179 @@
+/**
+ * @file forma.c
+ * @brief Forma del jugador con ventanas moviles sobre la secuencia de partidos
+ *
+ * Ver forma.h.
+ */
+
+#include "forma.h"
+#include "partido_store.h"
+#include <math.h>
+#include <string.h>
+
+static const char *NOMBRES[NUM_METRICAS_FORMA] = {"Goles", "Asistencias", "Rendimiento"};
+
+/**
+ * @brief Indica si un tamano de ventana es uno de los admitidos (3, 5, 10, 20)
+ */
+int forma_ventana_valida(int tamano)
+{
+    return tamano == 3 || tamano == 5 || tamano == 10 || tamano == 20;
+}
+
+/**
+ * @brief Nombre de una metrica para mostrar
+ */
+const char *forma_nombre_metrica(MetricaForma metrica)
+{
+    if (metrica < 0 || metrica >= NUM_METRICAS_FORMA)
+        return "";
+    return NOMBRES[metrica];
+}
+
+/**
+ * @brief Inicia una ventana vacia
+ */
+void ventana_forma_iniciar(VentanaForma *ventana, int tamano, int vida_media)
+{
+    memset(ventana, 0, sizeof(*ventana));
+    if (tamano < 1)
+        tamano = 1;
+    if (tamano > FORMA_VENTANA_MAX)
+        tamano = FORMA_VENTANA_MAX;
+
+    ventana->tamano = tamano;
+    ventana->lambda = vida_media > 0 ? pow(0.5, 1.0 / vida_media) : 1.0;
+    ventana->lambda_n = pow(ventana->lambda, tamano);
+}
+
+/**
+ * @brief Agrega un valor y descarta el mas antiguo si la ventana esta llena
+ *
+ * Al multiplicar las sumas por lambda todos los valores envejecen un
+ * partido; el que sale llega a edad N y se resta con peso lambda^N.
+ */
+void ventana_forma_agregar(VentanaForma *ventana, double valor)
+{
+    double lambda = ventana->lambda;
+
+    ventana->suma = lambda * ventana->suma + valor;
+    ventana->suma_cuadrados = lambda * ventana->suma_cuadrados + valor * valor;
+    ventana->peso = lambda * ventana->peso + 1.0;
+
+    if (ventana->cuenta == ventana->tamano)
+    {
+        double saliente = ventana->valores[ventana->siguiente];
+
+        ventana->suma -= ventana->lambda_n * saliente;
+        ventana->suma_cuadrados -= ventana->lambda_n * saliente * saliente;
+        ventana->peso -= ventana->lambda_n;
+    }
+    else
+    {
+        ventana->cuenta++;
+    }
+
+    ventana->valores[ventana->siguiente] = valor;
+    ventana->siguiente = (ventana->siguiente + 1) % ventana->tamano;
+}
+
+/**
+ * @brief Media ponderada de la ventana (0 si esta vacia)
+ */
+double ventana_forma_media(const VentanaForma *ventana)
+{
+    if (ventana->cuenta == 0)
+        return 0.0;
+    return ventana->suma / ventana->peso;
+}
+
+/**
+ * @brief Desviacion estandar ponderada de la ventana (poblacional)
+ */
+double ventana_forma_desviacion(const VentanaForma *ventana)
+{
+    double media, varianza;
+
+    if (ventana->cuenta == 0)
+        return 0.0;
+
+    media = ventana->suma / ventana->peso;
+    varianza = ventana->suma_cuadrados / ventana->peso - media * media;
+    return varianza > 0 ? sqrt(varianza) : 0.0;
+}
+
+/**
+ * @brief Copia el estado de las tres ventanas en un punto de la curva
+ */
+static void llenar_punto(PuntoForma *punto, const VentanaForma *ventanas, int indice, long long fecha_ts)
+{
+    punto->indice = indice;
+    punto->fecha_ts = fecha_ts;
+    for (int m = 0; m < NUM_METRICAS_FORMA; m++)
+    {
+        punto->media[m] = ventana_forma_media(&ventanas[m]);
+        punto->desviacion[m] = ventana_forma_desviacion(&ventanas[m]);
+    }
+}
+
+/**
+ * @brief Recorre todos los partidos en orden cronologico calculando la forma
+ */
+int forma_calcular(int tamano, int vida_media, PuntoForma *curva, int num_puntos, ResumenForma *resumen)
+{
+    const PartidoStore *s = partido_store_obtener();
+    const int *columnas[NUM_METRICAS_FORMA];
+    VentanaForma ventanas[NUM_METRICAS_FORMA];
+    int escritos = 0;
+    int muestra;
+
+    memset(resumen, 0, sizeof(*resumen));
+    for (int m = 0; m < NUM_METRICAS_FORMA; m++)
+        resumen->pico[m].indice = -1;
+    resumen->actual.indice = -1;
+    if (!s)
+        return -1;
+
+    columnas[FORMA_GOLES] = s->goles;
+    columnas[FORMA_ASISTENCIAS] = s->asistencias;
+    columnas[FORMA_RENDIMIENTO] = s->rendimiento;
+    for (int m = 0; m < NUM_METRICAS_FORMA; m++)
+        ventana_forma_iniciar(&ventanas[m], tamano, vida_media);
+
+    resumen->partidos = s->n;
+    resumen->ventana = ventanas[0].tamano;
+    resumen->vida_media = vida_media > 0 ? vida_media : 0;
+
+    if (!curva || num_puntos <= 0)
+        num_puntos = 0;
+    else if (num_puntos > s->n)
+        num_puntos = s->n;
+    // Punto k: ultimo partido del tramo k de num_puntos tramos iguales
+    muestra = num_puntos > 0 ? (int)((long long)s->n / num_puntos) - 1 : -1;
+
+    for (int i = 0; i < s->n; i++)
+    {
+        for (int m = 0; m < NUM_METRICAS_FORMA; m++)
+            ventana_forma_agregar(&ventanas[m], columnas[m][i]);
+
+        if (ventanas[0].cuenta == ventanas[0].tamano)
+        {
+            for (int m = 0; m < NUM_METRICAS_FORMA; m++)
+            {
+                // Ante empates queda el pico mas antiguo
+                if (resumen->pico[m].indice < 0 || ventana_forma_media(&ventanas[m]) > resumen->pico[m].media[m])
+                    llenar_punto(&resumen->pico[m], ventanas, i, s->fecha_ts[i]);
+            }
+        }
+
+        if (i == muestra)
+        {
+            llenar_punto(&curva[escritos++], ventanas, i, s->fecha_ts[i]);
+            muestra = escritos < num_puntos ? (int)((long long)s->n * (escritos + 1) / num_puntos) - 1 : -1;
+        }
+    }
+
+    if (s->n > 0)
+        llenar_punto(&resumen->actual, ventanas, s->n - 1, s->fecha_ts[s->n - 1]);
+    return escritos;
+}
@@ -0,0 +1,130 @@
+/**
+ * @file forma.h
+ * @brief Forma del jugador con ventanas moviles sobre la secuencia de partidos
+ *
+ * Recorre los partidos en orden cronologico manteniendo, para goles,
+ * asistencias y rendimiento, una media y una desviacion estandar moviles
+ * de los ultimos N partidos (N = 3, 5, 10 o 20). Opcionalmente los
+ * partidos de la ventana pesan con decaimiento exponencial: un partido
+ * pesa la mitad que el siguiente cada "vida media" partidos.
+ *
+ * Cada paso cuesta O(1): con pesos w = lambda^edad, las sumas ponderadas
+ * se actualizan como S = lambda * S + x_nuevo - lambda^N * x_saliente, y
+ * lo mismo para los cuadrados y el peso total. Sin decaimiento lambda = 1
+ * y las sumas son exactas.
+ */
+
+#ifndef FORMA_H
+#define FORMA_H
+
+/** Tamano maximo de ventana */
+#define FORMA_VENTANA_MAX 20
+
+/** Tamano de ventana por defecto (el de "ultimos 5 partidos") */
+#define FORMA_VENTANA_DEFECTO 5
+
+/** Vida media maxima configurable, en partidos (0 = sin decaimiento) */
+#define FORMA_VIDA_MEDIA_MAX 50
+
+/**
+ * @brief Metricas seguidas por la forma
+ */
+typedef enum
+{
+    FORMA_GOLES,
+    FORMA_ASISTENCIAS,
+    FORMA_RENDIMIENTO,
+    NUM_METRICAS_FORMA
+} MetricaForma;
+
+/**
+ * @brief Ventana movil con decaimiento exponencial opcional
+ */
+typedef struct
+{
+    int tamano;                         /**< Partidos de la ventana (N) */
+    double lambda;                      /**< Factor de decaimiento por partido (1 = sin decaimiento) */
+    double lambda_n;                    /**< lambda^N: peso con el que sale el valor mas antiguo */
+    double valores[FORMA_VENTANA_MAX];  /**< Buffer circular con los ultimos N valores */
+    int siguiente;                      /**< Posicion del buffer que se sobrescribe en el proximo paso */
+    int cuenta;                         /**< Valores en la ventana (hasta N) */
+    double suma;                        /**< Suma ponderada de los valores */
+    double suma_cuadrados;              /**< Suma ponderada de los cuadrados */
+    double peso;                        /**< Suma de los pesos */
+} VentanaForma;
+
+/**
+ * @brief Punto de la curva de forma
+ */
+typedef struct
+{
+    int indice;                             /**< Posicion en la secuencia cronologica */
+    long long fecha_ts;                     /**< Fecha del partido (0 si no tiene) */
+    double media[NUM_METRICAS_FORMA];       /**< Media movil */
+    double desviacion[NUM_METRICAS_FORMA];  /**< Desviacion estandar movil */
+} PuntoForma;
+
+/**
+ * @brief Forma actual frente a la mejor forma de la historia
+ */
+typedef struct
+{
+    int partidos;                           /**< Partidos recorridos */
+    int ventana;                            /**< Tamano de ventana usado */
+    int vida_media;                         /**< Vida media usada (0 = sin decaimiento) */
+    PuntoForma actual;                      /**< Forma tras el ultimo partido */
+    PuntoForma pico[NUM_METRICAS_FORMA];    /**< Punto de mayor media de cada metrica */
+} ResumenForma;
+
+/**
+ * @brief Indica si un tamano de ventana es uno de los admitidos (3, 5, 10, 20)
+ */
+int forma_ventana_valida(int tamano);
+
+/**
+ * @brief Nombre de una metrica para mostrar
+ */
+const char *forma_nombre_metrica(MetricaForma metrica);
+
+/**
+ * @brief Inicia una ventana vacia
+ *
+ * @param ventana Ventana a iniciar
+ * @param tamano Partidos de la ventana (1 a FORMA_VENTANA_MAX)
+ * @param vida_media Partidos tras los cuales un valor pesa la mitad; 0 sin decaimiento
+ */
+void ventana_forma_iniciar(VentanaForma *ventana, int tamano, int vida_media);
+
+/**
+ * @brief Agrega un valor y descarta el mas antiguo si la ventana esta llena (O(1))
+ */
+void ventana_forma_agregar(VentanaForma *ventana, double valor);
+
+/**
+ * @brief Media ponderada de la ventana (0 si esta vacia)
+ */
+double ventana_forma_media(const VentanaForma *ventana);
+
+/**
+ * @brief Desviacion estandar ponderada de la ventana (poblacional)
+ */
+double ventana_forma_desviacion(const VentanaForma *ventana);
+
+/**
+ * @brief Recorre todos los partidos en orden cronologico calculando la forma
+ *
+ * La mejor forma solo se busca entre posiciones con la ventana completa,
+ * para que los primeros partidos no cuenten como pico por si solos. Si se
+ * pide curva, se toman num_puntos puntos equiespaciados de la secuencia
+ * (el ultimo es siempre el partido mas reciente).
+ *
+ * @param tamano Partidos de la ventana
+ * @param vida_media Vida media del decaimiento, 0 sin decaimiento
+ * @param curva Destino de la curva muestreada, o NULL
+ * @param num_puntos Puntos pedidos de la curva
+ * @param resumen Forma actual y picos
+ * @return Puntos escritos en curva, -1 si no se pudo cargar la copia en memoria
+ */
+int forma_calcular(int tamano, int vida_media, PuntoForma *curva, int num_puntos, ResumenForma *resumen);
+
+#endif
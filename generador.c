@@ -0,0 +1,709 @@
+/**
+ * @file generador.c
+ * @brief Generador de datos sinteticos para pruebas de escala
+ *
+ * Los datos se escriben con las mismas sentencias INSERT que usan los
+ * modulos de la aplicacion, de modo que los triggers del esquema (fecha_ts,
+ * lista de IDs libres) se mantienen igual que con datos introducidos a mano.
+ * Los valores siguen distribuciones sencillas pero coherentes: el
+ * rendimiento evoluciona como un paseo aleatorio, los goles siguen una
+ * Poisson cuya media depende del rendimiento y el clima depende del mes.
+ */
+
+#include "generador.h"
+#include "db.h"
+#include "utils.h"
+#include "equipo.h"
+#include "torneo.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/** Filas insertadas por transaccion */
+#define TAM_LOTE 10000
+
+/** Equipos por torneo generado */
+#define EQUIPOS_POR_TORNEO 8
+
+/** Estado del generador xorshift64* */
+static unsigned long long estado_rng;
+
+static const char *NOMBRES_CAMISETA[] =
+{
+    "Titular", "Suplente", "Retro", "Alternativa", "Entrenamiento", "Seleccion",
+    "Clasica", "Edicion Especial", "Arquero", "Aniversario"
+};
+
+static const char *NOMBRES_CANCHA[] =
+{
+    "Complejo Norte", "La Bombonera Barrial", "Club Social", "Polideportivo",
+    "Cancha Sintetica", "Estadio Municipal", "Parque Central", "Club del Sur"
+};
+
+static const char *NOMBRES_JUGADOR[] =
+{
+    "Juan", "Pedro", "Lucas", "Martin", "Diego", "Nicolas", "Matias", "Santiago",
+    "Facundo", "Tomas", "Agustin", "Franco", "Gonzalo", "Pablo", "Ezequiel", "Bruno"
+};
+
+static const char *APELLIDOS_JUGADOR[] =
+{
+    "Gomez", "Perez", "Rodriguez", "Fernandez", "Lopez", "Martinez", "Garcia",
+    "Sanchez", "Romero", "Diaz", "Alvarez", "Torres", "Ruiz", "Suarez"
+};
+
+static const char *TIPOS_LESION[] =
+{
+    "Esguince", "Desgarro", "Contractura", "Tendinitis", "Golpe", "Fractura"
+};
+
+static const char *ZONAS_LESION[] =
+{
+    "tobillo", "rodilla", "isquiotibial", "gemelo", "hombro", "muneca", "aductor"
+};
+
+static const char *COMENTARIOS[] =
+{
+    "", "", "", "Buen partido", "Cancha pesada", "Mucho viento", "Partido parejo",
+    "Me costo entrar en ritmo", "Gran pase en el segundo tiempo"
+};
+
+#define NUM(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+/**
+ * @brief Siguiente valor pseudoaleatorio de 64 bits (xorshift64*)
+ */
+static unsigned long long rng_siguiente()
+{
+    estado_rng ^= estado_rng >> 12;
+    estado_rng ^= estado_rng << 25;
+    estado_rng ^= estado_rng >> 27;
+    return estado_rng * 2685821657736338717ULL;
+}
+
+/**
+ * @brief Entero uniforme en [min, max]
+ */
+static int rng_rango(int min, int max)
+{
+    return min + (int)(rng_siguiente() % (unsigned long long)(max - min + 1));
+}
+
+/**
+ * @brief Real uniforme en [0, 1)
+ */
+static double rng_uniforme()
+{
+    return (double)(rng_siguiente() >> 11) / 9007199254740992.0;
+}
+
+/**
+ * @brief Muestra de una Poisson de media lambda (metodo de Knuth, lambda pequeno)
+ */
+static int rng_poisson(double lambda)
+{
+    double limite = exp(-lambda);
+    double p = 1.0;
+    int k = 0;
+
+    do
+    {
+        k++;
+        p *= rng_uniforme();
+    }
+    while (p > limite);
+    return k - 1;
+}
+
+/**
+ * @brief Limita un valor al rango [min, max]
+ */
+static int acotar(int v, int min, int max)
+{
+    return v < min ? min : (v > max ? max : v);
+}
+
+/**
+ * @brief Ejecuta una sentencia sin resultados informando del error
+ */
+static int ejecutar(const char *sql)
+{
+    char *err = NULL;
+    if (sqlite3_exec(db, sql, NULL, NULL, &err) != SQLITE_OK)
+    {
+        printf("Error SQL (%s): %s\n", sql, err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Confirma el lote en curso y abre el siguiente cada TAM_LOTE filas
+ */
+static int avanzar_lote(long *filas)
+{
+    if (++(*filas) % TAM_LOTE != 0)
+        return 1;
+    return ejecutar("COMMIT") && ejecutar("BEGIN");
+}
+
+/**
+ * @brief Prepara una sentencia informando del error
+ */
+static sqlite3_stmt *preparar(const char *sql)
+{
+    sqlite3_stmt *stmt;
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+    {
+        printf("Error preparando generador: %s\n", sqlite3_errmsg(db));
+        return NULL;
+    }
+    return stmt;
+}
+
+/**
+ * @brief Ejecuta una sentencia preparada y la deja lista para reutilizarse
+ */
+static int paso(sqlite3_stmt *stmt)
+{
+    int rc = sqlite3_step(stmt);
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    if (rc != SQLITE_DONE)
+    {
+        printf("Error insertando datos: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Convierte segundos desde 1970 (UTC) a "dd/mm/yyyy hh:mm"
+ *
+ * Usa el algoritmo de dias civiles para no depender de la zona horaria,
+ * igual que fecha_a_epoch() en sentido inverso.
+ */
+static void epoch_a_fecha(long long epoch, char *buffer, int size, int *mes, int iso)
+{
+    long long dias = epoch / 86400;
+    int seg = (int)(epoch % 86400);
+    long long z = dias + 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned doe = (unsigned)(z - era * 146097);
+    unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    unsigned mp = (5 * doy + 2) / 153;
+    int d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    int m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    int y = (int)(yoe + era * 400 + (m <= 2));
+
+    if (mes)
+        *mes = m;
+    if (iso)
+        snprintf(buffer, size, "%04d-%02d-%02d", y, m, d);
+    else
+        snprintf(buffer, size, "%02d/%02d/%04d %02d:%02d", d, m, y, seg / 3600, (seg % 3600) / 60);
+}
+
+/**
+ * @brief Clima plausible segun el mes (hemisferio sur)
+ *
+ * 1=Despejado, 2=Nublado, 3=Lluvia, 4=Ventoso, 5=Mucho Calor, 6=Mucho Frio
+ */
+static int clima_para_mes(int mes)
+{
+    int verano = (mes == 12 || mes <= 2);
+    int invierno = (mes >= 6 && mes <= 8);
+    int r = rng_rango(1, 100);
+
+    if (r <= 40) return 1;
+    if (r <= 60) return 2;
+    if (r <= 72) return 3;
+    if (r <= 82) return 4;
+    if (verano) return 5;
+    if (invierno) return 6;
+    return r <= 91 ? 5 : 6;
+}
+
+/**
+ * @brief Inserta camisetas y canchas
+ */
+static int generar_catalogos(const GeneradorConfig *cfg, long *filas)
+{
+    sqlite3_stmt *cam = preparar("INSERT INTO camiseta(id, nombre) VALUES(?, ?)");
+    sqlite3_stmt *can = preparar("INSERT INTO cancha(id, nombre) VALUES(?, ?)");
+    char nombre[128];
+    int ok = cam && can;
+
+    for (int i = 1; ok && i <= cfg->camisetas; i++)
+    {
+        snprintf(nombre, sizeof(nombre), "%s %d", NOMBRES_CAMISETA[(i - 1) % NUM(NOMBRES_CAMISETA)], i);
+        sqlite3_bind_int(cam, 1, i);
+        sqlite3_bind_text(cam, 2, nombre, -1, SQLITE_TRANSIENT);
+        ok = paso(cam) && avanzar_lote(filas);
+    }
+    for (int i = 1; ok && i <= cfg->canchas; i++)
+    {
+        snprintf(nombre, sizeof(nombre), "%s %d", NOMBRES_CANCHA[(i - 1) % NUM(NOMBRES_CANCHA)], i);
+        sqlite3_bind_int(can, 1, i);
+        sqlite3_bind_text(can, 2, nombre, -1, SQLITE_TRANSIENT);
+        ok = paso(can) && avanzar_lote(filas);
+    }
+
+    sqlite3_finalize(cam);
+    sqlite3_finalize(can);
+    return ok;
+}
+
+/**
+ * @brief Inserta los partidos personales en orden cronologico
+ *
+ * Las fechas se reparten entre el 01/01/2010 y el 01/01/2025 con saltos
+ * aleatorios, de modo que con pocos partidos hay dias de descanso y con
+ * cientos de miles hay varios partidos por dia. El turno (dia, tarde,
+ * noche) se deduce de la hora.
+ */
+static int generar_partidos(const GeneradorConfig *cfg, long *filas)
+{
+    sqlite3_stmt *stmt = preparar(
+                             "INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, "
+                             "rendimiento_general, cansancio, estado_animo, comentario_personal, clima, dia) "
+                             "VALUES(?,?,?,?,?,?,?,?,?,?,?,?,?)");
+    const long long desde = 1262304000LL; // 01/01/2010 00:00 UTC
+    const long long hasta = 1735689600LL; // 01/01/2025 00:00 UTC
+    long long salto_medio_min = cfg->partidos > 0 ? (hasta - desde) / 60 / cfg->partidos : 1;
+    long long epoch = desde;
+    double forma = 6.0;
+    int cansancio_acum = 3;
+    char fecha[32];
+    int ok = stmt != NULL;
+
+    if (salto_medio_min < 1)
+        salto_medio_min = 1;
+
+    for (int i = 1; ok && i <= cfg->partidos; i++)
+    {
+        int mes;
+        long long salto_min = 1 + (long long)(rng_uniforme() * 2.0 * salto_medio_min);
+
+        epoch += salto_min * 60;
+        epoch_a_fecha(epoch, fecha, sizeof(fecha), &mes, 0);
+
+        int hora = (int)(epoch % 86400) / 3600;
+        int dia = hora < 13 ? 1 : (hora < 19 ? 2 : 3);
+
+        // Forma latente: paseo aleatorio con reversion hacia 6
+        forma += (6.0 - forma) * 0.1 + (rng_uniforme() - 0.5) * 1.6;
+        // Cuanto menos descanso desde el partido anterior, mas cansancio
+        int objetivo = salto_min < 1440 ? 8 : (salto_min < 4320 ? 5 : 3);
+        cansancio_acum = acotar((cansancio_acum + objetivo) / 2 + rng_rango(-2, 2), 1, 10);
+
+        int clima = clima_para_mes(mes);
+        int cansancio = cansancio_acum;
+        int rendimiento = acotar((int)(forma - (cansancio - 5) * 0.3 - (clima >= 5 ? 0.8 : 0.0) + 0.5), 1, 10);
+        int animo = acotar(rendimiento + rng_rango(-2, 2), 1, 10);
+        int goles = rng_poisson(0.2 + rendimiento * 0.12);
+        int asistencias = rng_poisson(0.15 + rendimiento * 0.08);
+        double p_victoria = 0.15 + rendimiento * 0.06;
+        double r = rng_uniforme();
+        int resultado = r < p_victoria ? 1 : (r < p_victoria + 0.22 ? 2 : 3);
+
+        sqlite3_bind_int(stmt, 1, i);
+        sqlite3_bind_int(stmt, 2, rng_rango(1, cfg->canchas));
+        sqlite3_bind_text(stmt, 3, fecha, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 4, goles);
+        sqlite3_bind_int(stmt, 5, asistencias);
+        sqlite3_bind_int(stmt, 6, rng_rango(1, cfg->camisetas));
+        sqlite3_bind_int(stmt, 7, resultado);
+        sqlite3_bind_int(stmt, 8, rendimiento);
+        sqlite3_bind_int(stmt, 9, cansancio);
+        sqlite3_bind_int(stmt, 10, animo);
+        sqlite3_bind_text(stmt, 11, COMENTARIOS[rng_rango(0, NUM(COMENTARIOS) - 1)], -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 12, clima);
+        sqlite3_bind_int(stmt, 13, dia);
+        ok = paso(stmt) && avanzar_lote(filas);
+    }
+
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+/**
+ * @brief Inserta lesiones asociadas a partidos existentes
+ */
+static int generar_lesiones(const GeneradorConfig *cfg, long *filas)
+{
+    sqlite3_stmt *ins = preparar(
+                            "INSERT INTO lesion(id, jugador, tipo, descripcion, fecha, camiseta_id, partido_id) "
+                            "VALUES(?,?,?,?,?,?,?)");
+    sqlite3_stmt *sel = preparar("SELECT fecha_hora, camiseta_id FROM partido WHERE id = ?");
+    char jugador[64];
+    char descripcion[128];
+    int ok = ins && sel;
+
+    for (int i = 1; ok && cfg->partidos > 0 && i <= cfg->lesiones; i++)
+    {
+        int partido_id = rng_rango(1, cfg->partidos);
+        const char *tipo = TIPOS_LESION[rng_rango(0, NUM(TIPOS_LESION) - 1)];
+
+        sqlite3_bind_int(sel, 1, partido_id);
+        if (sqlite3_step(sel) != SQLITE_ROW)
+        {
+            sqlite3_reset(sel);
+            continue;
+        }
+
+        snprintf(jugador, sizeof(jugador), "%s %s",
+                 NOMBRES_JUGADOR[rng_rango(0, NUM(NOMBRES_JUGADOR) - 1)],
+                 APELLIDOS_JUGADOR[rng_rango(0, NUM(APELLIDOS_JUGADOR) - 1)]);
+        snprintf(descripcion, sizeof(descripcion), "%s de %s, %d dias de baja", tipo,
+                 ZONAS_LESION[rng_rango(0, NUM(ZONAS_LESION) - 1)], rng_rango(3, 60));
+
+        sqlite3_bind_int(ins, 1, i);
+        sqlite3_bind_text(ins, 2, jugador, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(ins, 3, tipo, -1, SQLITE_STATIC);
+        sqlite3_bind_text(ins, 4, descripcion, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(ins, 5, (const char*)sqlite3_column_text(sel, 0), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(ins, 6, sqlite3_column_int(sel, 1));
+        sqlite3_bind_int(ins, 7, partido_id);
+        sqlite3_reset(sel);
+        ok = paso(ins) && avanzar_lote(filas);
+    }
+
+    sqlite3_finalize(ins);
+    sqlite3_finalize(sel);
+    return ok;
+}
+
+/**
+ * @brief Inserta equipos fijos con su plantel completo
+ */
+static int generar_equipos(const GeneradorConfig *cfg, long *filas)
+{
+    static const int JUGADORES_POR_TIPO[] = {5, 7, 8, 11};
+    sqlite3_stmt *eq = preparar(
+                           "INSERT INTO equipo(id, nombre, tipo, tipo_futbol, num_jugadores, partido_id) "
+                           "VALUES(?,?,?,?,?,-1)");
+    sqlite3_stmt *jug = preparar(
+                            "INSERT INTO jugador(equipo_id, nombre, numero, posicion, es_capitan) VALUES(?,?,?,?,?)");
+    char nombre[64];
+    int ok = eq && jug;
+
+    for (int e = 1; ok && e <= cfg->equipos; e++)
+    {
+        int tipo_futbol = rng_rango(FUTBOL_5, FUTBOL_11);
+        int n = JUGADORES_POR_TIPO[tipo_futbol];
+        int capitan = rng_rango(1, n - 1);
+
+        snprintf(nombre, sizeof(nombre), "Equipo %s %d",
+                 APELLIDOS_JUGADOR[(e - 1) % NUM(APELLIDOS_JUGADOR)], e);
+        sqlite3_bind_int(eq, 1, e);
+        sqlite3_bind_text(eq, 2, nombre, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(eq, 3, FIJO);
+        sqlite3_bind_int(eq, 4, tipo_futbol);
+        sqlite3_bind_int(eq, 5, n);
+        ok = paso(eq) && avanzar_lote(filas);
+
+        for (int j = 0; ok && j < n; j++)
+        {
+            // Primer jugador arquero, el resto repartido entre las demas posiciones
+            int posicion = j == 0 ? ARQUERO : (j <= n / 3 ? DEFENSOR : (j <= 2 * n / 3 ? MEDIOCAMPISTA : DELANTERO));
+            snprintf(nombre, sizeof(nombre), "%s %s",
+                     NOMBRES_JUGADOR[rng_rango(0, NUM(NOMBRES_JUGADOR) - 1)],
+                     APELLIDOS_JUGADOR[rng_rango(0, NUM(APELLIDOS_JUGADOR) - 1)]);
+            sqlite3_bind_int(jug, 1, e);
+            sqlite3_bind_text(jug, 2, nombre, -1, SQLITE_TRANSIENT);
+            sqlite3_bind_int(jug, 3, j + 1);
+            sqlite3_bind_int(jug, 4, posicion);
+            sqlite3_bind_int(jug, 5, j == capitan);
+            ok = paso(jug) && avanzar_lote(filas);
+        }
+    }
+
+    sqlite3_finalize(eq);
+    sqlite3_finalize(jug);
+    return ok;
+}
+
+/**
+ * @brief Estadisticas de un equipo dentro de un torneo generado
+ */
+typedef struct
+{
+    int equipo_id;
+    int pj, pg, pe, pp, gf, gc;
+} TablaEquipo;
+
+/**
+ * @brief Inserta torneos de liga a una rueda con todos los partidos jugados
+ *
+ * Cada torneo toma EQUIPOS_POR_TORNEO equipos consecutivos, genera el
+ * fixture todos contra todos con resultado y deja la tabla de posiciones
+ * y las estadisticas de jugadores coherentes con esos resultados.
+ */
+static int generar_torneos(const GeneradorConfig *cfg, long *filas)
+{
+    sqlite3_stmt *tor = preparar(
+                            "INSERT INTO torneo(id, nombre, tiene_equipo_fijo, equipo_fijo_id, cantidad_equipos, "
+                            "tipo_torneo, formato_torneo, fase_actual) VALUES(?,?,0,-1,?,?,?,'Finalizado')");
+    sqlite3_stmt *et = preparar("INSERT INTO equipo_torneo(torneo_id, equipo_id) VALUES(?,?)");
+    sqlite3_stmt *pt = preparar(
+                           "INSERT INTO partido_torneo(torneo_id, equipo1_id, equipo2_id, fecha, goles_equipo1, "
+                           "goles_equipo2, estado, fase) VALUES(?,?,?,?,?,?,?,'Fase de Grupos')");
+    sqlite3_stmt *est = preparar(
+                            "INSERT INTO equipo_torneo_estadisticas(torneo_id, equipo_id, partidos_jugados, "
+                            "partidos_ganados, partidos_empatados, partidos_perdidos, goles_favor, goles_contra, puntos) "
+                            "VALUES(?,?,?,?,?,?,?,?,?)");
+    sqlite3_stmt *je = preparar(
+                           "INSERT INTO jugador_estadisticas(jugador_id, torneo_id, equipo_id, goles, asistencias, "
+                           "tarjetas_amarillas, tarjetas_rojas, minutos_jugados) VALUES(?,?,?,?,?,?,?,?)");
+    sqlite3_stmt *plantel = preparar("SELECT id FROM jugador WHERE equipo_id = ? ORDER BY id");
+    char nombre[64];
+    char fecha[32];
+    long long epoch = 1420070400LL; // 01/01/2015
+    int ok = tor && et && pt && est && je && plantel;
+    int torneos = cfg->torneos;
+
+    if (torneos > 0 && cfg->equipos < EQUIPOS_POR_TORNEO)
+    {
+        printf("Se necesitan al menos %d equipos para generar torneos; se omiten.\n", EQUIPOS_POR_TORNEO);
+        torneos = 0;
+    }
+
+    for (int t = 1; ok && t <= torneos; t++)
+    {
+        TablaEquipo tabla[EQUIPOS_POR_TORNEO];
+        int base = ((t - 1) * EQUIPOS_POR_TORNEO) % (cfg->equipos - EQUIPOS_POR_TORNEO + 1);
+
+        snprintf(nombre, sizeof(nombre), "Liga Sintetica %d", t);
+        sqlite3_bind_int(tor, 1, t);
+        sqlite3_bind_text(tor, 2, nombre, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(tor, 3, EQUIPOS_POR_TORNEO);
+        sqlite3_bind_int(tor, 4, SOLO_IDA);
+        sqlite3_bind_int(tor, 5, LIGA_SIMPLE);
+        ok = paso(tor) && avanzar_lote(filas);
+
+        for (int k = 0; ok && k < EQUIPOS_POR_TORNEO; k++)
+        {
+            memset(&tabla[k], 0, sizeof(tabla[k]));
+            tabla[k].equipo_id = base + k + 1;
+            sqlite3_bind_int(et, 1, t);
+            sqlite3_bind_int(et, 2, tabla[k].equipo_id);
+            ok = paso(et) && avanzar_lote(filas);
+        }
+
+        for (int a = 0; ok && a < EQUIPOS_POR_TORNEO; a++)
+        {
+            for (int b = a + 1; ok && b < EQUIPOS_POR_TORNEO; b++)
+            {
+                int g1 = rng_poisson(1.5);
+                int g2 = rng_poisson(1.2);
+                const char *estado = g1 > g2 ? "Equipo1 Ganador" : (g2 > g1 ? "Equipo2 Ganador" : "Empate");
+
+                epoch += 86400 * rng_rango(1, 4);
+                epoch_a_fecha(epoch, fecha, sizeof(fecha), NULL, 0);
+                fecha[10] = '\0';
+
+                sqlite3_bind_int(pt, 1, t);
+                sqlite3_bind_int(pt, 2, tabla[a].equipo_id);
+                sqlite3_bind_int(pt, 3, tabla[b].equipo_id);
+                sqlite3_bind_text(pt, 4, fecha, -1, SQLITE_TRANSIENT);
+                sqlite3_bind_int(pt, 5, g1);
+                sqlite3_bind_int(pt, 6, g2);
+                sqlite3_bind_text(pt, 7, estado, -1, SQLITE_STATIC);
+                ok = paso(pt) && avanzar_lote(filas);
+
+                tabla[a].pj++;
+                tabla[b].pj++;
+                tabla[a].gf += g1;
+                tabla[a].gc += g2;
+                tabla[b].gf += g2;
+                tabla[b].gc += g1;
+                if (g1 > g2)
+                {
+                    tabla[a].pg++;
+                    tabla[b].pp++;
+                }
+                else if (g2 > g1)
+                {
+                    tabla[b].pg++;
+                    tabla[a].pp++;
+                }
+                else
+                {
+                    tabla[a].pe++;
+                    tabla[b].pe++;
+                }
+            }
+        }
+
+        for (int k = 0; ok && k < EQUIPOS_POR_TORNEO; k++)
+        {
+            sqlite3_bind_int(est, 1, t);
+            sqlite3_bind_int(est, 2, tabla[k].equipo_id);
+            sqlite3_bind_int(est, 3, tabla[k].pj);
+            sqlite3_bind_int(est, 4, tabla[k].pg);
+            sqlite3_bind_int(est, 5, tabla[k].pe);
+            sqlite3_bind_int(est, 6, tabla[k].pp);
+            sqlite3_bind_int(est, 7, tabla[k].gf);
+            sqlite3_bind_int(est, 8, tabla[k].gc);
+            sqlite3_bind_int(est, 9, tabla[k].pg * 3 + tabla[k].pe);
+            ok = paso(est) && avanzar_lote(filas);
+
+            // Goles y asistencias del plantel repartidos al azar, sin superar los del equipo
+            int goles_restantes = tabla[k].gf;
+            sqlite3_bind_int(plantel, 1, tabla[k].equipo_id);
+            while (ok && sqlite3_step(plantel) == SQLITE_ROW)
+            {
+                int goles = goles_restantes > 0 ? rng_rango(0, goles_restantes < 4 ? goles_restantes : 4) : 0;
+                goles_restantes -= goles;
+
+                sqlite3_bind_int(je, 1, sqlite3_column_int(plantel, 0));
+                sqlite3_bind_int(je, 2, t);
+                sqlite3_bind_int(je, 3, tabla[k].equipo_id);
+                sqlite3_bind_int(je, 4, goles);
+                sqlite3_bind_int(je, 5, rng_rango(0, 3));
+                sqlite3_bind_int(je, 6, rng_rango(0, 3));
+                sqlite3_bind_int(je, 7, rng_rango(1, 20) == 1);
+                sqlite3_bind_int(je, 8, tabla[k].pj * rng_rango(20, 50));
+                ok = paso(je) && avanzar_lote(filas);
+            }
+            sqlite3_reset(plantel);
+        }
+    }
+
+    sqlite3_finalize(tor);
+    sqlite3_finalize(et);
+    sqlite3_finalize(pt);
+    sqlite3_finalize(est);
+    sqlite3_finalize(je);
+    sqlite3_finalize(plantel);
+    return ok;
+}
+
+/**
+ * @brief Inserta movimientos de ingresos y gastos
+ */
+static int generar_financiamiento(const GeneradorConfig *cfg, long *filas)
+{
+    static const char *DESCRIPCIONES[] =
+    {
+        "Combi al partido", "Botines nuevos", "Cuota mensual", "Inscripcion torneo",
+        "Pago arbitro", "Alquiler cancha", "Kinesiologo", "Varios"
+    };
+    sqlite3_stmt *stmt = preparar(
+                             "INSERT INTO financiamiento(id, fecha, tipo, categoria, descripcion, monto, item_especifico) "
+                             "VALUES(?,?,?,?,?,?,?)");
+    long long epoch = 1262304000LL;
+    char fecha[32];
+    int ok = stmt != NULL;
+
+    for (int i = 1; ok && i <= cfg->financiamiento; i++)
+    {
+        int categoria = rng_rango(0, NUM(DESCRIPCIONES) - 1);
+        int tipo = categoria == 2 ? 0 : (rng_rango(1, 10) == 1 ? 0 : 1);
+
+        epoch += 86400 * rng_rango(0, 6);
+        epoch_a_fecha(epoch, fecha, sizeof(fecha), NULL, 1);
+
+        sqlite3_bind_int(stmt, 1, i);
+        sqlite3_bind_text(stmt, 2, fecha, -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int(stmt, 3, tipo);
+        sqlite3_bind_int(stmt, 4, categoria);
+        sqlite3_bind_text(stmt, 5, DESCRIPCIONES[categoria], -1, SQLITE_STATIC);
+        sqlite3_bind_double(stmt, 6, rng_rango(500, 50000) / 10.0);
+        sqlite3_bind_text(stmt, 7, "", -1, SQLITE_STATIC);
+        ok = paso(stmt) && avanzar_lote(filas);
+    }
+
+    sqlite3_finalize(stmt);
+    return ok;
+}
+
+/**
+ * @brief Comprueba que no haya datos que el generador pudiera pisar
+ */
+static int base_vacia()
+{
+    sqlite3_stmt *stmt;
+    int filas = -1;
+
+    if (sqlite3_prepare_v2(db,
+                           "SELECT (SELECT COUNT(*) FROM camiseta) + (SELECT COUNT(*) FROM partido) + "
+                           "(SELECT COUNT(*) FROM equipo) + (SELECT COUNT(*) FROM torneo)",
+                           -1, &stmt, NULL) == SQLITE_OK)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            filas = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+    }
+    return filas == 0;
+}
+
+void generador_config_defecto(GeneradorConfig *cfg, int partidos, unsigned long long semilla)
+{
+    cfg->semilla = semilla;
+    cfg->partidos = partidos;
+    cfg->camisetas = partidos >= 1000 ? 40 : 10;
+    cfg->canchas = partidos >= 1000 ? 25 : 8;
+    cfg->lesiones = partidos / 40;
+    cfg->equipos = partidos >= 1000 ? 64 : 16;
+    cfg->torneos = partidos / 2000 + 2;
+    cfg->financiamiento = partidos / 5;
+}
+
+int generador_ejecutar(const GeneradorConfig *cfg)
+{
+    long filas = 0;
+    int ok;
+    double inicio = get_time_ms();
+
+    if (cfg->partidos < 0 || cfg->camisetas < 1 || cfg->canchas < 1)
+    {
+        printf("Configuracion de generador invalida: se necesita al menos una camiseta y una cancha.\n");
+        return 0;
+    }
+    if (!base_vacia())
+    {
+        printf("La base de datos ya contiene datos; el generador solo escribe sobre una base vacia.\n");
+        return 0;
+    }
+
+    // xorshift no admite estado 0
+    estado_rng = cfg->semilla ? cfg->semilla : 0x9E3779B97F4A7C15ULL;
+
+    DbPerfil perfil_previo = db_perfil_actual();
+    db_aplicar_perfil(DB_PERFIL_MAX_RENDIMIENTO);
+
+    ok = ejecutar("BEGIN");
+    ok = ok && generar_catalogos(cfg, &filas);
+    ok = ok && generar_partidos(cfg, &filas);
+    ok = ok && generar_lesiones(cfg, &filas);
+    ok = ok && generar_equipos(cfg, &filas);
+    ok = ok && generar_torneos(cfg, &filas);
+    ok = ok && generar_financiamiento(cfg, &filas);
+
+    if (ok)
+        ok = ejecutar("COMMIT");
+    else
+        ejecutar("ROLLBACK");
+
+    db_aplicar_perfil(perfil_previo);
+
+    double ms = get_time_ms() - inicio;
+    if (ok)
+    {
+        printf("Datos generados (semilla %llu): %d camisetas, %d canchas, %d partidos, %d lesiones, "
+               "%d equipos, %d torneos, %d movimientos\n",
+               cfg->semilla, cfg->camisetas, cfg->canchas, cfg->partidos, cfg->lesiones,
+               cfg->equipos, cfg->torneos, cfg->financiamiento);
+        printf("%ld inserciones en %.1f ms (%.0f filas/s)\n", filas, ms, ms > 0 ? filas * 1000.0 / ms : 0.0);
+    }
+    else
+    {
+        printf("La generacion fallo; los lotes ya confirmados permanecen en la base.\n");
+    }
+    return ok;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file generador.h
+ * @brief Generador de datos sinteticos para pruebas de escala
+ *
+ * Rellena una base de datos vacia con un volumen configurable de camisetas,
+ * canchas, partidos, lesiones, equipos con jugadores, torneos con fixture y
+ * resultados y movimientos de financiamiento. Con la misma semilla produce
+ * siempre los mismos datos.
+ */
+
+#ifndef GENERADOR_H
+#define GENERADOR_H
+
+/**
+ * @brief Volumenes a generar
+ */
+typedef struct
+{
+    unsigned long long semilla; /**< Semilla del generador pseudoaleatorio */
+    int camisetas;              /**< Numero de camisetas */
+    int canchas;                /**< Numero de canchas */
+    int partidos;               /**< Numero de partidos personales */
+    int lesiones;               /**< Numero de lesiones */
+    int equipos;                /**< Numero de equipos fijos (con sus jugadores) */
+    int torneos;                /**< Numero de torneos de liga con resultados */
+    int financiamiento;         /**< Numero de movimientos de financiamiento */
+} GeneradorConfig;
+
+/**
+ * @brief Rellena la configuracion con volumenes proporcionales a un numero de partidos
+ *
+ * @param cfg Configuracion a rellenar
+ * @param partidos Numero de partidos personales
+ * @param semilla Semilla del generador
+ */
+void generador_config_defecto(GeneradorConfig *cfg, int partidos, unsigned long long semilla);
+
+/**
+ * @brief Genera los datos en la conexion global
+ *
+ * Se niega a escribir si la base de datos ya tiene camisetas o partidos.
+ * Las inserciones se agrupan en transacciones por lotes y se usa el perfil
+ * de maximo rendimiento mientras dura la carga.
+ *
+ * @param cfg Volumenes y semilla
+ * @return 1 si exito, 0 en caso de error
+ */
+int generador_ejecutar(const GeneradorConfig *cfg);
+
+#endif
@@ -122,11 +122,11 @@ void importar_camisetas_json()
 
         // Verificar si ya existe
         sqlite3_stmt *check_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM camiseta WHERE id = ?", -1, &check_stmt, NULL);
+        check_stmt = db_prepare_cached("SELECT COUNT(*) FROM camiseta WHERE id = ?");
         sqlite3_bind_int(check_stmt, 1, id);
         sqlite3_step(check_stmt);
         int exists = sqlite3_column_int(check_stmt, 0);
-        sqlite3_finalize(check_stmt);
+        db_release_cached(check_stmt);
 
         if (exists)
         {
@@ -136,11 +136,11 @@ void importar_camisetas_json()
 
         // Insertar
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)");
         sqlite3_bind_int(stmt, 1, id);
         sqlite3_bind_text(stmt, 2, nombre, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Camiseta '%s' importada correctamente\n", nombre);
     }
@@ -210,7 +210,7 @@ void importar_partidos_json()
             continue;
 
         const char *cancha_nombre = cancha_json->valuestring;
-        const char *fecha = fecha_json->valuestring;
+        char fecha[20];
         int goles = goles_json->valueint;
         int asistencias = asistencias_json->valueint;
         const char *camiseta_nombre = camiseta_json->valuestring;
@@ -222,39 +222,45 @@ void importar_partidos_json()
         int estado_animo = estado_animo_json ? estado_animo_json->valueint : 0;
         const char *comentario_personal = comentario_personal_json ? comentario_personal_json->valuestring : "";
 
+        if (!normalizar_fecha(fecha_json->valuestring, fecha, sizeof(fecha)))
+        {
+            printf("Fecha '%s' invalida, omitiendo partido...\n", fecha_json->valuestring);
+            continue;
+        }
+
         // Obtener ID de cancha
         sqlite3_stmt *cancha_stmt;
-        sqlite3_prepare_v2(db, "SELECT id FROM cancha WHERE nombre = ?", -1, &cancha_stmt, NULL);
+        cancha_stmt = db_prepare_cached("SELECT id FROM cancha WHERE nombre = ?");
         sqlite3_bind_text(cancha_stmt, 1, cancha_nombre, -1, SQLITE_TRANSIENT);
         int cancha_id = -1;
         if (sqlite3_step(cancha_stmt) == SQLITE_ROW)
         {
             cancha_id = sqlite3_column_int(cancha_stmt, 0);
         }
-        sqlite3_finalize(cancha_stmt);
+        db_release_cached(cancha_stmt);
 
         if (cancha_id == -1)
         {
             printf("Cancha '%s' no encontrada, creando...\n", cancha_nombre);
             // Crear cancha si no existe
             sqlite3_stmt *insert_cancha;
-            sqlite3_prepare_v2(db, "INSERT INTO cancha(nombre) VALUES(?)", -1, &insert_cancha, NULL);
+            insert_cancha = db_prepare_cached("INSERT INTO cancha(nombre) VALUES(?)");
             sqlite3_bind_text(insert_cancha, 1, cancha_nombre, -1, SQLITE_TRANSIENT);
             sqlite3_step(insert_cancha);
             cancha_id = sqlite3_last_insert_rowid(db);
-            sqlite3_finalize(insert_cancha);
+            db_release_cached(insert_cancha);
         }
 
         // Obtener ID de camiseta
         sqlite3_stmt *camiseta_stmt;
-        sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+        camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
         sqlite3_bind_text(camiseta_stmt, 1, camiseta_nombre, -1, SQLITE_TRANSIENT);
         int camiseta_id = -1;
         if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
         {
             camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
         }
-        sqlite3_finalize(camiseta_stmt);
+        db_release_cached(camiseta_stmt);
 
         if (camiseta_id == -1)
         {
@@ -264,13 +270,13 @@ void importar_partidos_json()
 
         // Verificar si ya existe un partido con los mismos datos
         sqlite3_stmt *dup_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?", -1, &dup_stmt, NULL);
+        dup_stmt = db_prepare_cached("SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?");
         sqlite3_bind_int(dup_stmt, 1, cancha_id);
         sqlite3_bind_text(dup_stmt, 2, fecha, -1, SQLITE_TRANSIENT);
         sqlite3_bind_int(dup_stmt, 3, camiseta_id);
         sqlite3_step(dup_stmt);
         int exists = sqlite3_column_int(dup_stmt, 0);
-        sqlite3_finalize(dup_stmt);
+        db_release_cached(dup_stmt);
 
         if (exists)
         {
@@ -279,18 +285,11 @@ void importar_partidos_json()
         }
 
         // Obtener siguiente ID para partido
-        int partido_id = 1;
-        sqlite3_stmt *max_stmt;
-        sqlite3_prepare_v2(db, "SELECT COALESCE(MAX(id), 0) + 1 FROM partido", -1, &max_stmt, NULL);
-        if (sqlite3_step(max_stmt) == SQLITE_ROW)
-        {
-            partido_id = sqlite3_column_int(max_stmt, 0);
-        }
-        sqlite3_finalize(max_stmt);
+        int partido_id = db_siguiente_id("partido");
 
         // Insertar partido
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
         sqlite3_bind_int(stmt, 1, partido_id);
         sqlite3_bind_int(stmt, 2, cancha_id);
         sqlite3_bind_text(stmt, 3, fecha, -1, SQLITE_TRANSIENT);
@@ -305,7 +304,7 @@ void importar_partidos_json()
         sqlite3_bind_int(stmt, 12, estado_animo);
         sqlite3_bind_text(stmt, 13, comentario_personal, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Partido en '%s' importado correctamente\n", cancha_nombre);
     }
@@ -377,11 +376,11 @@ void importar_lesiones_json()
 
         // Verificar si ya existe
         sqlite3_stmt *check_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM lesion WHERE id = ?", -1, &check_stmt, NULL);
+        check_stmt = db_prepare_cached("SELECT COUNT(*) FROM lesion WHERE id = ?");
         sqlite3_bind_int(check_stmt, 1, id);
         sqlite3_step(check_stmt);
         int exists = sqlite3_column_int(check_stmt, 0);
-        sqlite3_finalize(check_stmt);
+        db_release_cached(check_stmt);
 
         if (exists)
         {
@@ -391,14 +390,14 @@ void importar_lesiones_json()
 
         // Insertar lesión
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)");
         sqlite3_bind_int(stmt, 1, id);
         sqlite3_bind_text(stmt, 2, jugador, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 3, tipo, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 4, descripcion, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 5, fecha, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Lesion de '%s' importada correctamente\n", jugador);
     }
@@ -490,14 +489,14 @@ void importar_estadisticas_json()
 
         // Obtener ID de camiseta
         sqlite3_stmt *camiseta_stmt;
-        sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+        camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
         sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
         int camiseta_id = -1;
         if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
         {
             camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
         }
-        sqlite3_finalize(camiseta_stmt);
+        db_release_cached(camiseta_stmt);
 
         if (camiseta_id == -1)
         {
@@ -507,11 +506,11 @@ void importar_estadisticas_json()
 
         // Verificar si ya existe estadística para esta camiseta
         sqlite3_stmt *check_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?", -1, &check_stmt, NULL);
+        check_stmt = db_prepare_cached("SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?");
         sqlite3_bind_int(check_stmt, 1, camiseta_id);
         sqlite3_step(check_stmt);
         int exists = sqlite3_column_int(check_stmt, 0);
-        sqlite3_finalize(check_stmt);
+        db_release_cached(check_stmt);
 
         if (exists)
         {
@@ -521,7 +520,7 @@ void importar_estadisticas_json()
 
         // Insertar estadística
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)");
         sqlite3_bind_int(stmt, 1, camiseta_id);
         sqlite3_bind_int(stmt, 2, goles);
         sqlite3_bind_int(stmt, 3, asistencias);
@@ -530,7 +529,7 @@ void importar_estadisticas_json()
         sqlite3_bind_int(stmt, 6, empates);
         sqlite3_bind_int(stmt, 7, derrotas);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Estadistica de '%s' importada correctamente\n", camiseta);
     }
@@ -803,11 +802,11 @@ void importar_camisetas_txt()
             trim_trailing_spaces(nombre);
             // Verificar si ya existe
             sqlite3_stmt *check_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM camiseta WHERE id = ?", -1, &check_stmt, NULL);
+            check_stmt = db_prepare_cached("SELECT COUNT(*) FROM camiseta WHERE id = ?");
             sqlite3_bind_int(check_stmt, 1, id);
             sqlite3_step(check_stmt);
             int exists = sqlite3_column_int(check_stmt, 0);
-            sqlite3_finalize(check_stmt);
+            db_release_cached(check_stmt);
 
             if (exists)
             {
@@ -817,11 +816,11 @@ void importar_camisetas_txt()
 
             // Insertar
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)");
             sqlite3_bind_int(stmt, 1, id);
             sqlite3_bind_text(stmt, 2, nombre, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Camiseta '%s' importada correctamente\n", nombre);
             count++;
@@ -895,39 +894,45 @@ void importar_partidos_txt()
             else if (strcmp(dia_str, "Tarde") == 0) dia = 2;
             else if (strcmp(dia_str, "Noche") == 0) dia = 3;
 
+            if (!normalizar_fecha(fecha, fecha, sizeof(fecha)))
+            {
+                printf("Fecha '%s' invalida, omitiendo partido...\n", fecha);
+                continue;
+            }
+
             // Obtener ID de cancha
             sqlite3_stmt *cancha_stmt;
-            sqlite3_prepare_v2(db, "SELECT id FROM cancha WHERE nombre = ?", -1, &cancha_stmt, NULL);
+            cancha_stmt = db_prepare_cached("SELECT id FROM cancha WHERE nombre = ?");
             sqlite3_bind_text(cancha_stmt, 1, cancha, -1, SQLITE_TRANSIENT);
             int cancha_id = -1;
             if (sqlite3_step(cancha_stmt) == SQLITE_ROW)
             {
                 cancha_id = sqlite3_column_int(cancha_stmt, 0);
             }
-            sqlite3_finalize(cancha_stmt);
+            db_release_cached(cancha_stmt);
 
             if (cancha_id == -1)
             {
                 printf("Cancha '%s' no encontrada, creando...\n", cancha);
                 // Crear cancha si no existe
                 sqlite3_stmt *insert_cancha;
-                sqlite3_prepare_v2(db, "INSERT INTO cancha(nombre) VALUES(?)", -1, &insert_cancha, NULL);
+                insert_cancha = db_prepare_cached("INSERT INTO cancha(nombre) VALUES(?)");
                 sqlite3_bind_text(insert_cancha, 1, cancha, -1, SQLITE_TRANSIENT);
                 sqlite3_step(insert_cancha);
                 cancha_id = sqlite3_last_insert_rowid(db);
-                sqlite3_finalize(insert_cancha);
+                db_release_cached(insert_cancha);
             }
 
             // Obtener ID de camiseta
             sqlite3_stmt *camiseta_stmt;
-            sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+            camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
             sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
             int camiseta_id = -1;
             if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
             {
                 camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
             }
-            sqlite3_finalize(camiseta_stmt);
+            db_release_cached(camiseta_stmt);
 
             if (camiseta_id == -1)
             {
@@ -937,13 +942,13 @@ void importar_partidos_txt()
 
             // Verificar si ya existe un partido con los mismos datos
             sqlite3_stmt *dup_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?", -1, &dup_stmt, NULL);
+            dup_stmt = db_prepare_cached("SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?");
             sqlite3_bind_int(dup_stmt, 1, cancha_id);
             sqlite3_bind_text(dup_stmt, 2, fecha, -1, SQLITE_TRANSIENT);
             sqlite3_bind_int(dup_stmt, 3, camiseta_id);
             sqlite3_step(dup_stmt);
             int exists = sqlite3_column_int(dup_stmt, 0);
-            sqlite3_finalize(dup_stmt);
+            db_release_cached(dup_stmt);
 
             if (exists)
             {
@@ -952,18 +957,11 @@ void importar_partidos_txt()
             }
 
             // Obtener siguiente ID para partido
-            int partido_id = 1;
-            sqlite3_stmt *max_stmt;
-            sqlite3_prepare_v2(db, "SELECT COALESCE(MAX(id), 0) + 1 FROM partido", -1, &max_stmt, NULL);
-            if (sqlite3_step(max_stmt) == SQLITE_ROW)
-            {
-                partido_id = sqlite3_column_int(max_stmt, 0);
-            }
-            sqlite3_finalize(max_stmt);
+            int partido_id = db_siguiente_id("partido");
 
             // Insertar partido
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
             sqlite3_bind_int(stmt, 1, partido_id);
             sqlite3_bind_int(stmt, 2, cancha_id);
             sqlite3_bind_text(stmt, 3, fecha, -1, SQLITE_TRANSIENT);
@@ -978,7 +976,7 @@ void importar_partidos_txt()
             sqlite3_bind_int(stmt, 12, estado_animo);
             sqlite3_bind_text(stmt, 13, comentario, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Partido en '%s' importado correctamente\n", cancha);
             count++;
@@ -1032,11 +1030,11 @@ void importar_lesiones_txt()
         {
             // Verificar si ya existe
             sqlite3_stmt *check_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM lesion WHERE id = ?", -1, &check_stmt, NULL);
+            check_stmt = db_prepare_cached("SELECT COUNT(*) FROM lesion WHERE id = ?");
             sqlite3_bind_int(check_stmt, 1, id);
             sqlite3_step(check_stmt);
             int exists = sqlite3_column_int(check_stmt, 0);
-            sqlite3_finalize(check_stmt);
+            db_release_cached(check_stmt);
 
             if (exists)
             {
@@ -1046,14 +1044,14 @@ void importar_lesiones_txt()
 
             // Insertar lesión
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)");
             sqlite3_bind_int(stmt, 1, id);
             sqlite3_bind_text(stmt, 2, jugador, -1, SQLITE_TRANSIENT);
             sqlite3_bind_text(stmt, 3, tipo, -1, SQLITE_TRANSIENT);
             sqlite3_bind_text(stmt, 4, descripcion, -1, SQLITE_TRANSIENT);
             sqlite3_bind_text(stmt, 5, fecha, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Lesion de '%s' importada correctamente\n", jugador);
             count++;
@@ -1126,14 +1124,14 @@ void importar_estadisticas_txt()
         {
             // Obtener ID de camiseta
             sqlite3_stmt *camiseta_stmt;
-            sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+            camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
             sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
             int camiseta_id = -1;
             if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
             {
                 camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
             }
-            sqlite3_finalize(camiseta_stmt);
+            db_release_cached(camiseta_stmt);
 
             if (camiseta_id == -1)
             {
@@ -1143,11 +1141,11 @@ void importar_estadisticas_txt()
 
             // Verificar si ya existe estadística para esta camiseta
             sqlite3_stmt *check_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?", -1, &check_stmt, NULL);
+            check_stmt = db_prepare_cached("SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?");
             sqlite3_bind_int(check_stmt, 1, camiseta_id);
             sqlite3_step(check_stmt);
             int exists = sqlite3_column_int(check_stmt, 0);
-            sqlite3_finalize(check_stmt);
+            db_release_cached(check_stmt);
 
             if (exists)
             {
@@ -1157,7 +1155,7 @@ void importar_estadisticas_txt()
 
             // Insertar estadística
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)");
             sqlite3_bind_int(stmt, 1, camiseta_id);
             sqlite3_bind_int(stmt, 2, goles);
             sqlite3_bind_int(stmt, 3, asistencias);
@@ -1166,7 +1164,7 @@ void importar_estadisticas_txt()
             sqlite3_bind_int(stmt, 6, empates);
             sqlite3_bind_int(stmt, 7, derrotas);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Estadistica de '%s' importada correctamente\n", camiseta);
             count++;
@@ -1226,11 +1224,11 @@ void importar_camisetas_csv()
         {
             // Verificar si ya existe
             sqlite3_stmt *check_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM camiseta WHERE id = ?", -1, &check_stmt, NULL);
+            check_stmt = db_prepare_cached("SELECT COUNT(*) FROM camiseta WHERE id = ?");
             sqlite3_bind_int(check_stmt, 1, id);
             sqlite3_step(check_stmt);
             int exists = sqlite3_column_int(check_stmt, 0);
-            sqlite3_finalize(check_stmt);
+            db_release_cached(check_stmt);
 
             if (exists)
             {
@@ -1240,11 +1238,11 @@ void importar_camisetas_csv()
 
             // Insertar
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)");
             sqlite3_bind_int(stmt, 1, id);
             sqlite3_bind_text(stmt, 2, nombre, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Camiseta '%s' importada correctamente\n", nombre);
             count++;
@@ -1318,39 +1316,45 @@ void importar_partidos_csv()
             else if (strcmp(dia_str, "Tarde") == 0) dia = 2;
             else if (strcmp(dia_str, "Noche") == 0) dia = 3;
 
+            if (!normalizar_fecha(fecha, fecha, sizeof(fecha)))
+            {
+                printf("Fecha '%s' invalida, omitiendo partido...\n", fecha);
+                continue;
+            }
+
             // Obtener ID de cancha
             sqlite3_stmt *cancha_stmt;
-            sqlite3_prepare_v2(db, "SELECT id FROM cancha WHERE nombre = ?", -1, &cancha_stmt, NULL);
+            cancha_stmt = db_prepare_cached("SELECT id FROM cancha WHERE nombre = ?");
             sqlite3_bind_text(cancha_stmt, 1, cancha, -1, SQLITE_TRANSIENT);
             int cancha_id = -1;
             if (sqlite3_step(cancha_stmt) == SQLITE_ROW)
             {
                 cancha_id = sqlite3_column_int(cancha_stmt, 0);
             }
-            sqlite3_finalize(cancha_stmt);
+            db_release_cached(cancha_stmt);
 
             if (cancha_id == -1)
             {
                 printf("Cancha '%s' no encontrada, creando...\n", cancha);
                 // Crear cancha si no existe
                 sqlite3_stmt *insert_cancha;
-                sqlite3_prepare_v2(db, "INSERT INTO cancha(nombre) VALUES(?)", -1, &insert_cancha, NULL);
+                insert_cancha = db_prepare_cached("INSERT INTO cancha(nombre) VALUES(?)");
                 sqlite3_bind_text(insert_cancha, 1, cancha, -1, SQLITE_TRANSIENT);
                 sqlite3_step(insert_cancha);
                 cancha_id = sqlite3_last_insert_rowid(db);
-                sqlite3_finalize(insert_cancha);
+                db_release_cached(insert_cancha);
             }
 
             // Obtener ID de camiseta
             sqlite3_stmt *camiseta_stmt;
-            sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+            camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
             sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
             int camiseta_id = -1;
             if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
             {
                 camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
             }
-            sqlite3_finalize(camiseta_stmt);
+            db_release_cached(camiseta_stmt);
 
             if (camiseta_id == -1)
             {
@@ -1360,13 +1364,13 @@ void importar_partidos_csv()
 
             // Verificar si ya existe un partido con los mismos datos
             sqlite3_stmt *dup_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?", -1, &dup_stmt, NULL);
+            dup_stmt = db_prepare_cached("SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?");
             sqlite3_bind_int(dup_stmt, 1, cancha_id);
             sqlite3_bind_text(dup_stmt, 2, fecha, -1, SQLITE_TRANSIENT);
             sqlite3_bind_int(dup_stmt, 3, camiseta_id);
             sqlite3_step(dup_stmt);
             int exists = sqlite3_column_int(dup_stmt, 0);
-            sqlite3_finalize(dup_stmt);
+            db_release_cached(dup_stmt);
 
             if (exists)
             {
@@ -1375,18 +1379,11 @@ void importar_partidos_csv()
             }
 
             // Obtener siguiente ID para partido
-            int partido_id = 1;
-            sqlite3_stmt *max_stmt;
-            sqlite3_prepare_v2(db, "SELECT COALESCE(MAX(id), 0) + 1 FROM partido", -1, &max_stmt, NULL);
-            if (sqlite3_step(max_stmt) == SQLITE_ROW)
-            {
-                partido_id = sqlite3_column_int(max_stmt, 0);
-            }
-            sqlite3_finalize(max_stmt);
+            int partido_id = db_siguiente_id("partido");
 
             // Insertar partido
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
             sqlite3_bind_int(stmt, 1, partido_id);
             sqlite3_bind_int(stmt, 2, cancha_id);
             sqlite3_bind_text(stmt, 3, fecha, -1, SQLITE_TRANSIENT);
@@ -1401,7 +1398,7 @@ void importar_partidos_csv()
             sqlite3_bind_int(stmt, 12, estado_animo);
             sqlite3_bind_text(stmt, 13, comentario, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Partido en '%s' importado correctamente\n", cancha);
             count++;
@@ -1455,11 +1452,11 @@ void importar_lesiones_csv()
         {
             // Verificar si ya existe
             sqlite3_stmt *check_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM lesion WHERE id = ?", -1, &check_stmt, NULL);
+            check_stmt = db_prepare_cached("SELECT COUNT(*) FROM lesion WHERE id = ?");
             sqlite3_bind_int(check_stmt, 1, id);
             sqlite3_step(check_stmt);
             int exists = sqlite3_column_int(check_stmt, 0);
-            sqlite3_finalize(check_stmt);
+            db_release_cached(check_stmt);
 
             if (exists)
             {
@@ -1469,14 +1466,14 @@ void importar_lesiones_csv()
 
             // Insertar lesión
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)");
             sqlite3_bind_int(stmt, 1, id);
             sqlite3_bind_text(stmt, 2, jugador, -1, SQLITE_TRANSIENT);
             sqlite3_bind_text(stmt, 3, tipo, -1, SQLITE_TRANSIENT);
             sqlite3_bind_text(stmt, 4, descripcion, -1, SQLITE_TRANSIENT);
             sqlite3_bind_text(stmt, 5, fecha, -1, SQLITE_TRANSIENT);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Lesion de '%s' importada correctamente\n", jugador);
             count++;
@@ -1549,14 +1546,14 @@ void importar_estadisticas_csv()
         {
             // Obtener ID de camiseta
             sqlite3_stmt *camiseta_stmt;
-            sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+            camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
             sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
             int camiseta_id = -1;
             if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
             {
                 camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
             }
-            sqlite3_finalize(camiseta_stmt);
+            db_release_cached(camiseta_stmt);
 
             if (camiseta_id == -1)
             {
@@ -1566,11 +1563,11 @@ void importar_estadisticas_csv()
 
             // Verificar si ya existe estadística para esta camiseta
             sqlite3_stmt *check_stmt;
-            sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?", -1, &check_stmt, NULL);
+            check_stmt = db_prepare_cached("SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?");
             sqlite3_bind_int(check_stmt, 1, camiseta_id);
             sqlite3_step(check_stmt);
             int exists = sqlite3_column_int(check_stmt, 0);
-            sqlite3_finalize(check_stmt);
+            db_release_cached(check_stmt);
 
             if (exists)
             {
@@ -1580,7 +1577,7 @@ void importar_estadisticas_csv()
 
             // Insertar estadística
             sqlite3_stmt *stmt;
-            sqlite3_prepare_v2(db, "INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+            stmt = db_prepare_cached("INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)");
             sqlite3_bind_int(stmt, 1, camiseta_id);
             sqlite3_bind_int(stmt, 2, goles);
             sqlite3_bind_int(stmt, 3, asistencias);
@@ -1589,7 +1586,7 @@ void importar_estadisticas_csv()
             sqlite3_bind_int(stmt, 6, empates);
             sqlite3_bind_int(stmt, 7, derrotas);
             sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            db_release_cached(stmt);
 
             printf("Estadistica de '%s' importada correctamente\n", camiseta);
             count++;
@@ -1646,11 +1643,11 @@ void importar_camisetas_html()
 
         // Verificar si ya existe
         sqlite3_stmt *check_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM camiseta WHERE id = ?", -1, &check_stmt, NULL);
+        check_stmt = db_prepare_cached("SELECT COUNT(*) FROM camiseta WHERE id = ?");
         sqlite3_bind_int(check_stmt, 1, id);
         sqlite3_step(check_stmt);
         int exists = sqlite3_column_int(check_stmt, 0);
-        sqlite3_finalize(check_stmt);
+        db_release_cached(check_stmt);
 
         if (exists)
         {
@@ -1661,11 +1658,11 @@ void importar_camisetas_html()
 
         // Insertar
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO camiseta(id, nombre, sorteada) VALUES(?, ?, 0)");
         sqlite3_bind_int(stmt, 1, id);
         sqlite3_bind_text(stmt, 2, nombre, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Camiseta '%s' importada correctamente\n", nombre);
         count++;
@@ -1776,39 +1773,45 @@ void importar_partidos_html()
         else if (strcmp(dia_str, "Tarde") == 0) dia = 2;
         else if (strcmp(dia_str, "Noche") == 0) dia = 3;
 
+        if (!normalizar_fecha(fecha, fecha, sizeof(fecha)))
+        {
+            printf("Fecha '%s' invalida, omitiendo partido...\n", fecha);
+            continue;
+        }
+
         // Obtener ID de cancha
         sqlite3_stmt *cancha_stmt;
-        sqlite3_prepare_v2(db, "SELECT id FROM cancha WHERE nombre = ?", -1, &cancha_stmt, NULL);
+        cancha_stmt = db_prepare_cached("SELECT id FROM cancha WHERE nombre = ?");
         sqlite3_bind_text(cancha_stmt, 1, cancha, -1, SQLITE_TRANSIENT);
         int cancha_id = -1;
         if (sqlite3_step(cancha_stmt) == SQLITE_ROW)
         {
             cancha_id = sqlite3_column_int(cancha_stmt, 0);
         }
-        sqlite3_finalize(cancha_stmt);
+        db_release_cached(cancha_stmt);
 
         if (cancha_id == -1)
         {
             printf("Cancha '%s' no encontrada, creando...\n", cancha);
             // Crear cancha si no existe
             sqlite3_stmt *insert_cancha;
-            sqlite3_prepare_v2(db, "INSERT INTO cancha(nombre) VALUES(?)", -1, &insert_cancha, NULL);
+            insert_cancha = db_prepare_cached("INSERT INTO cancha(nombre) VALUES(?)");
             sqlite3_bind_text(insert_cancha, 1, cancha, -1, SQLITE_TRANSIENT);
             sqlite3_step(insert_cancha);
             cancha_id = sqlite3_last_insert_rowid(db);
-            sqlite3_finalize(insert_cancha);
+            db_release_cached(insert_cancha);
         }
 
         // Obtener ID de camiseta
         sqlite3_stmt *camiseta_stmt;
-        sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+        camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
         sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
         int camiseta_id = -1;
         if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
         {
             camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
         }
-        sqlite3_finalize(camiseta_stmt);
+        db_release_cached(camiseta_stmt);
 
         if (camiseta_id == -1)
         {
@@ -1817,18 +1820,11 @@ void importar_partidos_html()
         }
 
         // Obtener siguiente ID para partido
-        int partido_id = 1;
-        sqlite3_stmt *max_stmt;
-        sqlite3_prepare_v2(db, "SELECT COALESCE(MAX(id), 0) + 1 FROM partido", -1, &max_stmt, NULL);
-        if (sqlite3_step(max_stmt) == SQLITE_ROW)
-        {
-            partido_id = sqlite3_column_int(max_stmt, 0);
-        }
-        sqlite3_finalize(max_stmt);
+        int partido_id = db_siguiente_id("partido");
 
         // Insertar partido
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO partido(id, cancha_id, fecha_hora, goles, asistencias, camiseta_id, resultado, clima, dia, rendimiento_general, cansancio, estado_animo, comentario_personal) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
         sqlite3_bind_int(stmt, 1, partido_id);
         sqlite3_bind_int(stmt, 2, cancha_id);
         sqlite3_bind_text(stmt, 3, fecha, -1, SQLITE_TRANSIENT);
@@ -1843,7 +1839,7 @@ void importar_partidos_html()
         sqlite3_bind_int(stmt, 12, estado_animo);
         sqlite3_bind_text(stmt, 13, comentario, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Partido en '%s' importado correctamente\n", cancha);
         count++;
@@ -1915,11 +1911,11 @@ void importar_lesiones_html()
 
         // Verificar si ya existe
         sqlite3_stmt *check_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM lesion WHERE id = ?", -1, &check_stmt, NULL);
+        check_stmt = db_prepare_cached("SELECT COUNT(*) FROM lesion WHERE id = ?");
         sqlite3_bind_int(check_stmt, 1, id);
         sqlite3_step(check_stmt);
         int exists = sqlite3_column_int(check_stmt, 0);
-        sqlite3_finalize(check_stmt);
+        db_release_cached(check_stmt);
 
         if (exists)
         {
@@ -1929,14 +1925,14 @@ void importar_lesiones_html()
 
         // Insertar lesión
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO lesion(id, jugador, tipo, descripcion, fecha) VALUES(?, ?, ?, ?, ?)");
         sqlite3_bind_int(stmt, 1, id);
         sqlite3_bind_text(stmt, 2, jugador, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 3, tipo, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 4, descripcion, -1, SQLITE_TRANSIENT);
         sqlite3_bind_text(stmt, 5, fecha, -1, SQLITE_TRANSIENT);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Lesion de '%s' importada correctamente\n", jugador);
         count++;
@@ -2033,14 +2029,14 @@ void importar_estadisticas_html()
 
         // Obtener ID de camiseta
         sqlite3_stmt *camiseta_stmt;
-        sqlite3_prepare_v2(db, "SELECT id FROM camiseta WHERE nombre = ?", -1, &camiseta_stmt, NULL);
+        camiseta_stmt = db_prepare_cached("SELECT id FROM camiseta WHERE nombre = ?");
         sqlite3_bind_text(camiseta_stmt, 1, camiseta, -1, SQLITE_TRANSIENT);
         int camiseta_id = -1;
         if (sqlite3_step(camiseta_stmt) == SQLITE_ROW)
         {
             camiseta_id = sqlite3_column_int(camiseta_stmt, 0);
         }
-        sqlite3_finalize(camiseta_stmt);
+        db_release_cached(camiseta_stmt);
 
         if (camiseta_id == -1)
         {
@@ -2050,11 +2046,11 @@ void importar_estadisticas_html()
 
         // Verificar si ya existe estadística para esta camiseta
         sqlite3_stmt *check_stmt;
-        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?", -1, &check_stmt, NULL);
+        check_stmt = db_prepare_cached("SELECT COUNT(*) FROM estadistica WHERE camiseta_id = ?");
         sqlite3_bind_int(check_stmt, 1, camiseta_id);
         sqlite3_step(check_stmt);
         int exists = sqlite3_column_int(check_stmt, 0);
-        sqlite3_finalize(check_stmt);
+        db_release_cached(check_stmt);
 
         if (exists)
         {
@@ -2064,7 +2060,7 @@ void importar_estadisticas_html()
 
         // Insertar estadística
         sqlite3_stmt *stmt;
-        sqlite3_prepare_v2(db, "INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)", -1, &stmt, NULL);
+        stmt = db_prepare_cached("INSERT INTO estadistica(camiseta_id, goles, asistencias, partidos, victorias, empates, derrotas) VALUES(?, ?, ?, ?, ?, ?, ?)");
         sqlite3_bind_int(stmt, 1, camiseta_id);
         sqlite3_bind_int(stmt, 2, goles);
         sqlite3_bind_int(stmt, 3, asistencias);
@@ -2073,7 +2069,7 @@ void importar_estadisticas_html()
         sqlite3_bind_int(stmt, 6, empates);
         sqlite3_bind_int(stmt, 7, derrotas);
         sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
 
         printf("Estadistica de '%s' importada correctamente\n", camiseta);
         count++;
@@ -2165,12 +2161,100 @@ static void submenu_importar_html()
     ejecutar_menu("IMPORTAR DATOS DESDE HTML", items, 6);
 }
 
+/**
+ * @brief Importador asociado a un archivo del directorio de importacion
+ */
+typedef struct
+{
+    const char *archivo;
+    void (*accion)();
+} ImportacionNombrada;
+
+/**
+ * @brief Importaciones disponibles desde la linea de comandos (--import <archivo>)
+ */
+static const ImportacionNombrada IMPORTACIONES[] =
+{
+    {"camisetas.json", importar_camisetas_json},
+    {"partidos.json", importar_partidos_json},
+    {"lesiones.json", importar_lesiones_json},
+    {"estadisticas.json", importar_estadisticas_json},
+    {"camisetas.txt", importar_camisetas_txt},
+    {"partidos.txt", importar_partidos_txt},
+    {"lesiones.txt", importar_lesiones_txt},
+    {"estadisticas.txt", importar_estadisticas_txt},
+    {"camisetas.csv", importar_camisetas_csv},
+    {"partidos.csv", importar_partidos_csv},
+    {"lesiones.csv", importar_lesiones_csv},
+    {"estadisticas.csv", importar_estadisticas_csv},
+    {"camisetas.html", importar_camisetas_html},
+    {"partidos.html", importar_partidos_html},
+    {"lesiones.html", importar_lesiones_html},
+    {"estadisticas.html", importar_estadisticas_html}
+};
+
+int importar_por_nombre(const char *archivo)
+{
+    const char *base = archivo;
+    const char *ext;
+    int ejecutadas = 0;
+
+    // Los importadores leen siempre del directorio de importacion: solo cuenta el nombre
+    for (const char *c = archivo; *c; c++)
+    {
+        if (*c == '/' || *c == '\\')
+            base = c + 1;
+    }
+
+    DbPerfil perfil_previo = db_perfil_actual();
+    db_aplicar_perfil(DB_PERFIL_MAX_RENDIMIENTO);
+
+    ext = strrchr(base, '.');
+    if (ext && (strncmp(base, "todo.", 5) == 0 || strncmp(base, "all.", 4) == 0))
+    {
+        // todo.<formato>: los cuatro archivos del formato indicado
+        for (size_t i = 0; i < sizeof(IMPORTACIONES) / sizeof(IMPORTACIONES[0]); i++)
+        {
+            if (strcmp(strrchr(IMPORTACIONES[i].archivo, '.'), ext) == 0)
+            {
+                IMPORTACIONES[i].accion();
+                ejecutadas++;
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < sizeof(IMPORTACIONES) / sizeof(IMPORTACIONES[0]); i++)
+        {
+            if (strcmp(IMPORTACIONES[i].archivo, base) == 0)
+            {
+                IMPORTACIONES[i].accion();
+                ejecutadas++;
+                break;
+            }
+        }
+    }
+
+    db_aplicar_perfil(perfil_previo);
+
+    if (ejecutadas == 0)
+    {
+        printf("Importacion desconocida: %s\nDisponibles:", archivo);
+        for (size_t i = 0; i < sizeof(IMPORTACIONES) / sizeof(IMPORTACIONES[0]); i++)
+            printf(" %s", IMPORTACIONES[i].archivo);
+        printf(" todo.<json|txt|csv|html>\n");
+        return 0;
+    }
+    return 1;
+}
+
 /**
  * @brief Menu principal para importar datos desde archivos según selección del usuario.
  *
  * Esta función muestra un menú principal para que el usuario seleccione el formato
  * de archivo desde el cual importar: JSON, TXT, CSV o HTML.
- * Cada opción lleva a un submenú específico para ese formato.
+ * Cada opción lleva a un submenú específico para ese formato. Mientras el menú
+ * está activo la conexión usa el perfil de máximo rendimiento.
  */
 void menu_importar()
 {
@@ -2182,5 +2266,13 @@ void menu_importar()
         {4, "Importar desde HTML", submenu_importar_html},
         {0, "Volver", NULL}
     };
+
+    // Las importaciones son cargas masivas: usar el perfil de maximo rendimiento
+    // mientras se esta en este menu y restaurar el configurado al salir
+    DbPerfil perfil_previo = db_perfil_actual();
+    db_aplicar_perfil(DB_PERFIL_MAX_RENDIMIENTO);
+
     ejecutar_menu("IMPORTAR DATOS", items, 5);
+
+    db_aplicar_perfil(perfil_previo);
 }
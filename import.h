@@ -152,3 +152,17 @@ void importar_estadisticas_html();
  * Proporciona acceso a todas las funciones de importación disponibles.
  */
 void menu_importar();
+
+/**
+ * @brief Ejecuta el importador correspondiente a un archivo, sin menu
+ *
+ * Punto de entrada del modo de linea de comandos (--import <archivo>). El
+ * archivo se identifica por su nombre ("partidos.json", "lesiones.csv"...)
+ * y se lee del directorio de importacion; "todo.<formato>" importa los
+ * cuatro archivos de ese formato. Usa el perfil de maximo rendimiento
+ * durante la carga.
+ *
+ * @param archivo Nombre del archivo a importar
+ * @return 1 si se reconocio el archivo, 0 en caso contrario
+ */
+int importar_por_nombre(const char *archivo);
@@ -10,24 +10,6 @@
 
 static int current_lesion_id;
 
-// Obtains the next available ID by reusing deleted IDs to maintain efficient ID management
-// and prevent unnecessary growth of the ID sequence, which improves database performance over time.
-static int obtener_siguiente_id_lesion()
-{
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "WITH RECURSIVE seq(id) AS (VALUES(1) UNION ALL SELECT id+1 FROM seq WHERE id < (SELECT COALESCE(MAX(id),0)+1 FROM lesion)) SELECT MIN(id) FROM seq WHERE id NOT IN (SELECT id FROM lesion)",
-                       -1, &stmt, NULL);
-
-    int id = 1; // Default si la tabla está vacía
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        id = sqlite3_column_int(stmt, 0);
-    }
-    sqlite3_finalize(stmt);
-    return id;
-}
-
 /**
  * @brief Verifica si hay lesiones registradas en la base de datos
  *
@@ -71,7 +53,7 @@ void crear_lesion()
         jugador = "Usuario Desconocido";
     }
 
-    int id = obtener_siguiente_id_lesion();
+    int id = db_siguiente_id("lesion");
 
     sqlite3_stmt *stmt;
     sqlite3_prepare_v2(db,
@@ -322,6 +304,47 @@ void eliminar_lesion()
     pause_console();
 }
 
+/**
+ * @brief Imprime una lesion encontrada con su fragmento resaltado
+ */
+static void imprimir_lesion_fts(sqlite3_stmt *stmt)
+{
+    printf("%d - |Tipo Lesion:%s |Fecha:%s\n    %s\n",
+           sqlite3_column_int(stmt, 0),
+           sqlite3_column_text(stmt, 1),
+           sqlite3_column_text(stmt, 2),
+           sqlite3_column_text(stmt, 3));
+}
+
+/**
+ * @brief Busca lesiones por palabras del tipo o la descripcion
+ *
+ * Usa el indice FTS5 lesion_fts y ordena por relevancia (bm25), mostrando
+ * las lesiones mas relevantes hasta el tamano de pagina configurado.
+ */
+void buscar_lesiones()
+{
+    char texto[256];
+    char consulta[768];
+
+    clear_screen();
+    print_header("BUSCAR LESIONES");
+
+    input_string("Palabras a buscar: ", texto, sizeof(texto));
+    if (texto_a_consulta_fts(texto, consulta, sizeof(consulta)) == 0)
+        printf("No se ingresaron palabras para buscar.\n");
+    else
+    {
+        // snippet con columna -1 elige la columna (tipo o descripcion) que mejor coincide
+        mostrar_busqueda_fts("lesion_fts",
+                             "SELECT l.id, l.tipo, l.fecha, snippet(lesion_fts, -1, '[', ']', '...', 12) "
+                             "FROM lesion_fts JOIN lesion l ON l.id = lesion_fts.rowid",
+                             consulta, imprimir_lesion_fts,
+                             "No se encontraron lesiones con esas palabras.", "las");
+    }
+    pause_console();
+}
+
 /**
  * @brief Muestra el menú principal de gestión de lesiones
  *
@@ -338,7 +361,8 @@ void menu_lesiones()
         {3, "Modificar", modificar_lesion},
         {4, "Eliminar", eliminar_lesion},
         {5, "Estadisticas", mostrar_estadisticas_lesiones},
+        {6, "Buscar", buscar_lesiones},
         {0, "Volver", NULL}
     };
-    ejecutar_menu("LESIONES", items, 6);
+    ejecutar_menu("LESIONES", items, 7);
 }
@@ -50,11 +50,19 @@ void eliminar_lesion();
  */
 void mostrar_estadisticas_lesiones();
 
+/**
+ * @brief Busca lesiones por palabras del tipo o la descripcion
+ *
+ * Consulta el indice de texto completo y muestra las lesiones ordenadas
+ * por relevancia, con el fragmento del texto donde aparecen las palabras.
+ */
+void buscar_lesiones();
+
 /**
  * @brief Muestra el menú principal de gestión de lesiones
  *
- * Presenta un menú interactivo con opciones para crear, listar, editar
- * y eliminar lesiones. Utiliza la función ejecutar_menu para manejar
+ * Presenta un menú interactivo con opciones para crear, listar, editar,
+ * eliminar y buscar lesiones. Utiliza la función ejecutar_menu para manejar
  * la navegación del menú y delega las operaciones a las funciones correspondientes.
  */
 void menu_lesiones();
@@ -10,7 +10,11 @@
 #include "db.h"
 #include "utils.h"
 #include "menu.h"
+#include "partido_store.h"
+#include "rachas.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 
 /**
@@ -22,80 +26,149 @@ typedef struct
     const char *nombre;
     const char *descripcion;
     int objetivo;
-    const char *tipo; // tipos disponibles: "goles", "asistencias", "partidos", "goles+asistencias", "victorias", "empates", "derrotas", "rendimiento_general", "estado_animo", "canchas_distintas", "hat_tricks", "poker_asistencias", "rendimiento_perfecto", "animo_perfecto", "goles_victorias", "asistencias_victorias", "rendimiento_victorias", "animo_victorias", "goles_derrotas", "asistencias_derrotas", "rendimiento_empates", "animo_empates", y muchos mas (ver LOGRO_QUERIES)
+    const char *tipo; // tipos disponibles: "goles", "asistencias", "partidos", "goles+asistencias", "victorias", "empates", "derrotas", "rendimiento_general", "estado_animo", "canchas_distintas", "hat_tricks", "poker_asistencias", "rendimiento_perfecto", "animo_perfecto", "goles_victorias", "asistencias_victorias", "rendimiento_victorias", "animo_victorias", "goles_derrotas", "asistencias_derrotas", "rendimiento_empates", "animo_empates", y muchos mas (ver LOGRO_TIPOS)
 } Logro;
 
 /**
- * @brief Estructura para mapear tipos de logros con sus consultas SQL
+ * @brief Progreso de una camiseta en cada tipo de logro
+ *
+ * Se calcula en una sola pasada sobre la copia en memoria de partido
+ * (ver calcular_progreso_camiseta) en lugar de una consulta por logro.
+ */
+typedef struct
+{
+    int goles;
+    int asistencias;
+    int partidos;
+    int goles_asistencias;
+    int victorias;
+    int empates;
+    int derrotas;
+    int rendimiento_general;
+    int estado_animo;
+    int canchas_distintas;
+    int hat_tricks;
+    int poker_asistencias;
+    int rendimiento_perfecto;
+    int animo_perfecto;
+    int goles_victorias;
+    int asistencias_victorias;
+    int rendimiento_victorias;
+    int animo_victorias;
+    int goles_derrotas;
+    int asistencias_derrotas;
+    int rendimiento_empates;
+    int animo_empates;
+    int goles_empates;
+    int asistencias_empates;
+    int rendimiento_derrotas;
+    int animo_derrotas;
+    int partidos_sin_goles;
+    int partidos_sin_asistencias;
+    int partidos_con_goles;
+    int partidos_con_asistencias;
+    int partidos_con_contribucion;
+    int hat_tricks_dobles;
+    int asistencias_dobles;
+    int rendimiento_alto;
+    int animo_alto;
+    int rendimiento_bajo;
+    int animo_bajo;
+    int goles_por_partido_promedio;
+    int asistencias_por_partido_promedio;
+    int rendimiento_promedio;
+    int animo_promedio;
+    int partidos_con_rendimiento_alto;
+    int partidos_con_animo_alto;
+    int partidos_con_rendimiento_perfecto_y_animo;
+    int victorias_consecutivas_max;
+    int derrotas_consecutivas_max;
+    int empates_consecutivos_max;
+    int goles_en_ultimo_partido;
+    int asistencias_en_ultimo_partido;
+    int rendimiento_en_ultimo_partido;
+    int animo_en_ultimo_partido;
+} ProgresoCamiseta;
+
+/**
+ * @brief Estructura para mapear tipos de logros con su campo de progreso
  */
 typedef struct
 {
     const char *tipo;
-    const char *sql;
-} LogroQuery;
+    size_t campo;
+} LogroTipo;
+
+#define TIPO(nombre, miembro) {nombre, offsetof(ProgresoCamiseta, miembro)}
 
 /**
- * @brief Array de consultas SQL predefinidas para cada tipo de logro
+ * @brief Tipos de logro y el campo de ProgresoCamiseta que los mide
+ *
+ * Los promedios se guardan multiplicados por 10 y redondeados.
+ * "goles_en_primer_tiempo" y "asistencias_en_segundo_tiempo" usan los
+ * totales porque los partidos no registran el minuto.
  */
-static const LogroQuery LOGRO_QUERIES[] =
+static const LogroTipo LOGRO_TIPOS[] =
 {
-    {"goles", "SELECT IFNULL(SUM(goles), 0) FROM partido WHERE camiseta_id = ?"},
-    {"asistencias", "SELECT IFNULL(SUM(asistencias), 0) FROM partido WHERE camiseta_id = ?"},
-    {"partidos", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ?"},
-    {"goles+asistencias", "SELECT IFNULL(SUM(goles + asistencias), 0) FROM partido WHERE camiseta_id = ?"},
-    {"victorias", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND resultado = 1"},
-    {"empates", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND resultado = 2"},
-    {"derrotas", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND resultado = 3"},
-    {"rendimiento_general", "SELECT IFNULL(SUM(rendimiento_general), 0) FROM partido WHERE camiseta_id = ?"},
-    {"estado_animo", "SELECT IFNULL(SUM(estado_animo), 0) FROM partido WHERE camiseta_id = ?"},
-    {"canchas_distintas", "SELECT COUNT(DISTINCT cancha_id) FROM partido WHERE camiseta_id = ?"},
-    {"hat_tricks", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND goles >= 3"},
-    {"poker_asistencias", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND asistencias >= 4"},
-    {"rendimiento_perfecto", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND rendimiento_general = 10"},
-    {"animo_perfecto", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND estado_animo = 10"},
-    {"goles_victorias", "SELECT IFNULL(SUM(goles), 0) FROM partido WHERE camiseta_id = ? AND resultado = 1"},
-    {"asistencias_victorias", "SELECT IFNULL(SUM(asistencias), 0) FROM partido WHERE camiseta_id = ? AND resultado = 1"},
-    {"rendimiento_victorias", "SELECT IFNULL(SUM(rendimiento_general), 0) FROM partido WHERE camiseta_id = ? AND resultado = 1"},
-    {"animo_victorias", "SELECT IFNULL(SUM(estado_animo), 0) FROM partido WHERE camiseta_id = ? AND resultado = 1"},
-    {"goles_derrotas", "SELECT IFNULL(SUM(goles), 0) FROM partido WHERE camiseta_id = ? AND resultado = 3"},
-    {"asistencias_derrotas", "SELECT IFNULL(SUM(asistencias), 0) FROM partido WHERE camiseta_id = ? AND resultado = 3"},
-    {"rendimiento_empates", "SELECT IFNULL(SUM(rendimiento_general), 0) FROM partido WHERE camiseta_id = ? AND resultado = 2"},
-    {"animo_empates", "SELECT IFNULL(SUM(estado_animo), 0) FROM partido WHERE camiseta_id = ? AND resultado = 2"},
+    TIPO("goles", goles),
+    TIPO("asistencias", asistencias),
+    TIPO("partidos", partidos),
+    TIPO("goles+asistencias", goles_asistencias),
+    TIPO("victorias", victorias),
+    TIPO("empates", empates),
+    TIPO("derrotas", derrotas),
+    TIPO("rendimiento_general", rendimiento_general),
+    TIPO("estado_animo", estado_animo),
+    TIPO("canchas_distintas", canchas_distintas),
+    TIPO("hat_tricks", hat_tricks),
+    TIPO("poker_asistencias", poker_asistencias),
+    TIPO("rendimiento_perfecto", rendimiento_perfecto),
+    TIPO("animo_perfecto", animo_perfecto),
+    TIPO("goles_victorias", goles_victorias),
+    TIPO("asistencias_victorias", asistencias_victorias),
+    TIPO("rendimiento_victorias", rendimiento_victorias),
+    TIPO("animo_victorias", animo_victorias),
+    TIPO("goles_derrotas", goles_derrotas),
+    TIPO("asistencias_derrotas", asistencias_derrotas),
+    TIPO("rendimiento_empates", rendimiento_empates),
+    TIPO("animo_empates", animo_empates),
     // Nuevos tipos de logros
-    {"goles_empates", "SELECT IFNULL(SUM(goles), 0) FROM partido WHERE camiseta_id = ? AND resultado = 2"},
-    {"asistencias_empates", "SELECT IFNULL(SUM(asistencias), 0) FROM partido WHERE camiseta_id = ? AND resultado = 2"},
-    {"rendimiento_derrotas", "SELECT IFNULL(SUM(rendimiento_general), 0) FROM partido WHERE camiseta_id = ? AND resultado = 3"},
-    {"animo_derrotas", "SELECT IFNULL(SUM(estado_animo), 0) FROM partido WHERE camiseta_id = ? AND resultado = 3"},
-    {"partidos_sin_goles", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND goles = 0"},
-    {"partidos_sin_asistencias", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND asistencias = 0"},
-    {"partidos_con_goles", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND goles > 0"},
-    {"partidos_con_asistencias", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND asistencias > 0"},
-    {"partidos_con_contribucion", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND (goles > 0 OR asistencias > 0)"},
-    {"hat_tricks_dobles", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND goles >= 4"},
-    {"asistencias_dobles", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND asistencias >= 5"},
-    {"rendimiento_alto", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND rendimiento_general >= 8"},
-    {"animo_alto", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND estado_animo >= 8"},
-    {"rendimiento_bajo", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND rendimiento_general <= 3"},
-    {"animo_bajo", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND estado_animo <= 3"},
-    {"goles_por_partido_promedio", "SELECT ROUND(IFNULL(AVG(goles), 0) * 10) FROM partido WHERE camiseta_id = ?"},
-    {"asistencias_por_partido_promedio", "SELECT ROUND(IFNULL(AVG(asistencias), 0) * 10) FROM partido WHERE camiseta_id = ?"},
-    {"rendimiento_promedio", "SELECT ROUND(IFNULL(AVG(rendimiento_general), 0) * 10) FROM partido WHERE camiseta_id = ?"},
-    {"animo_promedio", "SELECT ROUND(IFNULL(AVG(estado_animo), 0) * 10) FROM partido WHERE camiseta_id = ?"},
-    {"partidos_con_rendimiento_alto", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND rendimiento_general >= 9"},
-    {"partidos_con_animo_alto", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND estado_animo >= 9"},
-    {"partidos_con_rendimiento_perfecto_y_animo", "SELECT COUNT(*) FROM partido WHERE camiseta_id = ? AND rendimiento_general = 10 AND estado_animo = 10"},
-    {"goles_en_primer_tiempo", "SELECT IFNULL(SUM(goles), 0) FROM partido WHERE camiseta_id = ?"},
-    {"asistencias_en_segundo_tiempo", "SELECT IFNULL(SUM(asistencias), 0) FROM partido WHERE camiseta_id = ?"},
-    {"victorias_consecutivas_max", "SELECT COUNT(*) FROM (SELECT resultado, ROW_NUMBER() OVER (ORDER BY id) - ROW_NUMBER() OVER (PARTITION BY resultado ORDER BY id) as grp FROM partido WHERE camiseta_id = ?) WHERE resultado = 1 GROUP BY grp ORDER BY COUNT(*) DESC LIMIT 1"},
-    {"derrotas_consecutivas_max", "SELECT COUNT(*) FROM (SELECT resultado, ROW_NUMBER() OVER (ORDER BY id) - ROW_NUMBER() OVER (PARTITION BY resultado ORDER BY id) as grp FROM partido WHERE camiseta_id = ?) WHERE resultado = 3 GROUP BY grp ORDER BY COUNT(*) DESC LIMIT 1"},
-    {"empates_consecutivos_max", "SELECT COUNT(*) FROM (SELECT resultado, ROW_NUMBER() OVER (ORDER BY id) - ROW_NUMBER() OVER (PARTITION BY resultado ORDER BY id) as grp FROM partido WHERE camiseta_id = ?) WHERE resultado = 2 GROUP BY grp ORDER BY COUNT(*) DESC LIMIT 1"},
-    {"goles_en_ultimo_partido", "SELECT IFNULL(goles, 0) FROM partido WHERE camiseta_id = ? ORDER BY id DESC LIMIT 1"},
-    {"asistencias_en_ultimo_partido", "SELECT IFNULL(asistencias, 0) FROM partido WHERE camiseta_id = ? ORDER BY id DESC LIMIT 1"},
-    {"rendimiento_en_ultimo_partido", "SELECT IFNULL(rendimiento_general, 0) FROM partido WHERE camiseta_id = ? ORDER BY id DESC LIMIT 1"},
-    {"animo_en_ultimo_partido", "SELECT IFNULL(estado_animo, 0) FROM partido WHERE camiseta_id = ? ORDER BY id DESC LIMIT 1"}
+    TIPO("goles_empates", goles_empates),
+    TIPO("asistencias_empates", asistencias_empates),
+    TIPO("rendimiento_derrotas", rendimiento_derrotas),
+    TIPO("animo_derrotas", animo_derrotas),
+    TIPO("partidos_sin_goles", partidos_sin_goles),
+    TIPO("partidos_sin_asistencias", partidos_sin_asistencias),
+    TIPO("partidos_con_goles", partidos_con_goles),
+    TIPO("partidos_con_asistencias", partidos_con_asistencias),
+    TIPO("partidos_con_contribucion", partidos_con_contribucion),
+    TIPO("hat_tricks_dobles", hat_tricks_dobles),
+    TIPO("asistencias_dobles", asistencias_dobles),
+    TIPO("rendimiento_alto", rendimiento_alto),
+    TIPO("animo_alto", animo_alto),
+    TIPO("rendimiento_bajo", rendimiento_bajo),
+    TIPO("animo_bajo", animo_bajo),
+    TIPO("goles_por_partido_promedio", goles_por_partido_promedio),
+    TIPO("asistencias_por_partido_promedio", asistencias_por_partido_promedio),
+    TIPO("rendimiento_promedio", rendimiento_promedio),
+    TIPO("animo_promedio", animo_promedio),
+    TIPO("partidos_con_rendimiento_alto", partidos_con_rendimiento_alto),
+    TIPO("partidos_con_animo_alto", partidos_con_animo_alto),
+    TIPO("partidos_con_rendimiento_perfecto_y_animo", partidos_con_rendimiento_perfecto_y_animo),
+    TIPO("goles_en_primer_tiempo", goles),
+    TIPO("asistencias_en_segundo_tiempo", asistencias),
+    TIPO("victorias_consecutivas_max", victorias_consecutivas_max),
+    TIPO("derrotas_consecutivas_max", derrotas_consecutivas_max),
+    TIPO("empates_consecutivos_max", empates_consecutivos_max),
+    TIPO("goles_en_ultimo_partido", goles_en_ultimo_partido),
+    TIPO("asistencias_en_ultimo_partido", asistencias_en_ultimo_partido),
+    TIPO("rendimiento_en_ultimo_partido", rendimiento_en_ultimo_partido),
+    TIPO("animo_en_ultimo_partido", animo_en_ultimo_partido)
 };
 
-#define NUM_QUERIES (sizeof(LOGRO_QUERIES) / sizeof(LogroQuery))
+#undef TIPO
+
+#define NUM_TIPOS (sizeof(LOGRO_TIPOS) / sizeof(LogroTipo))
 
 /**
  * @brief Array de logros disponibles en el sistema
@@ -284,33 +357,152 @@ static const Logro LOGROS[] =
 #define NUM_LOGROS (sizeof(LOGROS) / sizeof(Logro))
 
 /**
- * @brief Obtiene el progreso actual de una camiseta para un logro específico (versión optimizada)
+ * @brief Calcula el progreso de una camiseta en todos los tipos de logro
+ *
+ * Una pasada sobre la copia en memoria de partido acumula todos los
+ * contadores; una segunda, solo sobre los partidos de la camiseta, resuelve
+ * las canchas distintas. Las rachas salen del módulo de rachas, en orden
+ * cronológico.
  *
  * @param camiseta_id ID de la camiseta
- * @param tipo Tipo de estadística
- * @return Valor actual de la estadística
+ * @param progreso Destino del progreso calculado
+ * @return 1 si exito, 0 si no se pudo cargar partido
  */
-static int obtener_progreso_logro(int camiseta_id, const char *tipo)
+static int calcular_progreso_camiseta(int camiseta_id, ProgresoCamiseta *progreso)
 {
-    // Buscar la consulta correspondiente en el array
-    for (size_t i = 0; i < NUM_QUERIES; i++)
+    const PartidoStore *store = partido_store_obtener();
+    long long suma_goles = 0, suma_asistencias = 0, suma_rendimiento = 0, suma_animo = 0;
+    int max_cancha = 0;
+    int ultimo = -1;
+
+    memset(progreso, 0, sizeof(*progreso));
+    if (!store)
+        return 0;
+
+    for (int i = 0; i < store->n; i++)
     {
-        if (strcmp(tipo, LOGRO_QUERIES[i].tipo) == 0)
+        if (store->camiseta_id[i] != camiseta_id)
+            continue;
+
+        int g = store->goles[i];
+        int a = store->asistencias[i];
+        int r = store->rendimiento[i];
+        int e = store->animo[i];
+
+        progreso->partidos++;
+        suma_goles += g;
+        suma_asistencias += a;
+        suma_rendimiento += r;
+        suma_animo += e;
+
+        switch (store->resultado[i])
         {
-            sqlite3_stmt *stmt;
-            int progreso = 0;
+        case 1:
+            progreso->victorias++;
+            progreso->goles_victorias += g;
+            progreso->asistencias_victorias += a;
+            progreso->rendimiento_victorias += r;
+            progreso->animo_victorias += e;
+            break;
+        case 2:
+            progreso->empates++;
+            progreso->goles_empates += g;
+            progreso->asistencias_empates += a;
+            progreso->rendimiento_empates += r;
+            progreso->animo_empates += e;
+            break;
+        case 3:
+            progreso->derrotas++;
+            progreso->goles_derrotas += g;
+            progreso->asistencias_derrotas += a;
+            progreso->rendimiento_derrotas += r;
+            progreso->animo_derrotas += e;
+            break;
+        }
+
+        progreso->hat_tricks += g >= 3;
+        progreso->hat_tricks_dobles += g >= 4;
+        progreso->poker_asistencias += a >= 4;
+        progreso->asistencias_dobles += a >= 5;
+        progreso->partidos_sin_goles += g == 0;
+        progreso->partidos_con_goles += g > 0;
+        progreso->partidos_sin_asistencias += a == 0;
+        progreso->partidos_con_asistencias += a > 0;
+        progreso->partidos_con_contribucion += g > 0 || a > 0;
+        progreso->rendimiento_perfecto += r == 10;
+        progreso->rendimiento_alto += r >= 8;
+        progreso->partidos_con_rendimiento_alto += r >= 9;
+        progreso->rendimiento_bajo += r <= 3;
+        progreso->animo_perfecto += e == 10;
+        progreso->animo_alto += e >= 8;
+        progreso->partidos_con_animo_alto += e >= 9;
+        progreso->animo_bajo += e <= 3;
+        progreso->partidos_con_rendimiento_perfecto_y_animo += r == 10 && e == 10;
+
+        if (store->cancha_id[i] > max_cancha)
+            max_cancha = store->cancha_id[i];
+        if (ultimo < 0 || store->id[i] > store->id[ultimo])
+            ultimo = i;
+    }
 
-            if (sqlite3_prepare_v2(db, LOGRO_QUERIES[i].sql, -1, &stmt, NULL) == SQLITE_OK)
+    if (progreso->partidos == 0)
+        return 1;
+
+    progreso->goles = (int)suma_goles;
+    progreso->asistencias = (int)suma_asistencias;
+    progreso->goles_asistencias = (int)(suma_goles + suma_asistencias);
+    progreso->rendimiento_general = (int)suma_rendimiento;
+    progreso->estado_animo = (int)suma_animo;
+    progreso->goles_por_partido_promedio = (int)redondear((double)suma_goles / progreso->partidos * 10, 0);
+    progreso->asistencias_por_partido_promedio = (int)redondear((double)suma_asistencias / progreso->partidos * 10, 0);
+    progreso->rendimiento_promedio = (int)redondear((double)suma_rendimiento / progreso->partidos * 10, 0);
+    progreso->animo_promedio = (int)redondear((double)suma_animo / progreso->partidos * 10, 0);
+
+    progreso->goles_en_ultimo_partido = store->goles[ultimo];
+    progreso->asistencias_en_ultimo_partido = store->asistencias[ultimo];
+    progreso->rendimiento_en_ultimo_partido = store->rendimiento[ultimo];
+    progreso->animo_en_ultimo_partido = store->animo[ultimo];
+
+    unsigned char *canchas = calloc((size_t)max_cancha + 1, 1);
+    if (canchas)
+    {
+        for (int i = 0; i < store->n; i++)
+        {
+            if (store->camiseta_id[i] != camiseta_id)
+                continue;
+            if (store->cancha_id[i] >= 0 && !canchas[store->cancha_id[i]])
             {
-                sqlite3_bind_int(stmt, 1, camiseta_id);
-                if (sqlite3_step(stmt) == SQLITE_ROW)
-                {
-                    progreso = sqlite3_column_int(stmt, 0);
-                }
-                sqlite3_finalize(stmt);
+                canchas[store->cancha_id[i]] = 1;
+                progreso->canchas_distintas++;
             }
+        }
+    }
+    free(canchas);
+
+    Racha racha;
+    if (rachas_mejor(RACHA_VICTORIAS, camiseta_id, &racha))
+        progreso->victorias_consecutivas_max = racha.largo;
+    if (rachas_mejor(RACHA_EMPATES, camiseta_id, &racha))
+        progreso->empates_consecutivos_max = racha.largo;
+    if (rachas_mejor(RACHA_DERROTAS, camiseta_id, &racha))
+        progreso->derrotas_consecutivas_max = racha.largo;
+    return 1;
+}
 
-            return progreso;
+/**
+ * @brief Obtiene el progreso de una camiseta para un logro específico
+ *
+ * @param progreso Progreso ya calculado de la camiseta
+ * @param tipo Tipo de estadística
+ * @return Valor actual de la estadística
+ */
+static int obtener_progreso_logro(const ProgresoCamiseta *progreso, const char *tipo)
+{
+    for (size_t i = 0; i < NUM_TIPOS; i++)
+    {
+        if (strcmp(tipo, LOGRO_TIPOS[i].tipo) == 0)
+        {
+            return *(const int *)((const char *)progreso + LOGRO_TIPOS[i].campo);
         }
     }
 
@@ -321,14 +513,14 @@ static int obtener_progreso_logro(int camiseta_id, const char *tipo)
 /**
  * @brief Determina el estado de un logro para una camiseta específica
  *
- * @param camiseta_id ID de la camiseta
+ * @param progreso_camiseta Progreso ya calculado de la camiseta
  * @param logro Puntero al logro
  * @param progreso Puntero donde se almacenará el progreso actual
  * @return 0: No iniciado, 1: En progreso, 2: Completado
  */
-static int obtener_estado_logro(int camiseta_id, const Logro *logro, int *progreso)
+static int obtener_estado_logro(const ProgresoCamiseta *progreso_camiseta, const Logro *logro, int *progreso)
 {
-    *progreso = obtener_progreso_logro(camiseta_id, logro->tipo);
+    *progreso = obtener_progreso_logro(progreso_camiseta, logro->tipo);
 
     if (*progreso >= logro->objetivo)
     {
@@ -354,8 +546,9 @@ static int obtener_estado_logro(int camiseta_id, const Logro *logro, int *progre
  */
 static void obtener_nombre_camiseta(int camiseta_id, char *nombre)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db, "SELECT nombre FROM camiseta WHERE id = ?", -1, &stmt, NULL);
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT nombre FROM camiseta WHERE id = ?");
+    if (!stmt)
+        return;
     sqlite3_bind_int(stmt, 1, camiseta_id);
     if (sqlite3_step(stmt) == SQLITE_ROW)
     {
@@ -365,7 +558,7 @@ static void obtener_nombre_camiseta(int camiseta_id, char *nombre)
     {
         printf("Camiseta no encontrada.\n");
     }
-    sqlite3_finalize(stmt);
+    db_release_cached(stmt);
 }
 
 /**
@@ -422,11 +615,13 @@ static void mostrar_logros_camiseta(int camiseta_id, int filtro)
     printf("========================================\n\n");
 
     int mostrados = 0;
+    ProgresoCamiseta progreso_camiseta;
+    calcular_progreso_camiseta(camiseta_id, &progreso_camiseta);
 
     for (size_t i = 0; i < NUM_LOGROS; i++)
     {
         int progreso;
-        int estado = obtener_estado_logro(camiseta_id, &LOGROS[i], &progreso);
+        int estado = obtener_estado_logro(&progreso_camiseta, &LOGROS[i], &progreso);
 
         // Aplicar filtro
         if (filtro == 1 && estado != 2)
@@ -531,6 +726,27 @@ void mostrar_logros_en_progreso()
     mostrar_logros_con_filtro("LOGROS EN PROGRESO", 2);
 }
 
+/**
+ * @brief Muestra los logros de una camiseta sin interaccion
+ *
+ * Version no interactiva usada por la linea de comandos: valida la camiseta
+ * recibida en lugar de pedirla al usuario.
+ *
+ * @param camiseta_id ID de la camiseta
+ * @param filtro Tipo de filtro (0=todos, 1=completados, 2=en progreso)
+ * @return 1 si la camiseta existe, 0 en caso contrario
+ */
+int mostrar_logros_de_camiseta(int camiseta_id, int filtro)
+{
+    if (!existe_id("camiseta", camiseta_id))
+    {
+        printf("La camiseta no existe.\n");
+        return 0;
+    }
+    mostrar_logros_camiseta(camiseta_id, filtro);
+    return 1;
+}
+
 /**
  * @brief Muestra el menú principal de logros y badges
  */
@@ -36,3 +36,14 @@ void mostrar_logros_completados();
  * Lista los logros que están parcialmente completados pero aún no terminados.
  */
 void mostrar_logros_en_progreso();
+
+/**
+ * @brief Muestra los logros de una camiseta concreta sin pedir datos
+ *
+ * Usada por el modo de linea de comandos (--logros <camiseta>).
+ *
+ * @param camiseta_id ID de la camiseta
+ * @param filtro 0: Todos, 1: Solo completados, 2: Solo en progreso
+ * @return 1 si la camiseta existe, 0 en caso contrario
+ */
+int mostrar_logros_de_camiseta(int camiseta_id, int filtro);
@@ -21,16 +21,58 @@
 #include "ascii_art.h"
 #include "settings.h"
 #include "financiamiento.h"
+#include "migraciones.h"
+#include "perfil_sql.h"
+#include "cli.h"
+#include "respaldo.h"
 
-int main()
+int main(int argc, char *argv[])
 {
+    int verificar_indices = 0;
+    int perfilar = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--verificar-indices") == 0)
+            verificar_indices = 1;
+        else if (strcmp(argv[i], "--profile") == 0)
+            perfilar = 1;
+        else if (strcmp(argv[i], "--db") == 0 && i + 1 < argc)
+            db_set_ruta(argv[++i]);
+        else if (strcmp(argv[i], "--memoria") == 0)
+            db_set_modo_memoria(1);
+    }
+
     if (!db_init())
         return 1;
 
+    // Perfilado SQL: el informe se escribe en el directorio de datos al cerrar
+    if (perfilar)
+        perfil_sql_iniciar();
+
+    // Verificacion no interactiva de planes de consulta (uso en scripts)
+    if (verificar_indices)
+    {
+        int ok = migraciones_verificar_planes(1);
+        db_close();
+        return ok ? 0 : 2;
+    }
+
     setlocale(LC_ALL, "");
     // Inicializar configuración
     settings_init();
 
+    // Subcomandos no interactivos (--export, --import, --report, --logros, --generar, --respaldo...)
+    if (cli_hay_comandos(argc, argv))
+    {
+        int codigo = cli_ejecutar(argc, argv);
+        db_close();
+        return codigo;
+    }
+
+    // Instantanea diaria de la base antes de empezar a modificarla
+    respaldo_automatico();
+
     // Verificar si existe nombre de usuario
     char *nombre_usuario = get_user_name();
     if (!nombre_usuario)
@@ -1,5 +1,6 @@
 #include "menu.h"
 #include "utils.h"
+#include "db.h"
 #include <stdio.h>
 
 // Use an infinite loop to maintain menu interaction until the user explicitly chooses to exit,
@@ -10,6 +11,9 @@ void ejecutar_menu(const char *titulo, MenuItem *items, int cantidad)
 
     while (1)
     {
+        // In in-memory mode, flush pending changes to disk once the save interval has elapsed.
+        db_guardado_periodico();
+
         // Clear screen each iteration to provide a clean, focused interface and prevent menu clutter from previous interactions.
         clear_screen();
 
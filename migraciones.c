@@ -0,0 +1,1088 @@
+/**
+ * @file migraciones.c
+ * @brief Migraciones de esquema versionadas con PRAGMA user_version
+ *
+ * Sustituye la recreacion completa del esquema y los ALTER TABLE que
+ * fallaban en cada arranque por una lista ordenada de pasos que se
+ * aplican una unica vez cada uno.
+ */
+
+#include "migraciones.h"
+#include "db.h"
+#include "utils.h"
+#include "resumenes.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief Paso de migracion de esquema
+ *
+ * Un paso puede expresarse como script SQL, como funcion C (para cambios
+ * que dependen del estado actual de la base) o ambos; el SQL se ejecuta
+ * primero.
+ */
+typedef struct
+{
+    int version;                 /**< Version alcanzada al aplicar el paso */
+    const char *descripcion;     /**< Texto descriptivo para mensajes */
+    const char *sql;             /**< Script SQL del paso (puede ser NULL) */
+    int (*aplicar)();            /**< Funcion adicional del paso (puede ser NULL) */
+} Migracion;
+
+/** Tiempo consumido por la ultima ejecucion de migraciones_aplicar() */
+static double tiempo_migraciones_ms = 0.0;
+
+/**
+ * @brief Esquema relacional original de la aplicacion
+ *
+ * Se mantiene con CREATE TABLE IF NOT EXISTS porque las bases anteriores
+ * al versionado (user_version 0) ya pueden contener parte de las tablas.
+ */
+static const char SQL_ESQUEMA_BASE[] =
+    "CREATE TABLE IF NOT EXISTS camiseta ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " nombre TEXT NOT NULL,"
+    " sorteada INTEGER DEFAULT 0);"
+
+    "CREATE TABLE IF NOT EXISTS cancha ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " nombre TEXT NOT NULL);"
+
+    "CREATE TABLE IF NOT EXISTS partido ("
+    " id INTEGER PRIMARY KEY,"
+    " cancha_id INTEGER NOT NULL,"
+    " fecha_hora TEXT NOT NULL,"
+    " goles INTEGER NOT NULL,"
+    " asistencias INTEGER NOT NULL,"
+    " camiseta_id INTEGER NOT NULL,"
+    " FOREIGN KEY(cancha_id) REFERENCES cancha(id),"
+    " FOREIGN KEY(camiseta_id) REFERENCES camiseta(id));"
+
+    "CREATE TABLE IF NOT EXISTS lesion ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " jugador TEXT NOT NULL,"
+    " tipo TEXT NOT NULL,"
+    " descripcion TEXT NOT NULL,"
+    " fecha TEXT NOT NULL,"
+    " camiseta_id INTEGER NOT NULL,"
+    " FOREIGN KEY(camiseta_id) REFERENCES camiseta(id));"
+
+    "CREATE TABLE IF NOT EXISTS usuario ("
+    " id INTEGER PRIMARY KEY,"
+    " nombre TEXT NOT NULL);"
+
+    "CREATE TABLE IF NOT EXISTS equipo ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " nombre TEXT NOT NULL,"
+    " tipo INTEGER NOT NULL,"
+    " tipo_futbol INTEGER NOT NULL,"
+    " num_jugadores INTEGER NOT NULL,"
+    " partido_id INTEGER DEFAULT -1);"
+
+    "CREATE TABLE IF NOT EXISTS jugador ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " equipo_id INTEGER NOT NULL,"
+    " nombre TEXT NOT NULL,"
+    " numero INTEGER NOT NULL,"
+    " posicion INTEGER NOT NULL,"
+    " es_capitan INTEGER NOT NULL,"
+    " FOREIGN KEY(equipo_id) REFERENCES equipo(id));"
+
+    "CREATE TABLE IF NOT EXISTS torneo ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " nombre TEXT NOT NULL,"
+    " tiene_equipo_fijo INTEGER NOT NULL,"
+    " equipo_fijo_id INTEGER DEFAULT -1,"
+    " cantidad_equipos INTEGER NOT NULL,"
+    " tipo_torneo INTEGER NOT NULL,"
+    " formato_torneo INTEGER NOT NULL,"
+    " fase_actual TEXT DEFAULT 'Fase de Grupos');"
+
+    "CREATE TABLE IF NOT EXISTS equipo_torneo ("
+    " torneo_id INTEGER NOT NULL,"
+    " equipo_id INTEGER NOT NULL,"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
+    " FOREIGN KEY(equipo_id) REFERENCES equipo(id),"
+    " PRIMARY KEY(torneo_id, equipo_id));"
+
+    "CREATE TABLE IF NOT EXISTS partido_torneo ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " torneo_id INTEGER NOT NULL,"
+    " equipo1_id INTEGER NOT NULL,"
+    " equipo2_id INTEGER NOT NULL,"
+    " fecha TEXT,"
+    " goles_equipo1 INTEGER DEFAULT 0,"
+    " goles_equipo2 INTEGER DEFAULT 0,"
+    " estado TEXT,"
+    " fase TEXT DEFAULT 'Fase de Grupos',"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
+    " FOREIGN KEY(equipo1_id) REFERENCES equipo(id),"
+    " FOREIGN KEY(equipo2_id) REFERENCES equipo(id));"
+
+    "CREATE TABLE IF NOT EXISTS equipo_torneo_estadisticas ("
+    " torneo_id INTEGER NOT NULL,"
+    " equipo_id INTEGER NOT NULL,"
+    " partidos_jugados INTEGER DEFAULT 0,"
+    " partidos_ganados INTEGER DEFAULT 0,"
+    " partidos_empatados INTEGER DEFAULT 0,"
+    " partidos_perdidos INTEGER DEFAULT 0,"
+    " goles_favor INTEGER DEFAULT 0,"
+    " goles_contra INTEGER DEFAULT 0,"
+    " puntos INTEGER DEFAULT 0,"
+    " estado TEXT DEFAULT 'Activo',"
+    " PRIMARY KEY(torneo_id, equipo_id),"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
+    " FOREIGN KEY(equipo_id) REFERENCES equipo(id));"
+
+    "CREATE TABLE IF NOT EXISTS jugador_estadisticas ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " jugador_id INTEGER NOT NULL,"
+    " torneo_id INTEGER NOT NULL,"
+    " equipo_id INTEGER NOT NULL,"
+    " goles INTEGER DEFAULT 0,"
+    " asistencias INTEGER DEFAULT 0,"
+    " tarjetas_amarillas INTEGER DEFAULT 0,"
+    " tarjetas_rojas INTEGER DEFAULT 0,"
+    " minutos_jugados INTEGER DEFAULT 0,"
+    " FOREIGN KEY(jugador_id) REFERENCES jugador(id),"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
+    " FOREIGN KEY(equipo_id) REFERENCES equipo(id));"
+
+    "CREATE TABLE IF NOT EXISTS equipo_historial ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " equipo_id INTEGER NOT NULL,"
+    " torneo_id INTEGER NOT NULL,"
+    " posicion_final INTEGER,"
+    " partidos_jugados INTEGER DEFAULT 0,"
+    " partidos_ganados INTEGER DEFAULT 0,"
+    " partidos_empatados INTEGER DEFAULT 0,"
+    " partidos_perdidos INTEGER DEFAULT 0,"
+    " goles_favor INTEGER DEFAULT 0,"
+    " goles_contra INTEGER DEFAULT 0,"
+    " mejor_goleador TEXT,"
+    " goles_mejor_goleador INTEGER DEFAULT 0,"
+    " fecha_inicio TEXT,"
+    " fecha_fin TEXT,"
+    " FOREIGN KEY(equipo_id) REFERENCES equipo(id),"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id));"
+
+    "CREATE TABLE IF NOT EXISTS torneo_fases ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " torneo_id INTEGER NOT NULL,"
+    " nombre_fase TEXT NOT NULL,"
+    " descripcion TEXT,"
+    " orden INTEGER NOT NULL,"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id));"
+
+    "CREATE TABLE IF NOT EXISTS equipo_fase ("
+    " torneo_id INTEGER NOT NULL,"
+    " equipo_id INTEGER NOT NULL,"
+    " fase_id INTEGER NOT NULL,"
+    " grupo TEXT,"
+    " posicion_en_grupo INTEGER DEFAULT 0,"
+    " clasificado INTEGER DEFAULT 0,"
+    " eliminado INTEGER DEFAULT 0,"
+    " PRIMARY KEY(torneo_id, equipo_id, fase_id),"
+    " FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
+    " FOREIGN KEY(equipo_id) REFERENCES equipo(id),"
+    " FOREIGN KEY(fase_id) REFERENCES torneo_fases(id));"
+
+    "CREATE TABLE IF NOT EXISTS settings ("
+    " id INTEGER PRIMARY KEY,"
+    " theme INTEGER DEFAULT 0,"
+    " language INTEGER DEFAULT 0);"
+
+    "CREATE TABLE IF NOT EXISTS financiamiento ("
+    " id INTEGER PRIMARY KEY AUTOINCREMENT,"
+    " fecha TEXT NOT NULL,"
+    " tipo INTEGER NOT NULL,"
+    " categoria INTEGER NOT NULL,"
+    " descripcion TEXT NOT NULL,"
+    " monto REAL NOT NULL,"
+    " item_especifico TEXT);";
+
+/**
+ * @brief Columna anadida al esquema despues de su creacion original
+ */
+typedef struct
+{
+    const char *tabla;
+    const char *columna;
+    const char *definicion;
+} ColumnaEvolucion;
+
+/**
+ * @brief Comprueba si una tabla ya contiene una columna
+ *
+ * @param tabla Nombre de la tabla
+ * @param columna Nombre de la columna buscada
+ * @return 1 si existe, 0 si no existe
+ */
+static int columna_existe(const char *tabla, const char *columna)
+{
+    sqlite3_stmt *stmt;
+    char sql[128];
+    int existe = 0;
+
+    snprintf(sql, sizeof(sql), "PRAGMA table_info(%s);", tabla);
+    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+        return 0;
+
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        const char *nombre = (const char*)sqlite3_column_text(stmt, 1);
+        if (nombre && strcmp(nombre, columna) == 0)
+        {
+            existe = 1;
+            break;
+        }
+    }
+    sqlite3_finalize(stmt);
+    return existe;
+}
+
+/**
+ * @brief Agrega las columnas incorporadas tras la version original del esquema
+ *
+ * Solo emite ALTER TABLE para las columnas que realmente faltan, de modo
+ * que cualquier error es un error real y aborta la migracion.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int migrar_columnas_evolucion()
+{
+    static const ColumnaEvolucion columnas[] =
+    {
+        {"camiseta", "sorteada", "INTEGER DEFAULT 0"},
+        {"partido", "resultado", "INTEGER DEFAULT 0"},
+        {"partido", "clima", "INTEGER DEFAULT 0"},
+        {"partido", "dia", "INTEGER DEFAULT 0"},
+        {"partido", "rendimiento_general", "INTEGER DEFAULT 0"},
+        {"partido", "cansancio", "INTEGER DEFAULT 0"},
+        {"partido", "estado_animo", "INTEGER DEFAULT 0"},
+        {"partido", "comentario_personal", "TEXT DEFAULT ''"},
+        {"lesion", "partido_id", "INTEGER DEFAULT NULL"},
+        {NULL, NULL, NULL}
+    };
+
+    for (int i = 0; columnas[i].tabla != NULL; i++)
+    {
+        if (columna_existe(columnas[i].tabla, columnas[i].columna))
+            continue;
+
+        char sql[256];
+        snprintf(sql, sizeof(sql), "ALTER TABLE %s ADD COLUMN %s %s;",
+                 columnas[i].tabla, columnas[i].columna, columnas[i].definicion);
+        if (sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK)
+        {
+            printf("Error agregando columna %s.%s: %s\n",
+                   columnas[i].tabla, columnas[i].columna, sqlite3_errmsg(db));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Indice secundario gestionado por el programa
+ */
+typedef struct
+{
+    const char *nombre;
+    const char *tabla;
+    const char *columnas;
+} IndiceGestionado;
+
+/**
+ * @brief Conjunto de indices sobre las columnas de busqueda frecuentes
+ *
+ * Cubre los filtros y uniones de las rutas calientes: consultas de logros
+ * por camiseta, busquedas por cancha, lesiones por camiseta, partidos y
+ * jugadores de torneos y la clave de estadisticas de jugador.
+ */
+static const IndiceGestionado INDICES[] =
+{
+    {"idx_partido_camiseta", "partido", "camiseta_id"},
+    {"idx_partido_cancha", "partido", "cancha_id"},
+    {"idx_lesion_camiseta", "lesion", "camiseta_id"},
+    {"idx_partido_torneo_torneo", "partido_torneo", "torneo_id"},
+    {"idx_jugador_equipo", "jugador", "equipo_id"},
+    {"idx_jugador_estadisticas_clave", "jugador_estadisticas", "jugador_id, torneo_id, equipo_id"},
+    {NULL, NULL, NULL}
+};
+
+/**
+ * @brief Crea los indices gestionados que aun no existan
+ *
+ * Es idempotente para que una migracion posterior pueda volver a invocarla
+ * tras ampliar la lista de indices.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int crear_indices_gestionados()
+{
+    for (int i = 0; INDICES[i].nombre != NULL; i++)
+    {
+        char sql[256];
+        snprintf(sql, sizeof(sql), "CREATE INDEX IF NOT EXISTS %s ON %s(%s);",
+                 INDICES[i].nombre, INDICES[i].tabla, INDICES[i].columnas);
+        if (sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK)
+        {
+            printf("Error creando indice %s: %s\n", INDICES[i].nombre, sqlite3_errmsg(db));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Texto de fecha_hora pasado a "yyyy-mm-dd[ hh:mm]" en SQL puro
+ *
+ * Admite exactamente "dd/mm/yyyy[ hh:mm]" y "yyyy-mm-dd[ hh:mm]" con
+ * ceros a la izquierda, los mismos formatos que fecha_a_epoch(); cualquier
+ * otro texto da NULL.
+ */
+#define SQL_FECHA_ISO(texto) \
+    "CASE WHEN " texto " GLOB '[0-9][0-9]/[0-9][0-9]/[0-9][0-9][0-9][0-9]' " \
+    "OR " texto " GLOB '[0-9][0-9]/[0-9][0-9]/[0-9][0-9][0-9][0-9] [0-9][0-9]:[0-9][0-9]' " \
+    "THEN substr(" texto ", 7, 4) || '-' || substr(" texto ", 4, 2) || '-' || substr(" texto ", 1, 2) || substr(" texto ", 11) " \
+    "WHEN " texto " GLOB '[0-9][0-9][0-9][0-9]-[0-9][0-9]-[0-9][0-9]' " \
+    "OR " texto " GLOB '[0-9][0-9][0-9][0-9]-[0-9][0-9]-[0-9][0-9] [0-9][0-9]:[0-9][0-9]' THEN " texto " END"
+
+/**
+ * @brief Equivalente en SQL puro de fecha_epoch(texto)
+ *
+ * Los segundos obtenidos se vuelven a formatear y se comparan con la
+ * fecha original, asi "31/02/2024" o "24:00", que strftime() convierte
+ * en otro dia, dan NULL igual que en fecha_a_epoch(). Ambas rechazan los
+ * anios anteriores al 1000, donde strftime() de algunas versiones de
+ * SQLite se equivoca (0300-02-29 vuelve como si existiera). Los triggers lo
+ * usan en lugar de la funcion registrada por db.c para que cualquier
+ * cliente de SQLite pueda escribir en partido.
+ */
+#define SQL_FECHA_TS(texto) \
+    "(SELECT CASE WHEN iso >= '1000' AND " \
+    "strftime(CASE WHEN length(iso) > 10 THEN '%Y-%m-%d %H:%M' ELSE '%Y-%m-%d' END, ts, 'unixepoch') = iso " \
+    "THEN ts END FROM (SELECT iso, CAST(strftime('%s', iso) AS INTEGER) AS ts " \
+    "FROM (SELECT " SQL_FECHA_ISO(texto) " AS iso)))"
+
+/**
+ * @brief Marca temporal ordenable de partido
+ *
+ * fecha_ts guarda los segundos desde 1970 de fecha_hora y se mantiene con
+ * triggers, de modo que inserciones, modificaciones e importaciones quedan
+ * cubiertas. Las filas existentes se rellenan con la funcion fecha_epoch()
+ * registrada por db.c, despues de llevar a "dd/mm/yyyy hh:mm" las fechas
+ * que las versiones anteriores guardaban tal cual se ingresaban
+ * ("5/9/2026 18:30", "2026-09-06").
+ */
+static const char SQL_PARTIDO_FECHA_TS[] =
+    "ALTER TABLE partido ADD COLUMN fecha_ts INTEGER;"
+    "UPDATE partido SET fecha_hora = fecha_normalizada(fecha_hora) WHERE fecha_normalizada(fecha_hora) <> fecha_hora;"
+    "UPDATE partido SET fecha_ts = fecha_epoch(fecha_hora);"
+    "CREATE INDEX IF NOT EXISTS idx_partido_fecha_ts ON partido(fecha_ts);"
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_fecha_ts_ins AFTER INSERT ON partido "
+    "BEGIN UPDATE partido SET fecha_ts = " SQL_FECHA_TS("NEW.fecha_hora") " WHERE id = NEW.id; END;"
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_fecha_ts_upd AFTER UPDATE OF fecha_hora ON partido "
+    "BEGIN UPDATE partido SET fecha_ts = " SQL_FECHA_TS("NEW.fecha_hora") " WHERE id = NEW.id; END;";
+
+/**
+ * @brief Indices para el listado paginado de partidos
+ *
+ * El listado avanza por (fecha_ts, id); con camiseta o cancha como prefijo
+ * cada pagina filtrada es un rango del indice en lugar de ordenar todas las
+ * coincidencias. Los indices de una sola columna quedan cubiertos por el
+ * prefijo y se eliminan. Incluye el tamano de pagina en settings.
+ */
+static const char SQL_PAGINACION_PARTIDOS[] =
+    "CREATE INDEX IF NOT EXISTS idx_partido_camiseta_fecha ON partido(camiseta_id, fecha_ts);"
+    "CREATE INDEX IF NOT EXISTS idx_partido_cancha_fecha ON partido(cancha_id, fecha_ts);"
+    "DROP INDEX IF EXISTS idx_partido_camiseta;"
+    "DROP INDEX IF EXISTS idx_partido_cancha;"
+    "ALTER TABLE settings ADD COLUMN tamano_pagina INTEGER DEFAULT 20;";
+
+/**
+ * @brief Indices de texto completo sobre comentarios de partidos y lesiones
+ *
+ * Tablas FTS5 de contenido externo: guardan solo el indice invertido y leen
+ * el texto de partido y lesion. Los triggers replican cada alta, baja y
+ * cambio de las columnas indexadas; 'rebuild' indexa las filas existentes.
+ * remove_diacritics hace que "lesion" encuentre "lesión".
+ */
+static const char SQL_BUSQUEDA_TEXTO[] =
+    "CREATE VIRTUAL TABLE IF NOT EXISTS partido_fts USING fts5("
+    " comentario_personal, content='partido', content_rowid='id',"
+    " tokenize='unicode61 remove_diacritics 2');"
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_fts_ins AFTER INSERT ON partido "
+    "BEGIN INSERT INTO partido_fts(rowid, comentario_personal) VALUES(NEW.id, NEW.comentario_personal); END;"
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_fts_del AFTER DELETE ON partido "
+    "BEGIN INSERT INTO partido_fts(partido_fts, rowid, comentario_personal) VALUES('delete', OLD.id, OLD.comentario_personal); END;"
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_fts_upd AFTER UPDATE OF id, comentario_personal ON partido "
+    "BEGIN INSERT INTO partido_fts(partido_fts, rowid, comentario_personal) VALUES('delete', OLD.id, OLD.comentario_personal);"
+    " INSERT INTO partido_fts(rowid, comentario_personal) VALUES(NEW.id, NEW.comentario_personal); END;"
+    "INSERT INTO partido_fts(partido_fts) VALUES('rebuild');"
+    "CREATE VIRTUAL TABLE IF NOT EXISTS lesion_fts USING fts5("
+    " tipo, descripcion, content='lesion', content_rowid='id',"
+    " tokenize='unicode61 remove_diacritics 2');"
+    "CREATE TRIGGER IF NOT EXISTS trg_lesion_fts_ins AFTER INSERT ON lesion "
+    "BEGIN INSERT INTO lesion_fts(rowid, tipo, descripcion) VALUES(NEW.id, NEW.tipo, NEW.descripcion); END;"
+    "CREATE TRIGGER IF NOT EXISTS trg_lesion_fts_del AFTER DELETE ON lesion "
+    "BEGIN INSERT INTO lesion_fts(lesion_fts, rowid, tipo, descripcion) VALUES('delete', OLD.id, OLD.tipo, OLD.descripcion); END;"
+    "CREATE TRIGGER IF NOT EXISTS trg_lesion_fts_upd AFTER UPDATE OF id, tipo, descripcion ON lesion "
+    "BEGIN INSERT INTO lesion_fts(lesion_fts, rowid, tipo, descripcion) VALUES('delete', OLD.id, OLD.tipo, OLD.descripcion);"
+    " INSERT INTO lesion_fts(rowid, tipo, descripcion) VALUES(NEW.id, NEW.tipo, NEW.descripcion); END;"
+    "INSERT INTO lesion_fts(lesion_fts) VALUES('rebuild');";
+
+/**
+ * @brief Quita los triggers de texto completo
+ *
+ * Sin FTS5 cada escritura en partido o lesion que dispare uno de ellos
+ * falla con "no such module". Las tablas partido_fts y lesion_fts quedan:
+ * no se pueden borrar sin el modulo y no molestan mientras nadie las lea.
+ */
+static const char SQL_QUITAR_BUSQUEDA_TEXTO[] =
+    "DROP TRIGGER IF EXISTS trg_partido_fts_ins;"
+    "DROP TRIGGER IF EXISTS trg_partido_fts_del;"
+    "DROP TRIGGER IF EXISTS trg_partido_fts_upd;"
+    "DROP TRIGGER IF EXISTS trg_lesion_fts_ins;"
+    "DROP TRIGGER IF EXISTS trg_lesion_fts_del;"
+    "DROP TRIGGER IF EXISTS trg_lesion_fts_upd;";
+
+/**
+ * @brief Indica si la busqueda de texto coincide con el SQLite en uso
+ *
+ * Con FTS5 deben existir las dos tablas y los seis triggers; sin FTS5 no
+ * debe quedar ningun trigger de texto completo.
+ *
+ * @return 1 si no hay nada que hacer, 0 si hay que crear o quitar objetos
+ */
+static int busqueda_texto_al_dia()
+{
+    sqlite3_stmt *stmt;
+    int tablas = 0, triggers = 0;
+
+    if (sqlite3_prepare_v2(db,
+                           "SELECT COALESCE(SUM(type = 'table'), 0), COALESCE(SUM(type = 'trigger'), 0) FROM sqlite_master "
+                           "WHERE name IN ('partido_fts', 'lesion_fts', 'trg_partido_fts_ins', 'trg_partido_fts_del', "
+                           "'trg_partido_fts_upd', 'trg_lesion_fts_ins', 'trg_lesion_fts_del', 'trg_lesion_fts_upd')",
+                           -1, &stmt, NULL) != SQLITE_OK)
+        return 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        tablas = sqlite3_column_int(stmt, 0);
+        triggers = sqlite3_column_int(stmt, 1);
+    }
+    sqlite3_finalize(stmt);
+
+    if (sqlite3_compileoption_used("ENABLE_FTS5"))
+        return tablas == 2 && triggers == 6;
+    return triggers == 0;
+}
+
+/**
+ * @brief Crea la busqueda de texto completo si SQLite incluye FTS5
+ *
+ * Sin el modulo FTS5 no crea nada y quita los triggers que hubiera dejado
+ * un programa compilado con FTS5, para que las escrituras en partido y
+ * lesion sigan funcionando; la busqueda de texto queda deshabilitada.
+ * migraciones_aplicar() repite la comprobacion en cada apertura, asi una
+ * base migrada sin FTS5 recibe los indices (reconstruidos desde las
+ * tablas) la primera vez que la abre un programa con FTS5.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int crear_busqueda_texto()
+{
+    if (!sqlite3_compileoption_used("ENABLE_FTS5"))
+    {
+        printf("Aviso: SQLite compilado sin FTS5, la busqueda de texto no estara disponible.\n");
+        if (sqlite3_exec(db, SQL_QUITAR_BUSQUEDA_TEXTO, 0, 0, 0) != SQLITE_OK)
+        {
+            printf("Error quitando triggers de texto: %s\n", sqlite3_errmsg(db));
+            return 0;
+        }
+        return 1;
+    }
+    if (sqlite3_exec(db, SQL_BUSQUEDA_TEXTO, 0, 0, 0) != SQLITE_OK)
+    {
+        printf("Error creando indices de texto: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Ajusta la busqueda de texto de una base ya migrada
+ *
+ * La base pudo migrarse con un SQLite distinto del que la abre ahora (con
+ * o sin FTS5); solo escribe si busqueda_texto_al_dia() indica diferencias.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int revisar_busqueda_texto()
+{
+    char *err = NULL;
+
+    if (busqueda_texto_al_dia())
+        return 1;
+
+    if (sqlite3_exec(db, "BEGIN IMMEDIATE;", 0, 0, &err) != SQLITE_OK)
+    {
+        printf("Error revisando busqueda de texto: %s\n", err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return 0;
+    }
+    if (!crear_busqueda_texto() || sqlite3_exec(db, "COMMIT;", 0, 0, 0) != SQLITE_OK)
+    {
+        sqlite3_exec(db, "ROLLBACK;", 0, 0, 0);
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Crea la lista persistida de IDs libres y sus triggers
+ *
+ * Por cada tabla de entidad gestionada, un trigger AFTER DELETE anota el ID
+ * borrado y un trigger AFTER INSERT lo retira al reutilizarse (o si una
+ * importacion inserta ese ID explicitamente). Los huecos ya existentes se
+ * siembran una sola vez aqui.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int crear_lista_ids_libres()
+{
+    char sql[1024];
+
+    if (sqlite3_exec(db,
+                     "CREATE TABLE IF NOT EXISTS id_libre ("
+                     " tabla TEXT NOT NULL,"
+                     " id INTEGER NOT NULL,"
+                     " PRIMARY KEY(tabla, id)) WITHOUT ROWID;"
+                     "ALTER TABLE settings ADD COLUMN reutilizar_ids INTEGER DEFAULT 1;",
+                     0, 0, 0) != SQLITE_OK)
+    {
+        printf("Error creando lista de IDs libres: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+
+    for (int i = 0; db_tabla_id_gestionado(i) != NULL; i++)
+    {
+        const char *t = db_tabla_id_gestionado(i);
+
+        snprintf(sql, sizeof(sql),
+                 "CREATE TRIGGER IF NOT EXISTS trg_%s_id_libre_del AFTER DELETE ON %s "
+                 "BEGIN INSERT OR IGNORE INTO id_libre(tabla, id) VALUES('%s', OLD.id); END;"
+                 "CREATE TRIGGER IF NOT EXISTS trg_%s_id_libre_ins AFTER INSERT ON %s "
+                 "BEGIN DELETE FROM id_libre WHERE tabla = '%s' AND id = NEW.id; END;"
+                 "WITH RECURSIVE seq(id) AS (VALUES(1) UNION ALL SELECT id + 1 FROM seq "
+                 "WHERE id < (SELECT COALESCE(MAX(id), 0) FROM %s)) "
+                 "INSERT OR IGNORE INTO id_libre(tabla, id) "
+                 "SELECT '%s', id FROM seq WHERE id NOT IN (SELECT id FROM %s);",
+                 t, t, t, t, t, t, t, t, t);
+
+        if (sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK)
+        {
+            printf("Error preparando IDs libres de %s: %s\n", t, sqlite3_errmsg(db));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Condicion WHEN: el UPDATE es el de trg_partido_fecha_ts_ins
+ *
+ * Ese UPDATE solo pasa fecha_ts de NULL al valor calculado desde
+ * fecha_hora (si la fecha no es valida no cambia nada) y llega justo
+ * despues de la 'I' del alta, que sigue siendo la ultima entrada del
+ * registro. Quien lea la 'I' lee la fila completa, asi que no hace falta
+ * una 'U' mas. Un UPDATE de otro origen no cumple las tres condiciones a
+ * la vez y se anota.
+ */
+#define PARTIDO_SOLO_RELLENA_FECHA_TS \
+    "OLD.fecha_ts IS NULL AND NEW.fecha_ts IS " SQL_FECHA_TS("NEW.fecha_hora") " AND OLD.id = NEW.id AND " \
+    "OLD.cancha_id IS NEW.cancha_id AND OLD.fecha_hora IS NEW.fecha_hora AND " \
+    "OLD.goles IS NEW.goles AND OLD.asistencias IS NEW.asistencias AND " \
+    "OLD.camiseta_id IS NEW.camiseta_id AND OLD.resultado IS NEW.resultado AND " \
+    "OLD.clima IS NEW.clima AND OLD.dia IS NEW.dia AND " \
+    "OLD.rendimiento_general IS NEW.rendimiento_general AND OLD.cansancio IS NEW.cansancio AND " \
+    "OLD.estado_animo IS NEW.estado_animo AND OLD.comentario_personal IS NEW.comentario_personal AND " \
+    "(SELECT tabla = 'partido' AND fila = NEW.id AND op = 'I' FROM cambio ORDER BY seq DESC LIMIT 1)"
+
+/**
+ * @brief Tabla cuyos cambios se anotan en el registro de cambios
+ */
+typedef struct
+{
+    const char *tabla;
+    const char *cuando_upd;     /**< Clausula WHEN del trigger de UPDATE, o "" */
+} TablaRegistroCambios;
+
+/** Tablas cuyos cambios se anotan en el registro de cambios */
+static const TablaRegistroCambios TABLAS_REGISTRO_CAMBIOS[] =
+{
+    {"partido", "WHEN NOT (" PARTIDO_SOLO_RELLENA_FECHA_TS ") "},
+    {"lesion", ""},
+    {"partido_torneo", ""},
+    {"jugador_estadisticas", ""},
+    {"financiamiento", ""},
+    {NULL, NULL}
+};
+
+/**
+ * @brief Crea el registro de cambios y sus triggers
+ *
+ * Cada alta, modificacion o baja en las tablas de TABLAS_REGISTRO_CAMBIOS
+ * anota (tabla, rowid, operacion) en cambio. Un UPDATE que cambia el rowid
+ * se anota como baja del anterior y alta del nuevo. No se usa AUTOINCREMENT
+ * (encarece cada escritura): la purga conserva siempre la ultima entrada,
+ * de modo que MAX(seq) nunca retrocede y las secuencias no se reutilizan.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int crear_registro_cambios()
+{
+    char sql[4096];
+
+    if (sqlite3_exec(db,
+                     "CREATE TABLE IF NOT EXISTS cambio ("
+                     " seq INTEGER PRIMARY KEY,"
+                     " tabla TEXT NOT NULL,"
+                     " fila INTEGER NOT NULL,"
+                     " op TEXT NOT NULL);"
+                     "CREATE TABLE IF NOT EXISTS cambio_consumidor ("
+                     " nombre TEXT PRIMARY KEY,"
+                     " seq INTEGER NOT NULL DEFAULT 0) WITHOUT ROWID;",
+                     0, 0, 0) != SQLITE_OK)
+    {
+        printf("Error creando registro de cambios: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+
+    for (int i = 0; TABLAS_REGISTRO_CAMBIOS[i].tabla != NULL; i++)
+    {
+        const char *t = TABLAS_REGISTRO_CAMBIOS[i].tabla;
+
+        snprintf(sql, sizeof(sql),
+                 "CREATE TRIGGER IF NOT EXISTS trg_%s_cambio_ins AFTER INSERT ON %s "
+                 "BEGIN INSERT INTO cambio(tabla, fila, op) VALUES('%s', NEW.rowid, 'I'); END;"
+                 "CREATE TRIGGER IF NOT EXISTS trg_%s_cambio_upd AFTER UPDATE ON %s %s"
+                 "BEGIN INSERT INTO cambio(tabla, fila, op) SELECT '%s', OLD.rowid, 'D' WHERE OLD.rowid <> NEW.rowid;"
+                 " INSERT INTO cambio(tabla, fila, op) VALUES('%s', NEW.rowid,"
+                 " CASE WHEN OLD.rowid = NEW.rowid THEN 'U' ELSE 'I' END); END;"
+                 "CREATE TRIGGER IF NOT EXISTS trg_%s_cambio_del AFTER DELETE ON %s "
+                 "BEGIN INSERT INTO cambio(tabla, fila, op) VALUES('%s', OLD.rowid, 'D'); END;",
+                 t, t, t, t, t, TABLAS_REGISTRO_CAMBIOS[i].cuando_upd, t, t, t, t, t);
+
+        if (sqlite3_exec(db, sql, 0, 0, 0) != SQLITE_OK)
+        {
+            printf("Error creando triggers de cambios de %s: %s\n", t, sqlite3_errmsg(db));
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/** Sumas de un partido (fila OLD o NEW) con signo +1 o -1 para una fila de resumen */
+#define RESUMEN_VALOR(fila, signo, columna) \
+    signo " * COALESCE(" fila "." columna ", 0), " \
+    signo " * COALESCE(" fila "." columna ", 0) * COALESCE(" fila "." columna ", 0), "
+
+/** Suma (signo 1) o resta (signo -1) un partido en la fila de resumen de una dimension */
+#define RESUMEN_SUMAR(dimension, clave, fila, signo) \
+    "INSERT INTO resumen_partido VALUES('" dimension "', " clave ", COALESCE(" fila ".camiseta_id, 0), " signo ", " \
+    RESUMEN_VALOR(fila, signo, "goles") RESUMEN_VALOR(fila, signo, "asistencias") \
+    RESUMEN_VALOR(fila, signo, "rendimiento_general") RESUMEN_VALOR(fila, signo, "cansancio") \
+    RESUMEN_VALOR(fila, signo, "estado_animo") \
+    signo " * (COALESCE(" fila ".resultado, 0) = 1), " \
+    signo " * (COALESCE(" fila ".resultado, 0) = 2), " \
+    signo " * (COALESCE(" fila ".resultado, 0) = 3)) " \
+    "ON CONFLICT(dimension, clave, camiseta_id) DO UPDATE SET " \
+    "partidos = partidos + excluded.partidos, " \
+    "goles = goles + excluded.goles, goles_cuad = goles_cuad + excluded.goles_cuad, " \
+    "asistencias = asistencias + excluded.asistencias, asistencias_cuad = asistencias_cuad + excluded.asistencias_cuad, " \
+    "rendimiento = rendimiento + excluded.rendimiento, rendimiento_cuad = rendimiento_cuad + excluded.rendimiento_cuad, " \
+    "cansancio = cansancio + excluded.cansancio, cansancio_cuad = cansancio_cuad + excluded.cansancio_cuad, " \
+    "animo = animo + excluded.animo, animo_cuad = animo_cuad + excluded.animo_cuad, " \
+    "victorias = victorias + excluded.victorias, empates = empates + excluded.empates, " \
+    "derrotas = derrotas + excluded.derrotas;"
+
+/** Borra la fila de resumen de una dimension si se quedo sin partidos */
+#define RESUMEN_LIMPIAR(dimension, clave, fila) \
+    "DELETE FROM resumen_partido WHERE dimension = '" dimension "' AND clave = " clave \
+    " AND camiseta_id = COALESCE(" fila ".camiseta_id, 0) AND partidos = 0;"
+
+/** Mueve un partido de la fila de resumen de OLD a la de NEW en una dimension */
+#define RESUMEN_MOVER(dimension, clave_old, clave_new) \
+    RESUMEN_SUMAR(dimension, clave_old, "OLD", "-1") \
+    RESUMEN_LIMPIAR(dimension, clave_old, "OLD") \
+    RESUMEN_SUMAR(dimension, clave_new, "NEW", "1")
+
+/** Columnas comunes a todas las dimensiones que cambian alguna suma */
+#define RESUMEN_COLUMNAS_VALOR "camiseta_id, goles, asistencias, rendimiento_general, cansancio, estado_animo, resultado"
+
+/** Condicion WHEN: alguna de RESUMEN_COLUMNAS_VALOR cambio de verdad */
+#define RESUMEN_VALORES_CAMBIAN \
+    "OLD.camiseta_id IS NOT NEW.camiseta_id OR OLD.goles IS NOT NEW.goles OR " \
+    "OLD.asistencias IS NOT NEW.asistencias OR OLD.rendimiento_general IS NOT NEW.rendimiento_general OR " \
+    "OLD.cansancio IS NOT NEW.cansancio OR OLD.estado_animo IS NOT NEW.estado_animo OR " \
+    "OLD.resultado IS NOT NEW.resultado"
+
+/**
+ * @brief Tabla de resumenes de partido y triggers que la mantienen
+ *
+ * Las modificaciones se reparten en dos triggers: uno para las dimensiones
+ * temporales (mes y dia) y otro para cancha y clima, de modo que cada
+ * UPDATE solo mueve las filas cuya clave o sumas cambian. Las claves
+ * temporales salen solo de fecha_ts: el alta suma en la clave 0 y el
+ * UPDATE de fecha_ts que la sigue la mueve a su mes. Si ese UPDATE se
+ * dispara antes que trg_partido_resumen_ins, la clave 0 queda un momento
+ * en -1 partidos; por eso el alta tambien limpia las filas que vuelven a
+ * 0. Ver resumenes.h.
+ */
+static const char SQL_RESUMENES_PARTIDO[] =
+    "CREATE TABLE IF NOT EXISTS resumen_partido ("
+    " dimension TEXT NOT NULL,"
+    " clave INTEGER NOT NULL,"
+    " camiseta_id INTEGER NOT NULL,"
+    " partidos INTEGER NOT NULL,"
+    " goles INTEGER NOT NULL, goles_cuad INTEGER NOT NULL,"
+    " asistencias INTEGER NOT NULL, asistencias_cuad INTEGER NOT NULL,"
+    " rendimiento INTEGER NOT NULL, rendimiento_cuad INTEGER NOT NULL,"
+    " cansancio INTEGER NOT NULL, cansancio_cuad INTEGER NOT NULL,"
+    " animo INTEGER NOT NULL, animo_cuad INTEGER NOT NULL,"
+    " victorias INTEGER NOT NULL, empates INTEGER NOT NULL, derrotas INTEGER NOT NULL,"
+    " PRIMARY KEY(dimension, clave, camiseta_id)) WITHOUT ROWID;"
+
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_resumen_ins AFTER INSERT ON partido BEGIN "
+    RESUMEN_SUMAR("mes", RESUMEN_CLAVE_MES("NEW"), "NEW", "1")
+    RESUMEN_LIMPIAR("mes", RESUMEN_CLAVE_MES("NEW"), "NEW")
+    RESUMEN_SUMAR("dia", RESUMEN_CLAVE_DIA("NEW"), "NEW", "1")
+    RESUMEN_LIMPIAR("dia", RESUMEN_CLAVE_DIA("NEW"), "NEW")
+    RESUMEN_SUMAR("cancha", RESUMEN_CLAVE_CANCHA("NEW"), "NEW", "1")
+    RESUMEN_SUMAR("clima", RESUMEN_CLAVE_CLIMA("NEW"), "NEW", "1")
+    " END;"
+
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_resumen_del AFTER DELETE ON partido BEGIN "
+    RESUMEN_SUMAR("mes", RESUMEN_CLAVE_MES("OLD"), "OLD", "-1")
+    RESUMEN_LIMPIAR("mes", RESUMEN_CLAVE_MES("OLD"), "OLD")
+    RESUMEN_SUMAR("dia", RESUMEN_CLAVE_DIA("OLD"), "OLD", "-1")
+    RESUMEN_LIMPIAR("dia", RESUMEN_CLAVE_DIA("OLD"), "OLD")
+    RESUMEN_SUMAR("cancha", RESUMEN_CLAVE_CANCHA("OLD"), "OLD", "-1")
+    RESUMEN_LIMPIAR("cancha", RESUMEN_CLAVE_CANCHA("OLD"), "OLD")
+    RESUMEN_SUMAR("clima", RESUMEN_CLAVE_CLIMA("OLD"), "OLD", "-1")
+    RESUMEN_LIMPIAR("clima", RESUMEN_CLAVE_CLIMA("OLD"), "OLD")
+    " END;"
+
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_resumen_tiempo "
+    "AFTER UPDATE OF fecha_ts, " RESUMEN_COLUMNAS_VALOR " ON partido "
+    "WHEN " RESUMEN_TS("OLD") " IS NOT " RESUMEN_TS("NEW") " OR " RESUMEN_VALORES_CAMBIAN " BEGIN "
+    RESUMEN_MOVER("mes", RESUMEN_CLAVE_MES("OLD"), RESUMEN_CLAVE_MES("NEW"))
+    RESUMEN_MOVER("dia", RESUMEN_CLAVE_DIA("OLD"), RESUMEN_CLAVE_DIA("NEW"))
+    " END;"
+
+    "CREATE TRIGGER IF NOT EXISTS trg_partido_resumen_contexto "
+    "AFTER UPDATE OF cancha_id, clima, " RESUMEN_COLUMNAS_VALOR " ON partido "
+    "WHEN OLD.cancha_id IS NOT NEW.cancha_id OR OLD.clima IS NOT NEW.clima OR " RESUMEN_VALORES_CAMBIAN " BEGIN "
+    RESUMEN_MOVER("cancha", RESUMEN_CLAVE_CANCHA("OLD"), RESUMEN_CLAVE_CANCHA("NEW"))
+    RESUMEN_MOVER("clima", RESUMEN_CLAVE_CLIMA("OLD"), RESUMEN_CLAVE_CLIMA("NEW"))
+    " END;";
+
+/**
+ * @brief Crea los resumenes de partido y los rellena con los datos existentes
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int crear_resumenes_partido()
+{
+    if (sqlite3_exec(db, SQL_RESUMENES_PARTIDO, 0, 0, 0) != SQLITE_OK)
+    {
+        printf("Error creando resumenes de partido: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    return resumenes_llenar();
+}
+
+/**
+ * @brief Registro ordenado de migraciones
+ *
+ * Las versiones deben ser consecutivas empezando en 1. Nunca se modifica
+ * un paso ya publicado: los cambios nuevos se agregan al final.
+ */
+static const Migracion MIGRACIONES[] =
+{
+    {1, "Esquema base", SQL_ESQUEMA_BASE, NULL},
+    {2, "Columnas agregadas por evolucion del esquema", NULL, migrar_columnas_evolucion},
+    {3, "Indices de columnas de busqueda frecuente", NULL, crear_indices_gestionados},
+    {4, "Marca temporal ordenable fecha_ts en partido", SQL_PARTIDO_FECHA_TS, NULL},
+    {5, "Perfil de ajuste de conexion en settings", "ALTER TABLE settings ADD COLUMN perfil_db INTEGER DEFAULT 0;", NULL},
+    {6, "Lista persistida de IDs libres", NULL, crear_lista_ids_libres},
+    {7, "Preferencia de modo memoria en settings", "ALTER TABLE settings ADD COLUMN modo_memoria INTEGER DEFAULT 0;", NULL},
+    {8, "Listado paginado de partidos", SQL_PAGINACION_PARTIDOS, NULL},
+    {9, "Busqueda de texto en comentarios y lesiones", NULL, crear_busqueda_texto},
+    {10, "Registro de cambios para procesamiento incremental", NULL, crear_registro_cambios},
+    {11, "Resumenes de partido por mes, cancha, clima y dia", NULL, crear_resumenes_partido},
+    {12, "Ventana y decaimiento de la forma en settings",
+     "ALTER TABLE settings ADD COLUMN ventana_forma INTEGER DEFAULT 5;"
+     "ALTER TABLE settings ADD COLUMN vida_media_forma INTEGER DEFAULT 0;", NULL},
+};
+
+/** Numero de migraciones registradas */
+#define NUM_MIGRACIONES (sizeof(MIGRACIONES) / sizeof(MIGRACIONES[0]))
+
+/**
+ * @brief Ejecuta un paso de migracion dentro de su propia transaccion
+ *
+ * @param m Migracion a aplicar
+ * @return 1 si exito, 0 si fallo (la transaccion se revierte)
+ */
+static int aplicar_migracion(const Migracion *m)
+{
+    char *err = NULL;
+    const char *sql = m->sql;
+    char pragma[64];
+
+    if (sqlite3_exec(db, "BEGIN IMMEDIATE;", 0, 0, &err) != SQLITE_OK)
+    {
+        printf("Error iniciando migracion %d: %s\n", m->version, err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        return 0;
+    }
+
+    if (sql && sqlite3_exec(db, sql, 0, 0, &err) != SQLITE_OK)
+    {
+        printf("Error en migracion %d (%s): %s\n", m->version, m->descripcion, err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        sqlite3_exec(db, "ROLLBACK;", 0, 0, 0);
+        return 0;
+    }
+
+    if (m->aplicar && !m->aplicar())
+    {
+        printf("Error en migracion %d (%s)\n", m->version, m->descripcion);
+        sqlite3_exec(db, "ROLLBACK;", 0, 0, 0);
+        return 0;
+    }
+
+    snprintf(pragma, sizeof(pragma), "PRAGMA user_version = %d;", m->version);
+    if (sqlite3_exec(db, pragma, 0, 0, &err) != SQLITE_OK ||
+            sqlite3_exec(db, "COMMIT;", 0, 0, &err) != SQLITE_OK)
+    {
+        printf("Error confirmando migracion %d: %s\n", m->version, err ? err : sqlite3_errmsg(db));
+        sqlite3_free(err);
+        sqlite3_exec(db, "ROLLBACK;", 0, 0, 0);
+        return 0;
+    }
+    return 1;
+}
+
+int migraciones_version_actual()
+{
+    sqlite3_stmt *stmt;
+    int version = -1;
+
+    if (sqlite3_prepare_v2(db, "PRAGMA user_version;", -1, &stmt, NULL) == SQLITE_OK)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            version = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+    }
+    return version;
+}
+
+int migraciones_version_objetivo()
+{
+    return MIGRACIONES[NUM_MIGRACIONES - 1].version;
+}
+
+double migraciones_tiempo_ms()
+{
+    return tiempo_migraciones_ms;
+}
+
+/**
+ * @brief Lleva el esquema hasta la version objetivo
+ *
+ * Una base ya actualizada solo paga la lectura de PRAGMA user_version y
+ * la comprobacion de la busqueda de texto en sqlite_master.
+ * Una base creada por una version mas nueva del programa se deja intacta.
+ *
+ * @return 1 si el esquema queda utilizable, 0 en caso de error
+ */
+int migraciones_aplicar()
+{
+    double inicio = get_time_ms();
+    int version = migraciones_version_actual();
+    int objetivo = migraciones_version_objetivo();
+    int ok = 1;
+
+    if (version < 0)
+    {
+        printf("Error leyendo version del esquema: %s\n", sqlite3_errmsg(db));
+        tiempo_migraciones_ms = get_time_ms() - inicio;
+        return 0;
+    }
+
+    if (version > objetivo)
+    {
+        printf("Aviso: la base de datos tiene version de esquema %d, mas nueva que la soportada (%d)\n",
+               version, objetivo);
+    }
+
+    for (size_t i = 0; i < NUM_MIGRACIONES && ok; i++)
+    {
+        if (MIGRACIONES[i].version <= version)
+            continue;
+        ok = aplicar_migracion(&MIGRACIONES[i]);
+    }
+
+    if (ok && version <= objetivo)
+        ok = revisar_busqueda_texto();
+
+    tiempo_migraciones_ms = get_time_ms() - inicio;
+    return ok;
+}
+
+/**
+ * @brief Consulta caliente y el indice con el que debe resolverse
+ *
+ * No alcanza con que el plan evite el recorrido completo: si falta el
+ * indice compuesto, SQLite suele caer en otro de una sola columna y la
+ * consulta sigue "usando indice" pero recorre muchas mas filas.
+ */
+typedef struct
+{
+    const char *descripcion;   /**< Origen de la consulta */
+    const char *sql;           /**< Texto SQL tal como lo usa el programa */
+    const char *vigilada;      /**< Tabla o alias que debe accederse por indice */
+    const char *indice;        /**< Indice esperado, o "PRIMARY KEY" / "INTEGER PRIMARY KEY" */
+} ConsultaVigilada;
+
+/** Consultas de las rutas calientes verificadas con EXPLAIN QUERY PLAN */
+static const ConsultaVigilada CONSULTAS_VIGILADAS[] =
+{
+    {"partidos: primera pagina del listado", "SELECT p.id, p.fecha_ts, can.nombre, p.fecha_hora, p.goles, p.asistencias, c.nombre, p.resultado, p.clima, p.dia FROM partido p JOIN camiseta c ON p.camiseta_id = c.id JOIN cancha can ON p.cancha_id = can.id WHERE p.fecha_ts IS NOT NULL ORDER BY p.fecha_ts DESC, p.id DESC LIMIT ?", "p", "idx_partido_fecha_ts"},
+    {"partidos: pagina siguiente por cancha", "SELECT p.id, p.fecha_ts, can.nombre, p.fecha_hora, p.goles, p.asistencias, c.nombre, p.resultado, p.clima, p.dia FROM partido p JOIN camiseta c ON p.camiseta_id = c.id JOIN cancha can ON p.cancha_id = can.id WHERE (p.cancha_id = ?) AND (p.fecha_ts, p.id) < (?, ?) ORDER BY p.fecha_ts DESC, p.id DESC LIMIT ?", "p", "idx_partido_cancha_fecha"},
+    {"partidos: conteo de busqueda combinada", "SELECT COUNT(*) FROM partido p JOIN camiseta c ON p.camiseta_id = c.id JOIN cancha can ON p.cancha_id = can.id WHERE p.camiseta_id = ? AND p.fecha_ts BETWEEN ? AND ? AND p.resultado = ?", "p", "idx_partido_camiseta_fecha"},
+    {"partidos: busqueda por camiseta y cancha", "SELECT COUNT(*) FROM partido p JOIN camiseta c ON p.camiseta_id = c.id JOIN cancha can ON p.cancha_id = can.id WHERE p.camiseta_id = ? AND p.cancha_id = ? AND p.fecha_ts BETWEEN ? AND ?", "p", "idx_partido_cancha_fecha"},
+    {"importacion: partido duplicado", "SELECT COUNT(*) FROM partido WHERE cancha_id = ? AND fecha_hora = ? AND camiseta_id = ?", "partido", "idx_partido_cancha_fecha"},
+    {"lesiones: por camiseta", "SELECT COUNT(*) FROM lesion WHERE camiseta_id = ?", "lesion", "idx_lesion_camiseta"},
+    {"logros: camisetas con partidos", "SELECT DISTINCT c.id, c.nombre FROM camiseta c INNER JOIN partido p ON c.id = p.camiseta_id ORDER BY c.id", "p", "idx_partido_camiseta_fecha"},
+    {"logros: nombre de camiseta", "SELECT nombre FROM camiseta WHERE id = ?", "camiseta", "INTEGER PRIMARY KEY"},
+    {"torneos: partidos del torneo", "SELECT COUNT(*) FROM partido_torneo WHERE torneo_id = ?;", "partido_torneo", "idx_partido_torneo_torneo"},
+    {"torneos: jugadores del equipo", "SELECT id, nombre FROM jugador WHERE equipo_id = ? ORDER BY numero;", "jugador", "idx_jugador_equipo"},
+    {"analisis: ultimos partidos", "SELECT goles, asistencias FROM partido ORDER BY fecha_ts DESC, id DESC LIMIT 5", "partido", "idx_partido_fecha_ts"},
+    {"ids: siguiente ID libre", "SELECT id FROM id_libre WHERE tabla = ? ORDER BY id LIMIT 1;", "id_libre", "PRIMARY KEY"},
+    {"cambios: lectura desde una marca", "SELECT seq, tabla, fila, op FROM cambio WHERE seq > ? AND (?2 IS NULL OR tabla = ?2) ORDER BY seq", "cambio", "INTEGER PRIMARY KEY"},
+    {"torneos: estadisticas de jugador", "SELECT COUNT(*) FROM jugador_estadisticas WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;", "jugador_estadisticas", "idx_jugador_estadisticas_clave"},
+    {NULL, NULL, NULL, NULL}
+};
+
+/**
+ * @brief Obtiene como accede una linea de plan a la tabla vigilada
+ *
+ * Acepta tanto el formato actual ("SCAN t", "SEARCH t USING ...") como el
+ * anterior a SQLite 3.36 ("SCAN TABLE t").
+ *
+ * @param detalle Columna detail de EXPLAIN QUERY PLAN
+ * @param vigilada Tabla o alias vigilado
+ * @param acceso Destino: nombre del indice, "PRIMARY KEY", "INTEGER PRIMARY KEY"
+ *               o cadena vacia si es un recorrido completo
+ * @param tam Tamano del destino
+ * @return 1 si la linea corresponde a la tabla vigilada, 0 en otro caso
+ */
+static int acceso_de_plan(const char *detalle, const char *vigilada, char *acceso, size_t tam)
+{
+    size_t n = strlen(vigilada);
+    const char *usando;
+    size_t largo;
+
+    if (strncmp(detalle, "SCAN ", 5) == 0)
+        detalle += 5;
+    else if (strncmp(detalle, "SEARCH ", 7) == 0)
+        detalle += 7;
+    else
+        return 0;
+    if (strncmp(detalle, "TABLE ", 6) == 0)
+        detalle += 6;
+    if (strncmp(detalle, vigilada, n) != 0 || (detalle[n] != '\0' && detalle[n] != ' '))
+        return 0;
+
+    acceso[0] = '\0';
+    usando = strstr(detalle + n, " USING ");
+    if (!usando)
+        return 1;
+    usando += 7;
+    if (strncmp(usando, "COVERING INDEX ", 15) == 0)
+        usando += 15;
+    else if (strncmp(usando, "INDEX ", 6) == 0)
+        usando += 6;
+
+    // El nombre del indice termina en el primer espacio; las claves primarias, antes del " ("
+    largo = strncmp(usando, "INTEGER PRIMARY KEY", 19) == 0 ? 19 :
+            strncmp(usando, "PRIMARY KEY", 11) == 0 ? 11 : strcspn(usando, " ");
+    if (largo >= tam)
+        largo = tam - 1;
+    memcpy(acceso, usando, largo);
+    acceso[largo] = '\0';
+    return 1;
+}
+
+int migraciones_verificar_planes(int detallado)
+{
+    int fallos = 0;
+
+    for (int i = 0; CONSULTAS_VIGILADAS[i].sql != NULL; i++)
+    {
+        const ConsultaVigilada *c = &CONSULTAS_VIGILADAS[i];
+        char sql[1024];
+        char acceso[128];
+        char usado[128] = "";
+        sqlite3_stmt *stmt;
+        int esperado = 0;
+        int otro = 0;
+
+        snprintf(sql, sizeof(sql), "EXPLAIN QUERY PLAN %s", c->sql);
+        if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) != SQLITE_OK)
+        {
+            printf("[ERROR] %s: %s\n", c->descripcion, sqlite3_errmsg(db));
+            fallos++;
+            continue;
+        }
+
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            const char *detalle = (const char*)sqlite3_column_text(stmt, 3);
+            if (!detalle)
+                continue;
+            if (detallado)
+                printf("    %s\n", detalle);
+            if (!acceso_de_plan(detalle, c->vigilada, acceso, sizeof(acceso)))
+                continue;
+            if (strcmp(acceso, c->indice) == 0)
+            {
+                esperado = 1;
+            }
+            else
+            {
+                otro = 1;
+                snprintf(usado, sizeof(usado), "%s", acceso[0] ? acceso : "recorrido completo");
+            }
+        }
+        sqlite3_finalize(stmt);
+
+        if (esperado && !otro)
+        {
+            printf("[ OK ] %s\n", c->descripcion);
+        }
+        else
+        {
+            printf("[FALLA] %s: usa %s, se esperaba %s\n", c->descripcion,
+                   usado[0] ? usado : "un plan sin la tabla vigilada", c->indice);
+            fallos++;
+        }
+    }
+
+    return fallos == 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file migraciones.h
+ * @brief Registro ordenado de migraciones de esquema versionadas
+ *
+ * Cada migracion tiene un numero de version creciente y se aplica una sola
+ * vez; la version alcanzada se guarda en PRAGMA user_version, de modo que
+ * una base de datos ya actualizada arranca con una unica lectura del pragma.
+ */
+
+#ifndef MIGRACIONES_H
+#define MIGRACIONES_H
+
+/**
+ * @brief Aplica en orden las migraciones pendientes sobre la conexion global
+ *
+ * Cada paso se ejecuta en su propia transaccion junto con la actualizacion
+ * de PRAGMA user_version; si un paso falla se revierte y no se aplican
+ * los siguientes.
+ *
+ * @return 1 si el esquema quedo en la version esperada, 0 en caso de error
+ */
+int migraciones_aplicar();
+
+/**
+ * @brief Lee la version de esquema almacenada en la base de datos
+ *
+ * @return Valor de PRAGMA user_version, -1 si no se pudo leer
+ */
+int migraciones_version_actual();
+
+/**
+ * @brief Devuelve la version de esquema que espera esta version del programa
+ *
+ * @return Numero de la ultima migracion registrada
+ */
+int migraciones_version_objetivo();
+
+/**
+ * @brief Tiempo invertido en la ultima llamada a migraciones_aplicar()
+ *
+ * @return Milisegundos transcurridos
+ */
+double migraciones_tiempo_ms();
+
+/**
+ * @brief Verifica que las consultas calientes sigan usando sus indices
+ *
+ * Ejecuta EXPLAIN QUERY PLAN sobre cada consulta vigilada e informa
+ * cuales acceden a su tabla con otro indice o recorriendola completa.
+ *
+ * @param detallado 1 para imprimir tambien cada linea del plan
+ * @return 1 si todas usan el indice esperado, 0 si alguna no lo hace
+ */
+int migraciones_verificar_planes(int detallado);
+
+#endif
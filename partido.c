@@ -5,35 +5,15 @@
 #include "camiseta.h"
 #include "equipo.h"
 #include "ascii_art.h"
+#include "settings.h"
+#include <ctype.h>
 #include <stdio.h>
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 #include <windows.h>
 
 
-/**
- * @brief Obtiene el siguiente ID disponible para un nuevo partido
- *
- * Busca el ID más pequeño disponible reutilizando espacios de IDs eliminados.
- * Utiliza una consulta SQL que encuentra el primer hueco en la secuencia de IDs.
- *
- * @return El ID disponible más pequeño (comenzando desde 1 si la tabla está vacía)
- */
-static int obtener_siguiente_id_partido()
-{
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT CASE WHEN NOT EXISTS (SELECT 1 FROM partido WHERE id = 1) THEN 1 ELSE (SELECT MIN(t1.id + 1) FROM partido t1 WHERE NOT EXISTS (SELECT 1 FROM partido t2 WHERE t2.id = t1.id + 1)) END",
-                       -1, &stmt, NULL);
-
-    int id = 1; // Default si la tabla está vacía
-    if (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        id = sqlite3_column_int(stmt, 0);
-    }
-    sqlite3_finalize(stmt);
-    return id;
-}
-
 /**
  * @brief Verifica si hay partidos registrados en la base de datos
  *
@@ -41,15 +21,14 @@ static int obtener_siguiente_id_partido()
  */
 static int hay_partidos()
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM partido", -1, &stmt, NULL);
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT COUNT(*) FROM partido");
 
     int count = 0;
     if (sqlite3_step(stmt) == SQLITE_ROW)
     {
         count = sqlite3_column_int(stmt, 0);
     }
-    sqlite3_finalize(stmt);
+    db_release_cached(stmt);
     return count > 0;
 }
 
@@ -182,14 +161,13 @@ static void recopilar_datos_partido(int *cancha_id, int *goles, int *asistencias
  * @param comentario_personal Comentario personal
  * @param clima Condición climática
  * @param dia Momento del día
+ * @return 1 si se inserto, 0 en caso de error
  */
-static void insertar_partido(int id, int cancha_id, char *fecha, int goles, int asistencias, int camiseta, int resultado, int rendimiento_general, int cansancio, int estado_animo, char *comentario_personal, int clima, int dia)
+static int insertar_partido(int id, int cancha_id, const char *fecha, int goles, int asistencias, int camiseta, int resultado, int rendimiento_general, int cansancio, int estado_animo, const char *comentario_personal, int clima, int dia)
 {
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "INSERT INTO partido(id, cancha_id,fecha_hora,goles,asistencias,camiseta_id,resultado,rendimiento_general,cansancio,estado_animo,comentario_personal,clima,dia)"
-                       "VALUES(?,?,?,?,?,?,?,?,?,?,?,?,?)",
-                       -1, &stmt, NULL);
+    sqlite3_stmt *stmt = db_prepare_cached(
+                             "INSERT INTO partido(id, cancha_id,fecha_hora,goles,asistencias,camiseta_id,resultado,rendimiento_general,cansancio,estado_animo,comentario_personal,clima,dia)"
+                             "VALUES(?,?,?,?,?,?,?,?,?,?,?,?,?)");
     sqlite3_bind_int(stmt, 1, id);
     sqlite3_bind_int(stmt, 2, cancha_id);
     sqlite3_bind_text(stmt, 3, fecha, -1, SQLITE_TRANSIENT);
@@ -212,7 +190,8 @@ static void insertar_partido(int id, int cancha_id, char *fecha, int goles, int
     {
         printf("Error al crear el partido: %s\n", sqlite3_errmsg(db));
     }
-    sqlite3_finalize(stmt);
+    db_release_cached(stmt);
+    return result == SQLITE_DONE;
 }
 
 /**
@@ -230,60 +209,739 @@ void crear_partido()
     recopilar_datos_partido(&cancha_id, &goles, &asistencias, &camiseta, &resultado, &rendimiento_general, &cansancio, &estado_animo, comentario_personal, &clima, &dia);
     char fecha[20];
     get_datetime(fecha, sizeof(fecha));
-    int id = obtener_siguiente_id_partido();
+    int id = db_siguiente_id("partido");
     insertar_partido(id, cancha_id, fecha, goles, asistencias, camiseta, resultado, rendimiento_general, cansancio, estado_animo, comentario_personal, clima, dia);
 }
 
+/** Longitud maxima de una linea pegada en la carga masiva */
+#define LINEA_CARGA_MAX 1024
+
 /**
- * @brief Muestra un listado de todos los partidos registrados
+ * @brief Partido pendiente de guardar en una carga masiva
+ */
+typedef struct
+{
+    int cancha_id;
+    char fecha[20];
+    int goles;
+    int asistencias;
+    int camiseta;
+    int resultado;
+    int rendimiento_general;
+    int cansancio;
+    int estado_animo;
+    char comentario_personal[256];
+    int clima;
+    int dia;
+} PartidoNuevo;
+
+/**
+ * @brief Lote de partidos pendientes, en el orden en que se ingresaron
+ */
+typedef struct
+{
+    PartidoNuevo *partidos;
+    int cantidad;
+    int capacidad;
+} LotePartidos;
+
+/**
+ * @brief Agrega un partido al lote, ampliandolo si hace falta
  *
- * Consulta la base de datos y muestra en pantalla todos los partidos
- * con sus respectivos datos: ID, cancha, fecha/hora, goles, asistencias
- * y nombre de la camiseta utilizada. Realiza un JOIN con la tabla camiseta
- * para obtener el nombre de la camiseta.
+ * @return 1 si exito, 0 si falta memoria
+ */
+static int lote_agregar(LotePartidos *lote, const PartidoNuevo *p)
+{
+    if (lote->cantidad == lote->capacidad)
+    {
+        int nueva = lote->capacidad > 0 ? lote->capacidad * 2 : 16;
+        PartidoNuevo *q = realloc(lote->partidos, sizeof(PartidoNuevo) * nueva);
+        if (!q)
+        {
+            printf("Memoria insuficiente para el lote.\n");
+            return 0;
+        }
+        lote->partidos = q;
+        lote->capacidad = nueva;
+    }
+    lote->partidos[lote->cantidad++] = *p;
+    return 1;
+}
+
+/**
+ * @brief Valida los rangos de un partido pendiente
  *
- * @note Si no hay partidos registrados, muestra un mensaje informativo
+ * @param p Partido a validar
+ * @param error Buffer para el motivo del rechazo
+ * @param tam Tamano del buffer
+ * @return 1 si es valido, 0 en caso contrario
  */
-void listar_partidos()
+static int validar_partido_nuevo(const PartidoNuevo *p, char *error, int tam)
 {
-    clear_screen();
-    print_header("LISTADO DE PARTIDOS");
+    if (!existe_id("cancha", p->cancha_id))
+        snprintf(error, tam, "la cancha %d no existe", p->cancha_id);
+    else if (!existe_id("camiseta", p->camiseta))
+        snprintf(error, tam, "la camiseta %d no existe", p->camiseta);
+    else if (p->goles < 0 || p->asistencias < 0)
+        snprintf(error, tam, "goles y asistencias no pueden ser negativos");
+    else if (p->resultado < 1 || p->resultado > 3)
+        snprintf(error, tam, "resultado fuera de rango (1-3)");
+    else if (p->rendimiento_general < 1 || p->rendimiento_general > 10 ||
+             p->cansancio < 1 || p->cansancio > 10 ||
+             p->estado_animo < 1 || p->estado_animo > 10)
+        snprintf(error, tam, "rendimiento, cansancio y animo van de 1 a 10");
+    else if (p->clima < 1 || p->clima > 6)
+        snprintf(error, tam, "clima fuera de rango (1-6)");
+    else if (p->dia < 1 || p->dia > 3)
+        snprintf(error, tam, "dia fuera de rango (1-3)");
+    else
+        return 1;
+    return 0;
+}
 
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT p.id, can.nombre, fecha_hora, goles, asistencias, c.nombre, resultado, clima, dia "
-                       "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id "
-                       "JOIN cancha can ON p.cancha_id = can.id ORDER BY p.id DESC",
-                       -1, &stmt, NULL);
+/**
+ * @brief Interpreta una linea pegada en la carga masiva
+ *
+ * Campos separados por tabulador (si la linea tiene alguno) o por coma:
+ * fecha, cancha, camiseta, goles, asistencias, resultado, rendimiento,
+ * cansancio, animo, clima, dia y opcionalmente comentario. El comentario
+ * es el resto de la linea, asi que puede contener el separador.
+ *
+ * @param linea Linea sin salto final; se modifica al separar los campos
+ * @param p Destino
+ * @param error Buffer para el motivo del rechazo
+ * @param tam Tamano del buffer
+ * @return 1 si la linea es valida, 0 en caso contrario
+ */
+static int parsear_linea_partido(char *linea, PartidoNuevo *p, char *error, int tam)
+{
+    char separador = strchr(linea, '\t') ? '\t' : ',';
+    char *campos[12];
+    int valores[10];
+    int n = 0;
+    char *cursor = linea;
+
+    memset(p, 0, sizeof(*p));
+    while (n < 11)
+    {
+        campos[n++] = cursor;
+        char *fin = strchr(cursor, separador);
+        if (!fin)
+        {
+            cursor = NULL;
+            break;
+        }
+        *fin = '\0';
+        cursor = fin + 1;
+    }
+    campos[n] = cursor ? cursor : "";
 
-    int hay = 0;
-    char fecha_formateada[20];
+    if (n < 11)
+    {
+        snprintf(error, tam, "se esperaban al menos 11 campos y hay %d", n);
+        return 0;
+    }
+
+    for (int i = 0; i <= 11; i++)
+    {
+        while (*campos[i] == ' ')
+            campos[i]++;
+        char *fin = campos[i] + strlen(campos[i]);
+        while (fin > campos[i] && (fin[-1] == ' ' || fin[-1] == '\r'))
+            *--fin = '\0';
+    }
 
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    if (!normalizar_fecha(campos[0], p->fecha, sizeof(p->fecha)))
     {
-        // Formatear la fecha para visualización
-        format_date_for_display((const char *)sqlite3_column_text(stmt, 2), fecha_formateada, sizeof(fecha_formateada));
+        snprintf(error, tam, "fecha invalida '%s'", campos[0]);
+        return 0;
+    }
 
-        printf("%d |Cancha:%s |Fecha:%s | G:%d A:%d |Camiseta:%s | %s |Clima:%s |Dia:%s\n",
-               sqlite3_column_int(stmt, 0),
-               sqlite3_column_text(stmt, 1),
-               fecha_formateada,
-               sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4),
-               sqlite3_column_text(stmt, 5),
-               resultado_to_text(sqlite3_column_int(stmt, 6)),
-               clima_to_text(sqlite3_column_int(stmt, 7)),
-               dia_to_text(sqlite3_column_int(stmt, 8)));
-        hay = 1;
+    for (int i = 0; i < 10; i++)
+    {
+        char *fin;
+        long v = strtol(campos[i + 1], &fin, 10);
+        if (fin == campos[i + 1] || *fin != '\0')
+        {
+            snprintf(error, tam, "campo %d no es un numero: '%s'", i + 2, campos[i + 1]);
+            return 0;
+        }
+        valores[i] = (int)v;
     }
 
-    if (!hay)
-        printf("No hay partidos cargados.\n");
+    p->cancha_id = valores[0];
+    p->camiseta = valores[1];
+    p->goles = valores[2];
+    p->asistencias = valores[3];
+    p->resultado = valores[4];
+    p->rendimiento_general = valores[5];
+    p->cansancio = valores[6];
+    p->estado_animo = valores[7];
+    p->clima = valores[8];
+    p->dia = valores[9];
+    snprintf(p->comentario_personal, sizeof(p->comentario_personal), "%s", campos[11]);
+
+    return validar_partido_nuevo(p, error, tam);
+}
 
-    sqlite3_finalize(stmt);
+/**
+ * @brief Agrega al lote partidos ingresados uno por uno
+ *
+ * Usa el mismo formulario que crear_partido() mas la fecha, porque en una
+ * carga posterior al torneo los partidos no se jugaron "ahora".
+ */
+static void cargar_lote_interactivo(LotePartidos *lote)
+{
+    do
+    {
+        PartidoNuevo p;
+        char fecha[20], hora[10], fecha_hora[30];
+        char error[128];
+
+        clear_screen();
+        print_header("CARGA MASIVA - PARTIDO NUEVO");
+        printf("Partidos en el lote: %d\n\n", lote->cantidad);
+
+        // Fecha y hora por separado: input_date() no admite el espacio entre ambas
+        input_date("Fecha (dd/mm/yyyy, vacio = ahora): ", fecha, sizeof(fecha));
+        if (fecha[0] == '\0')
+        {
+            get_datetime(p.fecha, sizeof(p.fecha));
+        }
+        else
+        {
+            input_date("Hora (hh:mm, vacio = 00:00): ", hora, sizeof(hora));
+            if (hora[0] != '\0')
+                snprintf(fecha_hora, sizeof(fecha_hora), "%s %s", fecha, hora);
+            else
+                snprintf(fecha_hora, sizeof(fecha_hora), "%s", fecha);
+            if (!normalizar_fecha(fecha_hora, p.fecha, sizeof(p.fecha)))
+            {
+                printf("Fecha u hora invalida.\n");
+                continue;
+            }
+        }
+
+        listar_canchas_disponibles();
+        p.cancha_id = 0;
+        recopilar_datos_partido(&p.cancha_id, &p.goles, &p.asistencias, &p.camiseta, &p.resultado,
+                                &p.rendimiento_general, &p.cansancio, &p.estado_animo,
+                                p.comentario_personal, &p.clima, &p.dia);
+        if (p.cancha_id == 0)
+            break;
+
+        // recopilar_datos_partido() corta al primer ID inexistente
+        if (!validar_partido_nuevo(&p, error, sizeof(error)))
+        {
+            printf("Partido descartado: %s.\n", error);
+            continue;
+        }
+        if (!lote_agregar(lote, &p))
+            break;
+    }
+    while (confirmar("Agregar otro partido al lote?"));
+}
+
+/**
+ * @brief Agrega al lote lineas CSV/TSV pegadas en la consola
+ *
+ * Lee hasta una linea vacia. Las lineas invalidas se informan con su numero
+ * y se omiten; una primera linea que no empieza con una fecha se toma como
+ * cabecera.
+ */
+static void cargar_lote_pegado(LotePartidos *lote)
+{
+    char linea[LINEA_CARGA_MAX];
+    int numero = 0;
+    int rechazadas = 0;
+
+    clear_screen();
+    print_header("CARGA MASIVA - PEGAR LINEAS");
+    printf("Formato (separado por coma o tabulador):\n");
+    printf("fecha, cancha, camiseta, goles, asistencias, resultado(1-3), rendimiento(1-10),\n");
+    printf("cansancio(1-10), animo(1-10), clima(1-6), dia(1-3)[, comentario]\n");
+    printf("Pegue las lineas y termine con una linea vacia:\n");
+
+    while (fgets(linea, sizeof(linea), stdin))
+    {
+        PartidoNuevo p;
+        char error[128];
+
+        linea[strcspn(linea, "\r\n")] = '\0';
+        if (linea[0] == '\0')
+            break;
+        numero++;
+
+        if (numero == 1 && !isdigit((unsigned char)linea[strspn(linea, " \t")]))
+            continue;
+
+        if (!parsear_linea_partido(linea, &p, error, sizeof(error)))
+        {
+            printf("Linea %d omitida: %s\n", numero, error);
+            rechazadas++;
+            continue;
+        }
+        if (!lote_agregar(lote, &p))
+            break;
+    }
+
+    printf("\nLineas leidas: %d, omitidas: %d. Partidos en el lote: %d\n", numero, rechazadas, lote->cantidad);
     pause_console();
 }
 
+/**
+ * @brief Guarda todo el lote en una sola transaccion
+ *
+ * Todas las filas usan la misma sentencia INSERT de la cache y se
+ * confirman juntas: o se guardan todas o ninguna. Los triggers (fecha_ts,
+ * IDs libres, texto completo) corren por fila dentro de la transaccion; la
+ * copia en memoria de partido_store solo queda marcada como desactualizada
+ * y se recarga una vez, en la siguiente consulta que la use.
+ *
+ * @return Partidos guardados (0 si se deshizo el lote)
+ */
+static int guardar_lote(const LotePartidos *lote)
+{
+    if (!db_begin())
+        return 0;
+
+    int ok = 1;
+    for (int i = 0; i < lote->cantidad && ok; i++)
+    {
+        const PartidoNuevo *p = &lote->partidos[i];
+        int id = db_siguiente_id("partido");
+        ok = insertar_partido(id, p->cancha_id, p->fecha, p->goles, p->asistencias, p->camiseta,
+                              p->resultado, p->rendimiento_general, p->cansancio, p->estado_animo,
+                              p->comentario_personal, p->clima, p->dia);
+    }
+
+    if (ok && db_commit())
+        return lote->cantidad;
+
+    printf("No se guardo ningun partido del lote.\n");
+    db_rollback();
+    return 0;
+}
+
+/**
+ * @brief Carga varios partidos seguidos y los guarda juntos
+ *
+ * Los partidos se juntan en un lote (ingresados uno a uno o pegados como
+ * lineas CSV/TSV), se revisan y se guardan en una sola transaccion.
+ */
+void carga_masiva_partidos()
+{
+    LotePartidos lote = {NULL, 0, 0};
+    int opcion;
+
+    if (!verificar_prerrequisitos_partido())
+        return;
+
+    do
+    {
+        clear_screen();
+        print_header("CARGA MASIVA DE PARTIDOS");
+
+        printf("Partidos en el lote: %d\n", lote.cantidad);
+        for (int i = 0; i < lote.cantidad; i++)
+        {
+            const PartidoNuevo *p = &lote.partidos[i];
+            printf("  %d. %s |Cancha:%d | G:%d A:%d |Camiseta:%d | %s\n", i + 1, p->fecha, p->cancha_id,
+                   p->goles, p->asistencias, p->camiseta, resultado_to_text(p->resultado));
+        }
+
+        printf("\n1. Agregar partidos uno por uno\n");
+        printf("2. Pegar lineas CSV/TSV\n");
+        printf("3. Guardar lote\n");
+        printf("4. Vaciar lote\n");
+        printf("0. Volver\n");
+
+        opcion = input_int("> ");
+
+        switch (opcion)
+        {
+        case 1:
+            cargar_lote_interactivo(&lote);
+            break;
+        case 2:
+            cargar_lote_pegado(&lote);
+            break;
+        case 3:
+            if (lote.cantidad == 0)
+            {
+                printf("El lote esta vacio.\n");
+            }
+            else
+            {
+                double inicio = get_time_ms();
+                int guardados = guardar_lote(&lote);
+                if (guardados > 0)
+                {
+                    printf("%d partidos guardados en %.1f ms.\n", guardados, get_time_ms() - inicio);
+                    lote.cantidad = 0;
+                }
+            }
+            pause_console();
+            break;
+        case 4:
+            lote.cantidad = 0;
+            break;
+        case 0:
+            if (lote.cantidad > 0 && !confirmar("Hay partidos sin guardar. Descartarlos?"))
+                opcion = -1;
+            break;
+        default:
+            printf("Opcion invalida.\n");
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+
+    free(lote.partidos);
+}
+
+/** Tablas de los listados y conteos de partidos */
+#define SQL_TABLAS_PARTIDO \
+    "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id " \
+    "JOIN cancha can ON p.cancha_id = can.id"
+
+/**
+ * @brief Columnas comunes de los listados de partidos
+ *
+ * Las paginas se recorren por (fecha_ts, id): el orden cronologico del
+ * indice idx_partido_fecha_ts, que incluye el id como desempate.
+ */
+#define SQL_FILAS_PARTIDO \
+    "SELECT p.id, p.fecha_ts, can.nombre, p.fecha_hora, p.goles, p.asistencias, c.nombre, p.resultado, p.clima, p.dia " \
+    SQL_TABLAS_PARTIDO
+
+/** Maximo de valores enlazables en la condicion de un filtro */
+#define MAX_VALORES_FILTRO 24
+
+/**
+ * @brief Condicion adicional de un listado paginado
+ */
+typedef struct
+{
+    const char *condicion;                  /**< Expresion SQL sobre p con ?, o NULL para todos */
+    int num_valores;                        /**< Cantidad de ? en la condicion */
+    long long valores[MAX_VALORES_FILTRO];  /**< Valores de los ? en orden */
+} FiltroPartidos;
+
+/**
+ * @brief Fila de un listado de partidos
+ */
+typedef struct
+{
+    int id;
+    int con_fecha;          /**< 0 si fecha_ts es NULL (fecha_hora no interpretable) */
+    long long fecha_ts;
+    char cancha[64];
+    char fecha[20];
+    int goles;
+    int asistencias;
+    char camiseta[64];
+    int resultado;
+    int clima;
+    int dia;
+} FilaPartido;
+
+/**
+ * @brief Copia una columna de texto tolerando NULL
+ */
+static void copiar_texto(sqlite3_stmt *stmt, int columna, char *destino, size_t tam)
+{
+    const char *texto = (const char *)sqlite3_column_text(stmt, columna);
+    snprintf(destino, tam, "%s", texto ? texto : "");
+}
+
+/**
+ * @brief Lee un tramo de filas contiguas en el orden del listado
+ *
+ * Los partidos con fecha_ts NULL no se pueden comparar por fecha, asi que
+ * forman un tramo aparte que va despues de todos los fechados (como en
+ * ORDER BY fecha_ts DESC) y se recorre solo por id. Cada consulta es un
+ * rango del indice que empieza en el cursor, por lo que su costo depende
+ * del limite y no del tamano de la tabla.
+ *
+ * @param filtro Condicion adicional
+ * @param sin_fecha 1 para el tramo con fecha_ts NULL, 0 para el fechado
+ * @param descendente 1 para avanzar hacia partidos mas antiguos
+ * @param cursor Ultima fila ya mostrada del mismo tramo, o NULL desde el extremo
+ * @param limite Maximo de filas a leer
+ * @param destino Arreglo de al menos limite filas
+ * @return Filas leidas, -1 en caso de error
+ */
+static int leer_tramo(const FiltroPartidos *filtro, int sin_fecha, int descendente,
+                      const FilaPartido *cursor, int limite, FilaPartido *destino)
+{
+    const char *rango;
+    const char *orden;
+    char sql[1536];
+    int n = 0;
+    int param = 1;
+
+    if (!sin_fecha)
+    {
+        rango = !cursor ? "p.fecha_ts IS NOT NULL" :
+                descendente ? "(p.fecha_ts, p.id) < (?, ?)" : "(p.fecha_ts, p.id) > (?, ?)";
+        orden = descendente ? "p.fecha_ts DESC, p.id DESC" : "p.fecha_ts, p.id";
+    }
+    else
+    {
+        rango = !cursor ? "p.fecha_ts IS NULL" :
+                descendente ? "p.fecha_ts IS NULL AND p.id < ?" : "p.fecha_ts IS NULL AND p.id > ?";
+        orden = descendente ? "p.id DESC" : "p.id";
+    }
+
+    snprintf(sql, sizeof(sql), "%s WHERE %s%s%s%s ORDER BY %s LIMIT ?",
+             SQL_FILAS_PARTIDO,
+             filtro->condicion ? "(" : "",
+             filtro->condicion ? filtro->condicion : "",
+             filtro->condicion ? ") AND " : "",
+             rango, orden);
+
+    sqlite3_stmt *stmt = db_prepare_cached(sql);
+    if (!stmt)
+        return -1;
+
+    for (int i = 0; i < filtro->num_valores; i++)
+        sqlite3_bind_int64(stmt, param++, filtro->valores[i]);
+    if (cursor && !sin_fecha)
+        sqlite3_bind_int64(stmt, param++, cursor->fecha_ts);
+    if (cursor)
+        sqlite3_bind_int(stmt, param++, cursor->id);
+    sqlite3_bind_int(stmt, param, limite);
+
+    int rc;
+    while (n < limite && (rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        FilaPartido *f = &destino[n++];
+        f->id = sqlite3_column_int(stmt, 0);
+        f->con_fecha = sqlite3_column_type(stmt, 1) != SQLITE_NULL;
+        f->fecha_ts = sqlite3_column_int64(stmt, 1);
+        copiar_texto(stmt, 2, f->cancha, sizeof(f->cancha));
+        copiar_texto(stmt, 3, f->fecha, sizeof(f->fecha));
+        f->goles = sqlite3_column_int(stmt, 4);
+        f->asistencias = sqlite3_column_int(stmt, 5);
+        copiar_texto(stmt, 6, f->camiseta, sizeof(f->camiseta));
+        f->resultado = sqlite3_column_int(stmt, 7);
+        f->clima = sqlite3_column_int(stmt, 8);
+        f->dia = sqlite3_column_int(stmt, 9);
+    }
+    if (n < limite && rc != SQLITE_DONE)
+        n = -1;
+
+    db_release_cached(stmt);
+    return n;
+}
+
+/**
+ * @brief Lee la pagina contigua a un cursor
+ *
+ * Hacia adelante (partidos mas antiguos) lee tam + 1 filas para saber si
+ * existe una pagina siguiente. Hacia atras lee tam filas en orden inverso
+ * y las devuelve ya en el orden del listado.
+ *
+ * @param filtro Condicion adicional
+ * @param cursor Ultima fila (adelante) o primera fila (atras) de la pagina actual; NULL para la primera pagina
+ * @param adelante 1 para la pagina siguiente, 0 para la anterior
+ * @param tam Filas por pagina
+ * @param filas Arreglo de al menos tam + 1 filas
+ * @return Filas leidas, -1 en caso de error
+ */
+static int leer_pagina(const FiltroPartidos *filtro, const FilaPartido *cursor, int adelante, int tam, FilaPartido *filas)
+{
+    int n = 0;
+    int r;
+
+    if (adelante)
+    {
+        int limite = tam + 1;
+
+        if (!cursor || cursor->con_fecha)
+        {
+            n = leer_tramo(filtro, 0, 1, cursor, limite, filas);
+            if (n < 0)
+                return -1;
+        }
+        if (n < limite)
+        {
+            r = leer_tramo(filtro, 1, 1, (cursor && !cursor->con_fecha) ? cursor : NULL, limite - n, filas + n);
+            if (r < 0)
+                return -1;
+            n += r;
+        }
+        return n;
+    }
+
+    if (!cursor->con_fecha)
+    {
+        n = leer_tramo(filtro, 1, 0, cursor, tam, filas);
+        if (n < 0)
+            return -1;
+        if (n < tam)
+        {
+            r = leer_tramo(filtro, 0, 0, NULL, tam - n, filas + n);
+            if (r < 0)
+                return -1;
+            n += r;
+        }
+    }
+    else
+    {
+        n = leer_tramo(filtro, 0, 0, cursor, tam, filas);
+        if (n < 0)
+            return -1;
+    }
+
+    for (int i = 0, j = n - 1; i < j; i++, j--)
+    {
+        FilaPartido t = filas[i];
+        filas[i] = filas[j];
+        filas[j] = t;
+    }
+    return n;
+}
+
+/**
+ * @brief Muestra un listado de partidos por paginas, del mas reciente al mas antiguo
+ *
+ * Solo se consulta la pagina visible. El tamano de pagina sale de la
+ * configuracion; si todo cabe en una pagina se comporta como un listado
+ * simple.
+ *
+ * @param titulo Encabezado que se repite al cambiar de pagina
+ * @param filtro Condicion adicional del listado
+ * @param vacio Mensaje si no hay partidos que mostrar
+ */
+static void paginar_partidos(const char *titulo, const FiltroPartidos *filtro, const char *vacio)
+{
+    int tam = settings_get()->tamano_pagina;
+    if (tam < TAMANO_PAGINA_MIN || tam > TAMANO_PAGINA_MAX)
+        tam = TAMANO_PAGINA_DEFECTO;
+
+    FilaPartido *filas = malloc(sizeof(FilaPartido) * (tam + 1));
+    if (!filas)
+    {
+        printf("Memoria insuficiente para el listado.\n");
+        return;
+    }
+
+    int pagina = 1;
+    int n = leer_pagina(filtro, NULL, 1, tam, filas);
+    int hay_siguiente = n > tam;
+
+    while (n >= 0)
+    {
+        if (hay_siguiente)
+            n = tam;
+
+        if (n == 0)
+        {
+            printf("%s\n", vacio);
+            pause_console();
+            break;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            const FilaPartido *f = &filas[i];
+            char fecha_formateada[20];
+
+            format_date_for_display(f->fecha, fecha_formateada, sizeof(fecha_formateada));
+            printf("%d |Cancha:%s |Fecha:%s | G:%d A:%d |Camiseta:%s | %s |Clima:%s |Dia:%s\n",
+                   f->id, f->cancha, fecha_formateada, f->goles, f->asistencias, f->camiseta,
+                   resultado_to_text(f->resultado), clima_to_text(f->clima), dia_to_text(f->dia));
+        }
+
+        if (pagina == 1 && !hay_siguiente)
+        {
+            pause_console();
+            break;
+        }
+
+        printf("\nPagina %d (%d partidos)\n", pagina, n);
+        if (hay_siguiente)
+            printf("1. Siguiente\n");
+        if (pagina > 1)
+            printf("2. Anterior\n");
+        printf("0. Salir\n");
+
+        int opcion = input_int("> ");
+        FilaPartido cursor;
+        int leidas;
+
+        if (opcion == 1 && hay_siguiente)
+        {
+            cursor = filas[n - 1];
+            leidas = leer_pagina(filtro, &cursor, 1, tam, filas);
+            if (leidas == 0)
+            {
+                // Se borraron las filas restantes mientras se mostraba la pagina
+                leidas = leer_pagina(filtro, NULL, 1, tam, filas);
+                pagina = 0;
+            }
+            n = leidas;
+            hay_siguiente = n > tam;
+            pagina++;
+        }
+        else if (opcion == 2 && pagina > 1)
+        {
+            pagina--;
+            if (pagina > 1)
+            {
+                cursor = filas[0];
+                n = leer_pagina(filtro, &cursor, 0, tam, filas);
+                hay_siguiente = 1;
+            }
+            if (pagina == 1 || (n >= 0 && n < tam))
+            {
+                // Al llegar al principio se relee la primera pagina completa
+                n = leer_pagina(filtro, NULL, 1, tam, filas);
+                hay_siguiente = n > tam;
+                pagina = 1;
+            }
+        }
+        else if (opcion == 0)
+        {
+            break;
+        }
+        else
+        {
+            printf("Opcion invalida.\n");
+            continue;
+        }
+
+        clear_screen();
+        print_header(titulo);
+    }
+
+    if (n < 0)
+        printf("Error al consultar los partidos: %s\n", sqlite3_errmsg(db));
+
+    free(filas);
+}
+
+/**
+ * @brief Muestra un listado de todos los partidos registrados
+ *
+ * Muestra los partidos del mas reciente al mas antiguo con sus datos: ID,
+ * cancha, fecha/hora, goles, asistencias, camiseta, resultado, clima y dia.
+ * El listado es paginado y solo consulta la pagina visible.
+ *
+ * @note Si no hay partidos registrados, muestra un mensaje informativo
+ */
+void listar_partidos()
+{
+    FiltroPartidos filtro = {NULL, 0, {0}};
+
+    clear_screen();
+    print_header("LISTADO DE PARTIDOS");
+
+    paginar_partidos("LISTADO DE PARTIDOS", &filtro, "No hay partidos cargados.");
+}
+
 /**
  * @brief Elimina un partido de la base de datos.
  *
@@ -386,6 +1044,13 @@ static void modificar_fecha_hora_partido()
     fgets(hora, sizeof(hora), stdin);
     hora[strcspn(hora, "\n")] = 0;
     sprintf(fecha_hora, "%s %s", fecha, hora);
+    // Se guarda normalizada: los triggers de fecha_ts solo leen dd/mm/yyyy hh:mm
+    if (!normalizar_fecha(fecha_hora, fecha_hora, sizeof(fecha_hora)))
+    {
+        printf("Fecha u hora invalida. No se modifico el partido.\n");
+        pause_console();
+        return;
+    }
     sqlite3_stmt *stmt;
     sqlite3_prepare_v2(db, "UPDATE partido SET fecha_hora=? WHERE id=?", -1, &stmt, NULL);
     sqlite3_bind_text(stmt, 1, fecha_hora, -1, SQLITE_TRANSIENT);
@@ -696,6 +1361,224 @@ void modificar_partido()
 
     ejecutar_menu("MODIFICAR PARTIDO", items, 11);
 }
+/**
+ * @brief Rango opcional de un criterio numerico de busqueda
+ */
+typedef struct
+{
+    int min;    /**< Limite inferior incluido, -1 sin limite */
+    int max;    /**< Limite superior incluido, -1 sin limite */
+} RangoBusqueda;
+
+/**
+ * @brief Criterios combinables de la busqueda de partidos
+ *
+ * Un criterio en 0 (o un rango en -1/-1) no filtra.
+ */
+typedef struct
+{
+    int con_desde;
+    long long desde;            /**< fecha_ts minima */
+    char desde_texto[20];
+    int con_hasta;
+    long long hasta;            /**< fecha_ts maxima */
+    char hasta_texto[20];
+    int cancha_id;
+    int camiseta_id;
+    int resultado;
+    int clima;
+    int dia;
+    RangoBusqueda goles;
+    RangoBusqueda asistencias;
+    RangoBusqueda rendimiento;
+    RangoBusqueda cansancio;
+    RangoBusqueda animo;
+} CriteriosBusqueda;
+
+/**
+ * @brief Criterio numerico por rango: nombre visible, columna y campo en CriteriosBusqueda
+ */
+typedef struct
+{
+    const char *nombre;
+    const char *columna;
+    size_t campo;
+} CampoRango;
+
+#define RANGO(nombre, columna, miembro) {nombre, columna, offsetof(CriteriosBusqueda, miembro)}
+
+/** Criterios por rango, en el orden del menu de busqueda */
+static const CampoRango CAMPOS_RANGO[] =
+{
+    RANGO("Goles", "p.goles", goles),
+    RANGO("Asistencias", "p.asistencias", asistencias),
+    RANGO("Rendimiento", "p.rendimiento_general", rendimiento),
+    RANGO("Cansancio", "p.cansancio", cansancio),
+    RANGO("Estado de animo", "p.estado_animo", animo),
+};
+
+#define NUM_CAMPOS_RANGO (int)(sizeof(CAMPOS_RANGO) / sizeof(CAMPOS_RANGO[0]))
+
+/**
+ * @brief Devuelve el rango de un criterio numerico
+ */
+static RangoBusqueda *rango_de(CriteriosBusqueda *c, int i)
+{
+    return (RangoBusqueda *)((char *)c + CAMPOS_RANGO[i].campo);
+}
+
+/**
+ * @brief Deja todos los criterios sin filtrar
+ */
+static void limpiar_criterios(CriteriosBusqueda *c)
+{
+    memset(c, 0, sizeof(*c));
+    for (int i = 0; i < NUM_CAMPOS_RANGO; i++)
+    {
+        rango_de(c, i)->min = -1;
+        rango_de(c, i)->max = -1;
+    }
+}
+
+/**
+ * @brief Agrega una condicion con sus valores al filtro en construccion
+ */
+static void agregar_condicion(FiltroPartidos *filtro, char *sql, size_t tam, const char *condicion,
+                              int num_valores, long long v1, long long v2)
+{
+    size_t n = strlen(sql);
+
+    if (filtro->num_valores + num_valores > MAX_VALORES_FILTRO)
+        return;
+    snprintf(sql + n, tam - n, "%s%s", n > 0 ? " AND " : "", condicion);
+    if (num_valores > 0)
+        filtro->valores[filtro->num_valores++] = v1;
+    if (num_valores > 1)
+        filtro->valores[filtro->num_valores++] = v2;
+}
+
+/**
+ * @brief Construye una unica condicion parametrizada a partir de los criterios
+ *
+ * Las columnas se comparan sin funciones para que sigan siendo indexables y
+ * las fechas se filtran por fecha_ts, no por el texto fecha_hora. El orden
+ * de las condiciones no cambia el plan, SQLite elige el indice: con camiseta
+ * o cancha usa idx_partido_camiseta_fecha o idx_partido_cancha_fecha
+ * (igualdad mas rango de fechas), con ambas el de cancha, y sin ninguna
+ * idx_partido_fecha_ts. El resto de los criterios se evalua sobre las filas
+ * que devuelve el indice. migraciones_verificar_planes() vigila estos casos.
+ *
+ * @param c Criterios de busqueda
+ * @param filtro Filtro resultante; su condicion apunta a sql
+ * @param sql Buffer para el texto de la condicion
+ * @param tam Tamano del buffer
+ */
+static void construir_filtro(CriteriosBusqueda *c, FiltroPartidos *filtro, char *sql, size_t tam)
+{
+    sql[0] = '\0';
+    filtro->num_valores = 0;
+
+    if (c->camiseta_id > 0)
+        agregar_condicion(filtro, sql, tam, "p.camiseta_id = ?", 1, c->camiseta_id, 0);
+    if (c->cancha_id > 0)
+        agregar_condicion(filtro, sql, tam, "p.cancha_id = ?", 1, c->cancha_id, 0);
+
+    if (c->con_desde && c->con_hasta)
+        agregar_condicion(filtro, sql, tam, "p.fecha_ts BETWEEN ? AND ?", 2, c->desde, c->hasta);
+    else if (c->con_desde)
+        agregar_condicion(filtro, sql, tam, "p.fecha_ts >= ?", 1, c->desde, 0);
+    else if (c->con_hasta)
+        agregar_condicion(filtro, sql, tam, "p.fecha_ts <= ?", 1, c->hasta, 0);
+
+    if (c->resultado > 0)
+        agregar_condicion(filtro, sql, tam, "p.resultado = ?", 1, c->resultado, 0);
+    if (c->clima > 0)
+        agregar_condicion(filtro, sql, tam, "p.clima = ?", 1, c->clima, 0);
+    if (c->dia > 0)
+        agregar_condicion(filtro, sql, tam, "p.dia = ?", 1, c->dia, 0);
+
+    for (int i = 0; i < NUM_CAMPOS_RANGO; i++)
+    {
+        const RangoBusqueda *r = rango_de(c, i);
+        char condicion[96];
+
+        if (r->min >= 0 && r->max >= 0)
+        {
+            snprintf(condicion, sizeof(condicion), r->min == r->max ? "%s = ?" : "%s BETWEEN ? AND ?", CAMPOS_RANGO[i].columna);
+            agregar_condicion(filtro, sql, tam, condicion, r->min == r->max ? 1 : 2, r->min, r->max);
+        }
+        else if (r->min >= 0)
+        {
+            snprintf(condicion, sizeof(condicion), "%s >= ?", CAMPOS_RANGO[i].columna);
+            agregar_condicion(filtro, sql, tam, condicion, 1, r->min, 0);
+        }
+        else if (r->max >= 0)
+        {
+            snprintf(condicion, sizeof(condicion), "%s <= ?", CAMPOS_RANGO[i].columna);
+            agregar_condicion(filtro, sql, tam, condicion, 1, r->max, 0);
+        }
+    }
+
+    filtro->condicion = sql[0] ? sql : NULL;
+}
+
+/**
+ * @brief Cuenta los partidos que cumplen un filtro
+ *
+ * @return Cantidad de partidos, -1 en caso de error
+ */
+static int contar_partidos(const FiltroPartidos *filtro)
+{
+    char sql[1536];
+    int total = -1;
+
+    snprintf(sql, sizeof(sql), "SELECT COUNT(*) " SQL_TABLAS_PARTIDO "%s%s",
+             filtro->condicion ? " WHERE " : "",
+             filtro->condicion ? filtro->condicion : "");
+
+    sqlite3_stmt *stmt = db_prepare_cached(sql);
+    if (!stmt)
+        return -1;
+    for (int i = 0; i < filtro->num_valores; i++)
+        sqlite3_bind_int64(stmt, i + 1, filtro->valores[i]);
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        total = sqlite3_column_int(stmt, 0);
+    db_release_cached(stmt);
+    return total;
+}
+
+/**
+ * @brief Ejecuta una busqueda: informa cuantos partidos coinciden y los pagina
+ *
+ * @param titulo Encabezado del listado
+ * @param c Criterios de busqueda
+ * @param vacio Mensaje si ningun partido coincide
+ */
+static void ejecutar_busqueda(const char *titulo, CriteriosBusqueda *c, const char *vacio)
+{
+    FiltroPartidos filtro;
+    char sql[1024];
+
+    construir_filtro(c, &filtro, sql, sizeof(sql));
+
+    int total = contar_partidos(&filtro);
+    if (total < 0)
+    {
+        printf("Error al contar los partidos: %s\n", sqlite3_errmsg(db));
+        pause_console();
+        return;
+    }
+    if (total == 0)
+    {
+        printf("%s\n", vacio);
+        pause_console();
+        return;
+    }
+
+    printf("Partidos encontrados: %d\n\n", total);
+    paginar_partidos(titulo, &filtro, vacio);
+}
+
 /**
  * @brief Busca partidos por camiseta utilizada
  *
@@ -703,6 +1586,8 @@ void modificar_partido()
  */
 static void buscar_por_camiseta()
 {
+    CriteriosBusqueda c;
+
     print_header("BUSCAR PARTIDOS POR CAMISETA");
 
     listar_camisetas();
@@ -714,37 +1599,9 @@ static void buscar_por_camiseta()
         return;
     }
 
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT p.id, can.nombre, fecha_hora, goles, asistencias, c.nombre, resultado, clima, dia "
-                       "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id "
-                       "JOIN cancha can ON p.cancha_id = can.id "
-                       "WHERE p.camiseta_id = ?",
-                       -1, &stmt, NULL);
-
-    sqlite3_bind_int(stmt, 1, camiseta_id);
-
-    int hay = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        printf("%d | %s | %s | G:%d A:%d | %s | %s | %s | %s\n",
-               sqlite3_column_int(stmt, 0),
-               sqlite3_column_text(stmt, 1),
-               sqlite3_column_text(stmt, 2),
-               sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4),
-               sqlite3_column_text(stmt, 5),
-               resultado_to_text(sqlite3_column_int(stmt, 6)),
-               clima_to_text(sqlite3_column_int(stmt, 7)),
-               dia_to_text(sqlite3_column_int(stmt, 8)));
-        hay = 1;
-    }
-
-    if (!hay)
-        printf("No se encontraron partidos con esa camiseta.\n");
-
-    sqlite3_finalize(stmt);
-    pause_console();
+    limpiar_criterios(&c);
+    c.camiseta_id = camiseta_id;
+    ejecutar_busqueda("BUSCAR PARTIDOS POR CAMISETA", &c, "No se encontraron partidos con esa camiseta.");
 }
 
 /**
@@ -754,41 +1611,25 @@ static void buscar_por_camiseta()
  */
 static void buscar_por_goles()
 {
+    CriteriosBusqueda c;
+    char vacio[64];
+
     print_header("BUSCAR PARTIDOS POR GOLES");
 
     int goles = input_int("Número de goles: ");
 
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT p.id, can.nombre, fecha_hora, goles, asistencias, c.nombre, resultado, clima, dia "
-                       "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id "
-                       "JOIN cancha can ON p.cancha_id = can.id "
-                       "WHERE p.goles = ?",
-                       -1, &stmt, NULL);
-
-    sqlite3_bind_int(stmt, 1, goles);
-
-    int hay = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    snprintf(vacio, sizeof(vacio), "No se encontraron partidos con %d goles.", goles);
+    if (goles < 0)
     {
-        printf("%d | %s | %s | G:%d A:%d | %s | %s | %s | %s\n",
-               sqlite3_column_int(stmt, 0),
-               sqlite3_column_text(stmt, 1),
-               sqlite3_column_text(stmt, 2),
-               sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4),
-               sqlite3_column_text(stmt, 5),
-               resultado_to_text(sqlite3_column_int(stmt, 6)),
-               clima_to_text(sqlite3_column_int(stmt, 7)),
-               dia_to_text(sqlite3_column_int(stmt, 8)));
-        hay = 1;
+        printf("%s\n", vacio);
+        pause_console();
+        return;
     }
 
-    if (!hay)
-        printf("No se encontraron partidos con %d goles.\n", goles);
-
-    sqlite3_finalize(stmt);
-    pause_console();
+    limpiar_criterios(&c);
+    c.goles.min = goles;
+    c.goles.max = goles;
+    ejecutar_busqueda("BUSCAR PARTIDOS POR GOLES", &c, vacio);
 }
 
 /**
@@ -798,41 +1639,25 @@ static void buscar_por_goles()
  */
 static void buscar_por_asistencias()
 {
+    CriteriosBusqueda c;
+    char vacio[64];
+
     print_header("BUSCAR PARTIDOS POR ASISTENCIAS");
 
     int asistencias = input_int("Número de asistencias: ");
 
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT p.id, can.nombre, fecha_hora, goles, asistencias, c.nombre, resultado, clima, dia "
-                       "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id "
-                       "JOIN cancha can ON p.cancha_id = can.id "
-                       "WHERE p.asistencias = ?",
-                       -1, &stmt, NULL);
-
-    sqlite3_bind_int(stmt, 1, asistencias);
-
-    int hay = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    snprintf(vacio, sizeof(vacio), "No se encontraron partidos con %d asistencias.", asistencias);
+    if (asistencias < 0)
     {
-        printf("%d | %s | %s | G:%d A:%d | %s | %s | %s | %s\n",
-               sqlite3_column_int(stmt, 0),
-               sqlite3_column_text(stmt, 1),
-               sqlite3_column_text(stmt, 2),
-               sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4),
-               sqlite3_column_text(stmt, 5),
-               resultado_to_text(sqlite3_column_int(stmt, 6)),
-               clima_to_text(sqlite3_column_int(stmt, 7)),
-               dia_to_text(sqlite3_column_int(stmt, 8)));
-        hay = 1;
+        printf("%s\n", vacio);
+        pause_console();
+        return;
     }
 
-    if (!hay)
-        printf("No se encontraron partidos con %d asistencias.\n", asistencias);
-
-    sqlite3_finalize(stmt);
-    pause_console();
+    limpiar_criterios(&c);
+    c.asistencias.min = asistencias;
+    c.asistencias.max = asistencias;
+    ejecutar_busqueda("BUSCAR PARTIDOS POR ASISTENCIAS", &c, vacio);
 }
 
 /**
@@ -842,18 +1667,11 @@ static void buscar_por_asistencias()
  */
 static void buscar_por_cancha()
 {
-    print_header("BUSCAR PARTIDOS POR CANCHA");
+    CriteriosBusqueda c;
 
-    // Listar canchas disponibles
-    printf("Canchas disponibles:\n");
-    sqlite3_stmt *stmt_canchas;
-    sqlite3_prepare_v2(db, "SELECT id, nombre FROM cancha ORDER BY id", -1, &stmt_canchas, NULL);
-    while (sqlite3_step(stmt_canchas) == SQLITE_ROW)
-    {
-        printf("%d | %s\n", sqlite3_column_int(stmt_canchas, 0), sqlite3_column_text(stmt_canchas, 1));
-    }
-    sqlite3_finalize(stmt_canchas);
+    print_header("BUSCAR PARTIDOS POR CANCHA");
 
+    listar_canchas_disponibles();
     int cancha_id = input_int("ID de la cancha: ");
 
     if (!existe_id("cancha", cancha_id))
@@ -862,36 +1680,261 @@ static void buscar_por_cancha()
         return;
     }
 
-    sqlite3_stmt *stmt;
-    sqlite3_prepare_v2(db,
-                       "SELECT p.id, can.nombre, fecha_hora, goles, asistencias, c.nombre, resultado, clima, dia "
-                       "FROM partido p JOIN camiseta c ON p.camiseta_id = c.id "
-                       "JOIN cancha can ON p.cancha_id = can.id "
-                       "WHERE p.cancha_id = ?",
-                       -1, &stmt, NULL);
+    limpiar_criterios(&c);
+    c.cancha_id = cancha_id;
+    ejecutar_busqueda("BUSCAR PARTIDOS POR CANCHA", &c, "No se encontraron partidos en esa cancha.");
+}
 
-    sqlite3_bind_int(stmt, 1, cancha_id);
+/**
+ * @brief Pide una fecha limite para la busqueda
+ *
+ * La fecha y la hora se piden por separado porque input_date() no admite
+ * el espacio entre ambas. Una fecha sin hora cubre el dia completo: como
+ * limite inferior empieza a las 00:00 y como limite superior termina a
+ * las 23:59.
+ *
+ * @param msg Texto del pedido de la fecha
+ * @param hasta 1 si es el limite superior del rango
+ * @param activo Destino: 1 si se ingreso una fecha valida
+ * @param ts Destino de la marca fecha_ts
+ * @param texto Destino del limite como "dd/mm/yyyy hh:mm", para mostrarlo (20 bytes)
+ */
+static void pedir_fecha_busqueda(const char *msg, int hasta, int *activo, long long *ts, char *texto)
+{
+    char fecha[20], hora[10], fecha_hora[30];
+
+    input_date(msg, fecha, sizeof(fecha));
+    *activo = 0;
+    texto[0] = '\0';
+    if (fecha[0] == '\0')
+        return;
 
-    int hay = 0;
-    while (sqlite3_step(stmt) == SQLITE_ROW)
+    input_date(hasta ? "Hora (hh:mm, vacio = 23:59): " : "Hora (hh:mm, vacio = 00:00): ", hora, sizeof(hora));
+    if (hora[0] != '\0')
+        snprintf(fecha_hora, sizeof(fecha_hora), "%s %s", fecha, hora);
+    else
+        snprintf(fecha_hora, sizeof(fecha_hora), "%s", fecha);
+
+    if (!normalizar_fecha(fecha_hora, fecha_hora, sizeof(fecha_hora)) || !fecha_a_epoch(fecha_hora, ts))
     {
-        printf("%d | %s | %s | G:%d A:%d | %s | %s | %s | %s\n",
-               sqlite3_column_int(stmt, 0),
-               sqlite3_column_text(stmt, 1),
-               sqlite3_column_text(stmt, 2),
-               sqlite3_column_int(stmt, 3),
-               sqlite3_column_int(stmt, 4),
-               sqlite3_column_text(stmt, 5),
-               resultado_to_text(sqlite3_column_int(stmt, 6)),
-               clima_to_text(sqlite3_column_int(stmt, 7)),
-               dia_to_text(sqlite3_column_int(stmt, 8)));
-        hay = 1;
+        printf("Fecha u hora invalida, se ignora (fecha dd/mm/yyyy, hora hh:mm).\n");
+        pause_console();
+        return;
     }
+    if (hasta && hora[0] == '\0')
+        *ts += 86400 - 60;
+    *activo = 1;
+    formatear_epoch(*ts, texto, 20);
+}
 
-    if (!hay)
-        printf("No se encontraron partidos en esa cancha.\n");
+/**
+ * @brief Pide un codigo entre 1 y max, o 0 para no filtrar
+ */
+static int pedir_codigo_busqueda(const char *msg, int max)
+{
+    int v = input_int(msg);
+    while (v < 0 || v > max)
+        v = input_int("Valor invalido, reintente (0 para cualquiera): ");
+    return v;
+}
 
-    sqlite3_finalize(stmt);
+/**
+ * @brief Muestra los criterios activos de la busqueda combinada
+ */
+static void mostrar_criterios(CriteriosBusqueda *c)
+{
+    int activos = 0;
+
+    printf("Criterios activos:\n");
+    if (c->con_desde || c->con_hasta)
+    {
+        printf("  Fechas: %s - %s\n", c->con_desde ? c->desde_texto : "...", c->con_hasta ? c->hasta_texto : "...");
+        activos++;
+    }
+    if (c->cancha_id > 0)
+    {
+        printf("  Cancha: %d\n", c->cancha_id);
+        activos++;
+    }
+    if (c->camiseta_id > 0)
+    {
+        printf("  Camiseta: %d\n", c->camiseta_id);
+        activos++;
+    }
+    if (c->resultado > 0)
+    {
+        printf("  Resultado: %s\n", resultado_to_text(c->resultado));
+        activos++;
+    }
+    if (c->clima > 0)
+    {
+        printf("  Clima: %s\n", clima_to_text(c->clima));
+        activos++;
+    }
+    if (c->dia > 0)
+    {
+        printf("  Dia: %s\n", dia_to_text(c->dia));
+        activos++;
+    }
+    for (int i = 0; i < NUM_CAMPOS_RANGO; i++)
+    {
+        const RangoBusqueda *r = rango_de(c, i);
+        if (r->min < 0 && r->max < 0)
+            continue;
+        printf("  %s: ", CAMPOS_RANGO[i].nombre);
+        if (r->min >= 0)
+            printf("%d", r->min);
+        printf(" - ");
+        if (r->max >= 0)
+            printf("%d", r->max);
+        printf("\n");
+        activos++;
+    }
+    if (activos == 0)
+        printf("  (ninguno: se muestran todos los partidos)\n");
+    printf("\n");
+}
+
+/**
+ * @brief Busqueda de partidos combinando cualquier cantidad de criterios
+ *
+ * Los criterios se van definiendo en un formulario y la busqueda arma una
+ * sola consulta parametrizada con todos ellos, informa cuantos partidos
+ * coinciden y los muestra con el listado paginado.
+ */
+static void buscar_combinada()
+{
+    CriteriosBusqueda c;
+    int opcion;
+
+    limpiar_criterios(&c);
+    do
+    {
+        clear_screen();
+        print_header("BUSQUEDA COMBINADA");
+        mostrar_criterios(&c);
+
+        printf("1. Rango de fechas\n");
+        printf("2. Cancha\n");
+        printf("3. Camiseta\n");
+        printf("4. Resultado\n");
+        printf("5. Clima\n");
+        printf("6. Momento del dia\n");
+        for (int i = 0; i < NUM_CAMPOS_RANGO; i++)
+            printf("%d. %s (rango)\n", 7 + i, CAMPOS_RANGO[i].nombre);
+        printf("%d. Buscar\n", 7 + NUM_CAMPOS_RANGO);
+        printf("%d. Limpiar criterios\n", 8 + NUM_CAMPOS_RANGO);
+        printf("0. Volver\n");
+
+        opcion = input_int("> ");
+
+        if (opcion == 1)
+        {
+            pedir_fecha_busqueda("Desde (dd/mm/yyyy, vacio sin limite): ", 0, &c.con_desde, &c.desde, c.desde_texto);
+            pedir_fecha_busqueda("Hasta (dd/mm/yyyy, vacio sin limite): ", 1, &c.con_hasta, &c.hasta, c.hasta_texto);
+        }
+        else if (opcion == 2)
+        {
+            listar_canchas_disponibles();
+            c.cancha_id = input_int("ID de la cancha (0 para cualquiera): ");
+            if (c.cancha_id < 0)
+                c.cancha_id = 0;
+        }
+        else if (opcion == 3)
+        {
+            listar_camisetas();
+            c.camiseta_id = input_int("ID de la camiseta (0 para cualquiera): ");
+            if (c.camiseta_id < 0)
+                c.camiseta_id = 0;
+        }
+        else if (opcion == 4)
+        {
+            c.resultado = pedir_codigo_busqueda("Resultado (1=VICTORIA, 2=EMPATE, 3=DERROTA, 0=cualquiera): ", 3);
+        }
+        else if (opcion == 5)
+        {
+            c.clima = pedir_codigo_busqueda("Clima (1=Despejado, 2=Nublado, 3=Lluvia, 4=Ventoso, 5=Mucho Calor, 6=Mucho Frio, 0=cualquiera): ", 6);
+        }
+        else if (opcion == 6)
+        {
+            c.dia = pedir_codigo_busqueda("Dia (1=Dia, 2=Tarde, 3=Noche, 0=cualquiera): ", 3);
+        }
+        else if (opcion >= 7 && opcion < 7 + NUM_CAMPOS_RANGO)
+        {
+            RangoBusqueda *r = rango_de(&c, opcion - 7);
+            r->min = input_int("Minimo (-1 sin limite): ");
+            r->max = input_int("Maximo (-1 sin limite): ");
+            if (r->min < 0)
+                r->min = -1;
+            if (r->max < 0)
+                r->max = -1;
+            if (r->min >= 0 && r->max >= 0 && r->min > r->max)
+            {
+                int t = r->min;
+                r->min = r->max;
+                r->max = t;
+            }
+        }
+        else if (opcion == 7 + NUM_CAMPOS_RANGO)
+        {
+            clear_screen();
+            print_header("BUSQUEDA COMBINADA");
+            ejecutar_busqueda("BUSQUEDA COMBINADA", &c, "No se encontraron partidos con esos criterios.");
+        }
+        else if (opcion == 8 + NUM_CAMPOS_RANGO)
+        {
+            limpiar_criterios(&c);
+        }
+        else if (opcion != 0)
+        {
+            printf("Opcion invalida.\n");
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+}
+
+/**
+ * @brief Imprime un partido encontrado por comentario con su fragmento resaltado
+ */
+static void imprimir_partido_fts(sqlite3_stmt *stmt)
+{
+    printf("%d |Cancha:%s |Fecha:%s | G:%d A:%d |Camiseta:%s | %s\n    %s\n",
+           sqlite3_column_int(stmt, 0),
+           sqlite3_column_text(stmt, 1),
+           sqlite3_column_text(stmt, 2),
+           sqlite3_column_int(stmt, 3),
+           sqlite3_column_int(stmt, 4),
+           sqlite3_column_text(stmt, 5),
+           resultado_to_text(sqlite3_column_int(stmt, 6)),
+           sqlite3_column_text(stmt, 7));
+}
+
+/**
+ * @brief Busca partidos por palabras de su comentario personal
+ *
+ * Usa el indice FTS5 partido_fts y ordena por relevancia (bm25), mostrando
+ * los partidos mas relevantes hasta el tamano de pagina configurado.
+ */
+static void buscar_por_comentario()
+{
+    char texto[256];
+    char consulta[768];
+
+    print_header("BUSCAR PARTIDOS POR COMENTARIO");
+
+    input_string("Palabras a buscar: ", texto, sizeof(texto));
+    if (texto_a_consulta_fts(texto, consulta, sizeof(consulta)) == 0)
+        printf("No se ingresaron palabras para buscar.\n");
+    else
+        mostrar_busqueda_fts("partido_fts",
+                             "SELECT p.id, can.nombre, p.fecha_hora, p.goles, p.asistencias, c.nombre, p.resultado, "
+                             "snippet(partido_fts, 0, '[', ']', '...', 12) "
+                             "FROM partido_fts JOIN partido p ON p.id = partido_fts.rowid "
+                             "JOIN camiseta c ON p.camiseta_id = c.id "
+                             "JOIN cancha can ON p.cancha_id = can.id",
+                             consulta, imprimir_partido_fts,
+                             "No se encontraron partidos con esas palabras.", "los");
     pause_console();
 }
 
@@ -903,6 +1946,10 @@ static void buscar_por_cancha()
  * - Número de goles
  * - Número de asistencias
  * - Cancha donde se jugó
+ * - Palabras del comentario personal
+ * - Cualquier combinacion de fechas, cancha, camiseta, resultado, clima,
+ *   momento del dia y rangos de goles, asistencias, rendimiento,
+ *   cansancio y estado de animo
  */
 void buscar_partidos()
 {
@@ -912,10 +1959,12 @@ void buscar_partidos()
         {2, "Por Goles", buscar_por_goles},
         {3, "Por Asistencias", buscar_por_asistencias},
         {4, "Por Cancha", buscar_por_cancha},
+        {5, "Por Texto del Comentario", buscar_por_comentario},
+        {6, "Combinada (varios criterios)", buscar_combinada},
         {0, "Volver", NULL}
     };
 
-    ejecutar_menu("BUSQUEDA DE PARTIDOS", items, 5);
+    ejecutar_menu("BUSQUEDA DE PARTIDOS", items, 7);
 }
 
 /**
@@ -1039,7 +2088,7 @@ static void guardar_resultados_simulacion(Equipo *equipo_local, Equipo *equipo_v
             // Buscar o crear camiseta para este jugador
             int camiseta_id = 1; // Usar camiseta por defecto
 
-            int partido_id = obtener_siguiente_id_partido();
+            int partido_id = db_siguiente_id("partido");
             insertar_partido(partido_id, cancha_id, fecha_simulacion,
                              estadisticas_local[i], asistencias_local[i],
                              camiseta_id, resultado_local, 8, 5, 7,
@@ -1055,7 +2104,7 @@ static void guardar_resultados_simulacion(Equipo *equipo_local, Equipo *equipo_v
             // Buscar o crear camiseta para este jugador
             int camiseta_id = 1; // Usar camiseta por defecto
 
-            int partido_id = obtener_siguiente_id_partido();
+            int partido_id = db_siguiente_id("partido");
             insertar_partido(partido_id, cancha_id, fecha_simulacion,
                              estadisticas_visitante[i], asistencias_visitante[i],
                              camiseta_id, resultado_visitante, 8, 5, 7,
@@ -1339,7 +2388,8 @@ void simular_partido_guardados()
  * @brief Muestra el menú principal de gestión de partidos
  *
  * Presenta un menú interactivo con opciones para crear, listar, modificar,
- * eliminar partidos y simular partidos con equipos guardados.
+ * eliminar, buscar y cargar en lote partidos y simular partidos con
+ * equipos guardados.
  * Utiliza la función ejecutar_menu para manejar la navegación del menú
  * y delega las operaciones a las funciones correspondientes.
  */
@@ -1352,8 +2402,10 @@ void menu_partidos()
         {3, "Modificar", modificar_partido},
         {4, "Eliminar", eliminar_partido},
         {5, "Simular con Equipos Guardados", simular_partido_guardados},
+        {6, "Buscar", buscar_partidos},
+        {7, "Carga Masiva", carga_masiva_partidos},
         {0, "Volver", NULL}
     };
 
-    ejecutar_menu("PARTIDOS", items, 6);
+    ejecutar_menu("PARTIDOS", items, 8);
 }
@@ -26,6 +26,15 @@ void menu_partidos();
  */
 void crear_partido();
 
+/**
+ * @brief Carga varios partidos seguidos y los guarda en una sola transaccion
+ *
+ * Los partidos se ingresan uno por uno (con fecha) o se pegan como lineas
+ * separadas por coma o tabulador. El lote se revisa antes de guardarlo y
+ * se confirma completo o no se guarda nada.
+ */
+void carga_masiva_partidos();
+
 /**
  * @brief Muestra un listado de todos los partidos registrados
  *
@@ -65,5 +74,7 @@ void modificar_partido();
  * - Número de goles
  * - Número de asistencias
  * - Cancha donde se jugó
+ * - Palabras del comentario personal
+ * - Cualquier combinacion de esos y otros criterios en una sola consulta
  */
 void buscar_partidos();
@@ -0,0 +1,478 @@
+/**
+ * @file partido_store.c
+ * @brief Copia en memoria por columnas de la tabla partido
+ *
+ * Ver partido_store.h. La carga es una unica consulta ordenada por el
+ * indice de fecha_ts; despues los modulos de analisis recorren arreglos
+ * de enteros sin volver a SQLite mientras la tabla no cambie. Cuando
+ * cambian pocos partidos, el registro de cambios dice cuales y solo esas
+ * filas se releen y se recolocan en su posicion cronologica.
+ */
+
+#include "partido_store.h"
+#include "db.h"
+#include "cambios.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Copia actual; sus arreglos crecen con la tabla y se reutilizan entre cargas */
+static PartidoStore store;
+
+/** Numero de partidos que caben en los arreglos reservados */
+static int capacidad = 0;
+
+/** Conexion sobre la que se cargo la copia y se instalo el update hook */
+static sqlite3 *conexion = NULL;
+
+/** 1 si la copia refleja el contenido actual de partido */
+static int valida = 0;
+
+/** PRAGMA data_version leido antes de la ultima carga */
+static long long version_datos = 0;
+
+/** Ultima secuencia del registro de cambios reflejada en la copia; -1 si se desconoce */
+static long long marca_cambios = -1;
+
+/** Ultima generacion asignada; sobrevive a partido_store_liberar() para no repetir valores */
+static unsigned long long generacion = 0;
+
+/** 1 si la copia se leyo dentro de una transaccion que aun podia revertirse */
+static int cargada_en_transaccion = 0;
+
+/** Partidos distintos que se actualizan en sitio; con mas cambios se recarga todo */
+#define MAX_CAMBIOS_EN_SITIO 64
+
+/** Numero de columnas enteras de PartidoStore */
+#define NUM_COLUMNAS_ENTERAS 14
+
+/** Columnas que lee leer_fila(), en su orden */
+#define SQL_COLUMNAS_STORE "id, fecha_ts, cancha_id, camiseta_id, goles, asistencias, resultado, " \
+                           "clima, dia, rendimiento_general, cansancio, estado_animo"
+
+/**
+ * @brief IDs de partido con cambios pendientes de aplicar a la copia
+ */
+typedef struct
+{
+    int ids[MAX_CAMBIOS_EN_SITIO];
+    int n;
+    int excedido;   /**< 1 si hubo mas de MAX_CAMBIOS_EN_SITIO partidos distintos */
+} CambiosPendientes;
+
+/**
+ * @brief Update hook: cualquier cambio en partido invalida la copia
+ */
+static void hook_cambio(void *arg, int operacion, const char *base, const char *tabla, sqlite3_int64 rowid)
+{
+    (void)arg;
+    (void)operacion;
+    (void)base;
+    (void)rowid;
+
+    if (strcmp(tabla, "partido") == 0)
+        valida = 0;
+}
+
+/**
+ * @brief Lee PRAGMA data_version de la conexion global
+ *
+ * Cambia cuando otra conexion confirma escrituras sobre el mismo archivo.
+ *
+ * @param version Destino del valor leido
+ * @return 1 si exito, 0 en caso de error
+ */
+static int leer_version_datos(long long *version)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("PRAGMA data_version");
+    int ok = 0;
+
+    if (!stmt)
+        return 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        *version = sqlite3_column_int64(stmt, 0);
+        ok = 1;
+    }
+    db_release_cached(stmt);
+    return ok;
+}
+
+/**
+ * @brief Descompone una marca fecha_ts en anio, mes y dia de la semana
+ *
+ * Inversa del calculo de fecha_a_epoch(); coincide con
+ * strftime('%Y' / '%m' / '%w', fecha_ts, 'unixepoch').
+ */
+static void descomponer_fecha(long long ts, int *anio, int *mes, int *dia_semana)
+{
+    long long dias = ts >= 0 ? ts / 86400 : -((-ts + 86399) / 86400);
+    long long semana = (dias + 4) % 7; // 1970-01-01 fue jueves
+
+    if (semana < 0)
+        semana += 7;
+
+    long long z = dias + 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    long long m = mp < 10 ? mp + 3 : mp - 9;
+
+    *anio = (int)(yoe + era * 400 + (m <= 2));
+    *mes = (int)m;
+    *dia_semana = (int)semana;
+}
+
+/**
+ * @brief Obtiene las direcciones de los punteros de todas las columnas enteras
+ *
+ * @param columnas Destino con NUM_COLUMNAS_ENTERAS posiciones
+ */
+static void columnas_enteras(int **columnas[NUM_COLUMNAS_ENTERAS])
+{
+    int **todas[NUM_COLUMNAS_ENTERAS] =
+    {
+        &store.id, &store.cancha_id, &store.camiseta_id, &store.goles,
+        &store.asistencias, &store.resultado, &store.clima, &store.dia,
+        &store.rendimiento, &store.cansancio, &store.animo, &store.anio,
+        &store.mes, &store.dia_semana
+    };
+
+    memcpy(columnas, todas, sizeof(todas));
+}
+
+/**
+ * @brief Asegura espacio para al menos total partidos en todas las columnas
+ *
+ * @return 1 si exito, 0 si falta memoria
+ */
+static int reservar(int total)
+{
+    int **columnas[NUM_COLUMNAS_ENTERAS];
+    int nueva = capacidad > 0 ? capacidad : 256;
+
+    if (total <= capacidad)
+        return 1;
+    while (nueva < total)
+        nueva *= 2;
+
+    columnas_enteras(columnas);
+    for (int i = 0; i < NUM_COLUMNAS_ENTERAS; i++)
+    {
+        int *p = realloc(*columnas[i], sizeof(int) * nueva);
+        if (!p)
+            return 0;
+        *columnas[i] = p;
+    }
+    long long *ts = realloc(store.fecha_ts, sizeof(long long) * nueva);
+    if (!ts)
+        return 0;
+    store.fecha_ts = ts;
+
+    capacidad = nueva;
+    return 1;
+}
+
+/**
+ * @brief Copia la fila actual de una consulta sobre SQL_COLUMNAS_STORE en la posicion i
+ */
+static void leer_fila(sqlite3_stmt *stmt, int i)
+{
+    store.id[i] = sqlite3_column_int(stmt, 0);
+    if (sqlite3_column_type(stmt, 1) == SQLITE_NULL)
+    {
+        store.fecha_ts[i] = 0;
+        store.anio[i] = 0;
+        store.mes[i] = 0;
+        store.dia_semana[i] = -1;
+    }
+    else
+    {
+        store.fecha_ts[i] = sqlite3_column_int64(stmt, 1);
+        descomponer_fecha(store.fecha_ts[i], &store.anio[i], &store.mes[i], &store.dia_semana[i]);
+    }
+    store.cancha_id[i] = sqlite3_column_int(stmt, 2);
+    store.camiseta_id[i] = sqlite3_column_int(stmt, 3);
+    store.goles[i] = sqlite3_column_int(stmt, 4);
+    store.asistencias[i] = sqlite3_column_int(stmt, 5);
+    store.resultado[i] = sqlite3_column_int(stmt, 6);
+    store.clima[i] = sqlite3_column_int(stmt, 7);
+    store.dia[i] = sqlite3_column_int(stmt, 8);
+    store.rendimiento[i] = sqlite3_column_int(stmt, 9);
+    store.cansancio[i] = sqlite3_column_int(stmt, 10);
+    store.animo[i] = sqlite3_column_int(stmt, 11);
+}
+
+/**
+ * @brief Carga todas las filas de partido en orden cronologico
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int cargar()
+{
+    sqlite3_stmt *stmt;
+    int total = 0;
+    int i = 0;
+
+    // Dentro de una transaccion la secuencia puede revertirse y reutilizarse
+    cargada_en_transaccion = !sqlite3_get_autocommit(db);
+    marca_cambios = cargada_en_transaccion ? -1 : cambios_secuencia_actual();
+
+    stmt = db_prepare_cached("SELECT COUNT(*) FROM partido");
+    if (!stmt)
+        return 0;
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        total = sqlite3_column_int(stmt, 0);
+    db_release_cached(stmt);
+
+    if (!reservar(total))
+    {
+        printf("Memoria insuficiente para cargar %d partidos.\n", total);
+        return 0;
+    }
+
+    stmt = db_prepare_cached("SELECT " SQL_COLUMNAS_STORE " FROM partido ORDER BY fecha_ts, id");
+    if (!stmt)
+        return 0;
+
+    while (i < total && sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        leer_fila(stmt, i);
+        i++;
+    }
+    db_release_cached(stmt);
+
+    store.n = i;
+    store.generacion = ++generacion;
+    return 1;
+}
+
+/**
+ * @brief Desplaza todas las columnas para quitar o abrir la posicion pos
+ *
+ * @param pos Posicion afectada
+ * @param abrir 1 para abrir un hueco en pos, 0 para quitar el partido de pos
+ */
+static void desplazar(int pos, int abrir)
+{
+    int **columnas[NUM_COLUMNAS_ENTERAS];
+    int desde = abrir ? pos : pos + 1;
+    int hacia = abrir ? pos + 1 : pos;
+    size_t cuantos = (size_t)(store.n - desde);
+
+    columnas_enteras(columnas);
+    for (int i = 0; i < NUM_COLUMNAS_ENTERAS; i++)
+        memmove(*columnas[i] + hacia, *columnas[i] + desde, sizeof(int) * cuantos);
+    memmove(store.fecha_ts + hacia, store.fecha_ts + desde, sizeof(long long) * cuantos);
+    store.n += abrir ? 1 : -1;
+}
+
+/**
+ * @brief Primera posicion cuyo partido va despues de (sin_fecha, ts, id)
+ *
+ * Mismo orden que ORDER BY fecha_ts, id: los NULL van primero.
+ */
+static int posicion_cronologica(int sin_fecha, long long ts, int id)
+{
+    int bajo = 0;
+    int alto = store.n;
+
+    while (bajo < alto)
+    {
+        int medio = bajo + (alto - bajo) / 2;
+        int medio_sin_fecha = store.dia_semana[medio] == -1;
+        int antes;
+
+        if (medio_sin_fecha != sin_fecha)
+            antes = medio_sin_fecha;
+        else if (!sin_fecha && store.fecha_ts[medio] != ts)
+            antes = store.fecha_ts[medio] < ts;
+        else
+            antes = store.id[medio] < id;
+
+        if (antes)
+            bajo = medio + 1;
+        else
+            alto = medio;
+    }
+    return bajo;
+}
+
+/**
+ * @brief Anota el partido de un cambio, sin repetir IDs
+ */
+static int anotar_cambio(const Cambio *cambio, void *contexto)
+{
+    CambiosPendientes *p = contexto;
+
+    for (int i = 0; i < p->n; i++)
+    {
+        if (p->ids[i] == cambio->fila)
+            return 1;
+    }
+    if (p->n == MAX_CAMBIOS_EN_SITIO)
+    {
+        p->excedido = 1;
+        return 0;
+    }
+    p->ids[p->n++] = (int)cambio->fila;
+    return 1;
+}
+
+/**
+ * @brief Relee un partido y lo recoloca en la copia (o lo quita si ya no existe)
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int refrescar_partido(int id)
+{
+    sqlite3_stmt *stmt;
+    int rc;
+
+    for (int i = 0; i < store.n; i++)
+    {
+        if (store.id[i] == id)
+        {
+            desplazar(i, 0);
+            break;
+        }
+    }
+
+    stmt = db_prepare_cached("SELECT " SQL_COLUMNAS_STORE " FROM partido WHERE id = ?");
+    if (!stmt)
+        return 0;
+    sqlite3_bind_int(stmt, 1, id);
+    rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW)
+    {
+        int sin_fecha = sqlite3_column_type(stmt, 1) == SQLITE_NULL;
+        int pos = posicion_cronologica(sin_fecha, sin_fecha ? 0 : sqlite3_column_int64(stmt, 1), id);
+
+        if (!reservar(store.n + 1))
+        {
+            db_release_cached(stmt);
+            return 0;
+        }
+        desplazar(pos, 1);
+        leer_fila(stmt, pos);
+    }
+    db_release_cached(stmt);
+    return rc == SQLITE_ROW || rc == SQLITE_DONE;
+}
+
+/**
+ * @brief Aplica a la copia los cambios de partido posteriores a su marca
+ *
+ * @return 1 si la copia quedo al dia, 0 si hay que recargarla completa
+ */
+static int actualizar_en_sitio()
+{
+    CambiosPendientes pendientes;
+    long long hasta;
+
+    if (marca_cambios < 0 || !sqlite3_get_autocommit(db))
+        return 0;
+
+    pendientes.n = 0;
+    pendientes.excedido = 0;
+    if (cambios_consumir(marca_cambios, "partido", anotar_cambio, &pendientes, &hasta) < 0 ||
+            pendientes.excedido)
+        return 0;
+
+    for (int i = 0; i < pendientes.n; i++)
+    {
+        if (!refrescar_partido(pendientes.ids[i]))
+            return 0;
+    }
+    if (pendientes.n > 0)
+        store.generacion = ++generacion;
+    marca_cambios = hasta;
+    return 1;
+}
+
+/**
+ * @brief Devuelve la copia en memoria, recargandola si la tabla cambio
+ */
+const PartidoStore *partido_store_obtener()
+{
+    long long version;
+
+    if (!db)
+        return NULL;
+
+    if (conexion != db)
+    {
+        // Conexion nueva (apertura, modo memoria): el hook va con ella
+        sqlite3_update_hook(db, hook_cambio, NULL);
+        conexion = db;
+        valida = 0;
+        marca_cambios = -1;
+    }
+
+    // Lo leido dentro de una transaccion ya terminada pudo haberse revertido
+    if (cargada_en_transaccion && sqlite3_get_autocommit(db))
+    {
+        cargada_en_transaccion = 0;
+        valida = 0;
+        marca_cambios = -1;
+    }
+
+    if (!leer_version_datos(&version))
+        return NULL;
+    if (valida && version == version_datos)
+        return &store;
+
+    // Se marca valida antes de leer: un cambio durante la carga vuelve a invalidarla
+    valida = 1;
+    version_datos = version;
+    if (actualizar_en_sitio())
+        return &store;
+    if (!cargar())
+    {
+        valida = 0;
+        return NULL;
+    }
+    return &store;
+}
+
+/**
+ * @brief Marca la copia como desactualizada
+ */
+void partido_store_invalidar()
+{
+    valida = 0;
+    marca_cambios = -1;
+}
+
+/**
+ * @brief Libera la memoria de la copia y desinstala el update hook
+ */
+void partido_store_liberar()
+{
+    if (conexion && conexion == db)
+        sqlite3_update_hook(db, NULL, NULL);
+    conexion = NULL;
+    valida = 0;
+    marca_cambios = -1;
+    cargada_en_transaccion = 0;
+
+    free(store.id);
+    free(store.fecha_ts);
+    free(store.cancha_id);
+    free(store.camiseta_id);
+    free(store.goles);
+    free(store.asistencias);
+    free(store.resultado);
+    free(store.clima);
+    free(store.dia);
+    free(store.rendimiento);
+    free(store.cansancio);
+    free(store.animo);
+    free(store.anio);
+    free(store.mes);
+    free(store.dia_semana);
+    memset(&store, 0, sizeof(store));
+    capacidad = 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file partido_store.h
+ * @brief Copia en memoria por columnas de la tabla partido
+ *
+ * Los modulos de analisis, estadisticas, records y logros recorren una y
+ * otra vez las mismas columnas enteras de partido. Este modulo las carga
+ * una sola vez en arreglos contiguos (una columna por arreglo, en orden
+ * cronologico fecha_ts, id) y los mantiene hasta que la tabla cambia.
+ *
+ * La copia se invalida con el update hook de SQLite para los cambios
+ * hechos por esta conexion y con PRAGMA data_version para los hechos por
+ * otras conexiones sobre el mismo archivo. Al revalidarla, si el registro
+ * de cambios (cambios.h) muestra pocos partidos modificados, solo esos se
+ * releen; si no, se recarga la tabla completa.
+ *
+ * Quien guarde resultados derivados de la copia puede compararlos con
+ * PartidoStore.generacion para saber si siguen al dia.
+ */
+
+#ifndef PARTIDO_STORE_H
+#define PARTIDO_STORE_H
+
+/**
+ * @brief Columnas de partido en memoria
+ *
+ * Todos los arreglos tienen n elementos y la posicion i corresponde al
+ * mismo partido en cada uno. Los valores NULL se cargan como 0, igual que
+ * los DEFAULT de las columnas.
+ */
+typedef struct
+{
+    int n;                  /**< Numero de partidos */
+    int *id;                /**< ID del partido */
+    long long *fecha_ts;    /**< Segundos desde 1970 (UTC); 0 si fecha_ts es NULL */
+    int *cancha_id;         /**< ID de la cancha */
+    int *camiseta_id;       /**< ID de la camiseta */
+    int *goles;             /**< Goles */
+    int *asistencias;       /**< Asistencias */
+    int *resultado;         /**< 1 victoria, 2 empate, 3 derrota */
+    int *clima;             /**< Codigo de clima (1-6) */
+    int *dia;               /**< Codigo de dia */
+    int *rendimiento;       /**< rendimiento_general (1-10) */
+    int *cansancio;         /**< Cansancio (1-10) */
+    int *animo;             /**< estado_animo (1-10) */
+    int *anio;              /**< Anio de fecha_ts; 0 si fecha_ts es NULL */
+    int *mes;               /**< Mes de fecha_ts (1-12); 0 si fecha_ts es NULL */
+    int *dia_semana;        /**< Dia de la semana (0 domingo); -1 si fecha_ts es NULL */
+    unsigned long long generacion; /**< Cambia (nunca se repite) cada vez que cambia el contenido */
+} PartidoStore;
+
+/**
+ * @brief Devuelve la copia en memoria, recargandola si la tabla cambio
+ *
+ * El puntero sigue siendo valido hasta la siguiente llamada a cualquier
+ * funcion de este modulo o hasta la siguiente escritura en partido.
+ *
+ * @return Copia de partido, o NULL si no se pudo cargar
+ */
+const PartidoStore *partido_store_obtener();
+
+/**
+ * @brief Marca la copia como desactualizada
+ *
+ * Necesario tras cambios que no pasan por el update hook, como la
+ * restauracion de un respaldo con la API de backup. La siguiente lectura
+ * recarga la tabla completa sin consultar el registro de cambios.
+ */
+void partido_store_invalidar();
+
+/**
+ * @brief Libera la memoria de la copia y desinstala el update hook
+ */
+void partido_store_liberar();
+
+#endif
@@ -0,0 +1,406 @@
+/**
+ * @file perfil_sql.c
+ * @brief Perfilado de sentencias SQL con sqlite3_trace_v2
+ *
+ * Registra los eventos SQLITE_TRACE_ROW y SQLITE_TRACE_PROFILE de la
+ * conexion global. Las sentencias se agrupan por su texto normalizado
+ * (literales sustituidos por ?) para que las consultas construidas con
+ * sprintf cuenten como una sola.
+ */
+
+#include "perfil_sql.h"
+#include "db.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Capacidad de la tabla de filas pendientes por sentencia (potencia de 2) */
+#define FILAS_PENDIENTES 256
+
+/** Numero de sentencias que se listan en el informe */
+#define MAX_INFORME 200
+
+/**
+ * @brief Estadisticas acumuladas de un texto SQL normalizado
+ */
+typedef struct
+{
+    char *sql;                 /**< Texto normalizado */
+    unsigned long hash;        /**< Hash del texto normalizado */
+    unsigned long ejecuciones; /**< Veces que se completo la sentencia */
+    double total_ms;           /**< Latencia acumulada */
+    double max_ms;             /**< Peor latencia observada */
+    unsigned long long filas;  /**< Filas devueltas en total */
+} EntradaPerfil;
+
+/**
+ * @brief Filas devueltas por una sentencia aun no completada
+ */
+typedef struct
+{
+    sqlite3_stmt *stmt;
+    unsigned long filas;
+} FilasPendientes;
+
+static int activo = 0;
+static EntradaPerfil *entradas = NULL;
+static int num_entradas = 0;
+static int cap_entradas = 0;
+static int *indice = NULL;          /**< Tabla hash abierta: posicion en entradas o -1 */
+static int cap_indice = 0;
+static FilasPendientes pendientes[FILAS_PENDIENTES];
+static double inicio_sesion_ms = 0.0;
+
+/**
+ * @brief Hash FNV-1a de un texto
+ */
+static unsigned long hash_texto(const char *s)
+{
+    unsigned long h = 2166136261UL;
+    while (*s)
+    {
+        h ^= (unsigned char)*s++;
+        h = (h * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return h;
+}
+
+/**
+ * @brief Normaliza un texto SQL para agrupar variantes con distintos literales
+ *
+ * Sustituye cadenas y numeros literales por ? y colapsa los espacios.
+ *
+ * @param sql Texto original
+ * @return Copia normalizada en memoria dinamica, NULL si no hay memoria
+ */
+static char *normalizar_sql(const char *sql)
+{
+    size_t n = strlen(sql);
+    char *out = malloc(n + 1);
+    size_t j = 0;
+    int espacio = 0;
+
+    if (!out)
+        return NULL;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        char c = sql[i];
+
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        {
+            espacio = (j > 0);
+            continue;
+        }
+        if (espacio)
+        {
+            out[j++] = ' ';
+            espacio = 0;
+        }
+
+        if (c == '\'')
+        {
+            // Literal de cadena ('' es una comilla escapada)
+            i++;
+            while (i < n && !(sql[i] == '\'' && (i + 1 >= n || sql[i + 1] != '\'')))
+            {
+                if (sql[i] == '\'')
+                    i++;
+                i++;
+            }
+            out[j++] = '?';
+        }
+        else if (c >= '0' && c <= '9' &&
+                 (j == 0 || !(out[j - 1] == '_' || out[j - 1] == '?' ||
+                              (out[j - 1] >= 'a' && out[j - 1] <= 'z') ||
+                              (out[j - 1] >= 'A' && out[j - 1] <= 'Z') ||
+                              (out[j - 1] >= '0' && out[j - 1] <= '9'))))
+        {
+            while (i + 1 < n && ((sql[i + 1] >= '0' && sql[i + 1] <= '9') || sql[i + 1] == '.'))
+                i++;
+            out[j++] = '?';
+        }
+        else
+        {
+            out[j++] = c;
+        }
+    }
+    out[j] = '\0';
+    return out;
+}
+
+/**
+ * @brief Reconstruye el indice hash con el doble de capacidad
+ *
+ * @return 1 si exito, 0 si no hay memoria
+ */
+static int ampliar_indice()
+{
+    int nueva_cap = cap_indice ? cap_indice * 2 : 512;
+    int *nuevo = malloc(sizeof(int) * nueva_cap);
+    if (!nuevo)
+        return 0;
+    for (int i = 0; i < nueva_cap; i++)
+        nuevo[i] = -1;
+    for (int e = 0; e < num_entradas; e++)
+    {
+        int pos = (int)(entradas[e].hash & (unsigned long)(nueva_cap - 1));
+        while (nuevo[pos] >= 0)
+            pos = (pos + 1) & (nueva_cap - 1);
+        nuevo[pos] = e;
+    }
+    free(indice);
+    indice = nuevo;
+    cap_indice = nueva_cap;
+    return 1;
+}
+
+/**
+ * @brief Busca o crea la entrada de un texto SQL normalizado
+ *
+ * @param sql Texto normalizado (la entrada toma posesion si es nueva)
+ * @return Entrada correspondiente, NULL si no hay memoria
+ */
+static EntradaPerfil *obtener_entrada(char *sql)
+{
+    unsigned long h = hash_texto(sql);
+    int pos;
+
+    if ((num_entradas + 1) * 2 > cap_indice && !ampliar_indice())
+        return NULL;
+
+    pos = (int)(h & (unsigned long)(cap_indice - 1));
+    while (indice[pos] >= 0)
+    {
+        EntradaPerfil *e = &entradas[indice[pos]];
+        if (e->hash == h && strcmp(e->sql, sql) == 0)
+        {
+            free(sql);
+            return e;
+        }
+        pos = (pos + 1) & (cap_indice - 1);
+    }
+
+    if (num_entradas == cap_entradas)
+    {
+        int nueva_cap = cap_entradas ? cap_entradas * 2 : 128;
+        EntradaPerfil *nuevas = realloc(entradas, sizeof(EntradaPerfil) * nueva_cap);
+        if (!nuevas)
+            return NULL;
+        entradas = nuevas;
+        cap_entradas = nueva_cap;
+    }
+
+    EntradaPerfil *e = &entradas[num_entradas];
+    memset(e, 0, sizeof(*e));
+    e->sql = sql;
+    e->hash = h;
+    indice[pos] = num_entradas++;
+    return e;
+}
+
+/**
+ * @brief Localiza el contador de filas pendientes de una sentencia
+ *
+ * @param stmt Sentencia
+ * @param crear 1 para reservar una posicion si no existe
+ * @return Contador, NULL si no existe (o la tabla esta llena)
+ */
+static FilasPendientes *filas_de(sqlite3_stmt *stmt, int crear)
+{
+    unsigned long h = (unsigned long)(size_t)stmt;
+    int pos = (int)((h >> 4) & (FILAS_PENDIENTES - 1));
+
+    for (int k = 0; k < FILAS_PENDIENTES; k++)
+    {
+        FilasPendientes *f = &pendientes[(pos + k) & (FILAS_PENDIENTES - 1)];
+        if (f->stmt == stmt)
+            return f;
+        if (f->stmt == NULL)
+        {
+            if (!crear)
+                return NULL;
+            f->stmt = stmt;
+            f->filas = 0;
+            return f;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Libera la posicion de una sentencia manteniendo las cadenas de sondeo
+ */
+static void liberar_filas(FilasPendientes *f)
+{
+    int pos = (int)(f - pendientes);
+    f->stmt = NULL;
+
+    // Reubicar los elementos siguientes del mismo cluster
+    for (int k = 1; k < FILAS_PENDIENTES; k++)
+    {
+        FilasPendientes *g = &pendientes[(pos + k) & (FILAS_PENDIENTES - 1)];
+        if (g->stmt == NULL)
+            break;
+        FilasPendientes tmp = *g;
+        g->stmt = NULL;
+        FilasPendientes *dest = filas_de(tmp.stmt, 1);
+        if (dest)
+            dest->filas = tmp.filas;
+    }
+}
+
+/**
+ * @brief Callback de sqlite3_trace_v2
+ */
+static int traza_sql(unsigned tipo, void *ctx, void *p, void *x)
+{
+    sqlite3_stmt *stmt = (sqlite3_stmt*)p;
+    (void)ctx;
+
+    if (tipo == SQLITE_TRACE_ROW)
+    {
+        FilasPendientes *f = filas_de(stmt, 1);
+        if (f)
+            f->filas++;
+    }
+    else if (tipo == SQLITE_TRACE_PROFILE)
+    {
+        double ms = (double)(*(sqlite3_int64*)x) / 1000000.0;
+        const char *sql = sqlite3_sql(stmt);
+        FilasPendientes *f = filas_de(stmt, 0);
+        unsigned long filas = 0;
+
+        if (f)
+        {
+            filas = f->filas;
+            liberar_filas(f);
+        }
+        if (!sql)
+            return 0;
+
+        char *normal = normalizar_sql(sql);
+        if (!normal)
+            return 0;
+
+        EntradaPerfil *e = obtener_entrada(normal);
+        if (!e)
+        {
+            free(normal);
+            return 0;
+        }
+        e->ejecuciones++;
+        e->total_ms += ms;
+        if (ms > e->max_ms)
+            e->max_ms = ms;
+        e->filas += filas;
+    }
+    return 0;
+}
+
+int perfil_sql_iniciar()
+{
+    if (!db)
+        return 0;
+    if (sqlite3_trace_v2(db, SQLITE_TRACE_PROFILE | SQLITE_TRACE_ROW, traza_sql, NULL) != SQLITE_OK)
+    {
+        printf("Error activando perfilado SQL: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    activo = 1;
+    inicio_sesion_ms = get_time_ms();
+    return 1;
+}
+
+int perfil_sql_activo()
+{
+    return activo;
+}
+
+/**
+ * @brief Orden descendente por tiempo total
+ */
+static int comparar_total(const void *a, const void *b)
+{
+    const EntradaPerfil *x = a;
+    const EntradaPerfil *y = b;
+    if (x->total_ms < y->total_ms) return 1;
+    if (x->total_ms > y->total_ms) return -1;
+    return 0;
+}
+
+/**
+ * @brief Escribe el informe ordenado por tiempo total acumulado
+ *
+ * @param ruta Archivo destino
+ * @return 1 si exito, 0 en caso de error
+ */
+static int escribir_informe(const char *ruta)
+{
+    FILE *f = fopen(ruta, "w");
+    double total = 0.0;
+    unsigned long ejecuciones = 0;
+
+    if (!f)
+        return 0;
+
+    qsort(entradas, num_entradas, sizeof(EntradaPerfil), comparar_total);
+    for (int i = 0; i < num_entradas; i++)
+    {
+        total += entradas[i].total_ms;
+        ejecuciones += entradas[i].ejecuciones;
+    }
+
+    fprintf(f, "PERFIL SQL - MiFutbolC\n");
+    fprintf(f, "Duracion de la sesion: %.1f ms\n", get_time_ms() - inicio_sesion_ms);
+    fprintf(f, "Sentencias distintas: %d, ejecuciones: %lu, tiempo SQL total: %.3f ms\n\n",
+            num_entradas, ejecuciones, total);
+    fprintf(f, "%4s %12s %6s %10s %10s %10s %10s  %s\n",
+            "#", "total_ms", "%", "ejec", "media_ms", "max_ms", "filas", "sql");
+
+    for (int i = 0; i < num_entradas && i < MAX_INFORME; i++)
+    {
+        EntradaPerfil *e = &entradas[i];
+        fprintf(f, "%4d %12.3f %6.1f %10lu %10.4f %10.3f %10llu  %s\n",
+                i + 1, e->total_ms, total > 0 ? 100.0 * e->total_ms / total : 0.0,
+                e->ejecuciones, e->ejecuciones ? e->total_ms / e->ejecuciones : 0.0,
+                e->max_ms, e->filas, e->sql);
+    }
+    if (num_entradas > MAX_INFORME)
+        fprintf(f, "\n... %d sentencias mas omitidas\n", num_entradas - MAX_INFORME);
+
+    fclose(f);
+    return 1;
+}
+
+void perfil_sql_finalizar()
+{
+    char ruta[1200];
+    char ts[32];
+
+    if (!activo)
+        return;
+    activo = 0;
+
+    get_timestamp(ts, sizeof(ts));
+#ifdef _WIN32
+    snprintf(ruta, sizeof(ruta), "%s\\perfil_sql_%s.txt", get_data_dir(), ts);
+#else
+    snprintf(ruta, sizeof(ruta), "%s/perfil_sql_%s.txt", get_data_dir(), ts);
+#endif
+
+    if (escribir_informe(ruta))
+        printf("Informe de perfil SQL guardado en: %s\n", ruta);
+    else
+        printf("Error escribiendo informe de perfil SQL en: %s\n", ruta);
+
+    for (int i = 0; i < num_entradas; i++)
+        free(entradas[i].sql);
+    free(entradas);
+    free(indice);
+    entradas = NULL;
+    indice = NULL;
+    num_entradas = cap_entradas = cap_indice = 0;
+    memset(pendientes, 0, sizeof(pendientes));
+}
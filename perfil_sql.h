@@ -0,0 +1,35 @@
+/**
+ * @file perfil_sql.h
+ * @brief Perfilado de sentencias SQL con sqlite3_trace_v2
+ *
+ * Modo de diagnostico que acumula, por texto SQL normalizado, el numero de
+ * ejecuciones, la latencia total y maxima y las filas devueltas, y al
+ * cerrar la base de datos escribe un informe ordenado por tiempo total.
+ */
+
+#ifndef PERFIL_SQL_H
+#define PERFIL_SQL_H
+
+/**
+ * @brief Activa el perfilado sobre la conexion global
+ *
+ * @return 1 si se registro el trace, 0 en caso de error
+ */
+int perfil_sql_iniciar();
+
+/**
+ * @brief Indica si el perfilado esta activo
+ *
+ * @return 1 si esta activo, 0 en caso contrario
+ */
+int perfil_sql_activo();
+
+/**
+ * @brief Escribe el informe en el directorio de datos y libera la memoria
+ *
+ * No hace nada si el perfilado no estaba activo. Se invoca desde db_close()
+ * una vez cerrada la conexion.
+ */
+void perfil_sql_finalizar();
+
+#endif
@@ -0,0 +1,314 @@
+/**
+ * @file rachas.c
+ * @brief Rachas de partidos consecutivos a partir de la copia en memoria
+ *
+ * Ver rachas.h.
+ */
+
+#include "rachas.h"
+#include "partido_store.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Secuencias que se codifican por tramos
+ */
+typedef enum
+{
+    SERIE_RESULTADO,
+    SERIE_GOLES,
+    SERIE_ASISTENCIAS,
+    NUM_SERIES
+} SerieRacha;
+
+/**
+ * @brief Tramo de partidos consecutivos con el mismo valor en una serie
+ *
+ * desde y hasta son posiciones en la copia en memoria; en los tramos de
+ * una camiseta no tienen por que estar contiguas.
+ */
+typedef struct
+{
+    int valor;
+    int largo;
+    int desde;
+    int hasta;
+} Tramo;
+
+/**
+ * @brief Tramos de una serie: primero los de todos los partidos, luego los de cada camiseta
+ */
+typedef struct
+{
+    Tramo *tramos;
+    int num;
+    int capacidad;
+    int *limites;   /**< El ambito k ocupa [limites[k], limites[k + 1]); k = camiseta_id + 1 */
+} ListaTramos;
+
+static const struct
+{
+    SerieRacha serie;
+    int valor;
+    const char *nombre;
+} TIPOS[NUM_TIPOS_RACHA] =
+{
+    {SERIE_RESULTADO, 1, "Victorias"},
+    {SERIE_RESULTADO, 2, "Empates"},
+    {SERIE_RESULTADO, 3, "Derrotas"},
+    {SERIE_GOLES, 1, "Con goles"},
+    {SERIE_GOLES, 0, "Sin goles"},
+    {SERIE_ASISTENCIAS, 1, "Con asistencias"},
+    {SERIE_ASISTENCIAS, 0, "Sin asistencias"}
+};
+
+static ListaTramos series[NUM_SERIES];
+
+/** Ambitos de la ultima codificacion: todos los partidos y una por ID de camiseta */
+static int tramos_ambitos = 0;
+
+/** Generacion de partido_store sobre la que se codificaron los tramos; 0 si ninguna */
+static unsigned long long tramos_generacion = 0;
+
+/**
+ * @brief Nombre de un tipo de racha para mostrar
+ */
+const char *racha_nombre(TipoRacha tipo)
+{
+    if (tipo < 0 || tipo >= NUM_TIPOS_RACHA)
+        return "";
+    return TIPOS[tipo].nombre;
+}
+
+/**
+ * @brief Valor de un partido en una serie
+ */
+static int valor_serie(const PartidoStore *store, SerieRacha serie, int i)
+{
+    switch (serie)
+    {
+    case SERIE_RESULTADO:
+        return store->resultado[i];
+    case SERIE_GOLES:
+        return store->goles[i] > 0;
+    default:
+        return store->asistencias[i] > 0;
+    }
+}
+
+/**
+ * @brief Codifica por tramos una secuencia de partidos y los agrega a la lista
+ *
+ * @param lista Lista de la serie
+ * @param store Copia en memoria de partido
+ * @param serie Serie a codificar
+ * @param posiciones Posiciones de los partidos en orden cronologico, o NULL para 0..n-1
+ * @param n Partidos de la secuencia
+ * @return 1 si exito, 0 si no hubo memoria
+ */
+static int codificar(ListaTramos *lista, const PartidoStore *store, SerieRacha serie, const int *posiciones, int n)
+{
+    int primero = lista->num;
+
+    for (int k = 0; k < n; k++)
+    {
+        int i = posiciones ? posiciones[k] : k;
+        int valor = valor_serie(store, serie, i);
+
+        if (lista->num > primero && lista->tramos[lista->num - 1].valor == valor)
+        {
+            lista->tramos[lista->num - 1].largo++;
+            lista->tramos[lista->num - 1].hasta = i;
+            continue;
+        }
+
+        if (lista->num == lista->capacidad)
+        {
+            int capacidad = lista->capacidad ? lista->capacidad * 2 : 1024;
+            Tramo *tramos = realloc(lista->tramos, (size_t)capacidad * sizeof(Tramo));
+            if (!tramos)
+                return 0;
+            lista->tramos = tramos;
+            lista->capacidad = capacidad;
+        }
+        lista->tramos[lista->num].valor = valor;
+        lista->tramos[lista->num].largo = 1;
+        lista->tramos[lista->num].desde = i;
+        lista->tramos[lista->num].hasta = i;
+        lista->num++;
+    }
+    return 1;
+}
+
+/**
+ * @brief Codifica las tres series para todos los partidos y para cada camiseta
+ *
+ * Los partidos se agrupan por camiseta con un conteo (conservando el orden
+ * cronologico dentro de cada grupo) y cada grupo se codifica a continuacion
+ * de los tramos de todos los partidos.
+ *
+ * @param store Copia en memoria de partido
+ * @return 1 si exito, 0 si no hubo memoria
+ */
+static int construir_tramos(const PartidoStore *store)
+{
+    int max_camiseta = -1;
+    int *inicio, *orden;
+    int ok = 1;
+
+    tramos_generacion = 0;
+    for (int i = 0; i < store->n; i++)
+    {
+        if (store->camiseta_id[i] > max_camiseta)
+            max_camiseta = store->camiseta_id[i];
+    }
+
+    inicio = calloc((size_t)max_camiseta + 2, sizeof(int));
+    orden = malloc(((size_t)store->n + 1) * sizeof(int));
+    if (!inicio || !orden)
+    {
+        free(inicio);
+        free(orden);
+        printf("Memoria insuficiente.\n");
+        return 0;
+    }
+
+    // inicio[c] = primera posicion de la camiseta c en orden
+    for (int i = 0; i < store->n; i++)
+    {
+        if (store->camiseta_id[i] >= 0)
+            inicio[store->camiseta_id[i] + 1]++;
+    }
+    for (int c = 0; c <= max_camiseta; c++)
+        inicio[c + 1] += inicio[c];
+    for (int i = 0; i < store->n; i++)
+    {
+        int c = store->camiseta_id[i];
+        if (c >= 0)
+            orden[inicio[c]++] = i;
+    }
+    // Tras llenar, inicio[c] es el fin de c, es decir el inicio de c + 1
+    memmove(inicio + 1, inicio, (size_t)(max_camiseta + 1) * sizeof(int));
+    inicio[0] = 0;
+
+    tramos_ambitos = max_camiseta + 2;
+    for (int s = 0; s < NUM_SERIES && ok; s++)
+    {
+        ListaTramos *lista = &series[s];
+        int *limites = realloc(lista->limites, ((size_t)tramos_ambitos + 1) * sizeof(int));
+
+        if (!limites)
+        {
+            ok = 0;
+            break;
+        }
+        lista->limites = limites;
+        lista->num = 0;
+
+        limites[0] = 0;
+        ok = codificar(lista, store, s, NULL, store->n);
+        limites[1] = lista->num;
+        for (int c = 0; c <= max_camiseta && ok; c++)
+        {
+            ok = codificar(lista, store, s, orden + inicio[c], inicio[c + 1] - inicio[c]);
+            limites[c + 2] = lista->num;
+        }
+    }
+
+    free(inicio);
+    free(orden);
+    if (!ok)
+    {
+        printf("Memoria insuficiente.\n");
+        return 0;
+    }
+
+    tramos_generacion = store->generacion;
+    return 1;
+}
+
+/**
+ * @brief Devuelve los tramos de un ambito, codificandolos si la copia cambio
+ *
+ * @param tipo Tipo de racha
+ * @param camiseta_id ID de la camiseta, o RACHAS_TODAS
+ * @param store Destino de la copia en memoria
+ * @param tramos Destino del primer tramo del ambito
+ * @param num Destino del numero de tramos del ambito (0 si la camiseta no tiene partidos)
+ * @return 1 si exito, 0 si no se pudo cargar la copia o no hubo memoria
+ */
+static int tramos_ambito(TipoRacha tipo, int camiseta_id, const PartidoStore **store, const Tramo **tramos, int *num)
+{
+    const ListaTramos *lista;
+    int ambito = camiseta_id + 1;
+
+    *store = partido_store_obtener();
+    *num = 0;
+    if (!*store || tipo < 0 || tipo >= NUM_TIPOS_RACHA)
+        return 0;
+    if ((*store)->generacion != tramos_generacion && !construir_tramos(*store))
+        return 0;
+
+    if (ambito < 0 || ambito >= tramos_ambitos)
+        return 1;
+    lista = &series[TIPOS[tipo].serie];
+    *tramos = lista->tramos + lista->limites[ambito];
+    *num = lista->limites[ambito + 1] - lista->limites[ambito];
+    return 1;
+}
+
+/**
+ * @brief Llena una racha a partir de un tramo
+ */
+static void llenar_racha(Racha *racha, const PartidoStore *store, const Tramo *tramo)
+{
+    racha->largo = tramo->largo;
+    racha->id_desde = store->id[tramo->desde];
+    racha->id_hasta = store->id[tramo->hasta];
+    racha->fecha_desde = store->fecha_ts[tramo->desde];
+    racha->fecha_hasta = store->fecha_ts[tramo->hasta];
+}
+
+/**
+ * @brief Racha mas larga de un tipo
+ */
+int rachas_mejor(TipoRacha tipo, int camiseta_id, Racha *racha)
+{
+    const PartidoStore *store;
+    const Tramo *tramos;
+    const Tramo *mejor = NULL;
+    int num;
+
+    memset(racha, 0, sizeof(*racha));
+    if (!tramos_ambito(tipo, camiseta_id, &store, &tramos, &num))
+        return 0;
+
+    // Ante empates queda la racha mas antigua
+    for (int t = 0; t < num; t++)
+    {
+        if (tramos[t].valor == TIPOS[tipo].valor && (!mejor || tramos[t].largo > mejor->largo))
+            mejor = &tramos[t];
+    }
+    if (mejor)
+        llenar_racha(racha, store, mejor);
+    return 1;
+}
+
+/**
+ * @brief Racha en curso de un tipo (la que incluye el ultimo partido)
+ */
+int rachas_actual(TipoRacha tipo, int camiseta_id, Racha *racha)
+{
+    const PartidoStore *store;
+    const Tramo *tramos;
+    int num;
+
+    memset(racha, 0, sizeof(*racha));
+    if (!tramos_ambito(tipo, camiseta_id, &store, &tramos, &num))
+        return 0;
+
+    if (num > 0 && tramos[num - 1].valor == TIPOS[tipo].valor)
+        llenar_racha(racha, store, &tramos[num - 1]);
+    return 1;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file rachas.h
+ * @brief Rachas de partidos consecutivos a partir de la copia en memoria
+ *
+ * Una sola pasada sobre partido_store (orden cronologico fecha_ts, id)
+ * codifica por longitud de tramos (run-length) tres secuencias: el
+ * resultado, si hubo goles y si hubo asistencias. Los tramos se guardan
+ * para todos los partidos y, por separado, para los partidos de cada
+ * camiseta, y se reutilizan mientras la copia no cambie de generacion.
+ *
+ * La mejor racha de un tipo es el tramo mas largo con ese valor (ante
+ * empates, el mas antiguo); la racha actual es el ultimo tramo si tiene
+ * ese valor, y si no, 0.
+ */
+
+#ifndef RACHAS_H
+#define RACHAS_H
+
+/** Ambito que abarca todos los partidos, sin filtrar por camiseta */
+#define RACHAS_TODAS -1
+
+/**
+ * @brief Tipos de racha
+ */
+typedef enum
+{
+    RACHA_VICTORIAS,
+    RACHA_EMPATES,
+    RACHA_DERROTAS,
+    RACHA_CON_GOLES,
+    RACHA_SIN_GOLES,
+    RACHA_CON_ASISTENCIAS,
+    RACHA_SIN_ASISTENCIAS,
+    NUM_TIPOS_RACHA
+} TipoRacha;
+
+/**
+ * @brief Una racha concreta
+ *
+ * Los IDs y fechas solo tienen sentido si largo > 0.
+ */
+typedef struct
+{
+    int largo;              /**< Partidos consecutivos */
+    int id_desde;           /**< ID del primer partido de la racha */
+    int id_hasta;           /**< ID del ultimo partido de la racha */
+    long long fecha_desde;  /**< fecha_ts del primer partido (0 si no tiene) */
+    long long fecha_hasta;  /**< fecha_ts del ultimo partido (0 si no tiene) */
+} Racha;
+
+/**
+ * @brief Nombre de un tipo de racha para mostrar
+ */
+const char *racha_nombre(TipoRacha tipo);
+
+/**
+ * @brief Racha mas larga de un tipo
+ *
+ * @param tipo Tipo de racha
+ * @param camiseta_id ID de la camiseta, o RACHAS_TODAS
+ * @param racha Resultado (largo 0 si no hay ninguna)
+ * @return 1 si exito, 0 si no se pudo cargar la copia en memoria
+ */
+int rachas_mejor(TipoRacha tipo, int camiseta_id, Racha *racha);
+
+/**
+ * @brief Racha en curso de un tipo (la que incluye el ultimo partido)
+ *
+ * @param tipo Tipo de racha
+ * @param camiseta_id ID de la camiseta, o RACHAS_TODAS
+ * @param racha Resultado (largo 0 si el ultimo partido no la continua)
+ * @return 1 si exito, 0 si no se pudo cargar la copia en memoria
+ */
+int rachas_actual(TipoRacha tipo, int camiseta_id, Racha *racha);
+
+#endif
@@ -7,7 +7,10 @@
 #include "db.h"
 #include "utils.h"
 #include "menu.h"
+#include "partido_store.h"
+#include "rachas.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
@@ -45,64 +48,158 @@ static void mostrar_record(const char *titulo, const char *sql)
 }
 
 /**
- * Muestra resultados de combinaciones cancha-camiseta.
- * Necesario para mantener formato consistente en consultas complejas de rendimiento.
+ * Obtiene el nombre de una fila por ID de la tabla indicada (cancha o camiseta).
  */
-static void mostrar_combinacion(const char *titulo, const char *sql)
+static void obtener_nombre(const char *sql, int id, char *nombre, size_t tam)
 {
-    sqlite3_stmt *stmt;
+    sqlite3_stmt *stmt = db_prepare_cached(sql);
+
+    snprintf(nombre, tam, "%s", "Desconocido");
+    if (!stmt)
+        return;
+    sqlite3_bind_int(stmt, 1, id);
+    if (sqlite3_step(stmt) == SQLITE_ROW && sqlite3_column_text(stmt, 0))
+        snprintf(nombre, tam, "%s", (const char *)sqlite3_column_text(stmt, 0));
+    db_release_cached(stmt);
+}
+
+/**
+ * Muestra la combinación cancha-camiseta con mayor (o menor) rendimiento promedio.
+ * Acumula sobre la copia en memoria de partido en una tabla indexada por
+ * (cancha, camiseta), así basta una pasada en lugar de un GROUP BY con JOINs.
+ */
+static void mostrar_combinacion(const char *titulo, int mejor)
+{
+    const PartidoStore *store = partido_store_obtener();
+    int max_cancha = 0, max_camiseta = 0;
 
     printf("\n%s\n", titulo);
     printf("----------------------------------------\n");
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK)
+    if (!store)
+        return;
+
+    for (int i = 0; i < store->n; i++)
     {
-        if (sqlite3_step(stmt) == SQLITE_ROW)
-        {
-            printf("Cancha: %s\n", sqlite3_column_text(stmt, 0));
-            printf("Camiseta: %s\n", sqlite3_column_text(stmt, 1));
-            printf("Rendimiento Promedio: %.2f\n", sqlite3_column_double(stmt, 2));
-            printf("Partidos Jugados: %d\n", sqlite3_column_int(stmt, 3));
-        }
-        else
+        if (store->cancha_id[i] > max_cancha)
+            max_cancha = store->cancha_id[i];
+        if (store->camiseta_id[i] > max_camiseta)
+            max_camiseta = store->camiseta_id[i];
+    }
+
+    size_t celdas = (size_t)(max_cancha + 1) * (size_t)(max_camiseta + 1);
+    long long *sumas = calloc(celdas, sizeof(long long));
+    int *partidos = calloc(celdas, sizeof(int));
+    if (!sumas || !partidos)
+    {
+        printf("Memoria insuficiente.\n");
+        free(sumas);
+        free(partidos);
+        return;
+    }
+
+    for (int i = 0; i < store->n; i++)
+    {
+        if (store->cancha_id[i] < 0 || store->camiseta_id[i] < 0)
+            continue;
+        size_t celda = (size_t)store->cancha_id[i] * (max_camiseta + 1) + store->camiseta_id[i];
+        sumas[celda] += store->rendimiento[i];
+        partidos[celda]++;
+    }
+
+    // Recorrido en orden (cancha, camiseta): ante empates gana la primera combinación
+    size_t elegida = 0;
+    int hay = 0;
+    double promedio_elegido = 0.0;
+    for (size_t c = 0; c < celdas; c++)
+    {
+        if (partidos[c] == 0)
+            continue;
+        double promedio = (double)sumas[c] / partidos[c];
+        if (!hay || (mejor ? promedio > promedio_elegido : promedio < promedio_elegido))
         {
-            printf("No hay datos disponibles.\n");
+            elegida = c;
+            promedio_elegido = promedio;
+            hay = 1;
         }
-        sqlite3_finalize(stmt);
     }
+
+    if (hay)
+    {
+        char cancha[256], camiseta[256];
+        obtener_nombre("SELECT nombre FROM cancha WHERE id = ?", (int)(elegida / (max_camiseta + 1)), cancha, sizeof(cancha));
+        obtener_nombre("SELECT nombre FROM camiseta WHERE id = ?", (int)(elegida % (max_camiseta + 1)), camiseta, sizeof(camiseta));
+        printf("Cancha: %s\n", cancha);
+        printf("Camiseta: %s\n", camiseta);
+        printf("Rendimiento Promedio: %.2f\n", redondear(promedio_elegido, 2));
+        printf("Partidos Jugados: %d\n", partidos[elegida]);
+    }
+    else
+    {
+        printf("No hay datos disponibles.\n");
+    }
+
+    free(sumas);
+    free(partidos);
 }
 
 /**
  * @brief Función auxiliar para mostrar temporadas
+ *
+ * Recorre la copia en memoria de partido, donde los partidos de un mismo
+ * año son consecutivos, y muestra el año con mayor (o menor) rendimiento
+ * promedio. Los partidos sin fecha válida no cuentan para ninguna temporada.
+ *
+ * @param titulo Título a mostrar
+ * @param mejor 1 para la mejor temporada, 0 para la peor
  */
-static void mostrar_temporada(const char *titulo, const char *sql)
+static void mostrar_temporada(const char *titulo, int mejor)
 {
-    sqlite3_stmt *stmt;
+    const PartidoStore *store = partido_store_obtener();
+    int anio_elegido = 0, partidos_elegido = 0;
+    double promedio_elegido = 0.0;
+    int i = 0;
 
     printf("\n%s\n", titulo);
     printf("----------------------------------------\n");
 
-    if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK)
+    if (!store)
+        return;
+
+    while (i < store->n && store->anio[i] == 0)
+        i++;
+
+    while (i < store->n)
     {
-        if (sqlite3_step(stmt) == SQLITE_ROW)
+        int anio = store->anio[i];
+        long long suma = 0;
+        int partidos = 0;
+
+        for (; i < store->n && store->anio[i] == anio; i++)
         {
-            const char* year = (const char*)sqlite3_column_text(stmt, 0);
-            if (year)
-            {
-                printf("Anio: %s\n", year);
-            }
-            else
-            {
-                printf("Anio: Desconocido\n");
-            }
-            printf("Rendimiento Promedio: %.2f\n", sqlite3_column_double(stmt, 1));
-            printf("Partidos Jugados: %d\n", sqlite3_column_int(stmt, 2));
+            suma += store->rendimiento[i];
+            partidos++;
         }
-        else
+
+        double promedio = (double)suma / partidos;
+        if (partidos_elegido == 0 ||
+                (mejor ? promedio > promedio_elegido : promedio < promedio_elegido))
         {
-            printf("No hay datos disponibles.\n");
+            anio_elegido = anio;
+            partidos_elegido = partidos;
+            promedio_elegido = promedio;
         }
-        sqlite3_finalize(stmt);
+    }
+
+    if (partidos_elegido > 0)
+    {
+        printf("Anio: %d\n", anio_elegido);
+        printf("Rendimiento Promedio: %.2f\n", redondear(promedio_elegido, 2));
+        printf("Partidos Jugados: %d\n", partidos_elegido);
+    }
+    else
+    {
+        printf("No hay datos disponibles.\n");
     }
 }
 
@@ -148,13 +245,7 @@ void mostrar_mejor_combinacion_cancha_camiseta()
     clear_screen();
     print_header("MEJOR COMBINACION CANCHA + CAMISETA");
 
-    mostrar_combinacion("Mejor Combinacion Cancha + Camiseta",
-                        "SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) "
-                        "FROM partido p "
-                        "JOIN cancha ca ON p.cancha_id = ca.id "
-                        "JOIN camiseta c ON p.camiseta_id = c.id "
-                        "GROUP BY p.cancha_id, p.camiseta_id "
-                        "ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    mostrar_combinacion("Mejor Combinacion Cancha + Camiseta", 1);
 
     pause_console();
 }
@@ -167,13 +258,7 @@ void mostrar_peor_combinacion_cancha_camiseta()
     clear_screen();
     print_header("PEOR COMBINACION CANCHA + CAMISETA");
 
-    mostrar_combinacion("Peor Combinacion Cancha + Camiseta",
-                        "SELECT ca.nombre, c.nombre, ROUND(AVG(p.rendimiento_general), 2), COUNT(*) "
-                        "FROM partido p "
-                        "JOIN cancha ca ON p.cancha_id = ca.id "
-                        "JOIN camiseta c ON p.camiseta_id = c.id "
-                        "GROUP BY p.cancha_id, p.camiseta_id "
-                        "ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    mostrar_combinacion("Peor Combinacion Cancha + Camiseta", 0);
 
     pause_console();
 }
@@ -186,8 +271,7 @@ void mostrar_mejor_temporada()
     clear_screen();
     print_header("MEJOR TEMPORADA");
 
-    mostrar_temporada("Mejor Temporada",
-                      "SELECT substr(p.fecha_hora, instr(p.fecha_hora, '/') + 4, 4), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p WHERE p.fecha_hora IS NOT NULL GROUP BY substr(p.fecha_hora, instr(p.fecha_hora, '/') + 4, 4) ORDER BY AVG(p.rendimiento_general) DESC LIMIT 1");
+    mostrar_temporada("Mejor Temporada", 1);
 
     pause_console();
 }
@@ -200,8 +284,7 @@ void mostrar_peor_temporada()
     clear_screen();
     print_header("PEOR TEMPORADA");
 
-    mostrar_temporada("Peor Temporada",
-                      "SELECT substr(p.fecha_hora, instr(p.fecha_hora, '/') + 4, 4), ROUND(AVG(p.rendimiento_general), 2), COUNT(*) FROM partido p WHERE p.fecha_hora IS NOT NULL GROUP BY substr(p.fecha_hora, instr(p.fecha_hora, '/') + 4, 4) ORDER BY AVG(p.rendimiento_general) ASC LIMIT 1");
+    mostrar_temporada("Peor Temporada", 0);
 
     pause_console();
 }
@@ -333,13 +416,13 @@ static void mostrar_lista_partidos(const char *header, const char *titulo, const
     printf("\n%s\n", titulo);
     printf("----------------------------------------\n");
 
-    char sql[256];
+    char sql[512];
     snprintf(sql, sizeof(sql),
              "SELECT p.id, p.fecha_hora, c.nombre, p.goles, p.asistencias "
              "FROM partido p "
              "JOIN camiseta c ON p.camiseta_id = c.id "
              "WHERE %s "
-             "ORDER BY p.fecha_hora DESC",
+             "ORDER BY p.fecha_ts DESC, p.id DESC",
              condicion);
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, NULL) == SQLITE_OK)
@@ -390,92 +473,28 @@ void mostrar_partidos_sin_asistencias()
 }
 
 /**
- * Estructura para almacenar información de racha.
- * Necesaria para devolver múltiples valores de la función de cálculo de rachas.
+ * Muestra la mejor racha de un tipo y la que sigue en curso.
+ * Ambas salen de los tramos que mantiene el módulo de rachas.
  */
-typedef struct
+static void mostrar_racha(const char *titulo, TipoRacha tipo)
 {
-    int mejor_racha;
-    int inicio_racha;
-    int fin_racha;
-} RachaInfo;
-
-/**
- * Calcula la mejor racha consecutiva basada en condición específica.
- * Separado del display para permitir reutilización y testing independiente.
- */
-static RachaInfo calcular_mejor_racha(int tipo_racha)
-{
-    sqlite3_stmt *stmt;
-    RachaInfo resultado = {0, -1, -1};
-    int racha_actual = 0;
-    int temp_inicio = -1;
-
-    if (sqlite3_prepare_v2(db,
-                           "SELECT id, goles FROM partido ORDER BY fecha_hora ASC",
-                           -1, &stmt, NULL) != SQLITE_OK)
-    {
-        return resultado;
-    }
-
-    while (sqlite3_step(stmt) == SQLITE_ROW)
-    {
-        int id = sqlite3_column_int(stmt, 0);
-        int goles = sqlite3_column_int(stmt, 1);
-        int condicion = (tipo_racha == 1) ? (goles > 0) : (goles == 0);
-
-        if (condicion)
-        {
-            if (racha_actual == 0)
-            {
-                temp_inicio = id;
-            }
-            racha_actual++;
-            if (racha_actual > resultado.mejor_racha)
-            {
-                resultado.mejor_racha = racha_actual;
-                resultado.inicio_racha = temp_inicio;
-                resultado.fin_racha = id;
-            }
-        }
-        else
-        {
-            racha_actual = 0;
-        }
-    }
-
-    sqlite3_finalize(stmt);
-    return resultado;
-}
+    Racha mejor, actual;
 
-/**
- * Muestra información de racha en pantalla.
- * Separado del cálculo para claridad de responsabilidades.
- */
-static void mostrar_racha_info(const char *titulo, RachaInfo racha)
-{
     printf("\n%s\n", titulo);
     printf("----------------------------------------\n");
 
-    if (racha.mejor_racha > 0)
-    {
-        printf("Mejor Racha: %d partidos\n", racha.mejor_racha);
-        printf("Desde partido ID %d hasta ID %d\n", racha.inicio_racha, racha.fin_racha);
-    }
-    else
+    if (!rachas_mejor(tipo, RACHAS_TODAS, &mejor) || mejor.largo == 0)
     {
         printf("No hay rachas disponibles.\n");
+        return;
     }
-}
 
-/**
- * Función principal para mostrar rachas.
- * Coordina cálculo y display de rachas consecutivas.
- */
-static void mostrar_racha(const char *titulo, int tipo_racha)
-{
-    RachaInfo racha = calcular_mejor_racha(tipo_racha);
-    mostrar_racha_info(titulo, racha);
+    printf("Mejor Racha: %d partidos\n", mejor.largo);
+    printf("Desde partido ID %d hasta ID %d\n", mejor.id_desde, mejor.id_hasta);
+    if (rachas_actual(tipo, RACHAS_TODAS, &actual) && actual.largo > 0)
+        printf("Racha actual: %d partidos (desde partido ID %d)\n", actual.largo, actual.id_desde);
+    else
+        printf("Racha actual: 0 partidos\n");
 }
 
 /**
@@ -486,7 +505,7 @@ void mostrar_mejor_racha_goleadora()
     clear_screen();
     print_header("MEJOR RACHA GOLEADORA");
 
-    mostrar_racha("Mejor Racha Goleadora (partidos consecutivos con goles)", 1);
+    mostrar_racha("Mejor Racha Goleadora (partidos consecutivos con goles)", RACHA_CON_GOLES);
 
     pause_console();
 }
@@ -499,7 +518,7 @@ void mostrar_peor_racha()
     clear_screen();
     print_header("PEOR RACHA");
 
-    mostrar_racha("Peor Racha (partidos consecutivos sin goles)", 0);
+    mostrar_racha("Peor Racha (partidos consecutivos sin goles)", RACHA_SIN_GOLES);
 
     pause_console();
 }
@@ -512,7 +531,72 @@ void mostrar_partidos_consecutivos_anotando()
     clear_screen();
     print_header("PARTIDOS CONSECUTIVOS ANOTANDO");
 
-    mostrar_racha("Partidos Consecutivos Anotando", 1);
+    mostrar_racha("Partidos Consecutivos Anotando", RACHA_CON_GOLES);
+
+    pause_console();
+}
+
+/**
+ * @brief Muestra la racha en curso de resultados de una camiseta como "3V", "1E"...
+ */
+static void imprimir_racha_resultado_actual(int camiseta_id)
+{
+    static const char LETRAS[] = {'V', 'E', 'D'};
+
+    for (TipoRacha tipo = RACHA_VICTORIAS; tipo <= RACHA_DERROTAS; tipo++)
+    {
+        Racha actual;
+        if (rachas_actual(tipo, camiseta_id, &actual) && actual.largo > 0)
+        {
+            printf(" %7d%c\n", actual.largo, LETRAS[tipo - RACHA_VICTORIAS]);
+            return;
+        }
+    }
+    printf(" %8s\n", "-");
+}
+
+/**
+ * @brief Muestra las mejores rachas de cada camiseta
+ *
+ * Victorias, partidos seguidos con gol y con asistencia, más la racha de
+ * resultados en curso, contando solo los partidos jugados con esa camiseta.
+ */
+void mostrar_rachas_por_camiseta()
+{
+    sqlite3_stmt *stmt;
+    int filas = 0;
+
+    clear_screen();
+    print_header("RACHAS POR CAMISETA");
+
+    if (sqlite3_prepare_v2(db, "SELECT id, nombre FROM camiseta ORDER BY id", -1, &stmt, NULL) != SQLITE_OK)
+    {
+        printf("Error al consultar las camisetas.\n");
+        pause_console();
+        return;
+    }
+
+    printf("%-24s %9s %9s %9s %8s\n", "Camiseta", "Victorias", "Con gol", "Con asist", "Actual");
+    printf("---------------------------------------------------------------\n");
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        int id = sqlite3_column_int(stmt, 0);
+        const char *nombre = (const char *)sqlite3_column_text(stmt, 1);
+        Racha victorias, goles, asistencias;
+
+        if (!rachas_mejor(RACHA_VICTORIAS, id, &victorias) ||
+                !rachas_mejor(RACHA_CON_GOLES, id, &goles) ||
+                !rachas_mejor(RACHA_CON_ASISTENCIAS, id, &asistencias))
+            break;
+
+        printf("%-24.24s %9d %9d %9d", nombre ? nombre : "", victorias.largo, goles.largo, asistencias.largo);
+        imprimir_racha_resultado_actual(id);
+        filas++;
+    }
+    sqlite3_finalize(stmt);
+
+    if (filas == 0)
+        printf("No hay camisetas registradas.\n");
 
     pause_console();
 }
@@ -539,6 +623,7 @@ static MenuItem* construir_menu_records()
         {12, "Mejor Racha Goleadora", mostrar_mejor_racha_goleadora},
         {13, "Peor Racha", mostrar_peor_racha},
         {14, "Partidos Consecutivos Anotando", mostrar_partidos_consecutivos_anotando},
+        {15, "Rachas por Camiseta", mostrar_rachas_por_camiseta},
         {0, "Volver", NULL}
     };
     return items;
@@ -550,5 +635,5 @@ static MenuItem* construir_menu_records()
 void menu_records_rankings()
 {
     MenuItem *items = construir_menu_records();
-    ejecutar_menu("RECORDS & RANKINGS", items, 15);
+    ejecutar_menu("RECORDS & RANKINGS", items, 16);
 }
@@ -81,4 +81,9 @@ void mostrar_peor_racha();
  */
 void mostrar_partidos_consecutivos_anotando();
 
+/**
+ * @brief Muestra las mejores rachas y la racha en curso de cada camiseta
+ */
+void mostrar_rachas_por_camiseta();
+
 #endif /* RECORDS_RANKINGS_H */
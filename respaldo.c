@@ -0,0 +1,612 @@
+/**
+ * @file respaldo.c
+ * @brief Respaldos en caliente de la base de datos con rotacion
+ *
+ * Las instantaneas se copian desde la conexion de trabajo, asi que en modo
+ * memoria incluyen tambien los cambios que aun no se volcaron al archivo.
+ */
+
+#include "respaldo.h"
+#include "db.h"
+#include "migraciones.h"
+#include "settings.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <windows.h>
+#define MKDIR(path) _mkdir(path)
+#define SEPARADOR "\\"
+#else
+#include <sys/stat.h>
+#include <dirent.h>
+#define MKDIR(path) mkdir(path, 0755)
+#define SEPARADOR "/"
+#endif
+
+/** Parte del nombre que sigue al prefijo: AAAAMMDD_HHMMSS.db */
+#define LONGITUD_SUFIJO 18
+
+/** Longitud maxima del prefijo (nombre de la base sin extension y "_") */
+#define MAX_PREFIJO 200
+
+/** Nombre de archivo de respaldo */
+typedef char NombreRespaldo[MAX_PREFIJO + LONGITUD_SUFIJO + 1];
+
+/** Directorio de respaldos (se crea en el primer uso) */
+static char RESPALDO_DIR[1100];
+
+/** Prefijo de los respaldos de la base de trabajo, p. ej. "mifutbol_" */
+static char PREFIJO_RESPALDO[MAX_PREFIJO + 1];
+
+/**
+ * @brief Devuelve el directorio de respaldos, creandolo si hace falta
+ *
+ * Los respaldos de cada base van en el subdirectorio respaldos junto a su
+ * archivo y llevan como prefijo el nombre del archivo sin extension, de
+ * modo que las bases abiertas con --db no mezclan su historial (ni su
+ * rotacion ni sus restauraciones) con el de la base por defecto.
+ *
+ * @return Ruta del directorio, NULL si no se pudo crear
+ */
+static const char* directorio_respaldos()
+{
+    if (RESPALDO_DIR[0] == '\0')
+    {
+        const char *ruta = db_get_ruta();
+        const char *base = ruta;
+        size_t largo;
+
+        for (const char *p = ruta; *p; p++)
+        {
+            if (*p == '/' || *p == '\\')
+                base = p + 1;
+        }
+        largo = strcspn(base, ".");
+        if (largo == 0 || largo >= MAX_PREFIJO)
+        {
+            printf("Nombre de base de datos no valido para respaldos: %s\n", ruta);
+            return NULL;
+        }
+        snprintf(PREFIJO_RESPALDO, sizeof(PREFIJO_RESPALDO), "%.*s_", (int)largo, base);
+
+        if (base == ruta)
+            snprintf(RESPALDO_DIR, sizeof(RESPALDO_DIR), "respaldos");
+        else
+            snprintf(RESPALDO_DIR, sizeof(RESPALDO_DIR), "%.*srespaldos", (int)(base - ruta), ruta);
+        if (MKDIR(RESPALDO_DIR) != 0 && errno != EEXIST)
+        {
+            printf("Error creando directorio de respaldos: %s\n", strerror(errno));
+            RESPALDO_DIR[0] = '\0';
+            return NULL;
+        }
+    }
+    return RESPALDO_DIR;
+}
+
+/**
+ * @brief Parte AAAAMMDD_HHMMSS.db de un nombre de respaldo
+ */
+static const char* sufijo_respaldo(const char *nombre)
+{
+    return nombre + strlen(PREFIJO_RESPALDO);
+}
+
+/**
+ * @brief Comprueba que un nombre sigue el patron <prefijo>AAAAMMDD_HHMMSS.db
+ *
+ * Solo acepta respaldos de la base de trabajo y evita que una restauracion
+ * reciba rutas fuera del directorio.
+ */
+static int es_nombre_respaldo(const char *nombre)
+{
+    size_t n;
+    const char *sufijo;
+
+    // El prefijo se calcula junto con el directorio
+    if (!directorio_respaldos())
+        return 0;
+    n = strlen(PREFIJO_RESPALDO);
+    sufijo = nombre + n;
+    if (strlen(nombre) != n + LONGITUD_SUFIJO || strncmp(nombre, PREFIJO_RESPALDO, n) != 0)
+        return 0;
+    for (int i = 0; i < 15; i++)
+    {
+        if (i == 8)
+        {
+            if (sufijo[i] != '_')
+                return 0;
+        }
+        else if (sufijo[i] < '0' || sufijo[i] > '9')
+        {
+            return 0;
+        }
+    }
+    return strcmp(sufijo + 15, ".db") == 0;
+}
+
+/**
+ * @brief Numero de dia (desde 1970) de la fecha codificada en el nombre
+ */
+static long dia_de_respaldo(const char *nombre)
+{
+    struct tm fecha;
+    int anio, mes, dia;
+
+    if (sscanf(sufijo_respaldo(nombre), "%4d%2d%2d", &anio, &mes, &dia) != 3)
+        return 0;
+
+    memset(&fecha, 0, sizeof(fecha));
+    fecha.tm_year = anio - 1900;
+    fecha.tm_mon = mes - 1;
+    fecha.tm_mday = dia;
+    fecha.tm_hour = 12;
+    fecha.tm_isdst = -1;
+    return (long)(mktime(&fecha) / 86400);
+}
+
+static int comparar_desc(const void *a, const void *b)
+{
+    return strcmp((const char*)b, (const char*)a);
+}
+
+/**
+ * @brief Anade un nombre a la lista si es un respaldo, ampliandola si hace falta
+ *
+ * @return 0 si no hubo memoria, 1 en caso contrario
+ */
+static int agregar_nombre(NombreRespaldo **nombres, int *n, int *capacidad, const char *nombre)
+{
+    if (!es_nombre_respaldo(nombre))
+        return 1;
+    if (*n == *capacidad)
+    {
+        int nueva = *capacidad ? *capacidad * 2 : 32;
+        NombreRespaldo *tmp = realloc(*nombres, nueva * sizeof(NombreRespaldo));
+        if (!tmp)
+            return 0;
+        *nombres = tmp;
+        *capacidad = nueva;
+    }
+    strcpy((*nombres)[(*n)++], nombre);
+    return 1;
+}
+
+/**
+ * @brief Lista los respaldos del directorio, del mas reciente al mas antiguo
+ *
+ * @param lista Recibe un arreglo reservado con malloc (liberar con free)
+ * @return Numero de respaldos, -1 en caso de error
+ */
+static int listar_nombres(NombreRespaldo **lista)
+{
+    const char *dir = directorio_respaldos();
+    NombreRespaldo *nombres = NULL;
+    int n = 0, capacidad = 0;
+
+    *lista = NULL;
+    if (!dir)
+        return -1;
+
+#ifdef _WIN32
+    char patron[1400];
+    WIN32_FIND_DATAA datos;
+    HANDLE h;
+
+    snprintf(patron, sizeof(patron), "%s\\%s*.db", dir, PREFIJO_RESPALDO);
+    h = FindFirstFileA(patron, &datos);
+    if (h != INVALID_HANDLE_VALUE)
+    {
+        while (agregar_nombre(&nombres, &n, &capacidad, datos.cFileName) && FindNextFileA(h, &datos))
+            ;
+        FindClose(h);
+    }
+#else
+    DIR *d = opendir(dir);
+    struct dirent *entrada;
+
+    if (!d)
+        return -1;
+    while ((entrada = readdir(d)) != NULL && agregar_nombre(&nombres, &n, &capacidad, entrada->d_name))
+        ;
+    closedir(d);
+#endif
+
+    if (n > 1)
+        qsort(nombres, n, sizeof(NombreRespaldo), comparar_desc);
+    *lista = nombres;
+    return n;
+}
+
+/**
+ * @brief Comprueba la integridad de una base con PRAGMA quick_check
+ *
+ * @return 1 si la base esta sana, 0 en caso contrario
+ */
+static int verificar_integridad(sqlite3 *conexion)
+{
+    sqlite3_stmt *stmt;
+    int ok = 0;
+
+    if (sqlite3_prepare_v2(conexion, "PRAGMA quick_check;", -1, &stmt, NULL) == SQLITE_OK)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            const char *r = (const char*)sqlite3_column_text(stmt, 0);
+            ok = r && strcmp(r, "ok") == 0;
+            if (!ok)
+                printf("Verificacion de integridad fallida: %s\n", r ? r : "?");
+        }
+        sqlite3_finalize(stmt);
+    }
+    return ok;
+}
+
+/**
+ * @brief Copia la base de trabajo en otra conexion, por tramos
+ *
+ * Entre tramos la base de trabajo queda libre; si otra conexion la
+ * modifica, SQLite reinicia la copia para que el resultado sea consistente.
+ */
+static int copiar_por_tramos(sqlite3 *destino)
+{
+    sqlite3_backup *backup = sqlite3_backup_init(destino, "main", db, "main");
+    int rc;
+    int ultimo_decil = -1;
+
+    if (!backup)
+    {
+        printf("Error iniciando respaldo: %s\n", sqlite3_errmsg(destino));
+        return 0;
+    }
+
+    do
+    {
+        rc = sqlite3_backup_step(backup, RESPALDO_PAGINAS_POR_PASO);
+        if (rc == SQLITE_BUSY || rc == SQLITE_LOCKED)
+        {
+            sqlite3_sleep(10);
+            continue;
+        }
+
+        int total = sqlite3_backup_pagecount(backup);
+        if (rc == SQLITE_OK && total > 16 * RESPALDO_PAGINAS_POR_PASO)
+        {
+            int decil = (int)(10LL * (total - sqlite3_backup_remaining(backup)) / total);
+            if (decil != ultimo_decil)
+            {
+                printf("\rCopiando... %3d%%", decil * 10);
+                fflush(stdout);
+                ultimo_decil = decil;
+            }
+        }
+    }
+    while (rc == SQLITE_OK || rc == SQLITE_BUSY || rc == SQLITE_LOCKED);
+
+    if (ultimo_decil >= 0)
+        printf("\rCopiando... 100%%\n");
+
+    if (sqlite3_backup_finish(backup) != SQLITE_OK || rc != SQLITE_DONE)
+    {
+        printf("Error copiando la base de datos: %s\n", sqlite3_errmsg(destino));
+        return 0;
+    }
+    return 1;
+}
+
+int respaldo_crear(char *ruta, int tam)
+{
+    const char *dir = directorio_respaldos();
+    NombreRespaldo nombre;
+    char marca[LONGITUD_SUFIJO + 1];
+    char final[1400];
+    char temporal[1410];
+    sqlite3 *destino;
+    time_t ahora = time(NULL);
+    double inicio = get_time_ms();
+    int ok;
+
+    if (!dir)
+        return 0;
+    if (db_transaccion_nivel() > 0)
+    {
+        printf("No se puede crear un respaldo con una transaccion en curso.\n");
+        return 0;
+    }
+
+    // Dos respaldos en el mismo segundo no deben pisarse (p. ej. al restaurar)
+    for (;;)
+    {
+        FILE *existente;
+
+        strftime(marca, sizeof(marca), "%Y%m%d_%H%M%S.db", localtime(&ahora));
+        snprintf(nombre, sizeof(nombre), "%s%s", PREFIJO_RESPALDO, marca);
+        snprintf(final, sizeof(final), "%s" SEPARADOR "%s", dir, nombre);
+        existente = fopen(final, "rb");
+        if (!existente)
+            break;
+        fclose(existente);
+        ahora++;
+    }
+    snprintf(temporal, sizeof(temporal), "%s.tmp", final);
+    remove(temporal);
+
+    if (sqlite3_open(temporal, &destino) != SQLITE_OK)
+    {
+        printf("Error creando %s: %s\n", temporal, sqlite3_errmsg(destino));
+        sqlite3_close(destino);
+        return 0;
+    }
+
+    ok = copiar_por_tramos(destino) && verificar_integridad(destino);
+
+    // La copia hereda el modo WAL del origen; el respaldo debe ser un unico archivo
+    if (ok && sqlite3_exec(destino, "PRAGMA journal_mode=DELETE;", NULL, NULL, NULL) != SQLITE_OK)
+        ok = 0;
+    if (sqlite3_close(destino) != SQLITE_OK)
+        ok = 0;
+    if (ok)
+    {
+        if (rename(temporal, final) != 0)
+        {
+            printf("Error renombrando respaldo: %s\n", strerror(errno));
+            ok = 0;
+        }
+    }
+    if (!ok)
+    {
+        remove(temporal);
+        return 0;
+    }
+
+    printf("Respaldo creado: %s (%.1f ms)\n", final, get_time_ms() - inicio);
+    if (ruta && tam > 0)
+        snprintf(ruta, tam, "%s", final);
+    return 1;
+}
+
+int respaldo_rotar(int diarios, int semanales)
+{
+    NombreRespaldo *lista;
+    int n = listar_nombres(&lista);
+    long ultimo_dia = -1, ultima_semana = -1;
+    int dias = 0, semanas = 0, borrados = 0;
+
+    if (n < 0)
+        return -1;
+
+    // La lista va del mas reciente al mas antiguo: el primero de cada dia
+    // o semana es el que se conserva para ese periodo
+    for (int i = 0; i < n; i++)
+    {
+        long dia = dia_de_respaldo(lista[i]);
+        long semana = (dia + 3) / 7;   // 1970-01-01 fue jueves: semanas de lunes a domingo
+        int conservar = 0;
+
+        if (dia != ultimo_dia)
+        {
+            ultimo_dia = dia;
+            if (dias < diarios)
+            {
+                dias++;
+                conservar = 1;
+            }
+        }
+        if (semana != ultima_semana)
+        {
+            ultima_semana = semana;
+            if (semanas < semanales)
+            {
+                semanas++;
+                conservar = 1;
+            }
+        }
+
+        if (!conservar)
+        {
+            char ruta[1400];
+            snprintf(ruta, sizeof(ruta), "%s" SEPARADOR "%s", directorio_respaldos(), lista[i]);
+            if (remove(ruta) == 0)
+                borrados++;
+            else
+                printf("No se pudo borrar %s: %s\n", ruta, strerror(errno));
+        }
+    }
+
+    free(lista);
+    return borrados;
+}
+
+int respaldo_listar()
+{
+    NombreRespaldo *lista;
+    int n = listar_nombres(&lista);
+
+    if (n <= 0)
+    {
+        printf("No hay respaldos en %s\n", directorio_respaldos() ? directorio_respaldos() : "?");
+        free(lista);
+        return 0;
+    }
+
+    printf("Respaldos en %s:\n\n", directorio_respaldos());
+    for (int i = 0; i < n; i++)
+    {
+        const char *s = sufijo_respaldo(lista[i]);
+        printf("%3d. %s   %.2s/%.2s/%.4s %.2s:%.2s:%.2s\n", i + 1, lista[i],
+               s + 6, s + 4, s, s + 9, s + 11, s + 13);
+    }
+
+    free(lista);
+    return n;
+}
+
+int respaldo_restaurar(const char *nombre)
+{
+    char ruta[1400];
+    sqlite3 *origen;
+    sqlite3_stmt *stmt;
+    int version = -1;
+    int ok;
+
+    if (!es_nombre_respaldo(nombre) || !directorio_respaldos())
+    {
+        printf("Nombre de respaldo invalido: %s\n", nombre);
+        return 0;
+    }
+    snprintf(ruta, sizeof(ruta), "%s" SEPARADOR "%s", directorio_respaldos(), nombre);
+
+    // Validar el respaldo antes de tocar la base de trabajo
+    if (sqlite3_open_v2(ruta, &origen, SQLITE_OPEN_READONLY, NULL) != SQLITE_OK)
+    {
+        printf("Error abriendo %s: %s\n", ruta, sqlite3_errmsg(origen));
+        sqlite3_close(origen);
+        return 0;
+    }
+    ok = verificar_integridad(origen);
+    if (ok && sqlite3_prepare_v2(origen, "PRAGMA user_version;", -1, &stmt, NULL) == SQLITE_OK)
+    {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            version = sqlite3_column_int(stmt, 0);
+        sqlite3_finalize(stmt);
+    }
+    sqlite3_close(origen);
+
+    if (!ok)
+        return 0;
+    if (version > migraciones_version_objetivo())
+    {
+        printf("El respaldo tiene un esquema mas nuevo (%d) que esta version (%d).\n",
+               version, migraciones_version_objetivo());
+        return 0;
+    }
+
+    printf("Guardando el estado actual antes de restaurar...\n");
+    if (!respaldo_crear(NULL, 0))
+        return 0;
+
+    if (!db_restaurar_desde(ruta))
+    {
+        printf("Error restaurando el respaldo %s\n", nombre);
+        return 0;
+    }
+
+    // Las preferencias tambien vienen del respaldo
+    settings_init();
+    db_set_reutilizar_ids(settings_get()->reutilizar_ids);
+
+    printf("Respaldo %s restaurado.\n", nombre);
+    return 1;
+}
+
+int respaldo_automatico()
+{
+    NombreRespaldo *lista;
+    char hoy[16];
+    time_t ahora = time(NULL);
+    int n = listar_nombres(&lista);
+    int ok = 1;
+
+    if (n < 0)
+        return 0;
+
+    strftime(hoy, sizeof(hoy), "%Y%m%d", localtime(&ahora));
+    if (n == 0 || strncmp(sufijo_respaldo(lista[0]), hoy, 8) != 0)
+        ok = respaldo_crear(NULL, 0);
+    free(lista);
+
+    if (ok)
+        respaldo_rotar(RESPALDO_DIARIOS, RESPALDO_SEMANALES);
+    return ok;
+}
+
+/**
+ * @brief Pide el numero de un respaldo de la lista y lo restaura
+ */
+static void restaurar_desde_menu()
+{
+    NombreRespaldo *lista;
+    int n;
+
+    clear_screen();
+    print_header("RESTAURAR RESPALDO");
+
+    n = respaldo_listar();
+    if (n == 0)
+    {
+        pause_console();
+        return;
+    }
+
+    int opcion = input_int("\nNumero de respaldo a restaurar (0 para cancelar): ");
+    if (opcion <= 0 || opcion > n)
+        return;
+
+    if (listar_nombres(&lista) < opcion)
+    {
+        free(lista);
+        return;
+    }
+
+    printf("\nLa base de datos actual se reemplazara por %s.\n", lista[opcion - 1]);
+    if (confirmar("Continuar con la restauracion"))
+        respaldo_restaurar(lista[opcion - 1]);
+    else
+        printf("Restauracion cancelada.\n");
+
+    free(lista);
+    pause_console();
+}
+
+void menu_respaldos()
+{
+    int opcion;
+    do
+    {
+        clear_screen();
+        print_header("RESPALDOS");
+
+        printf("Se conservan los ultimos %d dias y %d semanas.\n\n", RESPALDO_DIARIOS, RESPALDO_SEMANALES);
+        printf("1. Crear respaldo ahora\n");
+        printf("2. Ver respaldos\n");
+        printf("3. Restaurar respaldo\n");
+        printf("4. Aplicar rotacion\n");
+        printf("0. Volver\n");
+
+        opcion = input_int("> ");
+
+        switch (opcion)
+        {
+        case 1:
+            respaldo_crear(NULL, 0);
+            pause_console();
+            break;
+        case 2:
+            respaldo_listar();
+            pause_console();
+            break;
+        case 3:
+            restaurar_desde_menu();
+            break;
+        case 4:
+        {
+            int borrados = respaldo_rotar(RESPALDO_DIARIOS, RESPALDO_SEMANALES);
+            if (borrados >= 0)
+                printf("Respaldos borrados: %d\n", borrados);
+            pause_console();
+            break;
+        }
+        case 0:
+            break;
+        default:
+            printf("Opcion invalida.\n");
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+}
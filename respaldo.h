@@ -0,0 +1,83 @@
+/**
+ * @file respaldo.h
+ * @brief Respaldos en caliente de la base de datos con rotacion
+ *
+ * Toma instantaneas consistentes de la base de trabajo con la API de backup
+ * de SQLite, copiando en tramos pequenos para no bloquear la base durante
+ * toda la copia. Las instantaneas se guardan en el subdirectorio respaldos
+ * junto al archivo de la base, con el nombre de ese archivo como prefijo,
+ * y se rotan conservando las ultimas diarias y semanales. Cada base tiene
+ * asi su propio historial. A diferencia de las exportaciones, incluyen
+ * todas las tablas.
+ */
+
+#ifndef RESPALDO_H
+#define RESPALDO_H
+
+/** Dias distintos cuyo respaldo mas reciente se conserva */
+#define RESPALDO_DIARIOS 7
+
+/** Semanas distintas cuyo respaldo mas reciente se conserva */
+#define RESPALDO_SEMANALES 4
+
+/** Paginas copiadas por cada paso del respaldo */
+#define RESPALDO_PAGINAS_POR_PASO 64
+
+/**
+ * @brief Crea una instantanea de la base de trabajo
+ *
+ * La copia se escribe en un archivo temporal, se verifica con
+ * PRAGMA quick_check y solo entonces recibe su nombre definitivo
+ * (<base>_AAAAMMDD_HHMMSS.db, p. ej. mifutbol_20260920_183000.db).
+ *
+ * @param ruta Buffer donde se devuelve la ruta creada (puede ser NULL)
+ * @param tam Tamano del buffer
+ * @return 1 si exito, 0 en caso de error
+ */
+int respaldo_crear(char *ruta, int tam);
+
+/**
+ * @brief Borra los respaldos que no cubre la politica de retencion
+ *
+ * Conserva el respaldo mas reciente de cada uno de los ultimos
+ * diarios dias y de cada una de las ultimas semanales semanas.
+ *
+ * @param diarios Numero de dias a conservar
+ * @param semanales Numero de semanas a conservar
+ * @return Numero de respaldos borrados, -1 en caso de error
+ */
+int respaldo_rotar(int diarios, int semanales);
+
+/**
+ * @brief Muestra los respaldos disponibles, del mas reciente al mas antiguo
+ *
+ * @return Numero de respaldos encontrados
+ */
+int respaldo_listar();
+
+/**
+ * @brief Restaura la base de trabajo desde un respaldo
+ *
+ * Verifica la integridad del respaldo y guarda antes una instantanea del
+ * estado actual, de modo que la restauracion tambien puede deshacerse.
+ *
+ * @param nombre Nombre del archivo de respaldo (sin directorio)
+ * @return 1 si exito, 0 en caso de error
+ */
+int respaldo_restaurar(const char *nombre);
+
+/**
+ * @brief Crea el respaldo del dia si aun no existe y aplica la rotacion
+ *
+ * Se invoca al iniciar la sesion interactiva.
+ *
+ * @return 1 si exito o si ya habia respaldo del dia, 0 en caso de error
+ */
+int respaldo_automatico();
+
+/**
+ * @brief Menu de gestion de respaldos
+ */
+void menu_respaldos();
+
+#endif
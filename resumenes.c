@@ -0,0 +1,160 @@
+/**
+ * @file resumenes.c
+ * @brief Resumenes de partido mantenidos por triggers
+ *
+ * Ver resumenes.h. La tabla y sus triggers se crean en la migracion 11;
+ * aqui se rellenan desde cero y se verifican contra un recalculo completo.
+ */
+
+#include "resumenes.h"
+#include "db.h"
+#include "utils.h"
+#include <stdio.h>
+
+/** Columnas agregadas de resumen_partido, en su orden, calculadas sobre partido p */
+#define SQL_AGREGADOS_RESUMEN \
+    "COUNT(*), " \
+    "SUM(COALESCE(p.goles, 0)), SUM(COALESCE(p.goles, 0) * COALESCE(p.goles, 0)), " \
+    "SUM(COALESCE(p.asistencias, 0)), SUM(COALESCE(p.asistencias, 0) * COALESCE(p.asistencias, 0)), " \
+    "SUM(COALESCE(p.rendimiento_general, 0)), SUM(COALESCE(p.rendimiento_general, 0) * COALESCE(p.rendimiento_general, 0)), " \
+    "SUM(COALESCE(p.cansancio, 0)), SUM(COALESCE(p.cansancio, 0) * COALESCE(p.cansancio, 0)), " \
+    "SUM(COALESCE(p.estado_animo, 0)), SUM(COALESCE(p.estado_animo, 0) * COALESCE(p.estado_animo, 0)), " \
+    "SUM(CASE WHEN p.resultado = 1 THEN 1 ELSE 0 END), " \
+    "SUM(CASE WHEN p.resultado = 2 THEN 1 ELSE 0 END), " \
+    "SUM(CASE WHEN p.resultado = 3 THEN 1 ELSE 0 END)"
+
+/** Filas de una dimension recalculadas desde partido */
+#define SQL_RECALCULO_DIMENSION(dimension, clave) \
+    "SELECT '" dimension "' AS dimension, " clave ", COALESCE(p.camiseta_id, 0), " SQL_AGREGADOS_RESUMEN \
+    " FROM partido p GROUP BY 2, 3"
+
+/** Contenido que deberia tener resumen_partido, con sus mismas columnas */
+#define SQL_RECALCULO_RESUMEN \
+    SQL_RECALCULO_DIMENSION("mes", RESUMEN_CLAVE_MES("p")) " UNION ALL " \
+    SQL_RECALCULO_DIMENSION("cancha", RESUMEN_CLAVE_CANCHA("p")) " UNION ALL " \
+    SQL_RECALCULO_DIMENSION("clima", RESUMEN_CLAVE_CLIMA("p")) " UNION ALL " \
+    SQL_RECALCULO_DIMENSION("dia", RESUMEN_CLAVE_DIA("p"))
+
+/**
+ * @brief Rellena resumen_partido desde partido
+ */
+int resumenes_llenar()
+{
+    if (sqlite3_exec(db,
+                     "DELETE FROM resumen_partido;"
+                     "INSERT INTO resumen_partido " SQL_RECALCULO_RESUMEN ";",
+                     0, 0, 0) != SQLITE_OK)
+    {
+        printf("Error recalculando resumenes: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Compara resumen_partido con un recalculo desde partido
+ *
+ * Cuenta por dimension las filas que faltan o sobran en cualquiera de los
+ * dos lados; una fila con algun total distinto cuenta dos veces.
+ */
+int resumenes_verificar(int detallado)
+{
+    sqlite3_stmt *stmt;
+    int diferencias = 0;
+    int rc;
+
+    if (sqlite3_prepare_v2(db,
+                           "WITH recalculo AS (" SQL_RECALCULO_RESUMEN "), "
+                           "faltan AS (SELECT * FROM recalculo EXCEPT SELECT * FROM resumen_partido), "
+                           "sobran AS (SELECT * FROM resumen_partido EXCEPT SELECT * FROM recalculo) "
+                           "SELECT dimension, COUNT(*) FROM "
+                           "(SELECT dimension FROM faltan UNION ALL SELECT dimension FROM sobran) "
+                           "GROUP BY dimension ORDER BY dimension",
+                           -1, &stmt, NULL) != SQLITE_OK)
+    {
+        printf("Error verificando resumenes: %s\n", sqlite3_errmsg(db));
+        return -1;
+    }
+
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        int filas = sqlite3_column_int(stmt, 1);
+
+        if (detallado)
+            printf("  %-8s %d filas distintas\n", (const char *)sqlite3_column_text(stmt, 0), filas);
+        diferencias += filas;
+    }
+    sqlite3_finalize(stmt);
+
+    if (rc != SQLITE_DONE)
+    {
+        printf("Error verificando resumenes: %s\n", sqlite3_errmsg(db));
+        return -1;
+    }
+    if (detallado)
+    {
+        if (diferencias == 0)
+            printf("Los resumenes coinciden con los partidos.\n");
+        else
+            printf("Los resumenes no coinciden con los partidos (%d filas distintas).\n", diferencias);
+    }
+    return diferencias;
+}
+
+/**
+ * @brief Verifica los resumenes y los recalcula dentro de una transaccion
+ */
+int resumenes_reconstruir()
+{
+    double inicio;
+
+    if (resumenes_verificar(1) < 0)
+        return 0;
+
+    inicio = get_time_ms();
+    if (!db_begin())
+        return 0;
+    if (!resumenes_llenar() || !db_commit())
+    {
+        printf("Error recalculando resumenes: %s\n", sqlite3_errmsg(db));
+        db_rollback();
+        return 0;
+    }
+
+    printf("Resumenes recalculados en %.1f ms.\n", get_time_ms() - inicio);
+    return 1;
+}
+
+void menu_resumenes()
+{
+    int opcion;
+    do
+    {
+        clear_screen();
+        print_header("RESUMENES ESTADISTICOS");
+
+        printf("1. Verificar contra los partidos\n");
+        printf("2. Reconstruir\n");
+        printf("0. Volver\n");
+
+        opcion = input_int("> ");
+
+        switch (opcion)
+        {
+        case 1:
+            resumenes_verificar(1);
+            pause_console();
+            break;
+        case 2:
+            resumenes_reconstruir();
+            pause_console();
+            break;
+        case 0:
+            break;
+        default:
+            printf("Opcion invalida.\n");
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file resumenes.h
+ * @brief Resumenes de partido mantenidos por triggers
+ *
+ * La tabla resumen_partido guarda, por dimension (mes, cancha, clima o dia
+ * de la semana), clave y camiseta, el numero de partidos y las sumas y
+ * sumas de cuadrados de goles, asistencias, rendimiento, cansancio y animo,
+ * ademas del conteo de victorias, empates y derrotas. Los triggers de la
+ * migracion 11 la mantienen exacta en cada alta, modificacion y baja, de
+ * modo que las pantallas por anio, mes, clima y dia leen unas pocas filas
+ * agregadas en lugar de agrupar toda la tabla partido.
+ *
+ * Las expresiones de clave se comparten entre los triggers y la
+ * reconstruccion para que ambos caminos agrupen exactamente igual.
+ */
+
+#ifndef RESUMENES_H
+#define RESUMENES_H
+
+/**
+ * @brief Marca temporal con la que se agrupa un partido
+ *
+ * Solo la columna guardada: las claves no llaman a funciones propias de la
+ * aplicacion, asi otros clientes de SQLite pueden escribir en partido.
+ * Durante el alta fecha_ts aun es NULL y el partido cae en la clave 0; el
+ * UPDATE de trg_partido_fecha_ts_ins lo mueve despues a su mes y dia.
+ */
+#define RESUMEN_TS(fila) fila ".fecha_ts"
+
+/** Clave de la dimension mes: AAAAMM, 0 si la fecha no es valida */
+#define RESUMEN_CLAVE_MES(fila) "COALESCE(CAST(strftime('%Y%m', " RESUMEN_TS(fila) ", 'unixepoch') AS INTEGER), 0)"
+
+/** Clave de la dimension dia: dia de la semana (0 domingo), -1 si la fecha no es valida */
+#define RESUMEN_CLAVE_DIA(fila) "COALESCE(CAST(strftime('%w', " RESUMEN_TS(fila) ", 'unixepoch') AS INTEGER), -1)"
+
+/** Clave de la dimension cancha */
+#define RESUMEN_CLAVE_CANCHA(fila) "COALESCE(" fila ".cancha_id, 0)"
+
+/** Clave de la dimension clima */
+#define RESUMEN_CLAVE_CLIMA(fila) "COALESCE(" fila ".clima, 0)"
+
+/**
+ * @brief Rellena resumen_partido desde partido
+ *
+ * Borra el contenido actual y lo recalcula con una pasada por dimension.
+ * No abre transaccion propia: la migracion que crea la tabla la invoca
+ * dentro de la suya.
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+int resumenes_llenar();
+
+/**
+ * @brief Compara resumen_partido con un recalculo desde partido
+ *
+ * @param detallado 1 para mostrar las filas distintas por dimension
+ * @return Numero de filas distintas (0 si coinciden), -1 en caso de error
+ */
+int resumenes_verificar(int detallado);
+
+/**
+ * @brief Verifica los resumenes y los recalcula dentro de una transaccion
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+int resumenes_reconstruir();
+
+/**
+ * @brief Menu de verificacion y reconstruccion de resumenes
+ */
+void menu_resumenes();
+
+#endif
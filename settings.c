@@ -7,9 +7,13 @@
 
 #include "settings.h"
 #include "db.h"
+#include "migraciones.h"
 #include "utils.h"
 #include "menu.h"
 #include "ascii_art.h"
+#include "respaldo.h"
+#include "resumenes.h"
+#include "forma.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -18,7 +22,7 @@
 #endif
 
 // Configuracion global
-static AppSettings current_settings = {THEME_LIGHT, LANG_SPANISH};
+static AppSettings current_settings = {THEME_LIGHT, LANG_SPANISH, DB_PERFIL_DURABLE, 1, 0, TAMANO_PAGINA_DEFECTO, FORMA_VENTANA_DEFECTO, 0};
 
 // Textos en diferentes idiomas
 typedef struct
@@ -70,6 +74,27 @@ static const TextEntry text_entries[] =
     {"reset_success", "Configuracion restablecida a valores por defecto.", "Settings reset to default values."},
     {"show_current", "Ver Configuracion Actual", "Show Current Settings"},
     {"reset_defaults", "Restablecer a Valores por Defecto", "Reset to Default Values"},
+    {"db_diagnostics", "Diagnostico de Base de Datos", "Database Diagnostics"},
+    {"settings_db_profile", "Perfil de Base de Datos", "Database Profile"},
+    {"db_profile_durable", "Durable (uso normal)", "Durable (normal use)"},
+    {"db_profile_max", "Maximo rendimiento (cargas masivas)", "Max throughput (bulk loads)"},
+    {"settings_reuse_ids", "Reutilizar IDs borrados", "Reuse Deleted IDs"},
+    {"reuse_ids_on", "Activado (rellenar huecos)", "Enabled (fill gaps)"},
+    {"reuse_ids_off", "Desactivado (siempre el siguiente al mayor)", "Disabled (always after the highest)"},
+    {"settings_memory_mode", "Base de datos en memoria", "In-Memory Database"},
+    {"memory_on", "Activado (se aplica al reiniciar)", "Enabled (applies on restart)"},
+    {"memory_off", "Desactivado", "Disabled"},
+    {"memory_save_now", "Guardar en disco ahora", "Save to disk now"},
+    {"memory_saved", "Base de datos guardada en disco.", "Database saved to disk."},
+    {"memory_save_error", "No se pudo guardar la base de datos en disco.", "Could not save the database to disk."},
+    {"memory_not_active", "El modo memoria no esta activo en esta sesion.", "In-memory mode is not active in this session."},
+    {"settings_page_size", "Filas por pagina en listados", "Rows Per Page in Listings"},
+    {"page_size_prompt", "Filas por pagina", "Rows per page"},
+    {"settings_backups", "Respaldos de la base de datos", "Database Backups"},
+    {"settings_rollups", "Resumenes estadisticos", "Statistics Rollups"},
+    {"settings_form", "Ventana de forma", "Form Window"},
+    {"form_window_prompt", "Partidos de la ventana de forma", "Form window matches"},
+    {"form_half_life_prompt", "Vida media del decaimiento (partidos, 0 = sin decaimiento)", "Decay half-life (matches, 0 = no decay)"},
     {"welcome_message", "Bienvenido De Vuelta, %s\n", "Welcome Back, %s\n"},
     {NULL, NULL, NULL} // Terminador
 };
@@ -80,7 +105,7 @@ static const TextEntry text_entries[] =
 void settings_init()
 {
     sqlite3_stmt *stmt;
-    const char *sql = "SELECT theme, language FROM settings WHERE id = 1;";
+    const char *sql = "SELECT theme, language, perfil_db, reutilizar_ids, modo_memoria, tamano_pagina, ventana_forma, vida_media_forma FROM settings WHERE id = 1;";
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK)
     {
@@ -88,6 +113,12 @@ void settings_init()
         {
             current_settings.theme = sqlite3_column_int(stmt, 0);
             current_settings.language = sqlite3_column_int(stmt, 1);
+            current_settings.perfil_db = sqlite3_column_int(stmt, 2);
+            current_settings.reutilizar_ids = sqlite3_column_int(stmt, 3);
+            current_settings.modo_memoria = sqlite3_column_int(stmt, 4);
+            current_settings.tamano_pagina = sqlite3_column_int(stmt, 5);
+            current_settings.ventana_forma = sqlite3_column_int(stmt, 6);
+            current_settings.vida_media_forma = sqlite3_column_int(stmt, 7);
         }
         sqlite3_finalize(stmt);
     }
@@ -102,12 +133,19 @@ void settings_init()
 void settings_save()
 {
     sqlite3_stmt *stmt;
-    const char *sql = "INSERT OR REPLACE INTO settings (id, theme, language) VALUES (1, ?, ?);";
+    // REPLACE reescribe la fila completa: toda columna de settings debe figurar aqui
+    const char *sql = "INSERT OR REPLACE INTO settings (id, theme, language, perfil_db, reutilizar_ids, modo_memoria, tamano_pagina, ventana_forma, vida_media_forma) VALUES (1, ?, ?, ?, ?, ?, ?, ?, ?);";
 
     if (sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK)
     {
         sqlite3_bind_int(stmt, 1, current_settings.theme);
         sqlite3_bind_int(stmt, 2, current_settings.language);
+        sqlite3_bind_int(stmt, 3, current_settings.perfil_db);
+        sqlite3_bind_int(stmt, 4, current_settings.reutilizar_ids);
+        sqlite3_bind_int(stmt, 5, current_settings.modo_memoria);
+        sqlite3_bind_int(stmt, 6, current_settings.tamano_pagina);
+        sqlite3_bind_int(stmt, 7, current_settings.ventana_forma);
+        sqlite3_bind_int(stmt, 8, current_settings.vida_media_forma);
         sqlite3_step(stmt);
         sqlite3_finalize(stmt);
     }
@@ -140,6 +178,66 @@ void settings_set_language(LanguageType language)
     settings_save();
 }
 
+/**
+ * @brief Establece el perfil de ajuste de la base de datos
+ */
+void settings_set_perfil_db(int perfil)
+{
+    current_settings.perfil_db = perfil;
+    settings_save();
+    db_aplicar_perfil((DbPerfil)perfil);
+}
+
+/**
+ * @brief Establece la politica de reutilizacion de IDs
+ */
+void settings_set_reutilizar_ids(int activar)
+{
+    current_settings.reutilizar_ids = activar ? 1 : 0;
+    settings_save();
+    db_set_reutilizar_ids(current_settings.reutilizar_ids);
+}
+
+/**
+ * @brief Establece la preferencia de modo memoria
+ *
+ * Solo se guarda: la conexion se abre en memoria en el siguiente inicio.
+ */
+void settings_set_modo_memoria(int activar)
+{
+    current_settings.modo_memoria = activar ? 1 : 0;
+    settings_save();
+}
+
+/**
+ * @brief Establece el tamano de pagina de los listados, acotado a los limites
+ */
+void settings_set_tamano_pagina(int filas)
+{
+    if (filas < TAMANO_PAGINA_MIN)
+        filas = TAMANO_PAGINA_MIN;
+    if (filas > TAMANO_PAGINA_MAX)
+        filas = TAMANO_PAGINA_MAX;
+    current_settings.tamano_pagina = filas;
+    settings_save();
+}
+
+/**
+ * @brief Establece la ventana y el decaimiento de la forma
+ */
+void settings_set_forma(int ventana, int vida_media)
+{
+    if (!forma_ventana_valida(ventana))
+        ventana = FORMA_VENTANA_DEFECTO;
+    if (vida_media < 0)
+        vida_media = 0;
+    if (vida_media > FORMA_VIDA_MEDIA_MAX)
+        vida_media = FORMA_VIDA_MEDIA_MAX;
+    current_settings.ventana_forma = ventana;
+    current_settings.vida_media_forma = vida_media;
+    settings_save();
+}
+
 /**
  * @brief Aplica el tema actual a la consola
  */
@@ -426,6 +524,175 @@ static void menu_language_settings()
     while (opcion != 0);
 }
 
+/**
+ * @brief Submenú para el perfil de ajuste de la base de datos
+ */
+static void menu_db_profile_settings()
+{
+    int opcion;
+    do
+    {
+        clear_screen();
+        print_header(get_text("settings_db_profile"));
+
+        db_mostrar_pragmas();
+        printf("\n");
+        printf("1. %s\n", get_text("db_profile_durable"));
+        printf("2. %s\n", get_text("db_profile_max"));
+        printf("0. %s\n", get_text("menu_back"));
+
+        opcion = input_int("> ");
+
+        switch (opcion)
+        {
+        case 1:
+            settings_set_perfil_db(DB_PERFIL_DURABLE);
+            printf("%s\n", get_text("settings_saved"));
+            pause_console();
+            break;
+        case 2:
+            settings_set_perfil_db(DB_PERFIL_MAX_RENDIMIENTO);
+            printf("%s\n", get_text("settings_saved"));
+            pause_console();
+            break;
+        case 0:
+            break;
+        default:
+            printf("%s\n", get_text("invalid_option"));
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+}
+
+/**
+ * @brief Submenú para la politica de reutilizacion de IDs
+ */
+static void menu_reuse_ids_settings()
+{
+    int opcion;
+    do
+    {
+        clear_screen();
+        print_header(get_text("settings_reuse_ids"));
+
+        printf("Actual: %s\n\n", current_settings.reutilizar_ids ? get_text("reuse_ids_on") : get_text("reuse_ids_off"));
+        printf("1. %s\n", get_text("reuse_ids_on"));
+        printf("2. %s\n", get_text("reuse_ids_off"));
+        printf("0. %s\n", get_text("menu_back"));
+
+        opcion = input_int("> ");
+
+        switch (opcion)
+        {
+        case 1:
+        case 2:
+            settings_set_reutilizar_ids(opcion == 1);
+            printf("%s\n", get_text("settings_saved"));
+            pause_console();
+            break;
+        case 0:
+            break;
+        default:
+            printf("%s\n", get_text("invalid_option"));
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+}
+
+/**
+ * @brief Submenú para el modo de base de datos en memoria
+ */
+static void menu_memory_mode_settings()
+{
+    int opcion;
+    do
+    {
+        clear_screen();
+        print_header(get_text("settings_memory_mode"));
+
+        printf("Actual: %s\n", current_settings.modo_memoria ? get_text("memory_on") : get_text("memory_off"));
+        printf("Sesion: %s\n\n", db_en_memoria() ? "en memoria" : "sobre el archivo");
+        printf("1. %s\n", get_text("memory_on"));
+        printf("2. %s\n", get_text("memory_off"));
+        printf("3. %s\n", get_text("memory_save_now"));
+        printf("0. %s\n", get_text("menu_back"));
+
+        opcion = input_int("> ");
+
+        switch (opcion)
+        {
+        case 1:
+        case 2:
+            settings_set_modo_memoria(opcion == 1);
+            printf("%s\n", get_text("settings_saved"));
+            pause_console();
+            break;
+        case 3:
+            if (!db_en_memoria())
+                printf("%s\n", get_text("memory_not_active"));
+            else if (db_guardar())
+                printf("%s\n", get_text("memory_saved"));
+            else
+                printf("%s\n", get_text("memory_save_error"));
+            pause_console();
+            break;
+        case 0:
+            break;
+        default:
+            printf("%s\n", get_text("invalid_option"));
+            pause_console();
+        }
+    }
+    while (opcion != 0);
+}
+
+/**
+ * @brief Submenú para el tamano de pagina de los listados
+ */
+static void menu_page_size_settings()
+{
+    clear_screen();
+    print_header(get_text("settings_page_size"));
+
+    printf("Actual: %d\n", current_settings.tamano_pagina);
+    printf("Rango: %d - %d (0 para volver)\n\n", TAMANO_PAGINA_MIN, TAMANO_PAGINA_MAX);
+
+    int filas = input_int("> ");
+    if (filas == 0)
+        return;
+
+    settings_set_tamano_pagina(filas);
+    printf("%s (%d)\n", get_text("settings_saved"), current_settings.tamano_pagina);
+    pause_console();
+}
+
+/**
+ * @brief Submenú para la ventana y el decaimiento de la forma
+ */
+static void menu_form_settings()
+{
+    clear_screen();
+    print_header(get_text("settings_form"));
+
+    printf("Actual: %d partidos, vida media %d\n", current_settings.ventana_forma, current_settings.vida_media_forma);
+    printf("Ventanas: 3, 5, 10, 20 (0 para volver)\n\n");
+
+    int ventana = input_int("> ");
+    if (ventana == 0)
+        return;
+    while (!forma_ventana_valida(ventana))
+        ventana = input_int("Ventana invalida (3, 5, 10, 20): ");
+
+    printf("%s [0 - %d]\n", get_text("form_half_life_prompt"), FORMA_VIDA_MEDIA_MAX);
+    int vida_media = input_int("> ");
+
+    settings_set_forma(ventana, vida_media);
+    printf("%s (%d / %d)\n", get_text("settings_saved"), current_settings.ventana_forma, current_settings.vida_media_forma);
+    pause_console();
+}
+
 /**
  * @brief Obtiene el nombre del tema actual
  */
@@ -464,6 +731,11 @@ static void show_current_settings()
 
     printf("Tema: %s\n", get_current_theme_name());
     printf("Idioma: %s\n", current_settings.language == LANG_SPANISH ? get_text("lang_spanish") : get_text("lang_english"));
+    printf("Perfil BD: %s\n", db_perfil_nombre((DbPerfil)current_settings.perfil_db));
+    printf("Reutilizar IDs: %s\n", current_settings.reutilizar_ids ? get_text("reuse_ids_on") : get_text("reuse_ids_off"));
+    printf("Modo memoria: %s\n", current_settings.modo_memoria ? get_text("memory_on") : get_text("memory_off"));
+    printf("%s: %d\n", get_text("page_size_prompt"), current_settings.tamano_pagina);
+    printf("%s: %d (vida media %d)\n", get_text("form_window_prompt"), current_settings.ventana_forma, current_settings.vida_media_forma);
 
     char *usuario = get_user_name();
     if (usuario)
@@ -480,6 +752,50 @@ static void show_current_settings()
     pause_console();
 }
 
+/**
+ * @brief Muestra contadores internos de la capa de base de datos
+ *
+ * Permite comprobar cuanto tiempo de compilacion SQL ahorra la cache
+ * de sentencias preparadas durante la sesion actual.
+ */
+static void show_db_diagnostics()
+{
+    DbCacheStats stats;
+    db_cache_stats(&stats);
+
+    clear_screen();
+    print_header(get_text("db_diagnostics"));
+
+    unsigned long total = stats.aciertos + stats.fallos;
+    double ms_por_compilacion = stats.fallos > 0 ? stats.ms_compilacion / (double)stats.fallos : 0.0;
+
+    printf("=== CACHE DE SENTENCIAS PREPARADAS ===\n");
+    printf("Entradas: %d / %d\n", stats.entradas, stats.capacidad);
+    printf("Aciertos: %lu\n", stats.aciertos);
+    printf("Fallos (compilaciones): %lu\n", stats.fallos);
+    printf("Tasa de aciertos: %.1f%%\n", total > 0 ? 100.0 * (double)stats.aciertos / (double)total : 0.0);
+    printf("Desalojos LRU: %lu\n", stats.desalojos);
+    printf("Entregadas sin cache: %lu\n", stats.sin_cache);
+    printf("Tiempo compilando: %.3f ms (%.3f ms por sentencia)\n", stats.ms_compilacion, ms_por_compilacion);
+    printf("Tiempo ahorrado estimado: %.3f ms\n", ms_por_compilacion * (double)stats.aciertos);
+
+    printf("\n=== CONEXION ===\n");
+    db_mostrar_pragmas();
+
+    printf("\n=== ESQUEMA ===\n");
+    printf("Version de esquema: %d (esperada %d)\n", migraciones_version_actual(), migraciones_version_objetivo());
+    printf("Tiempo de migraciones al iniciar: %.3f ms\n", migraciones_tiempo_ms());
+
+    printf("\n=== PLANES DE CONSULTA ===\n");
+    if (!migraciones_verificar_planes(0))
+    {
+        printf("Hay consultas frecuentes que no usan el indice esperado.\n");
+    }
+
+    printf("\n");
+    pause_console();
+}
+
 /**
  * @brief Restablece la configuracion a valores por defecto
  */
@@ -498,8 +814,16 @@ static void reset_settings_to_defaults()
     {
         current_settings.theme = THEME_LIGHT;
         current_settings.language = LANG_SPANISH;
+        current_settings.perfil_db = DB_PERFIL_DURABLE;
+        current_settings.reutilizar_ids = 1;
+        current_settings.modo_memoria = 0;
+        current_settings.tamano_pagina = TAMANO_PAGINA_DEFECTO;
+        current_settings.ventana_forma = FORMA_VENTANA_DEFECTO;
+        current_settings.vida_media_forma = 0;
         settings_apply_theme();
         settings_save();
+        db_aplicar_perfil(DB_PERFIL_DURABLE);
+        db_set_reutilizar_ids(1);
 
         // Limpiar nombre de usuario también
         sqlite3_stmt *stmt;
@@ -535,8 +859,16 @@ void menu_settings()
         {3, get_text("menu_usuario"), menu_usuario},
         {4, get_text("show_current"), show_current_settings},
         {5, get_text("reset_defaults"), reset_settings_to_defaults},
+        {6, get_text("db_diagnostics"), show_db_diagnostics},
+        {7, get_text("settings_db_profile"), menu_db_profile_settings},
+        {8, get_text("settings_reuse_ids"), menu_reuse_ids_settings},
+        {9, get_text("settings_memory_mode"), menu_memory_mode_settings},
+        {10, get_text("settings_backups"), menu_respaldos},
+        {11, get_text("settings_page_size"), menu_page_size_settings},
+        {12, get_text("settings_rollups"), menu_resumenes},
+        {13, get_text("settings_form"), menu_form_settings},
         {0, get_text("menu_back"), NULL}
     };
 
-    ejecutar_menu(get_text("menu_settings"), items, 6);
+    ejecutar_menu(get_text("menu_settings"), items, 14);
 }
@@ -29,11 +29,22 @@ typedef enum
     LANG_ENGLISH = 1
 } LanguageType;
 
+/** Limites del tamano de pagina de los listados */
+#define TAMANO_PAGINA_MIN 5
+#define TAMANO_PAGINA_MAX 200
+#define TAMANO_PAGINA_DEFECTO 20
+
 // Estructura para almacenar configuración
 typedef struct
 {
     ThemeType theme;
     LanguageType language;
+    int perfil_db;           /**< Perfil de ajuste de la conexion (DbPerfil) */
+    int reutilizar_ids;      /**< 1 para rellenar huecos de IDs borrados */
+    int modo_memoria;        /**< 1 para trabajar sobre una copia en memoria */
+    int tamano_pagina;       /**< Filas por pagina en los listados de partidos */
+    int ventana_forma;       /**< Partidos de la ventana movil de forma (3, 5, 10 o 20) */
+    int vida_media_forma;    /**< Vida media en partidos del decaimiento de la forma, 0 sin decaimiento */
 } AppSettings;
 
 /**
@@ -63,6 +74,34 @@ void settings_set_theme(ThemeType theme);
  */
 void settings_set_language(LanguageType language);
 
+/**
+ * @brief Establece y aplica el perfil de ajuste de la base de datos
+ */
+void settings_set_perfil_db(int perfil);
+
+/**
+ * @brief Activa o desactiva la reutilizacion de IDs borrados
+ */
+void settings_set_reutilizar_ids(int activar);
+
+/**
+ * @brief Activa o desactiva el modo memoria (se aplica al reiniciar)
+ */
+void settings_set_modo_memoria(int activar);
+
+/**
+ * @brief Establece el numero de filas por pagina de los listados
+ */
+void settings_set_tamano_pagina(int filas);
+
+/**
+ * @brief Establece la ventana y el decaimiento de la forma
+ *
+ * Una ventana no admitida se reemplaza por la de defecto y la vida media
+ * se acota a 0 - FORMA_VIDA_MEDIA_MAX.
+ */
+void settings_set_forma(int ventana, int vida_media);
+
 /**
  * @brief Aplica el tema actual a la consola
  */
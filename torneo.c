@@ -978,31 +978,50 @@ void eliminar_torneo()
 
     if (confirmar("Esta seguro que desea eliminar este torneo? Esta accion no se puede deshacer."))
     {
+        if (!db_begin())
+        {
+            pause_console();
+            return;
+        }
+        int ok = 1;
+
         // Eliminar asociaciones de equipos primero
         const char *sql_delete_equipos = "DELETE FROM equipo_torneo WHERE torneo_id = ?;";
-        if (sqlite3_prepare_v2(db, sql_delete_equipos, -1, &stmt, 0) == SQLITE_OK)
+        if (ok && sqlite3_prepare_v2(db, sql_delete_equipos, -1, &stmt, 0) == SQLITE_OK)
         {
             sqlite3_bind_int(stmt, 1, torneo_id);
-            sqlite3_step(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
             sqlite3_finalize(stmt);
         }
+        else
+        {
+            ok = 0;
+        }
 
         // Eliminar torneo
         const char *sql_delete_torneo = "DELETE FROM torneo WHERE id = ?;";
-        if (sqlite3_prepare_v2(db, sql_delete_torneo, -1, &stmt, 0) == SQLITE_OK)
+        if (ok && sqlite3_prepare_v2(db, sql_delete_torneo, -1, &stmt, 0) == SQLITE_OK)
         {
             sqlite3_bind_int(stmt, 1, torneo_id);
-
-            if (sqlite3_step(stmt) == SQLITE_DONE)
-            {
-                printf("Torneo eliminado exitosamente.\n");
-            }
-            else
-            {
-                printf("Error al eliminar el torneo: %s\n", sqlite3_errmsg(db));
-            }
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
             sqlite3_finalize(stmt);
         }
+        else
+        {
+            ok = 0;
+        }
+
+        if (ok && db_commit())
+        {
+            printf("Torneo eliminado exitosamente.\n");
+        }
+        else
+        {
+            printf("Error al eliminar el torneo: %s\n", sqlite3_errmsg(db));
+            db_rollback();
+        }
     }
     else
     {
@@ -1661,6 +1680,199 @@ void mostrar_fixture(int torneo_id)
     pause_console();
 }
 
+/**
+ * @brief Estadisticas de un jugador en un partido, ingresadas antes de guardar
+ */
+typedef struct
+{
+    int jugador_id;
+    int equipo_id;
+    char nombre[50];
+    int goles;
+    int asistencias;
+    int tarjetas_amarillas;
+    int tarjetas_rojas;
+    int minutos;
+} EstadisticaJugador;
+
+/**
+ * @brief Pide por consola las estadisticas de los jugadores de un equipo
+ *
+ * Solo lee de la base: se llama antes de abrir la transaccion para no
+ * retenerla mientras el usuario escribe. El plantel se copia completo y
+ * la sentencia se libera antes del primer pedido, porque un SELECT a
+ * medio recorrer tambien mantiene abierta una transaccion de lectura.
+ *
+ * @param equipo_id ID del equipo
+ * @param lista Arreglo que se amplia con un elemento por jugador
+ * @param n Elementos en uso de lista
+ * @param capacidad Capacidad de lista
+ * @return 1 si exito, 0 si no se pudo leer el plantel o no hubo memoria
+ */
+static int pedir_estadisticas_equipo(int equipo_id, EstadisticaJugador **lista, int *n, int *capacidad)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT id, nombre FROM jugador WHERE equipo_id = ? ORDER BY numero;");
+    int inicio = *n;
+    int ok = 1;
+
+    if (!stmt)
+        return 0;
+
+    sqlite3_bind_int(stmt, 1, equipo_id);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        if (*n == *capacidad)
+        {
+            int nueva = *capacidad ? *capacidad * 2 : 16;
+            EstadisticaJugador *ampliada = realloc(*lista, (size_t)nueva * sizeof(EstadisticaJugador));
+            if (!ampliada)
+            {
+                ok = 0;
+                break;
+            }
+            *lista = ampliada;
+            *capacidad = nueva;
+        }
+
+        EstadisticaJugador *e = &(*lista)[(*n)++];
+        const unsigned char *nombre = sqlite3_column_text(stmt, 1);
+        e->jugador_id = sqlite3_column_int(stmt, 0);
+        e->equipo_id = equipo_id;
+        snprintf(e->nombre, sizeof(e->nombre), "%s", nombre ? (const char*)nombre : "");
+    }
+    db_release_cached(stmt);
+    if (!ok)
+        return 0;
+
+    printf("\n=== ESTADISTICAS JUGADORES - %s ===\n", get_equipo_nombre(equipo_id));
+    for (int i = inicio; i < *n; i++)
+    {
+        EstadisticaJugador *e = &(*lista)[i];
+
+        printf("\nJugador: %s\n", e->nombre);
+        e->goles = input_int("Goles anotados: ");
+        e->asistencias = input_int("Asistencias: ");
+        e->tarjetas_amarillas = input_int("Tarjetas amarillas: ");
+        e->tarjetas_rojas = input_int("Tarjetas rojas: ");
+        e->minutos = input_int("Minutos jugados: ");
+    }
+    return 1;
+}
+
+/**
+ * @brief Pide las estadisticas de los jugadores de los dos equipos
+ *
+ * @param equipo1_id ID del primer equipo
+ * @param equipo2_id ID del segundo equipo
+ * @param lista Destino del arreglo (liberar con free)
+ * @param n Destino del numero de elementos
+ * @return 1 si exito, 0 en caso de error (lista queda liberada)
+ */
+static int pedir_estadisticas_jugadores(int equipo1_id, int equipo2_id, EstadisticaJugador **lista, int *n)
+{
+    int capacidad = 0;
+
+    *lista = NULL;
+    *n = 0;
+    if (pedir_estadisticas_equipo(equipo1_id, lista, n, &capacidad) &&
+            pedir_estadisticas_equipo(equipo2_id, lista, n, &capacidad))
+        return 1;
+
+    free(*lista);
+    *lista = NULL;
+    *n = 0;
+    return 0;
+}
+
+/**
+ * @brief Suma las estadisticas de un jugador a las que ya tiene en el torneo
+ *
+ * @return 1 si exito, 0 en caso de error
+ */
+static int guardar_estadistica_jugador(int torneo_id, const EstadisticaJugador *e)
+{
+    sqlite3_stmt *stmt = db_prepare_cached("SELECT COUNT(*) FROM jugador_estadisticas "
+                                           "WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;");
+    int existe = 0;
+    int ok;
+
+    if (!stmt)
+        return 0;
+    sqlite3_bind_int(stmt, 1, e->jugador_id);
+    sqlite3_bind_int(stmt, 2, torneo_id);
+    sqlite3_bind_int(stmt, 3, e->equipo_id);
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+        existe = sqlite3_column_int(stmt, 0);
+    db_release_cached(stmt);
+
+    if (existe)
+    {
+        stmt = db_prepare_cached("UPDATE jugador_estadisticas SET "
+                                 "goles = goles + ?, "
+                                 "asistencias = asistencias + ?, "
+                                 "tarjetas_amarillas = tarjetas_amarillas + ?, "
+                                 "tarjetas_rojas = tarjetas_rojas + ?, "
+                                 "minutos_jugados = minutos_jugados + ? "
+                                 "WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;");
+        if (!stmt)
+            return 0;
+        sqlite3_bind_int(stmt, 1, e->goles);
+        sqlite3_bind_int(stmt, 2, e->asistencias);
+        sqlite3_bind_int(stmt, 3, e->tarjetas_amarillas);
+        sqlite3_bind_int(stmt, 4, e->tarjetas_rojas);
+        sqlite3_bind_int(stmt, 5, e->minutos);
+        sqlite3_bind_int(stmt, 6, e->jugador_id);
+        sqlite3_bind_int(stmt, 7, torneo_id);
+        sqlite3_bind_int(stmt, 8, e->equipo_id);
+    }
+    else
+    {
+        stmt = db_prepare_cached("INSERT INTO jugador_estadisticas "
+                                 "(jugador_id, torneo_id, equipo_id, goles, asistencias, "
+                                 "tarjetas_amarillas, tarjetas_rojas, minutos_jugados) "
+                                 "VALUES (?, ?, ?, ?, ?, ?, ?, ?);");
+        if (!stmt)
+            return 0;
+        sqlite3_bind_int(stmt, 1, e->jugador_id);
+        sqlite3_bind_int(stmt, 2, torneo_id);
+        sqlite3_bind_int(stmt, 3, e->equipo_id);
+        sqlite3_bind_int(stmt, 4, e->goles);
+        sqlite3_bind_int(stmt, 5, e->asistencias);
+        sqlite3_bind_int(stmt, 6, e->tarjetas_amarillas);
+        sqlite3_bind_int(stmt, 7, e->tarjetas_rojas);
+        sqlite3_bind_int(stmt, 8, e->minutos);
+    }
+
+    ok = sqlite3_step(stmt) == SQLITE_DONE;
+    db_release_cached(stmt);
+    return ok;
+}
+
+/**
+ * @brief Guarda un lote de estadisticas de jugadores en una transaccion
+ *
+ * Dentro de otra transaccion queda anidada como savepoint.
+ *
+ * @return 1 si se aplico completo, 0 si se deshizo por un error
+ */
+static int guardar_estadisticas_jugadores(int torneo_id, const EstadisticaJugador *lista, int n)
+{
+    int ok = db_begin();
+
+    for (int i = 0; ok && i < n; i++)
+        ok = guardar_estadistica_jugador(torneo_id, &lista[i]);
+
+    if (!ok || !db_commit())
+    {
+        printf("Error al guardar estadisticas de jugadores: %s\n", sqlite3_errmsg(db));
+        db_rollback();
+        return 0;
+    }
+
+    printf("Estadisticas de jugadores actualizadas correctamente.\n");
+    return 1;
+}
+
 void ingresar_resultado(int torneo_id)
 {
     clear_screen();
@@ -1750,31 +1962,57 @@ void ingresar_resultado(int torneo_id)
     const char *estado = (goles1 > goles2) ? "Equipo1 Ganador" :
                          (goles2 > goles1) ? "Equipo2 Ganador" : "Empate";
 
+    // Las estadisticas se piden antes de abrir la transaccion, para no
+    // retenerla mientras el usuario escribe
+    EstadisticaJugador *estadisticas = NULL;
+    int num_estadisticas = 0;
+    if (confirmar("¿Desea ingresar estadisticas individuales de los jugadores?") &&
+            !pedir_estadisticas_jugadores(equipo1_id, equipo2_id, &estadisticas, &num_estadisticas))
+    {
+        printf("Error al leer los jugadores: %s\n", sqlite3_errmsg(db));
+        pause_console();
+        return;
+    }
+
+    // Resultado, tabla y estadisticas se aplican juntos o no se aplican
+    if (!db_begin())
+    {
+        free(estadisticas);
+        pause_console();
+        return;
+    }
+
+    int ok = 0;
     if (sqlite3_prepare_v2(db, sql_update, -1, &stmt, 0) == SQLITE_OK)
     {
         sqlite3_bind_int(stmt, 1, goles1);
         sqlite3_bind_int(stmt, 2, goles2);
         sqlite3_bind_text(stmt, 3, estado, -1, SQLITE_STATIC);
         sqlite3_bind_int(stmt, 4, partido_id);
+        ok = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_finalize(stmt);
+    }
 
-        if (sqlite3_step(stmt) == SQLITE_DONE)
-        {
-            printf("Resultado registrado exitosamente.\n");
+    if (ok)
+    {
+        // Actualizar tabla de posiciones
+        ok = actualizar_tabla_posiciones(torneo_id, equipo1_id, equipo2_id, goles1, goles2);
+    }
 
-            // Actualizar tabla de posiciones
-            actualizar_tabla_posiciones(torneo_id, equipo1_id, equipo2_id, goles1, goles2);
+    if (ok && estadisticas)
+    {
+        ok = guardar_estadisticas_jugadores(torneo_id, estadisticas, num_estadisticas);
+    }
+    free(estadisticas);
 
-            // Preguntar si quiere ingresar estadisticas de jugadores
-            if (confirmar("¿Desea ingresar estadisticas individuales de los jugadores?"))
-            {
-                actualizar_estadisticas_jugadores(torneo_id, equipo1_id, equipo2_id, goles1, goles2);
-            }
-        }
-        else
-        {
-            printf("Error al registrar el resultado: %s\n", sqlite3_errmsg(db));
-        }
-        sqlite3_finalize(stmt);
+    if (ok && db_commit())
+    {
+        printf("Resultado registrado exitosamente.\n");
+    }
+    else
+    {
+        printf("Error al registrar el resultado: %s\n", sqlite3_errmsg(db));
+        db_rollback();
     }
 
     pause_console();
@@ -1975,10 +2213,11 @@ const char* get_equipo_nombre(int equipo_id)
  * @param goles1 Goles del primer equipo
  * @param goles2 Goles del segundo equipo
  */
-void actualizar_fase_torneo(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2)
+int actualizar_fase_torneo(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2)
 {
     // Esta función actualiza la fase del torneo para torneos de eliminacion
     sqlite3_stmt *stmt;
+    int ok = 1;
 
     // Obtener formato del torneo
     const char *sql_formato = "SELECT formato_torneo FROM torneo WHERE id = ?;";
@@ -2012,9 +2251,14 @@ void actualizar_fase_torneo(int torneo_id, int equipo1_id, int equipo2_id, int g
         {
             sqlite3_bind_int(stmt, 1, torneo_id);
             sqlite3_bind_int(stmt, 2, perdedor_id);
-            sqlite3_step(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
             sqlite3_finalize(stmt);
         }
+        else
+        {
+            ok = 0;
+        }
 
         // Avanzar al ganador a la siguiente fase
         // Por simplicidad, avanzamos automáticamente a la siguiente fase
@@ -2023,6 +2267,8 @@ void actualizar_fase_torneo(int torneo_id, int equipo1_id, int equipo2_id, int g
         printf("Equipo %s avanza a la siguiente fase.\n", get_equipo_nombre(ganador_id));
         printf("Equipo %s queda eliminado del torneo.\n", get_equipo_nombre(perdedor_id));
     }
+
+    return ok;
 }
 
 void mostrar_estadisticas_jugador(int torneo_id, int equipo_id)
@@ -2206,6 +2452,13 @@ void finalizar_torneo(int torneo_id)
         return;
     }
 
+    // El historial de todos los equipos se guarda como una unica transaccion
+    if (!db_begin())
+    {
+        pause_console();
+        return;
+    }
+
     // Obtener equipos participantes y sus estadisticas
     const char *sql_equipos = "SELECT e.id, e.nombre, es.partidos_jugados, es.partidos_ganados, "
                               "es.partidos_empatados, es.partidos_perdidos, es.goles_favor, "
@@ -2216,11 +2469,12 @@ void finalizar_torneo(int torneo_id)
                               "ORDER BY es.puntos DESC, (es.goles_favor - es.goles_contra) DESC;";
 
     int posicion = 1;
+    int ok = 1;
     if (sqlite3_prepare_v2(db, sql_equipos, -1, &stmt, 0) == SQLITE_OK)
     {
         sqlite3_bind_int(stmt, 1, torneo_id);
 
-        while (sqlite3_step(stmt) == SQLITE_ROW)
+        while (ok && sqlite3_step(stmt) == SQLITE_ROW)
         {
             int equipo_id = sqlite3_column_int(stmt, 0);
             const char *equipo_nombre = (const char*)sqlite3_column_text(stmt, 1);
@@ -2280,217 +2534,67 @@ void finalizar_torneo(int torneo_id)
                 sqlite3_bind_int(stmt_goleador, 9, gc);
                 sqlite3_bind_text(stmt_goleador, 10, mejor_goleador, -1, SQLITE_STATIC);
                 sqlite3_bind_int(stmt_goleador, 11, goles_mejor);
-                sqlite3_step(stmt_goleador);
+                if (sqlite3_step(stmt_goleador) != SQLITE_DONE)
+                    ok = 0;
                 sqlite3_finalize(stmt_goleador);
             }
-
-            printf("Guardado historial para %s (Posicion %d)\n", equipo_nombre, posicion);
-            posicion++;
-        }
-        sqlite3_finalize(stmt);
-    }
-
-    printf("\nTorneo finalizado exitosamente. Historial guardado.\n");
-    pause_console();
-}
-
-void actualizar_estadisticas_jugadores(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2)
-{
-    // Esta función permite ingresar estadisticas individuales de jugadores después de un partido
-
-    sqlite3_stmt *stmt;
-
-    // Mostrar jugadores de equipo1
-    printf("\n=== ESTADISTICAS JUGADORES - %s ===\n", get_equipo_nombre(equipo1_id));
-
-    const char *sql_jugadores1 = "SELECT id, nombre FROM jugador WHERE equipo_id = ? ORDER BY numero;";
-    if (sqlite3_prepare_v2(db, sql_jugadores1, -1, &stmt, 0) == SQLITE_OK)
-    {
-        sqlite3_bind_int(stmt, 1, equipo1_id);
-
-        while (sqlite3_step(stmt) == SQLITE_ROW)
-        {
-            int jugador_id = sqlite3_column_int(stmt, 0);
-            const char *nombre = (const char*)sqlite3_column_text(stmt, 1);
-
-            printf("\nJugador: %s\n", nombre);
-
-            int goles = input_int("Goles anotados: ");
-            int asistencias = input_int("Asistencias: ");
-            int tarjetas_amarillas = input_int("Tarjetas amarillas: ");
-            int tarjetas_rojas = input_int("Tarjetas rojas: ");
-            int minutos = input_int("Minutos jugados: ");
-
-            // Verificar si ya existen estadisticas para este jugador en este torneo
-            const char *sql_check = "SELECT COUNT(*) FROM jugador_estadisticas "
-                                    "WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;";
-            sqlite3_stmt *stmt_check;
-            int existe = 0;
-
-            if (sqlite3_prepare_v2(db, sql_check, -1, &stmt_check, 0) == SQLITE_OK)
+            else
             {
-                sqlite3_bind_int(stmt_check, 1, jugador_id);
-                sqlite3_bind_int(stmt_check, 2, torneo_id);
-                sqlite3_bind_int(stmt_check, 3, equipo1_id);
-
-                if (sqlite3_step(stmt_check) == SQLITE_ROW)
-                {
-                    existe = sqlite3_column_int(stmt_check, 0);
-                }
-                sqlite3_finalize(stmt_check);
+                ok = 0;
             }
 
-            if (existe)
+            if (ok)
             {
-                // Actualizar estadisticas existentes
-                const char *sql_update = "UPDATE jugador_estadisticas SET "
-                                         "goles = goles + ?, "
-                                         "asistencias = asistencias + ?, "
-                                         "tarjetas_amarillas = tarjetas_amarillas + ?, "
-                                         "tarjetas_rojas = tarjetas_rojas + ?, "
-                                         "minutos_jugados = minutos_jugados + ? "
-                                         "WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;";
-
-                if (sqlite3_prepare_v2(db, sql_update, -1, &stmt_check, 0) == SQLITE_OK)
-                {
-                    sqlite3_bind_int(stmt_check, 1, goles);
-                    sqlite3_bind_int(stmt_check, 2, asistencias);
-                    sqlite3_bind_int(stmt_check, 3, tarjetas_amarillas);
-                    sqlite3_bind_int(stmt_check, 4, tarjetas_rojas);
-                    sqlite3_bind_int(stmt_check, 5, minutos);
-                    sqlite3_bind_int(stmt_check, 6, jugador_id);
-                    sqlite3_bind_int(stmt_check, 7, torneo_id);
-                    sqlite3_bind_int(stmt_check, 8, equipo1_id);
-                    sqlite3_step(stmt_check);
-                    sqlite3_finalize(stmt_check);
-                }
-            }
-            else
-            {
-                // Insertar nuevas estadisticas
-                const char *sql_insert = "INSERT INTO jugador_estadisticas "
-                                         "(jugador_id, torneo_id, equipo_id, goles, asistencias, "
-                                         "tarjetas_amarillas, tarjetas_rojas, minutos_jugados) "
-                                         "VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
-
-                if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt_check, 0) == SQLITE_OK)
-                {
-                    sqlite3_bind_int(stmt_check, 1, jugador_id);
-                    sqlite3_bind_int(stmt_check, 2, torneo_id);
-                    sqlite3_bind_int(stmt_check, 3, equipo1_id);
-                    sqlite3_bind_int(stmt_check, 4, goles);
-                    sqlite3_bind_int(stmt_check, 5, asistencias);
-                    sqlite3_bind_int(stmt_check, 6, tarjetas_amarillas);
-                    sqlite3_bind_int(stmt_check, 7, tarjetas_rojas);
-                    sqlite3_bind_int(stmt_check, 8, minutos);
-                    sqlite3_step(stmt_check);
-                    sqlite3_finalize(stmt_check);
-                }
+                printf("Guardado historial para %s (Posicion %d)\n", equipo_nombre, posicion);
             }
+            posicion++;
         }
         sqlite3_finalize(stmt);
     }
-
-    // Mostrar jugadores de equipo2
-    printf("\n=== ESTADISTICAS JUGADORES - %s ===\n", get_equipo_nombre(equipo2_id));
-
-    const char *sql_jugadores2 = "SELECT id, nombre FROM jugador WHERE equipo_id = ? ORDER BY numero;";
-    if (sqlite3_prepare_v2(db, sql_jugadores2, -1, &stmt, 0) == SQLITE_OK)
+    else
     {
-        sqlite3_bind_int(stmt, 1, equipo2_id);
-
-        while (sqlite3_step(stmt) == SQLITE_ROW)
-        {
-            int jugador_id = sqlite3_column_int(stmt, 0);
-            const char *nombre = (const char*)sqlite3_column_text(stmt, 1);
-
-            printf("\nJugador: %s\n", nombre);
-
-            int goles = input_int("Goles anotados: ");
-            int asistencias = input_int("Asistencias: ");
-            int tarjetas_amarillas = input_int("Tarjetas amarillas: ");
-            int tarjetas_rojas = input_int("Tarjetas rojas: ");
-            int minutos = input_int("Minutos jugados: ");
-
-            // Verificar si ya existen estadisticas para este jugador en este torneo
-            const char *sql_check = "SELECT COUNT(*) FROM jugador_estadisticas "
-                                    "WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;";
-            sqlite3_stmt *stmt_check;
-            int existe = 0;
+        ok = 0;
+    }
 
-            if (sqlite3_prepare_v2(db, sql_check, -1, &stmt_check, 0) == SQLITE_OK)
-            {
-                sqlite3_bind_int(stmt_check, 1, jugador_id);
-                sqlite3_bind_int(stmt_check, 2, torneo_id);
-                sqlite3_bind_int(stmt_check, 3, equipo2_id);
+    if (!ok || !db_commit())
+    {
+        printf("\nError al guardar el historial: %s\n", sqlite3_errmsg(db));
+        printf("No se guardo ningun cambio.\n");
+        db_rollback();
+        pause_console();
+        return;
+    }
 
-                if (sqlite3_step(stmt_check) == SQLITE_ROW)
-                {
-                    existe = sqlite3_column_int(stmt_check, 0);
-                }
-                sqlite3_finalize(stmt_check);
-            }
+    printf("\nTorneo finalizado exitosamente. Historial guardado.\n");
+    pause_console();
+}
 
-            if (existe)
-            {
-                // Actualizar estadisticas existentes
-                const char *sql_update = "UPDATE jugador_estadisticas SET "
-                                         "goles = goles + ?, "
-                                         "asistencias = asistencias + ?, "
-                                         "tarjetas_amarillas = tarjetas_amarillas + ?, "
-                                         "tarjetas_rojas = tarjetas_rojas + ?, "
-                                         "minutos_jugados = minutos_jugados + ? "
-                                         "WHERE jugador_id = ? AND torneo_id = ? AND equipo_id = ?;";
-
-                if (sqlite3_prepare_v2(db, sql_update, -1, &stmt_check, 0) == SQLITE_OK)
-                {
-                    sqlite3_bind_int(stmt_check, 1, goles);
-                    sqlite3_bind_int(stmt_check, 2, asistencias);
-                    sqlite3_bind_int(stmt_check, 3, tarjetas_amarillas);
-                    sqlite3_bind_int(stmt_check, 4, tarjetas_rojas);
-                    sqlite3_bind_int(stmt_check, 5, minutos);
-                    sqlite3_bind_int(stmt_check, 6, jugador_id);
-                    sqlite3_bind_int(stmt_check, 7, torneo_id);
-                    sqlite3_bind_int(stmt_check, 8, equipo2_id);
-                    sqlite3_step(stmt_check);
-                    sqlite3_finalize(stmt_check);
-                }
-            }
-            else
-            {
-                // Insertar nuevas estadisticas
-                const char *sql_insert = "INSERT INTO jugador_estadisticas "
-                                         "(jugador_id, torneo_id, equipo_id, goles, asistencias, "
-                                         "tarjetas_amarillas, tarjetas_rojas, minutos_jugados) "
-                                         "VALUES (?, ?, ?, ?, ?, ?, ?, ?);";
+int actualizar_estadisticas_jugadores(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2)
+{
+    // Esta función permite ingresar estadisticas individuales de jugadores después de un partido
+    EstadisticaJugador *lista;
+    int n, ok;
 
-                if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt_check, 0) == SQLITE_OK)
-                {
-                    sqlite3_bind_int(stmt_check, 1, jugador_id);
-                    sqlite3_bind_int(stmt_check, 2, torneo_id);
-                    sqlite3_bind_int(stmt_check, 3, equipo2_id);
-                    sqlite3_bind_int(stmt_check, 4, goles);
-                    sqlite3_bind_int(stmt_check, 5, asistencias);
-                    sqlite3_bind_int(stmt_check, 6, tarjetas_amarillas);
-                    sqlite3_bind_int(stmt_check, 7, tarjetas_rojas);
-                    sqlite3_bind_int(stmt_check, 8, minutos);
-                    sqlite3_step(stmt_check);
-                    sqlite3_finalize(stmt_check);
-                }
-            }
-        }
-        sqlite3_finalize(stmt);
-    }
+    (void)goles1;
+    (void)goles2;
+    if (!pedir_estadisticas_jugadores(equipo1_id, equipo2_id, &lista, &n))
+        return 0;
 
-    printf("Estadisticas de jugadores actualizadas correctamente.\n");
+    ok = guardar_estadisticas_jugadores(torneo_id, lista, n);
+    free(lista);
+    return ok;
 }
 
-void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2)
+int actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2)
 {
     // Esta función actualiza la tabla de posiciones después de un partido
     // Actualiza las estadisticas de los equipos en la tabla equipo_torneo
 
     sqlite3_stmt *stmt;
+    int ok = db_begin();
+
+    if (!ok)
+        return 0;
 
     // Primero, verificar si ya existen registros de estadisticas para estos equipos en este torneo
     // Si no existen, crearlos
@@ -2500,7 +2604,8 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                     "WHERE torneo_id = ? AND equipo_id = ?;";
     int equipo1_exists = 0;
 
-    if (sqlite3_prepare_v2(db, sql_check_equipo1, -1, &stmt, 0) == SQLITE_OK)
+    stmt = db_prepare_cached(sql_check_equipo1);
+    if (stmt)
     {
         sqlite3_bind_int(stmt, 1, torneo_id);
         sqlite3_bind_int(stmt, 2, equipo1_id);
@@ -2509,7 +2614,7 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
         {
             equipo1_exists = sqlite3_column_int(stmt, 0);
         }
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
     }
 
     // Crear tabla de estadisticas si no existe
@@ -2528,7 +2633,8 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                    "FOREIGN KEY(torneo_id) REFERENCES torneo(id),"
                                    "FOREIGN KEY(equipo_id) REFERENCES equipo(id));";
 
-    sqlite3_exec(db, sql_create_table, 0, 0, 0);
+    if (sqlite3_exec(db, sql_create_table, 0, 0, 0) != SQLITE_OK)
+        ok = 0;
 
     // Inicializar estadisticas para equipo1 si no existen
     if (!equipo1_exists)
@@ -2538,12 +2644,18 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                        "partidos_empatados, partidos_perdidos, goles_favor, goles_contra, puntos, estado) "
                                        "VALUES (?, ?, 0, 0, 0, 0, 0, 0, 0, 'Activo');";
 
-        if (sqlite3_prepare_v2(db, sql_init_equipo1, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_init_equipo1);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, torneo_id);
             sqlite3_bind_int(stmt, 2, equipo1_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
 
@@ -2552,7 +2664,8 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                     "WHERE torneo_id = ? AND equipo_id = ?;";
     int equipo2_exists = 0;
 
-    if (sqlite3_prepare_v2(db, sql_check_equipo2, -1, &stmt, 0) == SQLITE_OK)
+    stmt = db_prepare_cached(sql_check_equipo2);
+    if (stmt)
     {
         sqlite3_bind_int(stmt, 1, torneo_id);
         sqlite3_bind_int(stmt, 2, equipo2_id);
@@ -2561,7 +2674,7 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
         {
             equipo2_exists = sqlite3_column_int(stmt, 0);
         }
-        sqlite3_finalize(stmt);
+        db_release_cached(stmt);
     }
 
     // Inicializar estadisticas para equipo2 si no existen
@@ -2572,12 +2685,18 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                        "partidos_empatados, partidos_perdidos, goles_favor, goles_contra, puntos, estado) "
                                        "VALUES (?, ?, 0, 0, 0, 0, 0, 0, 0, 'Activo');";
 
-        if (sqlite3_prepare_v2(db, sql_init_equipo2, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_init_equipo2);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, torneo_id);
             sqlite3_bind_int(stmt, 2, equipo2_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
 
@@ -2593,14 +2712,20 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                          "puntos = puntos + 3 "
                                          "WHERE torneo_id = ? AND equipo_id = ?;";
 
-        if (sqlite3_prepare_v2(db, sql_update_equipo1, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_update_equipo1);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, goles1);
             sqlite3_bind_int(stmt, 2, goles2);
             sqlite3_bind_int(stmt, 3, torneo_id);
             sqlite3_bind_int(stmt, 4, equipo1_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
     else if (goles1 == goles2)
@@ -2614,14 +2739,20 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                          "puntos = puntos + 1 "
                                          "WHERE torneo_id = ? AND equipo_id = ?;";
 
-        if (sqlite3_prepare_v2(db, sql_update_equipo1, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_update_equipo1);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, goles1);
             sqlite3_bind_int(stmt, 2, goles2);
             sqlite3_bind_int(stmt, 3, torneo_id);
             sqlite3_bind_int(stmt, 4, equipo1_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
     else
@@ -2634,14 +2765,20 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                          "goles_contra = goles_contra + ? "
                                          "WHERE torneo_id = ? AND equipo_id = ?;";
 
-        if (sqlite3_prepare_v2(db, sql_update_equipo1, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_update_equipo1);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, goles1);
             sqlite3_bind_int(stmt, 2, goles2);
             sqlite3_bind_int(stmt, 3, torneo_id);
             sqlite3_bind_int(stmt, 4, equipo1_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
 
@@ -2657,14 +2794,20 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                          "puntos = puntos + 3 "
                                          "WHERE torneo_id = ? AND equipo_id = ?;";
 
-        if (sqlite3_prepare_v2(db, sql_update_equipo2, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_update_equipo2);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, goles2);
             sqlite3_bind_int(stmt, 2, goles1);
             sqlite3_bind_int(stmt, 3, torneo_id);
             sqlite3_bind_int(stmt, 4, equipo2_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
     else if (goles1 == goles2)
@@ -2678,14 +2821,20 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                          "puntos = puntos + 1 "
                                          "WHERE torneo_id = ? AND equipo_id = ?;";
 
-        if (sqlite3_prepare_v2(db, sql_update_equipo2, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_update_equipo2);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, goles2);
             sqlite3_bind_int(stmt, 2, goles1);
             sqlite3_bind_int(stmt, 3, torneo_id);
             sqlite3_bind_int(stmt, 4, equipo2_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
     else
@@ -2698,21 +2847,36 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
                                          "goles_contra = goles_contra + ? "
                                          "WHERE torneo_id = ? AND equipo_id = ?;";
 
-        if (sqlite3_prepare_v2(db, sql_update_equipo2, -1, &stmt, 0) == SQLITE_OK)
+        stmt = db_prepare_cached(sql_update_equipo2);
+        if (stmt)
         {
             sqlite3_bind_int(stmt, 1, goles2);
             sqlite3_bind_int(stmt, 2, goles1);
             sqlite3_bind_int(stmt, 3, torneo_id);
             sqlite3_bind_int(stmt, 4, equipo2_id);
-            sqlite3_step(stmt);
-            sqlite3_finalize(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
+            db_release_cached(stmt);
+        }
+        else
+        {
+            ok = 0;
         }
     }
 
     // Actualizar fase del torneo y estado de equipos si es torneo de eliminacion
-    actualizar_fase_torneo(torneo_id, equipo1_id, equipo2_id, goles1, goles2);
+    if (ok)
+        ok = actualizar_fase_torneo(torneo_id, equipo1_id, equipo2_id, goles1, goles2);
+
+    if (!ok || !db_commit())
+    {
+        printf("Error al actualizar la tabla de posiciones: %s\n", sqlite3_errmsg(db));
+        db_rollback();
+        return 0;
+    }
 
     printf("Tabla de posiciones actualizada correctamente.\n");
+    return 1;
 }
 
 void mostrar_dashboard_torneo(int torneo_id, int equipo_id)
@@ -3451,15 +3615,31 @@ void generar_fixture(int torneo_id)
             pause_console();
             return;
         }
+    }
+
+    // El borrado del fixture anterior y todos los partidos nuevos van en una transaccion
+    if (!db_begin())
+    {
+        pause_console();
+        return;
+    }
+    int ok = 1;
 
+    if (partidos_existentes > 0)
+    {
         // Eliminar partidos existentes
         const char *sql_delete = "DELETE FROM partido_torneo WHERE torneo_id = ?;";
         if (sqlite3_prepare_v2(db, sql_delete, -1, &stmt, 0) == SQLITE_OK)
         {
             sqlite3_bind_int(stmt, 1, torneo_id);
-            sqlite3_step(stmt);
+            if (sqlite3_step(stmt) != SQLITE_DONE)
+                ok = 0;
             sqlite3_finalize(stmt);
         }
+        else
+        {
+            ok = 0;
+        }
     }
 
     // Obtener lista de equipos participantes
@@ -3487,6 +3667,7 @@ void generar_fixture(int torneo_id)
     if (num_equipos == 0)
     {
         printf("No hay equipos asociados a este torneo.\n");
+        db_rollback();
         pause_console();
         return;
     }
@@ -3518,14 +3699,21 @@ void generar_fixture(int torneo_id)
                                              "(torneo_id, equipo1_id, equipo2_id, estado, fase) "
                                              "VALUES (?, ?, ?, 'Pendiente', 'Fase de Grupos');";
 
-                    if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt, 0) == SQLITE_OK)
+                    stmt = ok ? db_prepare_cached(sql_insert) : NULL;
+                    if (stmt)
                     {
                         sqlite3_bind_int(stmt, 1, torneo_id);
                         sqlite3_bind_int(stmt, 2, equipo1);
                         sqlite3_bind_int(stmt, 3, equipo2);
-                        sqlite3_step(stmt);
-                        sqlite3_finalize(stmt);
-                        partidos_generados++;
+                        if (sqlite3_step(stmt) == SQLITE_DONE)
+                            partidos_generados++;
+                        else
+                            ok = 0;
+                        db_release_cached(stmt);
+                    }
+                    else
+                    {
+                        ok = 0;
                     }
                 }
             }
@@ -3552,14 +3740,21 @@ void generar_fixture(int torneo_id)
                                              "(torneo_id, equipo1_id, equipo2_id, estado, fase) "
                                              "VALUES (?, ?, ?, 'Pendiente', 'Primera Ronda');";
 
-                    if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt, 0) == SQLITE_OK)
+                    stmt = ok ? db_prepare_cached(sql_insert) : NULL;
+                    if (stmt)
                     {
                         sqlite3_bind_int(stmt, 1, torneo_id);
                         sqlite3_bind_int(stmt, 2, equipo_ids[i]);
                         sqlite3_bind_int(stmt, 3, equipo_ids[i + 1]);
-                        sqlite3_step(stmt);
-                        sqlite3_finalize(stmt);
-                        partidos_generados++;
+                        if (sqlite3_step(stmt) == SQLITE_DONE)
+                            partidos_generados++;
+                        else
+                            ok = 0;
+                        db_release_cached(stmt);
+                    }
+                    else
+                    {
+                        ok = 0;
                     }
                 }
             }
@@ -3598,15 +3793,22 @@ void generar_fixture(int torneo_id)
                                              "(torneo_id, equipo1_id, equipo2_id, estado, fase) "
                                              "VALUES (?, ?, ?, 'Pendiente', ?);";
 
-                    if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt, 0) == SQLITE_OK)
+                    stmt = ok ? db_prepare_cached(sql_insert) : NULL;
+                    if (stmt)
                     {
                         sqlite3_bind_int(stmt, 1, torneo_id);
                         sqlite3_bind_int(stmt, 2, equipo_ids[i]);
                         sqlite3_bind_int(stmt, 3, equipo_ids[j]);
                         sqlite3_bind_text(stmt, 4, nombre_grupo, -1, SQLITE_STATIC);
-                        sqlite3_step(stmt);
-                        sqlite3_finalize(stmt);
-                        partidos_generados++;
+                        if (sqlite3_step(stmt) == SQLITE_DONE)
+                            partidos_generados++;
+                        else
+                            ok = 0;
+                        db_release_cached(stmt);
+                    }
+                    else
+                    {
+                        ok = 0;
                     }
                 }
             }
@@ -3620,12 +3822,19 @@ void generar_fixture(int torneo_id)
                                      "(torneo_id, equipo1_id, equipo2_id, estado, fase) "
                                      "VALUES (?, NULL, NULL, 'Pendiente', 'Final');";
 
-            if (sqlite3_prepare_v2(db, sql_insert, -1, &stmt, 0) == SQLITE_OK)
+            stmt = ok ? db_prepare_cached(sql_insert) : NULL;
+            if (stmt)
             {
                 sqlite3_bind_int(stmt, 1, torneo_id);
-                sqlite3_step(stmt);
-                sqlite3_finalize(stmt);
-                partidos_generados++;
+                if (sqlite3_step(stmt) == SQLITE_DONE)
+                    partidos_generados++;
+                else
+                    ok = 0;
+                db_release_cached(stmt);
+            }
+            else
+            {
+                ok = 0;
             }
         }
         break;
@@ -3633,6 +3842,16 @@ void generar_fixture(int torneo_id)
 
     default:
         printf("Formato de torneo no soportado para generación automatica de fixture.\n");
+        db_rollback();
+        pause_console();
+        return;
+    }
+
+    if (!ok || !db_commit())
+    {
+        printf("Error al generar el fixture: %s\n", sqlite3_errmsg(db));
+        printf("Se conserva el fixture anterior.\n");
+        db_rollback();
         pause_console();
         return;
     }
@@ -192,8 +192,9 @@ void asociar_equipos_torneo(int torneo_id);
  * @param equipo2_id ID del segundo equipo
  * @param goles1 Goles del primer equipo
  * @param goles2 Goles del segundo equipo
+ * @return 1 si se aplico completa, 0 si se deshizo por un error
  */
-void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2);
+int actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2);
 
 /**
  * @brief Actualiza las estadísticas de los jugadores después de un partido
@@ -203,8 +204,9 @@ void actualizar_tabla_posiciones(int torneo_id, int equipo1_id, int equipo2_id,
  * @param equipo2_id ID del segundo equipo
  * @param goles1 Goles del primer equipo
  * @param goles2 Goles del segundo equipo
+ * @return 1 si se aplico completa, 0 si se deshizo por un error
  */
-void actualizar_estadisticas_jugadores(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2);
+int actualizar_estadisticas_jugadores(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2);
 
 /**
  * @brief Actualiza la fase del torneo para torneos de eliminación
@@ -214,8 +216,9 @@ void actualizar_estadisticas_jugadores(int torneo_id, int equipo1_id, int equipo
  * @param equipo2_id ID del segundo equipo
  * @param goles1 Goles del primer equipo
  * @param goles2 Goles del segundo equipo
+ * @return 1 si exito, 0 en caso de error
  */
-void actualizar_fase_torneo(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2);
+int actualizar_fase_torneo(int torneo_id, int equipo1_id, int equipo2_id, int goles1, int goles2);
 
 /**
  * @brief Muestra estadísticas de jugadores de un torneo
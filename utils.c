@@ -11,14 +11,17 @@
 #include "db.h"
 #include "menu.h"
 #include "ascii_art.h"
+#include "settings.h"
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <math.h>
 
 #ifdef _WIN32
 #include <direct.h>
+#include <windows.h>
 #define MKDIR(path) _mkdir(path)
 #else
 #include <sys/stat.h>
@@ -210,6 +213,28 @@ void get_timestamp(char *buffer, int size)
     strftime(buffer, size, "%Y%m%d_%H%M", localtime(&t));
 }
 
+/**
+ * Proporciona un reloj monotono para medir tiempos de ejecucion de consultas
+ * y operaciones costosas sin verse afectado por cambios de hora del sistema.
+ */
+double get_time_ms()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frecuencia;
+    LARGE_INTEGER contador;
+    if (frecuencia.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frecuencia);
+    }
+    QueryPerformanceCounter(&contador);
+    return (double)contador.QuadPart * 1000.0 / (double)frecuencia.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1000.0 + (double)ts.tv_nsec / 1000000.0;
+#endif
+}
+
 /**
  * Verifica la existencia de registros en la base de datos para mantener la integridad referencial
  * y evitar operaciones inválidas que puedan corromper los datos.
@@ -219,21 +244,45 @@ int existe_id(const char *tabla, int id)
     sqlite3_stmt *stmt;
     char sql[128];
 
-    sprintf(sql, "SELECT 1 FROM %s WHERE id=?", tabla);
-    sqlite3_prepare_v2(db, sql, -1, &stmt, NULL);
+    snprintf(sql, sizeof(sql), "SELECT 1 FROM %s WHERE id=?", tabla);
+    stmt = db_prepare_cached(sql);
+    if (!stmt)
+        return 0;
     sqlite3_bind_int(stmt, 1, id);
 
     int existe = (sqlite3_step(stmt) == SQLITE_ROW);
-    sqlite3_finalize(stmt);
+    db_release_cached(stmt);
     return existe;
 }
 
+/** Modo no interactivo: sin pausas ni limpieza de pantalla */
+static int modo_batch = 0;
+
+/**
+ * Activa o desactiva el modo no interactivo usado por la linea de comandos,
+ * en el que las pausas y la limpieza de pantalla no hacen nada.
+ */
+void set_modo_batch(int activo)
+{
+    modo_batch = activo ? 1 : 0;
+}
+
+/**
+ * Indica si la aplicacion se ejecuta en modo no interactivo.
+ */
+int es_modo_batch()
+{
+    return modo_batch;
+}
+
 /**
  * Limpia la pantalla de la consola para proporcionar una interfaz limpia y organizada,
  * mejorando la legibilidad de la información mostrada.
  */
 void clear_screen()
 {
+    if (modo_batch)
+        return;
 #ifdef _WIN32
     system("cls");
 #else
@@ -331,6 +380,8 @@ void print_header(const char *titulo)
  */
 void pause_console()
 {
+    if (modo_batch)
+        return;
     printf("\nPresione ENTER para continuar...");
     getchar();
 }
@@ -470,6 +521,163 @@ void convert_display_date_to_storage(const char *display_date, char *storage_buf
     storage_buffer[buffer_size - 1] = '\0';
 }
 
+/**
+ * @brief Dias de un mes del calendario gregoriano, con anios bisiestos
+ */
+static int dias_del_mes(int mes, int anio)
+{
+    static const int DIAS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int bisiesto = (anio % 4 == 0 && anio % 100 != 0) || anio % 400 == 0;
+
+    return mes == 2 && bisiesto ? 29 : DIAS[mes - 1];
+}
+
+/**
+ * @brief Comprueba que un texto siga exactamente un formato de fecha
+ *
+ * Cada '9' del formato pide un digito; el resto de los caracteres debe
+ * coincidir tal cual y el texto no puede tener nada despues.
+ */
+static int coincide_formato(const char *texto, const char *formato)
+{
+    for (; *formato; texto++, formato++)
+    {
+        if (*formato == '9' ? !isdigit((unsigned char)*texto) : *texto != *formato)
+            return 0;
+    }
+    return *texto == '\0';
+}
+
+/**
+ * @brief Lee dia, mes, anio y hora opcional con sscanf
+ *
+ * Los formatos reciben los tres campos de la fecha en el orden en que
+ * aparecen en el texto; solo se admiten espacios despues de la hora.
+ *
+ * @return 1 si el texto completo coincide con alguno de los dos formatos
+ */
+static int leer_campos_fecha(const char *fecha, const char *con_hora, const char *sin_hora,
+                             int *a, int *b, int *c, int *hh, int *mm)
+{
+    int fin = -1;
+
+    *hh = 0;
+    *mm = 0;
+    if (sscanf(fecha, con_hora, a, b, c, hh, mm, &fin) == 5 && fin >= 0 && fecha[fin] == '\0')
+        return 1;
+    fin = -1;
+    *hh = 0;
+    *mm = 0;
+    return sscanf(fecha, sin_hora, a, b, c, &fin) == 3 && fin >= 0 && fecha[fin] == '\0';
+}
+
+/**
+ * @brief Segundos desde 1970 de una fecha ya separada en campos
+ *
+ * @return 1 si el dia existe en ese mes (con bisiestos) y la hora es valida
+ */
+static int epoch_de_campos(int d, int m, int y, int hh, int mm, long long *epoch)
+{
+    if (y < 1000 || y > 9999 || m < 1 || m > 12 || d < 1 || d > dias_del_mes(m, y) ||
+            hh < 0 || hh > 23 || mm < 0 || mm > 59)
+        return 0;
+
+    // Dias desde 1970-01-01 en el calendario gregoriano proleptico
+    long long ya = y - (m <= 2);
+    long long era = (ya >= 0 ? ya : ya - 399) / 400;
+    long long yoe = ya - era * 400;
+    long long doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    long long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long long dias = era * 146097 + doe - 719468;
+
+    *epoch = dias * 86400LL + hh * 3600LL + mm * 60LL;
+    return 1;
+}
+
+/**
+ * Calcula un instante ordenable a partir de la fecha en texto para que
+ * las consultas por anio, mes, dia de semana y recencia no tengan que
+ * reinterpretar la cadena en cada fila. Solo admite los formatos que
+ * reconoce SQL_FECHA_TS en los triggers de migraciones.c, asi la columna
+ * fecha_ts da lo mismo la escriba la aplicacion o cualquier otro cliente.
+ */
+int fecha_a_epoch(const char *fecha, long long *epoch)
+{
+    int d, m, y, hh, mm;
+
+    if (!fecha || !epoch)
+        return 0;
+
+    if (coincide_formato(fecha, "99/99/9999 99:99") || coincide_formato(fecha, "99/99/9999"))
+        leer_campos_fecha(fecha, "%d/%d/%d %d:%d%n", "%d/%d/%d%n", &d, &m, &y, &hh, &mm);
+    else if (coincide_formato(fecha, "9999-99-99 99:99") || coincide_formato(fecha, "9999-99-99"))
+        leer_campos_fecha(fecha, "%d-%d-%d %d:%d%n", "%d-%d-%d%n", &y, &m, &d, &hh, &mm);
+    else
+        return 0;
+
+    return epoch_de_campos(d, m, y, hh, mm, epoch);
+}
+
+/**
+ * Lleva la fecha que escribe el usuario o trae un archivo importado al
+ * formato de almacenamiento, el unico que fecha_a_epoch() y los triggers
+ * entienden: "5/9/2026 18:30" pasa a ser "05/09/2026 18:30".
+ */
+int normalizar_fecha(const char *entrada, char *destino, int tam)
+{
+    int d, m, y, hh, mm;
+    long long epoch;
+
+    if (!entrada)
+        return 0;
+
+    if (!leer_campos_fecha(entrada, " %d/%d/%d %d:%d %n", " %d/%d/%d %n", &d, &m, &y, &hh, &mm) &&
+            !leer_campos_fecha(entrada, " %d-%d-%d %d:%d %n", " %d-%d-%d %n", &y, &m, &d, &hh, &mm))
+        return 0;
+    if (!epoch_de_campos(d, m, y, hh, mm, &epoch))
+        return 0;
+
+    formatear_epoch(epoch, destino, tam);
+    return 1;
+}
+
+/**
+ * Inversa de fecha_a_epoch(): permite guardar en el formato de siempre
+ * fechas que el usuario ingreso en otro formato admitido.
+ */
+void formatear_epoch(long long epoch, char *buffer, int size)
+{
+    long long dias = epoch >= 0 ? epoch / 86400 : -((-epoch + 86399) / 86400);
+    long long segundos = epoch - dias * 86400;
+    long long z = dias + 719468;
+    long long era = (z >= 0 ? z : z - 146096) / 146097;
+    long long doe = z - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    int d = (int)(doy - (153 * mp + 2) / 5 + 1);
+    int m = (int)(mp < 10 ? mp + 3 : mp - 9);
+    int y = (int)(yoe + era * 400 + (m <= 2));
+
+    snprintf(buffer, size, "%02d/%02d/%04d %02d:%02d", d, m, y,
+             (int)(segundos / 3600), (int)(segundos % 3600 / 60));
+}
+
+/**
+ * @brief Redondea a un numero de decimales como ROUND() de SQLite
+ */
+double redondear(double valor, int decimales)
+{
+    double escala = 1.0;
+    for (int i = 0; i < decimales; i++)
+        escala *= 10.0;
+
+    // El margen absorbe el error de representacion binaria del valor escalado
+    if (valor < 0)
+        return -floor(-valor * escala + 0.5 + 1e-9) / escala;
+    return floor(valor * escala + 0.5 + 1e-9) / escala;
+}
+
 /**
  * Normaliza cadenas de texto removiendo caracteres acentuados para asegurar compatibilidad con sistemas que no los soportan
  * y mejorar la consistencia en búsquedas.
@@ -495,6 +703,86 @@ char* remover_tildes(const char *str)
     return buffer;
 }
 
+/**
+ * Separa el texto en palabras (letras, digitos y cualquier byte no ASCII,
+ * para conservar caracteres acentuados) y arma "palabra"* por cada una.
+ */
+int texto_a_consulta_fts(const char *texto, char *destino, int tam)
+{
+    int palabras = 0;
+    int pos = 0;
+    const unsigned char *p = (const unsigned char *)texto;
+
+    destino[0] = '\0';
+    while (*p)
+    {
+        while (*p && *p < 0x80 && !isalnum(*p))
+            p++;
+        if (!*p)
+            break;
+
+        const unsigned char *inicio = p;
+        while (*p && (*p >= 0x80 || isalnum(*p)))
+            p++;
+
+        int largo = (int)(p - inicio);
+        // Separador + comillas + asterisco + terminador
+        if (pos + largo + 5 > tam)
+            break;
+        pos += snprintf(destino + pos, tam - pos, "%s\"%.*s\"*", palabras > 0 ? " " : "", largo, (const char *)inicio);
+        palabras++;
+    }
+    return palabras;
+}
+
+/**
+ * Las dos sentencias se arman con el nombre de la tabla y pasan por la
+ * cache, que guarda su propia copia del texto SQL.
+ */
+int mostrar_busqueda_fts(const char *tabla, const char *select_desde, const char *consulta,
+                         ImprimirFilaFts imprimir, const char *sin_resultados, const char *articulo)
+{
+    char sql[1024];
+
+    snprintf(sql, sizeof(sql), "SELECT COUNT(*) FROM %s WHERE %s MATCH ?", tabla, tabla);
+    sqlite3_stmt *stmt = db_prepare_cached(sql);
+    if (!stmt)
+    {
+        printf("La busqueda de texto no esta disponible: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    sqlite3_bind_text(stmt, 1, consulta, -1, SQLITE_TRANSIENT);
+    int total = sqlite3_step(stmt) == SQLITE_ROW ? sqlite3_column_int(stmt, 0) : 0;
+    db_release_cached(stmt);
+
+    if (total == 0)
+    {
+        printf("%s\n", sin_resultados);
+        return 1;
+    }
+
+    snprintf(sql, sizeof(sql), "%s WHERE %s MATCH ? ORDER BY bm25(%s) LIMIT ?", select_desde, tabla, tabla);
+    stmt = db_prepare_cached(sql);
+    if (!stmt)
+    {
+        printf("Error en la busqueda: %s\n", sqlite3_errmsg(db));
+        return 0;
+    }
+    sqlite3_bind_text(stmt, 1, consulta, -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(stmt, 2, settings_get()->tamano_pagina);
+
+    int mostrados = 0;
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        imprimir(stmt);
+        mostrados++;
+    }
+    db_release_cached(stmt);
+
+    printf("\nMostrando %s %d mas relevantes de %d coincidencias.\n", articulo, mostrados, total);
+    return 1;
+}
+
 /**
  * Convierte un valor de resultado a texto
  *
@@ -10,6 +10,8 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include "sqlite3.h"
+
 /**
  * @brief Solicita al usuario un número entero.
  *
@@ -74,6 +76,33 @@ void get_datetime(char *buffer, int size);
  */
 void get_timestamp(char *buffer, int size);
 
+/**
+ * @brief Obtiene un instante monotono de alta resolucion en milisegundos.
+ *
+ * Solo sirve para medir intervalos (restando dos lecturas); el origen
+ * depende del sistema operativo.
+ *
+ * @return Milisegundos transcurridos desde un origen arbitrario.
+ */
+double get_time_ms();
+
+/**
+ * @brief Activa o desactiva el modo no interactivo.
+ *
+ * En modo no interactivo clear_screen() y pause_console() no hacen nada,
+ * de forma que las funciones de menu se pueden invocar desde scripts.
+ *
+ * @param activo 1 para activar, 0 para desactivar.
+ */
+void set_modo_batch(int activo);
+
+/**
+ * @brief Indica si el modo no interactivo esta activo.
+ *
+ * @return 1 si esta activo, 0 en caso contrario.
+ */
+int es_modo_batch();
+
 /**
  * @brief Limpia la pantalla de la consola.
  */
@@ -159,6 +188,57 @@ void format_date_for_display(const char *input_date, char *output_buffer, int bu
  */
 void convert_display_date_to_storage(const char *display_date, char *storage_buffer, int buffer_size);
 
+/**
+ * @brief Convierte una fecha almacenada a segundos desde 1970-01-01 00:00
+ *
+ * Acepta "dd/mm/yyyy hh:mm" y "yyyy-mm-dd hh:mm", con o sin hora y con
+ * ceros a la izquierda, igual que los triggers de fecha_ts. La hora se
+ * interpreta tal cual, sin zona horaria, de modo que
+ * strftime(..., 'unixepoch') devuelve los mismos campos.
+ *
+ * @param fecha Fecha en texto
+ * @param epoch Destino de los segundos calculados
+ * @return 1 si la fecha es valida (el dia existe en ese mes, con bisiestos,
+ *         y el anio esta entre 1000 y 9999), 0 en caso contrario
+ */
+int fecha_a_epoch(const char *fecha, long long *epoch);
+
+/**
+ * @brief Normaliza una fecha ingresada al formato de almacenamiento
+ *
+ * Acepta los formatos de fecha_a_epoch() tambien sin ceros a la izquierda
+ * y con espacios alrededor, y escribe siempre "dd/mm/yyyy hh:mm".
+ * destino puede ser el mismo buffer que entrada.
+ *
+ * @param entrada Fecha en texto
+ * @param destino Buffer de salida (al menos 17 caracteres)
+ * @param tam Tamano del buffer
+ * @return 1 si la fecha es valida, 0 en caso contrario (destino no cambia)
+ */
+int normalizar_fecha(const char *entrada, char *destino, int tam);
+
+/**
+ * @brief Convierte segundos desde 1970-01-01 00:00 a "dd/mm/yyyy hh:mm"
+ *
+ * @param epoch Segundos, como los devuelve fecha_a_epoch()
+ * @param buffer Buffer de salida (al menos 17 caracteres)
+ * @param size Tamano del buffer
+ */
+void formatear_epoch(long long epoch, char *buffer, int size);
+
+/**
+ * @brief Redondea a un numero de decimales como ROUND() de SQLite
+ *
+ * Los empates se alejan del cero y un valor como 2.675 (2.67499... en
+ * binario) redondea a 2.68, de modo que los calculos hechos en C
+ * muestran las mismas cifras que las consultas que reemplazan.
+ *
+ * @param valor Valor a redondear
+ * @param decimales Numero de decimales
+ * @return Valor redondeado
+ */
+double redondear(double valor, int decimales);
+
 /**
  * @brief Remueve tildes y caracteres acentuados de una cadena
  *
@@ -169,6 +249,48 @@ void convert_display_date_to_storage(const char *display_date, char *storage_buf
  */
 char* remover_tildes(const char *str);
 
+/**
+ * @brief Convierte texto libre en una consulta MATCH de FTS5
+ *
+ * Cada palabra se entrega como termino entre comillas con busqueda por
+ * prefijo ("rodi" encuentra "rodilla") y todas deben aparecer. Los signos
+ * de puntuacion separan palabras, asi que el texto del usuario nunca se
+ * interpreta como sintaxis de FTS5.
+ *
+ * @param texto Texto ingresado por el usuario
+ * @param destino Buffer para la consulta
+ * @param tam Tamano del buffer
+ * @return Numero de palabras de la consulta (0 si no hay ninguna)
+ */
+int texto_a_consulta_fts(const char *texto, char *destino, int tam);
+
+/**
+ * @brief Imprime una fila del resultado de una busqueda de texto
+ *
+ * @param stmt Sentencia posicionada en la fila; las columnas son las del
+ *             SELECT pasado a mostrar_busqueda_fts()
+ */
+typedef void (*ImprimirFilaFts)(sqlite3_stmt *stmt);
+
+/**
+ * @brief Muestra las coincidencias mas relevantes de una consulta FTS5
+ *
+ * Cuenta las coincidencias de la tabla, trae las mejores ordenadas por
+ * bm25 hasta el tamano de pagina configurado y cierra con el resumen
+ * "Mostrando N mas relevantes de M coincidencias". No pausa la consola.
+ *
+ * @param tabla Tabla FTS5 consultada
+ * @param select_desde SELECT ... FROM ... JOIN ... sin WHERE; se completa
+ *                     con el MATCH, el orden por bm25 y el LIMIT
+ * @param consulta Consulta armada con texto_a_consulta_fts()
+ * @param imprimir Funcion que imprime cada fila
+ * @param sin_resultados Mensaje si no hay coincidencias
+ * @param articulo "los" o "las", segun lo que se busca
+ * @return 1 si la busqueda se pudo ejecutar, 0 en caso de error
+ */
+int mostrar_busqueda_fts(const char *tabla, const char *select_desde, const char *consulta,
+                         ImprimirFilaFts imprimir, const char *sin_resultados, const char *articulo);
+
 /**
  * @brief Convierte un valor de resultado a texto
  *